@@ -12,6 +12,7 @@ CONFIG_TREE_DATA = [
                 ("3.6", [
                     ("parallel_tbb", [X(True)]),
                     ("parallel_native", [X(True)]),
+                    ("parallel_work_stealing", [X(True)]),
                 ]),
             ]),
             # TODO: bring back libtorch test
@@ -121,6 +122,7 @@ class ExperimentalFeatureConfigNode(TreeConfigNode):
             "xla": XlaConfigNode,
             "parallel_tbb": ParallelTBBConfigNode,
             "parallel_native": ParallelNativeConfigNode,
+            "parallel_work_stealing": ParallelWorkStealingConfigNode,
             "libtorch": LibTorchConfigNode,
             "important": ImportantConfigNode,
             "build_only": BuildOnlyConfigNode,
@@ -162,6 +164,17 @@ class ParallelNativeConfigNode(TreeConfigNode):
         return ImportantConfigNode
 
 
+class ParallelWorkStealingConfigNode(TreeConfigNode):
+    def modify_label(self, label):
+        return "PARALLELWORKSTEALING=" + str(label)
+
+    def init2(self, node_name):
+        self.props["parallel_backend"] = "parallelworkstealing"
+
+    def child_constructor(self):
+        return ImportantConfigNode
+
+
 class LibTorchConfigNode(TreeConfigNode):
     def modify_label(self, label):
         return "BUILD_TEST_LIBTORCH=" + str(label)
@@ -131,6 +131,7 @@ def gen_dependent_configs(xenial_parent_config):
         (["multigpu"], "large"),
         (["NO_AVX2"], "medium"),
         (["NO_AVX", "NO_AVX2"], "medium"),
+        (["AVX512"], "medium"),
         (["slow"], "medium"),
         (["nogpu"], None),
     ]
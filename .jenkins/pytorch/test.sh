@@ -137,6 +137,16 @@ if [[ "${BUILD_ENVIRONMENT}" == *-NO_AVX-* ]]; then
   export ATEN_CPU_CAPABILITY=default
 elif [[ "${BUILD_ENVIRONMENT}" == *-NO_AVX2-* ]]; then
   export ATEN_CPU_CAPABILITY=avx
+elif [[ "${BUILD_ENVIRONMENT}" == *-AVX512-* ]]; then
+  # Forcing the AVX512 kernels on a machine without them dies with SIGILL,
+  # so fail with a readable message instead.
+  for flag in avx512f avx512bw avx512dq avx512vl; do
+    if ! grep -qw "$flag" /proc/cpuinfo; then
+      echo "AVX512 test shard scheduled on a machine without $flag"
+      exit 1
+    fi
+  done
+  export ATEN_CPU_CAPABILITY=avx512
 fi
 
 if [ -n "$CIRCLE_PULL_REQUEST" ]; then
@@ -143,6 +143,16 @@ CAFFE2_API std::shared_ptr<c10::ivalue::Future> intraop_launch_future(
 // Returns number of intra-op threads used by default
 CAFFE2_API int intraop_default_num_threads();
 
+// Pins the intra-op pool threads of the native and work-stealing backends to
+// the CPUs and memory of a NUMA node (-1, the default, leaves them unpinned).
+// Only takes effect if NUMA support is enabled and must be called before the
+// first parallel region. With a node set, the default number of intra-op
+// threads is derived from the CPUs of that node.
+CAFFE2_API void set_intraop_numa_node(int numa_node_id);
+
+// Returns the NUMA node set by set_intraop_numa_node, or -1
+CAFFE2_API int get_intraop_numa_node();
+
 } // namespace at
 
 #if AT_PARALLEL_OPENMP
@@ -151,4 +161,6 @@ CAFFE2_API int intraop_default_num_threads();
 #include <ATen/ParallelNative.h>
 #elif AT_PARALLEL_NATIVE_TBB
 #include <ATen/ParallelNativeTBB.h>
+#elif AT_PARALLEL_WORK_STEALING
+#include <ATen/ParallelWorkStealing.h>
 #endif
@@ -4,6 +4,10 @@
 #include <ATen/PTThreadPool.h>
 #include <ATen/Version.h>
 
+#include <c10/util/numa.h>
+
+#include <algorithm>
+#include <atomic>
 #include <sstream>
 #include <thread>
 
@@ -40,6 +44,8 @@ size_t get_env_num_threads(const char* var_name, size_t def_value = 0) {
   return def_value;
 }
 
+std::atomic<int> intraop_numa_node{-1};
+
 } // namespace
 
 std::string get_parallel_info() {
@@ -65,6 +71,12 @@ std::string get_parallel_info() {
   ss << "std::thread::hardware_concurrency() : "
      << std::thread::hardware_concurrency() << std::endl;
 
+  if (c10::IsNUMAEnabled()) {
+    ss << "NUMA nodes : " << c10::GetNumNUMANodes()
+       << ", intra-op threads pinned to node : "
+       << at::get_intraop_numa_node() << std::endl;
+  }
+
   ss << "Environment variables:" << std::endl;
   ss << "\tOMP_NUM_THREADS : "
      << get_env_var("OMP_NUM_THREADS", "[not set]") << std::endl;
@@ -78,6 +90,8 @@ std::string get_parallel_info() {
   ss << "native thread pool";
   #elif AT_PARALLEL_NATIVE_TBB
   ss << "native thread pool and TBB";
+  #elif AT_PARALLEL_WORK_STEALING
+  ss << "native thread pool and work-stealing thread pool";
   #endif
   #ifdef C10_MOBILE
   ss << " [mobile]";
@@ -101,10 +115,28 @@ int intraop_default_num_threads() {
   size_t nthreads = get_env_num_threads("OMP_NUM_THREADS", 0);
   nthreads = get_env_num_threads("MKL_NUM_THREADS", nthreads);
   if (nthreads == 0) {
-    nthreads = TaskThreadPoolBase::defaultNumThreads();
+    auto numa_cpus = c10::GetNUMANodeCPUs(get_intraop_numa_node());
+    if (!numa_cpus.empty()) {
+      // one thread per physical core of the node, as defaultNumThreads does
+      nthreads = numa_cpus.size();
+#if defined(_M_X64) || defined(__x86_64__)
+      nthreads = std::max<size_t>(nthreads / 2, 1);
+#endif
+    } else {
+      nthreads = TaskThreadPoolBase::defaultNumThreads();
+    }
   }
   return nthreads;
 #endif
 }
 
+void set_intraop_numa_node(int numa_node_id) {
+  TORCH_CHECK(numa_node_id >= -1, "Invalid NUMA node id: ", numa_node_id);
+  intraop_numa_node.store(numa_node_id);
+}
+
+int get_intraop_numa_node() {
+  return intraop_numa_node.load();
+}
+
 } // namespace at
@@ -11,6 +11,11 @@
 #endif // C10_MOBILE
 
 #include <atomic>
+#include <mutex>
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -66,14 +71,56 @@ int _num_pool_threads(int nthreads) {
   return nthreads - 1;
 }
 
+// The pool is created on first use. It is not a function-local static so
+// that a forked child can drop it, see _forked_child().
+std::mutex intraop_pool_mutex;
+std::shared_ptr<TaskThreadPoolBase> intraop_pool;
+std::atomic<TaskThreadPoolBase*> intraop_pool_ptr{nullptr};
+
+#ifndef _WIN32
+void _lock_before_fork() {
+  intraop_pool_mutex.lock();
+}
+
+void _unlock_after_fork() {
+  intraop_pool_mutex.unlock();
+}
+
+// Only the forking thread exists in the child, so tasks submitted to the
+// parent's pool would never run. The pool is leaked rather than destroyed,
+// which would join threads that don't exist, and the child starts over as
+// if no parallel work had been done yet.
+void _forked_child() {
+  new std::shared_ptr<TaskThreadPoolBase>(std::move(intraop_pool));
+  intraop_pool_ptr.store(nullptr);
+  num_intraop_threads.store(NOT_SET);
+  in_parallel_region_ = false;
+  thread_num_ = 0;
+  intraop_pool_mutex.unlock();
+}
+#endif
+
 TaskThreadPoolBase& _get_intraop_pool() {
-  static std::shared_ptr<TaskThreadPoolBase> pool =
-      ThreadPoolRegistry()->Create(
-          "C10",
-          /* device_id */ 0,
-          /* pool_size */ _num_pool_threads(num_intraop_threads.exchange(CONSUMED)),
-          /* create_new */ true); // create a separate thread pool for intra-op
-  return *pool;
+  TaskThreadPoolBase* pool = intraop_pool_ptr.load(std::memory_order_acquire);
+  if (pool) {
+    return *pool;
+  }
+#ifndef _WIN32
+  static std::once_flag flag;
+  std::call_once(flag, [] {
+    pthread_atfork(_lock_before_fork, _unlock_after_fork, _forked_child);
+  });
+#endif
+  std::lock_guard<std::mutex> guard(intraop_pool_mutex);
+  if (!intraop_pool) {
+    intraop_pool = ThreadPoolRegistry()->Create(
+        "C10",
+        /* device_id */ get_intraop_numa_node(),
+        /* pool_size */ _num_pool_threads(num_intraop_threads.exchange(CONSUMED)),
+        /* create_new */ true); // create a separate thread pool for intra-op
+    intraop_pool_ptr.store(intraop_pool.get(), std::memory_order_release);
+  }
+  return *intraop_pool;
 }
 
 #endif // C10_MOBILE
@@ -1,5 +1,5 @@
 #include <ATen/Config.h>
-#if AT_PARALLEL_OPENMP || AT_PARALLEL_NATIVE || AT_PARALLEL_NATIVE_TBB
+#if AT_PARALLEL_OPENMP || AT_PARALLEL_NATIVE || AT_PARALLEL_NATIVE_TBB || AT_PARALLEL_WORK_STEALING
 #include <ATen/Parallel.h>
 #include <ATen/PTThreadPool.h>
 #include <ATen/ThreadLocalState.h>
@@ -25,7 +25,7 @@ TaskThreadPoolBase& get_pool() {
   static std::shared_ptr<TaskThreadPoolBase> pool =
       ThreadPoolRegistry()->Create(
           "C10",
-          /* device_id */ 0,
+          /* device_id */ -1,
           /* pool_size */ num_interop_threads.exchange(CONSUMED),
           /* create_new */ true);
   return *pool;
@@ -36,11 +36,12 @@ std::shared_ptr<TaskThreadPoolBase> create_c10_threadpool(
     int device_id,
     int pool_size,
     bool create_new) {
-  // For now, the only accepted device id is 0
-  TORCH_CHECK(device_id == 0);
+  // As with the caffe2 CPU pools, the device id is the NUMA node the pool
+  // threads are bound to, or -1 for no binding
+  TORCH_CHECK(device_id >= -1);
   // Create new thread pool
   TORCH_CHECK(create_new);
-  return std::make_shared<PTThreadPool>(pool_size);
+  return std::make_shared<PTThreadPool>(pool_size, device_id);
 }
 
 } // namespace
@@ -0,0 +1,245 @@
+#include <ATen/Config.h>
+#if AT_PARALLEL_WORK_STEALING
+#include <ATen/Parallel.h>
+#include <ATen/PTThreadPool.h>
+
+#include <c10/core/work_stealing_pool.h>
+#include <c10/util/numa.h>
+#include <c10/util/thread_name.h>
+
+#include <atomic>
+#include <mutex>
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef TH_BLAS_MKL
+#include <mkl.h>
+#endif
+
+namespace at {
+namespace {
+// used with ParallelRegionGuard to mark the current thread as in parallel
+// region while executing a piece of a parallel primitive
+thread_local bool in_parallel_region_ = false;
+
+// thread number set by parallel primitive: the id of the task being run
+thread_local size_t thread_num_ = 0;
+
+const int NOT_SET = -1;
+const int CONSUMED = -2;
+
+// Number of threads set by the user
+// NOT_SET -> positive value -> CONSUMED
+// or
+// NOT_SET -> CONSUMED
+// Meaning:
+//  - NOT_SET - pool not initialized, user value is not set
+//  - positive value - pool not initialized, user value set
+//  - CONSUMED - pool is initialized
+std::atomic<int> num_intraop_threads{NOT_SET};
+
+int _num_pool_threads(int nthreads) {
+  if (nthreads == NOT_SET) {
+    nthreads = intraop_default_num_threads();
+  } else {
+    TORCH_INTERNAL_ASSERT(nthreads > 0);
+  }
+  // minus one because of the master thread
+  return nthreads - 1;
+}
+
+// The pool is created on first use. It is not a function-local static so
+// that a forked child can drop it, see _forked_child().
+std::mutex intraop_pool_mutex;
+std::shared_ptr<c10::WorkStealingPool> intraop_pool;
+std::atomic<c10::WorkStealingPool*> intraop_pool_ptr{nullptr};
+
+#ifndef _WIN32
+void _lock_before_fork() {
+  intraop_pool_mutex.lock();
+}
+
+void _unlock_after_fork() {
+  intraop_pool_mutex.unlock();
+}
+
+// Only the forking thread exists in the child, so the workers of the
+// parent's pool would never pick up work. The pool is leaked rather than
+// destroyed, which would join threads that don't exist, and the child starts
+// over as if no parallel work had been done yet.
+void _forked_child() {
+  new std::shared_ptr<c10::WorkStealingPool>(std::move(intraop_pool));
+  intraop_pool_ptr.store(nullptr);
+  num_intraop_threads.store(NOT_SET);
+  in_parallel_region_ = false;
+  thread_num_ = 0;
+  intraop_pool_mutex.unlock();
+}
+#endif
+
+c10::WorkStealingPool& _get_intraop_pool() {
+  c10::WorkStealingPool* pool =
+      intraop_pool_ptr.load(std::memory_order_acquire);
+  if (pool) {
+    return *pool;
+  }
+#ifndef _WIN32
+  static std::once_flag flag;
+  std::call_once(flag, [] {
+    pthread_atfork(_lock_before_fork, _unlock_after_fork, _forked_child);
+  });
+#endif
+  std::lock_guard<std::mutex> guard(intraop_pool_mutex);
+  if (!intraop_pool) {
+    intraop_pool = std::make_shared<c10::WorkStealingPool>(
+        _num_pool_threads(num_intraop_threads.exchange(CONSUMED)),
+        [numa_node_id = get_intraop_numa_node()]() {
+          c10::setThreadName("PTIntraOpWS");
+          c10::NUMABind(numa_node_id);
+          at::init_num_threads();
+        });
+    intraop_pool_ptr.store(intraop_pool.get(), std::memory_order_release);
+  }
+  return *intraop_pool;
+}
+
+// RAII guard helps to support in_parallel_region() and get_thread_num() API.
+struct ParallelRegionGuard {
+  ParallelRegionGuard(size_t thread_num)
+      : prev_in_region_(in_parallel_region_), prev_thread_num_(thread_num_) {
+    thread_num_ = thread_num;
+    in_parallel_region_ = true;
+  }
+
+  ~ParallelRegionGuard() {
+    in_parallel_region_ = prev_in_region_;
+    thread_num_ = prev_thread_num_;
+  }
+
+ private:
+  bool prev_in_region_;
+  size_t prev_thread_num_;
+};
+
+} // namespace
+
+namespace internal {
+
+void _parallel_run(
+  const int64_t begin,
+  const int64_t end,
+  const int64_t grain_size,
+  const std::function<void(int64_t, int64_t, size_t)>& f) {
+  at::internal::lazy_init_num_threads();
+
+  size_t num_tasks, chunk_size;
+  std::tie(num_tasks, chunk_size) =
+      internal::calc_num_tasks_and_chunk_size(begin, end, grain_size);
+
+  _get_intraop_pool().parallelFor(
+      0,
+      num_tasks,
+      /* grain_size */ 1,
+      [&f, begin, end, chunk_size](int64_t first_task, int64_t last_task) {
+        for (int64_t task_id = first_task; task_id < last_task; ++task_id) {
+          int64_t local_start = begin + task_id * chunk_size;
+          int64_t local_end =
+              std::min(end, (int64_t)(chunk_size + local_start));
+          ParallelRegionGuard guard(task_id);
+          f(local_start, local_end, task_id);
+        }
+      });
+}
+
+} // namespace internal
+
+void init_num_threads() {
+#ifdef _OPENMP
+  omp_set_num_threads(1);
+#endif
+
+#ifdef TH_BLAS_MKL
+  mkl_set_num_threads(1);
+#endif
+}
+
+void set_num_threads(int nthreads) {
+  TORCH_CHECK(nthreads > 0, "Expected positive number of threads");
+  int no_value = NOT_SET;
+  if (!num_intraop_threads.compare_exchange_strong(no_value, nthreads)) {
+    // num_intraop_threads either stores a positive integer or CONSUMED,
+    // check that requested size is the same as the current one
+    int stored_nthreads = num_intraop_threads.load();
+    if (stored_nthreads <= 0) {
+      // plus one because of master thread
+      stored_nthreads = _get_intraop_pool().size() + 1;
+    }
+    if (stored_nthreads != nthreads) {
+      TORCH_WARN(
+        "Cannot set number of intraop threads "
+        "after parallel work has started or after set_num_threads call "
+        "when using work-stealing parallel backend");
+    }
+  }
+}
+
+int get_num_threads() {
+  // not initializing pool unnecessarily,
+  // because pool cannot be resized after initialization
+  int nthreads = num_intraop_threads.load();
+  if (nthreads > 0) {
+    return nthreads;
+  } else if (nthreads == NOT_SET) {
+    return intraop_default_num_threads();
+  } else {
+    TORCH_INTERNAL_ASSERT(nthreads == CONSUMED);
+    return _get_intraop_pool().size() + 1;
+  }
+}
+
+int get_thread_num() {
+  return thread_num_;
+}
+
+bool in_parallel_region() {
+  return in_parallel_region_ || (
+    num_intraop_threads.load() == CONSUMED &&
+    // Needed as intraop_launch() doesn't set in_parallel_region().
+    _get_intraop_pool().inThreadPool()
+  );
+}
+
+void intraop_launch(std::function<void()> func) {
+  if (!in_parallel_region() && get_num_threads() > 1) {
+    _get_intraop_pool().run(func);
+  } else {
+    // execute inline if we're in parallel region
+    func();
+  }
+}
+
+std::shared_ptr<c10::ivalue::Future> intraop_launch_future(
+    std::function<void()> func) {
+  auto future = std::make_shared<c10::ivalue::Future>(c10::NoneType::get());
+  if (!in_parallel_region() && get_num_threads() > 1) {
+    _get_intraop_pool().run(
+      [func, future]() {
+        func();
+        future->markCompleted();
+      }
+    );
+  } else {
+    func();
+    future->markCompleted();
+  }
+  return future;
+}
+
+} // namespace at
+#endif
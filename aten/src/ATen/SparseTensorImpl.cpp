@@ -109,6 +109,7 @@ void SparseTensorImpl::set_indices_and_values_unsafe(const Tensor& indices, cons
 
   indices_ = indices;
   values_ = values;
+  set_csr_indices(nullptr);
   AT_ASSERT(device() == values_.device());
   AT_ASSERT(values_.device() == indices_.device());
 
@@ -4,7 +4,25 @@
 #include <c10/core/TensorImpl.h>
 #include <c10/util/Exception.h>
 
+#include <memory>
+
 namespace at {
+
+// The row pointers of a 2-D sparse matrix in CSR format: the elements of row
+// `i` are `perm[row_ptr[i]:row_ptr[i+1]]`, or `row_ptr[i]:row_ptr[i+1]` when
+// `perm` is undefined because the elements are already ordered by row (as in
+// a coalesced matrix). Computed by sparse-dense matrix products, and cached
+// on the SparseTensorImpl together with what it was computed from.
+struct SparseCsrIndices {
+  Tensor row_ptr;
+  Tensor perm;
+
+  Tensor indices;
+  uint32_t indices_version;
+  std::vector<int64_t> sizes;
+  bool coalesced;
+};
+
 struct CAFFE2_API SparseTensorImpl : public TensorImpl {
   // Stored in COO format, indices + values.
 
@@ -29,6 +47,10 @@ struct CAFFE2_API SparseTensorImpl : public TensorImpl {
   // because many algorithms proceed by merging two sorted lists (of indices).
   bool coalesced_ = false;
 
+  // Mutable because it is only a cache. Accessed atomically, since several
+  // threads may multiply with the same sparse matrix.
+  mutable std::shared_ptr<const SparseCsrIndices> csr_indices_;
+
 public:
   // Public for now...
   explicit SparseTensorImpl(at::DispatchKeySet, const caffe2::TypeMeta&);
@@ -40,6 +62,15 @@ public:
   Tensor indices() const { return indices_; }
   Tensor values() const { return values_; }
 
+  // The cached CSR row pointers, if any. Callers must check that they match
+  // the current indices, sizes and coalesced flag before using them.
+  std::shared_ptr<const SparseCsrIndices> csr_indices() const {
+    return std::atomic_load(&csr_indices_);
+  }
+  void set_csr_indices(std::shared_ptr<const SparseCsrIndices> csr_indices) const {
+    std::atomic_store(&csr_indices_, std::move(csr_indices));
+  }
+
   IntArrayRef strides() const override;
   bool is_contiguous(at::MemoryFormat memory_format=at::MemoryFormat::Contiguous) const override;
   int64_t stride(int64_t d) const override;
@@ -170,6 +201,7 @@ public:
     AT_ASSERT(new_nnz <= nnz());
     indices_ = indices_.narrow(1, 0, new_nnz);
     values_ = values_.narrow(0, 0, new_nnz);
+    set_csr_indices(nullptr);
   }
 
   // Takes indices and values and directly puts them into the sparse tensor, no copy.
@@ -238,6 +270,7 @@ private:
     dest_sparse_impl->indices_ = src_sparse_impl->indices();
     dest_sparse_impl->values_ = src_sparse_impl->values();
     dest_sparse_impl->coalesced_ = src_sparse_impl->coalesced();
+    dest_sparse_impl->set_csr_indices(src_sparse_impl->csr_indices());
   }
 };
 
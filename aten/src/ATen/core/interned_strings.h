@@ -96,6 +96,9 @@ namespace c10 {
   _(prim, ConstantChunk)             \
   _(prim, MMTreeReduce)              \
   _(prim, MMBatchSide)               \
+  _(prim, AllocateArena)             \
+  _(prim, ArenaTensor)               \
+  _(prim, MemoryPlanGuard)           \
   _(prim, min)                       \
   _(prim, max)                       \
   _(prim, abs)                       \
@@ -0,0 +1,822 @@
+#pragma once
+
+// DO NOT DEFINE STATIC DATA IN THIS HEADER!
+// See Note [Do not compile initializers with AVX]
+//
+// This is the 512-bit counterpart of ATen/cpu/vec256/vec256_base.h.  The
+// generic Vec512<T> below emulates a 64-byte vector; the AVX512
+// specializations in the sibling headers are only enabled when the file is
+// compiled with CPU_CAPABILITY_AVX512.
+
+#include <cstring>
+#include <functional>
+#include <cmath>
+#include <type_traits>
+#include <bitset>
+
+#include <ATen/cpu/vec256/intrinsics.h>
+#include <ATen/Utils.h>
+#include <ATen/native/Copy.h>
+#include <ATen/native/Math.h>
+#include <ATen/NumericUtils.h>
+#include <c10/util/C++17.h>
+#include <c10/util/BFloat16.h>
+#include <c10/util/BFloat16-math.h>
+#include <c10/util/math_compat.h>
+#include <ATen/native/cpu/zmath.h>
+#include <c10/util/TypeCast.h>
+#include <c10/macros/Macros.h>
+
+#if defined(__GNUC__)
+#define __at_align64__ __attribute__((aligned(64)))
+#elif defined(_WIN32)
+#define __at_align64__ __declspec(align(64))
+#else
+#define __at_align64__
+#endif
+
+namespace at {
+namespace vec512 {
+// See Note [Acceptable use of anonymous namespace in header]
+namespace {
+// at::Half should be treated as floating point
+template <typename T>
+struct is_floating_point:
+    std::integral_constant<bool,
+      std::is_floating_point<T>::value ||
+      std::is_same<T, at::Half>::value> {
+};
+
+template<size_t n> struct int_of_size;
+
+#define DEFINE_INT_OF_SIZE(int_t) \
+template<> struct int_of_size<sizeof(int_t)> { using type = int_t; }
+
+DEFINE_INT_OF_SIZE(int64_t);
+DEFINE_INT_OF_SIZE(int32_t);
+DEFINE_INT_OF_SIZE(int16_t);
+DEFINE_INT_OF_SIZE(int8_t);
+
+#undef DEFINE_INT_OF_SIZE
+
+template <typename T>
+using int_same_size_t = typename int_of_size<sizeof(T)>::type;
+
+// NOTE: If you specialize on a type, you must define all operations!
+
+// emulates vectorized types
+template <class T>
+struct Vec512 {
+private:
+  __at_align64__ T values[64 / sizeof(T)];
+public:
+  using value_type = T;
+  // See Note [constexpr static function to avoid odr-usage compiler bug]
+  static constexpr int size() {
+    return 64 / sizeof(T);
+  }
+  Vec512() : values{0} {}
+  Vec512(T val) {
+    for (int i = 0; i != size(); i++) {
+      values[i] = val;
+    }
+  }
+  template<typename... Args,
+           typename = std::enable_if_t<(sizeof...(Args) == size())>>
+  Vec512(Args... vals) {
+    values = { vals... };
+  }
+  // This also implies const T& operator[](int idx) const
+  inline operator const T*() const {
+    return values;
+  }
+  // This also implies T& operator[](int idx)
+  inline operator T*() {
+    return values;
+  }
+  template <int64_t mask_>
+  static Vec512<T> blend(const Vec512<T>& a, const Vec512<T>& b) {
+    int64_t mask = mask_;
+    Vec512 vec;
+    for (int64_t i = 0; i < size(); i++) {
+      if (mask & 0x01) {
+        vec[i] = b[i];
+      } else {
+        vec[i] = a[i];
+      }
+      mask = mask >> 1;
+    }
+    return vec;
+  }
+  static Vec512<T> blendv(const Vec512<T>& a, const Vec512<T>& b,
+                          const Vec512<T>& mask) {
+    Vec512 vec;
+    int_same_size_t<T> buffer[size()];
+    mask.store(buffer);
+    for (int64_t i = 0; i < size(); i++) {
+      if (buffer[i] & 0x01)
+       {
+        vec[i] = b[i];
+      } else {
+        vec[i] = a[i];
+      }
+    }
+    return vec;
+  }
+  template<typename step_t>  // step sometimes requires a higher precision type (e.g., T=int, step_t=double)
+  static Vec512<T> arange(T base = static_cast<T>(0), step_t step = static_cast<step_t>(1)) {
+    Vec512 vec;
+    for (int64_t i = 0; i < size(); i++) {
+      vec.values[i] = base + i * step;
+    }
+    return vec;
+  }
+  static Vec512<T> set(const Vec512<T>& a, const Vec512<T>& b, int64_t count = size()) {
+    Vec512 vec;
+    for (int64_t i = 0; i < size(); i++) {
+      if (i < count) {
+        vec[i] = b[i];
+      } else {
+        vec[i] = a[i];
+      }
+    }
+    return vec;
+  }
+  static Vec512<T> loadu(const void* ptr) {
+    Vec512 vec;
+    std::memcpy(vec.values, ptr, 64);
+    return vec;
+  }
+  static Vec512<T> loadu(const void* ptr, int64_t count) {
+    Vec512 vec;
+    std::memcpy(vec.values, ptr, count * sizeof(T));
+    return vec;
+  }
+  void store(void* ptr, int count = size()) const {
+    std::memcpy(ptr, values, count * sizeof(T));
+  }
+  int64_t zero_mask() const {
+    // returns an integer mask where all zero elements are translated to 1-bit and others are translated to 0-bit
+    int64_t mask = 0;
+    for (int i = 0; i < size(); ++ i) {
+      if (values[i] == static_cast<T>(0)) {
+        mask |= (static_cast<int64_t>(1) << i);
+      }
+    }
+    return mask;
+  }
+  Vec512<T> map(T (*f)(T)) const {
+    Vec512<T> ret;
+    for (int64_t i = 0; i != size(); i++) {
+      ret[i] = f(values[i]);
+    }
+    return ret;
+  }
+  Vec512<T> map(T (*f)(const T &)) const {
+    Vec512<T> ret;
+    for (int64_t i = 0; i != size(); i++) {
+      ret[i] = f(values[i]);
+    }
+    return ret;
+  }
+  template <typename other_t_abs = T,
+            typename std::enable_if<!is_floating_point<other_t_abs>::value && !c10::is_complex_t<other_t_abs>::value, int>::type = 0>
+  Vec512<T> abs() const {
+    // other_t_abs is for SFINAE and clarity. Make sure it is not changed.
+    static_assert(std::is_same<other_t_abs, T>::value, "other_t_abs must be T");
+    return map([](T x) -> T { return x < static_cast<T>(0) ? -x : x; });
+  }
+  template <typename float_t_abs = T,
+            typename std::enable_if<is_floating_point<float_t_abs>::value, int>::type = 0>
+  Vec512<T> abs() const {
+    // float_t_abs is for SFINAE and clarity. Make sure it is not changed.
+    static_assert(std::is_same<float_t_abs, T>::value, "float_t_abs must be T");
+    // Specifically deal with floating-point because the generic code above won't handle -0.0 (which should result in
+    // 0.0) properly.
+    return map([](T x) -> T { return std::abs(x); });
+  }
+  template <typename complex_t_abs = T,
+            typename std::enable_if<c10::is_complex_t<complex_t_abs>::value, int>::type = 0>
+  Vec512<T> abs() const {
+    // complex_t_abs is for SFINAE and clarity. Make sure it is not changed.
+    static_assert(std::is_same<complex_t_abs, T>::value, "complex_t_abs must be T");
+    // Specifically map() does not perform the type conversion needed by abs.
+    return map([](T x) { return static_cast<T>(std::abs(x)); });
+  }
+  template <typename other_t_angle = T,
+            typename std::enable_if<!c10::is_complex_t<other_t_angle>::value, int>::type = 0>
+  Vec512<T> angle() const {
+    // other_t_angle is for SFINAE and clarity. Make sure it is not changed.
+    static_assert(std::is_same<other_t_angle, T>::value, "other_t_angle must be T");
+    return Vec512(0);
+  }
+  template <typename complex_t_angle = T,
+            typename std::enable_if<c10::is_complex_t<complex_t_angle>::value, int>::type = 0>
+  Vec512<T> angle() const {
+    // complex_t_angle is for SFINAE and clarity. Make sure it is not changed.
+    static_assert(std::is_same<complex_t_angle, T>::value, "complex_t_angle must be T");
+    return map([](T x) { return static_cast<T>(std::arg(x)); });
+  }
+  template <typename other_t_real = T,
+            typename std::enable_if<!c10::is_complex_t<other_t_real>::value, int>::type = 0>
+  Vec512<T> real() const {
+    // other_t_real is for SFINAE and clarity. Make sure it is not changed.
+    static_assert(std::is_same<other_t_real, T>::value, "other_t_real must be T");
+    return *this;
+  }
+  template <typename complex_t_real = T,
+            typename std::enable_if<c10::is_complex_t<complex_t_real>::value, int>::type = 0>
+  Vec512<T> real() const {
+    // complex_t_real is for SFINAE and clarity. Make sure it is not changed.
+    static_assert(std::is_same<complex_t_real, T>::value, "complex_t_real must be T");
+    return map([](T x) { return static_cast<T>(x.real()); });
+  }
+  template <typename other_t_imag = T,
+            typename std::enable_if<!c10::is_complex_t<other_t_imag>::value, int>::type = 0>
+  Vec512<T> imag() const {
+    // other_t_imag is for SFINAE and clarity. Make sure it is not changed.
+    static_assert(std::is_same<other_t_imag, T>::value, "other_t_imag must be T");
+    return Vec512(0);
+  }
+  template <typename complex_t_imag = T,
+            typename std::enable_if<c10::is_complex_t<complex_t_imag>::value, int>::type = 0>
+  Vec512<T> imag() const {
+    // complex_t_imag is for SFINAE and clarity. Make sure it is not changed.
+    static_assert(std::is_same<complex_t_imag, T>::value, "complex_t_imag must be T");
+    return map([](T x) { return static_cast<T>(x.imag()); });
+  }
+  template <typename other_t_conj = T,
+            typename std::enable_if<!c10::is_complex_t<other_t_conj>::value, int>::type = 0>
+  Vec512<T> conj() const {
+    // other_t_conj is for SFINAE and clarity. Make sure it is not changed.
+    static_assert(std::is_same<other_t_conj, T>::value, "other_t_conj must be T");
+    return *this;
+  }
+  template <typename complex_t_conj = T,
+            typename std::enable_if<c10::is_complex_t<complex_t_conj>::value, int>::type = 0>
+  Vec512<T> conj() const {
+    // complex_t_conj is for SFINAE and clarity. Make sure it is not changed.
+    static_assert(std::is_same<complex_t_conj, T>::value, "complex_t_conj must be T");
+    return map([](T x) { return static_cast<T>(std::conj(x)); });
+  }
+  Vec512<T> acos() const {
+    return map(std::acos);
+  }
+  Vec512<T> asin() const {
+    return map(std::asin);
+  }
+  Vec512<T> atan() const {
+    return map(std::atan);
+  }
+  Vec512<T> atan2(const Vec512<T> &exp) const {
+    Vec512<T> ret;
+    for (int64_t i = 0; i < size(); i++) {
+      ret[i] = std::atan2(values[i], exp[i]);
+    }
+    return ret;
+  }
+  Vec512<T> erf() const {
+    return map(std::erf);
+  }
+  Vec512<T> erfc() const {
+    return map(std::erfc);
+  }
+  Vec512<T> erfinv() const {
+    return map(calc_erfinv);
+  }
+  Vec512<T> exp() const {
+    return map(std::exp);
+  }
+  Vec512<T> expm1() const {
+    return map(std::expm1);
+  }
+  Vec512<T> frac() const {
+    return *this - this->trunc();
+  }
+  template <
+    typename U = T,
+    typename std::enable_if_t<is_floating_point<U>::value, int> = 0>
+  Vec512<T> fmod(const Vec512<T>& q) const {
+    // U is for SFINAE purposes only. Make sure it is not changed.
+    static_assert(std::is_same<U, T>::value, "U must be T");
+    Vec512<T> ret;
+    for (int64_t i = 0; i < size(); i++) {
+      ret[i] = std::fmod(values[i], q[i]);
+    }
+    return ret;
+  }
+  Vec512<T> log() const {
+    return map(std::log);
+  }
+  Vec512<T> log10() const {
+    return map(std::log10);
+  }
+  Vec512<T> log1p() const {
+    return map(std::log1p);
+  }
+  template <typename other_t_log2 = T,
+            typename std::enable_if<!c10::is_complex_t<other_t_log2>::value, int>::type = 0>
+  Vec512<T> log2() const {
+    // other_t_log2 is for SFINAE and clarity. Make sure it is not changed.
+    static_assert(std::is_same<other_t_log2, T>::value, "other_t_log2 must be T");
+    return map(std::log2);
+  }
+  template <typename complex_t_log2 = T,
+            typename std::enable_if<c10::is_complex_t<complex_t_log2>::value, int>::type = 0>
+  Vec512<T> log2() const {
+    // complex_t_log2 is for SFINAE and clarity. Make sure it is not changed.
+    static_assert(std::is_same<complex_t_log2, T>::value, "complex_t_log2 must be T");
+    const T log_2 = T(std::log(2.0));
+    return Vec512(map(std::log))/Vec512(log_2);
+  }
+  Vec512<T> ceil() const {
+    return map(at::native::ceil_impl);
+  }
+  Vec512<T> cos() const {
+    return map(std::cos);
+  }
+  Vec512<T> cosh() const {
+    return map(std::cosh);
+  }
+  Vec512<T> floor() const {
+    return map(at::native::floor_impl);
+  }
+  Vec512<T> neg() const {
+    // NB: the trailing return type is needed because we need to coerce the
+    // return value back to T in the case of unary operator- incuring a
+    // promotion
+    return map([](T x) -> T { return -x; });
+  }
+  Vec512<T> round() const {
+    // We do not use std::round because we would like to round midway numbers to the nearest even integer.
+    return map(at::native::round_impl);
+  }
+  Vec512<T> sin() const {
+    return map(std::sin);
+  }
+  Vec512<T> sinh() const {
+    return map(std::sinh);
+  }
+  Vec512<T> tan() const {
+    return map(std::tan);
+  }
+  Vec512<T> tanh() const {
+    return map(std::tanh);
+  }
+  Vec512<T> trunc() const {
+    return map(at::native::trunc_impl);
+  }
+  Vec512<T> lgamma() const {
+    return map(std::lgamma);
+  }
+  Vec512<T> sqrt() const {
+    return map(std::sqrt);
+  }
+  Vec512<T> reciprocal() const {
+    return map([](T x) { return (T)(1) / x; });
+  }
+  Vec512<T> rsqrt() const {
+    return map([](T x) { return (T)1 / std::sqrt(x); });
+  }
+  Vec512<T> pow(const Vec512<T> &exp) const {
+    Vec512<T> ret;
+    for (int64_t i = 0; i < size(); i++) {
+      ret[i] = std::pow(values[i], exp[i]);
+    }
+    return ret;
+  }
+private:
+  template <typename Op>
+  inline Vec512<T> binary_pred(const Vec512<T>& other, Op op) const {
+    // All bits are set to 1 if the pred is true, otherwise 0.
+    Vec512<T> vec;
+    for (int64_t i = 0; i != size(); i++) {
+      if (op(values[i], other.values[i])) {
+        std::memset(static_cast<void*>(vec.values + i), 0xFF, sizeof(T));
+      } else {
+        std::memset(static_cast<void*>(vec.values + i), 0, sizeof(T));
+      }
+    }
+    return vec;
+  }
+
+public:
+  Vec512<T> operator==(const Vec512<T>& other) const { return binary_pred(other, std::equal_to<T>()); }
+  Vec512<T> operator!=(const Vec512<T>& other) const { return binary_pred(other, std::not_equal_to<T>()); }
+  Vec512<T> operator>=(const Vec512<T>& other) const { return binary_pred(other, std::greater_equal<T>()); }
+  Vec512<T> operator<=(const Vec512<T>& other) const { return binary_pred(other, std::less_equal<T>()); }
+  Vec512<T> operator>(const Vec512<T>& other) const { return binary_pred(other, std::greater<T>()); }
+  Vec512<T> operator<(const Vec512<T>& other) const { return binary_pred(other, std::less<T>()); }
+
+private:
+  template <typename Op>
+  inline Vec512<T> binary_pred_bool(const Vec512<T>& other, Op op) const {
+    // 1 if the pred is true, otherwise 0.
+    Vec512<T> vec;
+    for (int i = 0; i != size(); ++ i) {
+      vec[i] = bool(op(values[i], other.values[i]));
+    }
+    return vec;
+  }
+
+public:
+  Vec512<T> eq(const Vec512<T>& other) const { return binary_pred_bool(other, std::equal_to<T>()); }
+  Vec512<T> ne(const Vec512<T>& other) const { return binary_pred_bool(other, std::not_equal_to<T>()); }
+  Vec512<T> gt(const Vec512<T>& other) const { return binary_pred_bool(other, std::greater<T>()); }
+  Vec512<T> ge(const Vec512<T>& other) const { return binary_pred_bool(other, std::greater_equal<T>()); }
+  Vec512<T> lt(const Vec512<T>& other) const { return binary_pred_bool(other, std::less<T>()); }
+  Vec512<T> le(const Vec512<T>& other) const { return binary_pred_bool(other, std::less_equal<T>()); }
+};
+
+template <class T> Vec512<T> inline operator+(const Vec512<T> &a, const Vec512<T> &b) {
+  Vec512<T> c = Vec512<T>();
+  for (int i = 0; i != Vec512<T>::size(); i++) {
+    c[i] = a[i] + b[i];
+  }
+  return c;
+}
+
+template <class T> Vec512<T> inline operator-(const Vec512<T> &a, const Vec512<T> &b) {
+  Vec512<T> c = Vec512<T>();
+  for (int i = 0; i != Vec512<T>::size(); i++) {
+    c[i] = a[i] - b[i];
+  }
+  return c;
+}
+
+template <class T> Vec512<T> inline operator*(const Vec512<T> &a, const Vec512<T> &b) {
+  Vec512<T> c = Vec512<T>();
+  for (int i = 0; i != Vec512<T>::size(); i++) {
+    c[i] = a[i] * b[i];
+  }
+  return c;
+}
+
+template <class T> Vec512<T> inline operator/(const Vec512<T> &a, const Vec512<T> &b) __ubsan_ignore_float_divide_by_zero__ {
+  Vec512<T> c = Vec512<T>();
+  for (int i = 0; i != Vec512<T>::size(); i++) {
+    c[i] = a[i] / b[i];
+  }
+  return c;
+}
+
+template <class T> Vec512<T> inline operator||(
+    const Vec512<T> &a, const Vec512<T> &b) {
+  Vec512<T> c = Vec512<T>();
+  for (int i = 0; i != Vec512<T>::size(); i++) {
+    c[i] = a[i] || b[i];
+  }
+  return c;
+}
+
+// Implements the IEEE 754 201X `maximum` operation, which propagates NaN if
+// either input is a NaN.
+template <class T,
+          typename std::enable_if<!c10::is_complex_t<T>::value, int>::type = 0>
+Vec512<T> inline maximum(const Vec512<T> &a, const Vec512<T> &b) {
+  Vec512<T> c = Vec512<T>();
+  for (int i = 0; i != Vec512<T>::size(); i++) {
+    c[i] = (a[i] > b[i]) ? a[i] : b[i];
+    if (_isnan(a[i])) {
+      // If either input is NaN, propagate a NaN.
+      // NOTE: The case where b[i] was NaN is handled correctly by the naive
+      // ternary operator above.
+      c[i] = a[i];
+    }
+  }
+  return c;
+}
+
+template <class T,
+          typename std::enable_if<c10::is_complex_t<T>::value, int>::type = 0>
+Vec512<T> inline maximum(const Vec512<T> &a, const Vec512<T> &b) {
+  Vec512<T> c = Vec512<T>();
+  for (int i = 0; i != Vec512<T>::size(); i++) {
+    c[i] = (std::abs(a[i]) > std::abs(b[i])) ? a[i] : b[i];
+    if (_isnan(a[i])) {
+      // If either input is NaN, propagate a NaN.
+      // NOTE: The case where b[i] was NaN is handled correctly by the naive
+      // ternary operator above.
+      c[i] = a[i];
+    }
+  }
+  return c;
+}
+
+template <typename T>
+inline T maximum(const T& a, const T& b) {
+  T c = (a > b) ? a : b;
+  if (_isnan(a)) {
+    c = a;
+  }
+  return c;
+}
+
+// Implements the IEEE 754 201X `minimum` operation, which propagates NaN if
+// either input is a NaN.
+template <class T,
+          typename std::enable_if<!c10::is_complex_t<T>::value, int>::type = 0>
+Vec512<T> inline minimum(const Vec512<T> &a, const Vec512<T> &b) {
+  Vec512<T> c = Vec512<T>();
+  for (int i = 0; i != Vec512<T>::size(); i++) {
+    c[i] = (a[i] < b[i]) ? a[i] : b[i];
+    if (_isnan(a[i])) {
+      // If either input is NaN, propagate a NaN.
+      // NOTE: The case where b[i] was NaN is handled correctly by the naive
+      // ternary operator above.
+      c[i] = a[i];
+    }
+  }
+  return c;
+}
+
+template <class T,
+          typename std::enable_if<c10::is_complex_t<T>::value, int>::type = 0>
+Vec512<T> inline minimum(const Vec512<T> &a, const Vec512<T> &b) {
+  Vec512<T> c = Vec512<T>();
+  for (int i = 0; i != Vec512<T>::size(); i++) {
+    c[i] = (std::abs(a[i]) < std::abs(b[i])) ? a[i] : b[i];
+    if (_isnan(a[i])) {
+      // If either input is NaN, propagate a NaN.
+      // NOTE: The case where b[i] was NaN is handled correctly by the naive
+      // ternary operator above.
+      c[i] = a[i];
+    }
+  }
+  return c;
+}
+
+template <typename T>
+inline T minimum(const T& a, const T& b) {
+  T c = (a < b) ? a : b;
+  if (_isnan(a)) {
+    c = a;
+  }
+  return c;
+}
+
+// To save BC, it will not propagate NaN based on IEEE 754 201X
+template <class T,
+          typename std::enable_if<!c10::is_complex_t<T>::value, int>::type = 0>
+Vec512<T> inline clamp(const Vec512<T> &a, const Vec512<T> &min_vec, const Vec512<T> &max_vec) {
+  Vec512<T> c = Vec512<T>();
+  for (int i = 0; i != Vec512<T>::size(); i++) {
+    c[i] = a[i] < min_vec[i] ? min_vec[i] : (a[i] > max_vec[i] ? max_vec[i] : a[i]);
+  }
+  return c;
+}
+
+template <class T,
+          typename std::enable_if<c10::is_complex_t<T>::value, int>::type = 0>
+Vec512<T> inline clamp(const Vec512<T> &a, const Vec512<T> &min_vec, const Vec512<T> &max_vec) {
+  Vec512<T> c = Vec512<T>();
+  for (int i = 0; i != Vec512<T>::size(); i++) {
+    c[i] = std::abs(a[i]) < std::abs(min_vec[i]) ? min_vec[i] : (std::abs(a[i]) > std::abs(max_vec[i]) ? max_vec[i] : a[i]);
+  }
+  return c;
+}
+
+template <class T,
+          typename std::enable_if<!c10::is_complex_t<T>::value, int>::type = 0>
+Vec512<T> inline clamp_max(const Vec512<T> &a, const Vec512<T> &max_vec) {
+  Vec512<T> c = Vec512<T>();
+  for (int i = 0; i != Vec512<T>::size(); i++) {
+    c[i] = a[i] > max_vec[i] ? max_vec[i] : a[i];
+  }
+  return c;
+}
+
+template <class T,
+          typename std::enable_if<c10::is_complex_t<T>::value, int>::type = 0>
+Vec512<T> inline clamp_max(const Vec512<T> &a, const Vec512<T> &max_vec) {
+  Vec512<T> c = Vec512<T>();
+  for (int i = 0; i != Vec512<T>::size(); i++) {
+    c[i] = std::abs(a[i]) > std::abs(max_vec[i]) ? max_vec[i] : a[i];
+  }
+  return c;
+}
+
+template <class T,
+          typename std::enable_if<!c10::is_complex_t<T>::value, int>::type = 0>
+Vec512<T> inline clamp_min(const Vec512<T> &a, const Vec512<T> &min_vec) {
+  Vec512<T> c = Vec512<T>();
+  for (int i = 0; i != Vec512<T>::size(); i++) {
+    c[i] = a[i] < min_vec[i] ? min_vec[i] : a[i];
+  }
+  return c;
+}
+
+template <class T,
+          typename std::enable_if<c10::is_complex_t<T>::value, int>::type = 0>
+Vec512<T> inline clamp_min(const Vec512<T> &a, const Vec512<T> &min_vec) {
+  Vec512<T> c = Vec512<T>();
+  for (int i = 0; i != Vec512<T>::size(); i++) {
+    c[i] = std::abs(a[i]) < std::abs(min_vec[i]) ? min_vec[i] : a[i];
+  }
+  return c;
+}
+
+struct Vec512i;
+
+#ifdef CPU_CAPABILITY_AVX512
+
+template <class T, typename Op>
+static inline Vec512<T> bitwise_binary_op(const Vec512<T> &a, const Vec512<T> &b, Op op) {
+  __m512i buffer;
+  __m512i a_buffer = _mm512_loadu_si512(reinterpret_cast<const __m512i*>((const T*)a));
+  __m512i b_buffer = _mm512_loadu_si512(reinterpret_cast<const __m512i*>((const T*)b));
+  buffer = op(a_buffer, b_buffer);
+  __at_align64__ T results[Vec512<T>::size()];
+  _mm512_storeu_si512(reinterpret_cast<__m512i*>(results), buffer);
+  return Vec512<T>::loadu(results);
+}
+
+template<class T, typename std::enable_if_t<!std::is_base_of<Vec512i, Vec512<T>>::value, int> = 0>
+inline Vec512<T> operator&(const Vec512<T>& a, const Vec512<T>& b) {
+  // We enclose _mm512_and_si512 with lambda because it is always_inline
+  return bitwise_binary_op(a, b, [](__m512i a, __m512i b) { return _mm512_and_si512(a, b); });
+}
+template<class T, typename std::enable_if_t<!std::is_base_of<Vec512i, Vec512<T>>::value, int> = 0>
+inline Vec512<T> operator|(const Vec512<T>& a, const Vec512<T>& b) {
+  // We enclose _mm512_or_si512 with lambda because it is always_inline
+  return bitwise_binary_op(a, b, [](__m512i a, __m512i b) { return _mm512_or_si512(a, b); });
+}
+template<class T, typename std::enable_if_t<!std::is_base_of<Vec512i, Vec512<T>>::value, int> = 0>
+inline Vec512<T> operator^(const Vec512<T>& a, const Vec512<T>& b) {
+  // We enclose _mm512_xor_si512 with lambda because it is always_inline
+  return bitwise_binary_op(a, b, [](__m512i a, __m512i b) { return _mm512_xor_si512(a, b); });
+}
+
+#else
+
+template<class T, typename Op>
+static inline Vec512<T> bitwise_binary_op(const Vec512<T> &a, const Vec512<T> &b, Op op) {
+  static constexpr uint32_t element_no = 64 / sizeof(intmax_t);
+  __at_align64__ intmax_t buffer[element_no];
+  const intmax_t *a_ptr = reinterpret_cast<const intmax_t*>((const T*) a);
+  const intmax_t *b_ptr = reinterpret_cast<const intmax_t*>((const T*) b);
+  for (uint32_t i = 0U; i < element_no; ++ i) {
+    buffer[i] = op(a_ptr[i], b_ptr[i]);
+  }
+  return Vec512<T>::loadu(buffer);
+}
+
+template<class T, typename std::enable_if_t<!std::is_base_of<Vec512i, Vec512<T>>::value, int> = 0>
+inline Vec512<T> operator&(const Vec512<T>& a, const Vec512<T>& b) {
+  return bitwise_binary_op(a, b, std::bit_and<intmax_t>());
+}
+template<class T, typename std::enable_if_t<!std::is_base_of<Vec512i, Vec512<T>>::value, int> = 0>
+inline Vec512<T> operator|(const Vec512<T>& a, const Vec512<T>& b) {
+  return bitwise_binary_op(a, b, std::bit_or<intmax_t>());
+}
+template<class T, typename std::enable_if_t<!std::is_base_of<Vec512i, Vec512<T>>::value, int> = 0>
+inline Vec512<T> operator^(const Vec512<T>& a, const Vec512<T>& b) {
+  return bitwise_binary_op(a, b, std::bit_xor<intmax_t>());
+}
+
+#endif
+
+template <typename T>
+inline Vec512<T> fmadd(const Vec512<T>& a, const Vec512<T>& b, const Vec512<T>& c) {
+  return a * b + c;
+}
+
+template <int64_t scale = 1, typename T = void>
+std::enable_if_t<scale == 1 || scale == 2 || scale == 4 || scale == 8, Vec512<T>>
+inline gather(T const* base_addr, const Vec512<int_same_size_t<T>>& vindex) {
+  static constexpr int size = Vec512<T>::size();
+  int_same_size_t<T> index_arr[size];
+  vindex.store(static_cast<void*>(index_arr));
+  T buffer[size];
+  for (int64_t i = 0; i < size; i++) {
+    buffer[i] = base_addr[index_arr[i] * scale / sizeof(T)];
+  }
+  return Vec512<T>::loadu(static_cast<void*>(buffer));
+}
+
+template <int64_t scale = 1, typename T = void>
+std::enable_if_t<scale == 1 || scale == 2 || scale == 4 || scale == 8, Vec512<T>>
+inline mask_gather(const Vec512<T>& src, T const* base_addr,
+                   const Vec512<int_same_size_t<T>>& vindex, Vec512<T>& mask) {
+  static constexpr int size = Vec512<T>::size();
+  T src_arr[size];
+  int_same_size_t<T> mask_arr[size];  // use int type so we can logical and
+  int_same_size_t<T> index_arr[size];
+  src.store(static_cast<void*>(src_arr));
+  mask.store(static_cast<void*>(mask_arr));
+  vindex.store(static_cast<void*>(index_arr));
+  T buffer[size];
+  for (int64_t i = 0; i < size; i++) {
+    if (mask_arr[i] & 0x01) {  // check highest bit
+      buffer[i] = base_addr[index_arr[i] * scale / sizeof(T)];
+    } else {
+      buffer[i] = src_arr[i];
+    }
+  }
+  mask = Vec512<T>();  // "zero out" mask
+  return Vec512<T>::loadu(static_cast<void*>(buffer));
+}
+
+// Cast a given vector to another type without changing the bits representation.
+// So a Vec<double> of 512 bits containing all ones can be cast to a
+// Vec<int64_t> of 512 bits containing all ones (i.e., eight negative 1s).
+namespace {
+  // There is a struct here because we don't have static_if and I can't
+  // partially specialize a templated function.
+  template<typename dst_t, typename src_t>
+  struct CastImpl {
+    static inline Vec512<dst_t> apply(const Vec512<src_t>& src) {
+      src_t src_arr[Vec512<src_t>::size()];
+      src.store(static_cast<void*>(src_arr));
+      return Vec512<dst_t>::loadu(static_cast<const void*>(src_arr));
+    }
+  };
+
+  template<typename scalar_t>
+  struct CastImpl<scalar_t, scalar_t> {
+    static inline Vec512<scalar_t> apply(const Vec512<scalar_t>& src) {
+      return src;
+    }
+  };
+}
+template<typename dst_t, typename src_t>
+inline Vec512<dst_t> cast(const Vec512<src_t>& src) {
+  return CastImpl<dst_t, src_t>::apply(src);
+}
+
+template <typename T>
+inline Vec512<int_same_size_t<T>> convert_to_int_of_same_size(const Vec512<T>& src) {
+  static constexpr int size = Vec512<T>::size();
+  T src_arr[size];
+  src.store(static_cast<void*>(src_arr));
+  int_same_size_t<T> buffer[size];
+  for (int64_t i = 0; i < size; i++) {
+    buffer[i] = static_cast<int_same_size_t<T>>(src_arr[i]);
+  }
+  return Vec512<int_same_size_t<T>>::loadu(static_cast<void*>(buffer));
+}
+
+// E.g., inputs: a           Vec512<float>   = {a0, b0, a1, b1, a2, b2, a3, b3}
+//               b           Vec512<float>   = {a4, b4, a5, b5, a6, b6, a7, b7}
+//       returns:            Vec512<float>   = {a0, a1, a2, a3, a4, a5, a6, a7}
+//                           Vec512<float>   = {b0, b1, b2, b3, b4, b5, b6, b7}
+template <typename T>
+inline std::enable_if_t<Vec512<T>::size() % 2 == 0, std::pair<Vec512<T>, Vec512<T>>>
+deinterleave2(const Vec512<T>& a, const Vec512<T>& b) {
+  static constexpr int size = Vec512<T>::size();
+  static constexpr int half_size = size / 2;
+  T a_arr[size];
+  T b_arr[size];
+  T buffer1[size];
+  T buffer2[size];
+  a.store(static_cast<void*>(a_arr));
+  b.store(static_cast<void*>(b_arr));
+  for (int64_t i = 0; i < half_size; i++) {
+    buffer1[i] = a_arr[i * 2];
+    buffer1[half_size + i] = b_arr[i * 2];
+    buffer2[i] = a_arr[i * 2 + 1];
+    buffer2[half_size + i] = b_arr[i * 2 + 1];
+  }
+  return std::make_pair(Vec512<T>::loadu(static_cast<void*>(buffer1)),
+                        Vec512<T>::loadu(static_cast<void*>(buffer2)));
+}
+
+// inverse operation of deinterleave2
+// E.g., inputs: a           Vec512<float>   = {a0, a1, a2, a3, a4, a5, a6, a7}
+//               b           Vec512<float>   = {b0, b1, b2, b3, b4, b5, b6, b7}
+//       returns:            Vec512<float>   = {a0, b0, a1, b1, a2, b2, a3, b3}
+//                           Vec512<float>   = {a4, b4, a5, b5, a6, b6, a7, b7}
+template <typename T>
+inline std::enable_if_t<Vec512<T>::size() % 2 == 0, std::pair<Vec512<T>, Vec512<T>>>
+interleave2(const Vec512<T>& a, const Vec512<T>& b) {
+  static constexpr int size = Vec512<T>::size();
+  static constexpr int half_size = size / 2;
+  T a_arr[size];
+  T b_arr[size];
+  T buffer1[size];
+  T buffer2[size];
+  a.store(static_cast<void*>(a_arr));
+  b.store(static_cast<void*>(b_arr));
+  for (int64_t i = 0; i < half_size; i++) {
+    buffer1[i * 2] = a_arr[i];
+    buffer1[i * 2 + 1] = b_arr[i];
+    buffer2[i * 2] = a_arr[half_size + i];
+    buffer2[i * 2 + 1] = b_arr[half_size + i];
+  }
+  return std::make_pair(Vec512<T>::loadu(static_cast<void*>(buffer1)),
+                        Vec512<T>::loadu(static_cast<void*>(buffer2)));
+}
+
+template <typename src_T, typename dst_T>
+inline void convert(const src_T *src, dst_T *dst, int64_t n) {
+#ifndef _MSC_VER
+# pragma unroll
+#endif
+  for (int64_t i = 0; i < n; i++) {
+    *dst = c10::static_cast_with_inter_type<dst_T, src_T>::apply(*src);
+    src++;
+    dst++;
+  }
+}
+
+}}}
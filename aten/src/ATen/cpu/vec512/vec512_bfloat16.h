@@ -0,0 +1,513 @@
+#pragma once
+
+// DO NOT DEFINE STATIC DATA IN THIS HEADER!
+// See Note [Do not compile initializers with AVX]
+
+#include <ATen/cpu/vec256/intrinsics.h>
+#include <ATen/cpu/vec512/vec512_base.h>
+#if defined(CPU_CAPABILITY_AVX512) && !defined(_MSC_VER)
+#include <sleef.h>
+#endif
+
+namespace at {
+namespace vec512 {
+// See Note [Acceptable use of anonymous namespace in header]
+namespace {
+
+#if defined(CPU_CAPABILITY_AVX512) && !defined(_MSC_VER)
+
+static inline void cvtbf16_fp32(const __m512i& a, __m512& o1, __m512& o2) {
+  __m256i lo = _mm512_extracti64x4_epi64(a, 0);
+  __m256i hi = _mm512_extracti64x4_epi64(a, 1);
+  o1 = _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_cvtepu16_epi32(lo), 16));
+  o2 = _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_cvtepu16_epi32(hi), 16));
+}
+static inline __m512i cvtfp32_bf16(const __m512& a, const __m512& b) {
+  __m512i lo = _mm512_castps_si512(a);
+  __m512i hi = _mm512_castps_si512(b);
+  __m512i nan = _mm512_set1_epi32(0x7fc0);
+  __mmask16 mask_lo = _mm512_cmp_ps_mask(a, a, _CMP_ORD_Q);
+  __mmask16 mask_hi = _mm512_cmp_ps_mask(b, b, _CMP_ORD_Q);
+  __m512i ones = _mm512_set1_epi32(0x1);
+  __m512i vec_bias = _mm512_set1_epi32(0x7fff);
+  // uint32_t lsb = (input >> 16) & 1;
+  auto t_lo = _mm512_and_si512(_mm512_srli_epi32(lo, 16), ones);
+  auto t_hi = _mm512_and_si512(_mm512_srli_epi32(hi, 16), ones);
+  // uint32_t rounding_bias = 0x7fff + lsb;
+  t_lo = _mm512_add_epi32(t_lo, vec_bias);
+  t_hi = _mm512_add_epi32(t_hi, vec_bias);
+  // input += rounding_bias;
+  t_lo = _mm512_add_epi32(t_lo, lo);
+  t_hi = _mm512_add_epi32(t_hi, hi);
+  // input = input >> 16;
+  t_lo = _mm512_srli_epi32(t_lo, 16);
+  t_hi = _mm512_srli_epi32(t_hi, 16);
+  // Check NaN before converting back to bf16
+  t_lo = _mm512_mask_blend_epi32(mask_lo, nan, t_lo);
+  t_hi = _mm512_mask_blend_epi32(mask_hi, nan, t_hi);
+
+  // Every lane now fits in 16 bits, so a truncating narrow keeps the order
+  // without the lane fix-up _mm256_packus_epi32 needs.
+  __m256i o_lo = _mm512_cvtepi32_epi16(t_lo);
+  __m256i o_hi = _mm512_cvtepi32_epi16(t_hi);
+  return _mm512_inserti64x4(_mm512_castsi256_si512(o_lo), o_hi, 1);
+}
+
+// Expands a per-float comparison k-mask into all-ones float lanes.
+static inline __m512 cmp_mask_to_ps(__mmask16 mask) {
+  return _mm512_castsi512_ps(_mm512_movm_epi32(mask));
+}
+
+template <> class Vec512<BFloat16> {
+private:
+  __m512i values;
+public:
+  using value_type = uint16_t;
+  static constexpr int size() {
+    return 32;
+  }
+  Vec512() {}
+  Vec512(__m512i v) : values(v) {}
+  Vec512(BFloat16 val) {
+    value_type uw = val.x;
+    values = _mm512_set1_epi16(uw);
+  }
+  operator __m512i() const {
+    return values;
+  }
+  BFloat16& operator[](int idx) = delete;
+  const BFloat16& operator[](int idx) const  = delete;
+  int64_t zero_mask() const {
+    // returns an integer mask where all zero elements are translated to 1-bit and others are translated to 0-bit
+    return _mm512_cmpeq_epi16_mask(values, _mm512_set1_epi16(0));
+  }
+  static Vec512<BFloat16> loadu(const void* ptr) {
+    return _mm512_loadu_si512(ptr);
+  }
+  static Vec512<BFloat16> loadu(const void* ptr, int64_t count) {
+    __mmask32 mask = (1ULL << count) - 1;
+    return _mm512_maskz_loadu_epi16(mask, ptr);
+  }
+  void store(void* ptr, int count = size()) const {
+    if (count == size()) {
+      _mm512_storeu_si512(ptr, values);
+    } else if (count > 0) {
+      __mmask32 mask = (1ULL << count) - 1;
+      _mm512_mask_storeu_epi16(ptr, mask, values);
+    }
+  }
+  template <int64_t mask>
+  static Vec512<BFloat16> blend(const Vec512<BFloat16>& a, const Vec512<BFloat16>& b) {
+    return _mm512_mask_blend_epi16(static_cast<__mmask32>(mask), a.values, b.values);
+  }
+  static Vec512<BFloat16> blendv(const Vec512<BFloat16>& a,
+      const Vec512<BFloat16>& b, const Vec512<BFloat16>& mask) {
+    // Like _mm256_blendv_epi8, only the sign bit of each mask lane is used.
+    auto mmask = _mm512_movepi16_mask(mask.values);
+    return _mm512_mask_blend_epi16(mmask, a.values, b.values);
+  }
+  template<typename step_t>
+  static Vec512<BFloat16> arange(BFloat16 base = 0.f, step_t step = static_cast<step_t>(1)) {
+    __at_align64__ BFloat16 tmp_values[size()];
+    for (int64_t i = 0; i < size(); i++) {
+      tmp_values[i] = base + i * step;
+    }
+    return loadu(tmp_values);
+  }
+  static Vec512<BFloat16> set(const Vec512<BFloat16>& a,
+      const Vec512<BFloat16>& b, int64_t count = size()) {
+    if (count >= size()) {
+      return b;
+    }
+    __mmask32 mask = (1ULL << count) - 1;
+    return _mm512_mask_blend_epi16(mask, a.values, b.values);
+  }
+  Vec512<BFloat16> map(const __m512 (*vop)(__m512)) const {
+    __m512 lo, hi;
+    cvtbf16_fp32(values, lo, hi);
+    auto o1 = vop(lo);
+    auto o2 = vop(hi);
+    return cvtfp32_bf16(o1, o2);
+  }
+  Vec512<BFloat16> abs() const {
+    __m512 lo, hi;
+    cvtbf16_fp32(values, lo, hi);
+    auto mask = _mm512_set1_ps(-0.f);
+    auto o1 = _mm512_andnot_ps(mask, lo);
+    auto o2 = _mm512_andnot_ps(mask, hi);
+    return cvtfp32_bf16(o1, o2);
+  }
+  Vec512<BFloat16> angle() const {
+    return _mm512_set1_epi16(0);
+  }
+  Vec512<BFloat16> real() const {
+    return *this;
+  }
+  Vec512<BFloat16> imag() const {
+    return _mm512_set1_epi16(0);
+  }
+  Vec512<BFloat16> conj() const {
+    return *this;
+  }
+  Vec512<BFloat16> acos() const {
+    return map(Sleef_acosf16_u10);
+  }
+  Vec512<BFloat16> asin() const {
+    return map(Sleef_asinf16_u10);
+  }
+  Vec512<BFloat16> atan() const {
+    return map(Sleef_atanf16_u10);
+  }
+  Vec512<BFloat16> atan2(const Vec512<BFloat16> &b) const {
+    __m512 lo, hi;
+    __m512 b1, b2;
+    cvtbf16_fp32(values, lo, hi);
+    cvtbf16_fp32(b.values, b1, b2);
+    auto o1 = Sleef_atan2f16_u10(lo, b1);
+    auto o2 = Sleef_atan2f16_u10(hi, b2);
+    return cvtfp32_bf16(o1, o2);
+  }
+  Vec512<BFloat16> erf() const {
+    return map(Sleef_erff16_u10);
+  }
+  Vec512<BFloat16> erfc() const {
+    return map(Sleef_erfcf16_u15);
+  }
+  Vec512<BFloat16> erfinv() const {
+    __at_align64__ BFloat16 tmp[size()];
+    store(tmp);
+    for (int64_t i = 0; i < size(); i++) {
+      tmp[i] = calc_erfinv(static_cast<float>(tmp[i]));
+    }
+    return loadu(tmp);
+  }
+  Vec512<BFloat16> exp() const {
+    return map(Sleef_expf16_u10);
+  }
+  Vec512<BFloat16> expm1() const {
+    return map(Sleef_expm1f16_u10);
+  }
+  Vec512<BFloat16> fmod(const Vec512<BFloat16> & q) const {
+    __m512 x_lo, x_hi;
+    cvtbf16_fp32(values, x_lo, x_hi);
+    __m512 q_lo, q_hi;
+    cvtbf16_fp32(q.values, q_lo, q_hi);
+    auto o1 = Sleef_fmodf16(x_lo, q_lo);
+    auto o2 = Sleef_fmodf16(x_hi, q_hi);
+    return cvtfp32_bf16(o1, o2);
+  }
+  Vec512<BFloat16> log() const {
+    return map(Sleef_logf16_u10);
+  }
+  Vec512<BFloat16> log2() const {
+    return map(Sleef_log2f16_u10);
+  }
+  Vec512<BFloat16> log10() const {
+    return map(Sleef_log10f16_u10);
+  }
+  Vec512<BFloat16> log1p() const {
+    return map(Sleef_log1pf16_u10);
+  }
+  Vec512<BFloat16> frac() const;
+  Vec512<BFloat16> sin() const {
+    return map(Sleef_sinf16_u10);
+  }
+  Vec512<BFloat16> sinh() const {
+    return map(Sleef_sinhf16_u10);
+  }
+  Vec512<BFloat16> cos() const {
+    return map(Sleef_cosf16_u10);
+  }
+  Vec512<BFloat16> cosh() const {
+    return map(Sleef_coshf16_u10);
+  }
+  Vec512<BFloat16> ceil() const {
+    __m512 lo, hi;
+    cvtbf16_fp32(values, lo, hi);
+    auto o1 = _mm512_roundscale_ps(lo, (_MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC));
+    auto o2 = _mm512_roundscale_ps(hi, (_MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC));
+    return cvtfp32_bf16(o1, o2);
+  }
+  Vec512<BFloat16> floor() const {
+    __m512 lo, hi;
+    cvtbf16_fp32(values, lo, hi);
+    auto o1 = _mm512_roundscale_ps(lo, (_MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC));
+    auto o2 = _mm512_roundscale_ps(hi, (_MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC));
+    return cvtfp32_bf16(o1, o2);
+  }
+  Vec512<BFloat16> neg() const {
+    __m512 lo, hi;
+    cvtbf16_fp32(values, lo, hi);
+    auto mask = _mm512_set1_ps(-0.f);
+    auto o1 = _mm512_xor_ps(mask, lo);
+    auto o2 = _mm512_xor_ps(mask, hi);
+    return cvtfp32_bf16(o1, o2);
+  }
+  Vec512<BFloat16> round() const {
+    __m512 lo, hi;
+    cvtbf16_fp32(values, lo, hi);
+    auto o1 = _mm512_roundscale_ps(lo, (_MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+    auto o2 = _mm512_roundscale_ps(hi, (_MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+    return cvtfp32_bf16(o1, o2);
+  }
+  Vec512<BFloat16> tan() const {
+    return map(Sleef_tanf16_u10);
+  }
+  Vec512<BFloat16> tanh() const {
+    return map(Sleef_tanhf16_u10);
+  }
+  Vec512<BFloat16> trunc() const {
+    __m512 lo, hi;
+    cvtbf16_fp32(values, lo, hi);
+    auto o1 = _mm512_roundscale_ps(lo, (_MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));
+    auto o2 = _mm512_roundscale_ps(hi, (_MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));
+    return cvtfp32_bf16(o1, o2);
+  }
+  Vec512<BFloat16> lgamma() const {
+    return map(Sleef_lgammaf16_u10);
+  }
+  Vec512<BFloat16> sqrt() const {
+    __m512 lo, hi;
+    cvtbf16_fp32(values, lo, hi);
+    auto o1 = _mm512_sqrt_ps(lo);
+    auto o2 = _mm512_sqrt_ps(hi);
+    return cvtfp32_bf16(o1, o2);
+  }
+  Vec512<BFloat16> reciprocal() const {
+    __m512 lo, hi;
+    cvtbf16_fp32(values, lo, hi);
+    auto ones = _mm512_set1_ps(1);
+    auto o1 = _mm512_div_ps(ones, lo);
+    auto o2 = _mm512_div_ps(ones, hi);
+    return cvtfp32_bf16(o1, o2);
+  }
+  Vec512<BFloat16> rsqrt() const {
+    __m512 lo, hi;
+    cvtbf16_fp32(values, lo, hi);
+    auto ones = _mm512_set1_ps(1);
+    auto o1 = _mm512_div_ps(ones, _mm512_sqrt_ps(lo));
+    auto o2 = _mm512_div_ps(ones, _mm512_sqrt_ps(hi));
+    return cvtfp32_bf16(o1, o2);
+  }
+  Vec512<BFloat16> pow(const Vec512<BFloat16> &b) const {
+    __m512 lo, hi;
+    __m512 b1, b2;
+    cvtbf16_fp32(values, lo, hi);
+    cvtbf16_fp32(b.values, b1, b2);
+    auto o1 = Sleef_powf16_u10(lo, b1);
+    auto o2 = Sleef_powf16_u10(hi, b2);
+    return cvtfp32_bf16(o1, o2);
+  }
+
+  Vec512<BFloat16> inline operator>(const Vec512<BFloat16>& other) const;
+  Vec512<BFloat16> inline operator<(const Vec512<BFloat16>& other) const;
+  Vec512<BFloat16> inline operator>=(const Vec512<BFloat16>& other) const;
+  Vec512<BFloat16> inline operator<=(const Vec512<BFloat16>& other) const;
+  Vec512<BFloat16> inline operator==(const Vec512<BFloat16>& other) const;
+  Vec512<BFloat16> inline operator!=(const Vec512<BFloat16>& other) const;
+
+  Vec512<BFloat16> eq(const Vec512<BFloat16>& other) const;
+  Vec512<BFloat16> ne(const Vec512<BFloat16>& other) const;
+  Vec512<BFloat16> gt(const Vec512<BFloat16>& other) const;
+  Vec512<BFloat16> ge(const Vec512<BFloat16>& other) const;
+  Vec512<BFloat16> lt(const Vec512<BFloat16>& other) const;
+  Vec512<BFloat16> le(const Vec512<BFloat16>& other) const;
+};
+
+template<typename Op>
+Vec512<BFloat16> static inline bfloat16_binary_op_as_fp32(const Vec512<BFloat16>& a, const Vec512<BFloat16>& b, Op op) {
+  __m512 a_lo, a_hi;
+  __m512 b_lo, b_hi;
+  cvtbf16_fp32(__m512i(a), a_lo, a_hi);
+  cvtbf16_fp32(__m512i(b), b_lo, b_hi);
+  auto o1 = op(a_lo, b_lo);
+  auto o2 = op(a_hi, b_hi);
+  return cvtfp32_bf16(o1, o2);
+}
+
+Vec512<BFloat16> inline Vec512<BFloat16>::operator>(const Vec512<BFloat16>& other) const {
+  return bfloat16_binary_op_as_fp32(*this, other, [](__m512 x, __m512 y) {
+    return cmp_mask_to_ps(_mm512_cmp_ps_mask(x, y, _CMP_GT_OQ));
+  });
+}
+Vec512<BFloat16> inline Vec512<BFloat16>::operator<(const Vec512<BFloat16>& other) const {
+  return bfloat16_binary_op_as_fp32(*this, other, [](__m512 x, __m512 y) {
+    return cmp_mask_to_ps(_mm512_cmp_ps_mask(x, y, _CMP_LT_OQ));
+  });
+}
+Vec512<BFloat16> inline Vec512<BFloat16>::operator>=(const Vec512<BFloat16>& other) const {
+  return bfloat16_binary_op_as_fp32(*this, other, [](__m512 x, __m512 y) {
+    return cmp_mask_to_ps(_mm512_cmp_ps_mask(x, y, _CMP_GE_OQ));
+  });
+}
+Vec512<BFloat16> inline Vec512<BFloat16>::operator<=(const Vec512<BFloat16>& other) const {
+  return bfloat16_binary_op_as_fp32(*this, other, [](__m512 x, __m512 y) {
+    return cmp_mask_to_ps(_mm512_cmp_ps_mask(x, y, _CMP_LE_OQ));
+  });
+}
+Vec512<BFloat16> inline Vec512<BFloat16>::operator==(const Vec512<BFloat16>& other) const {
+  return bfloat16_binary_op_as_fp32(*this, other, [](__m512 x, __m512 y) {
+    return cmp_mask_to_ps(_mm512_cmp_ps_mask(x, y, _CMP_EQ_OQ));
+  });
+}
+Vec512<BFloat16> inline Vec512<BFloat16>::operator!=(const Vec512<BFloat16>& other) const {
+  return bfloat16_binary_op_as_fp32(*this, other, [](__m512 x, __m512 y) {
+    return cmp_mask_to_ps(_mm512_cmp_ps_mask(x, y, _CMP_NEQ_OQ));
+  });
+}
+
+Vec512<BFloat16> inline operator+(const Vec512<BFloat16>& a, const Vec512<BFloat16>& b) {
+  return bfloat16_binary_op_as_fp32(a, b, [](const __m512& x, const __m512& y) { return _mm512_add_ps(x, y); });
+}
+Vec512<BFloat16> inline operator-(const Vec512<BFloat16>& a, const Vec512<BFloat16>& b) {
+  return bfloat16_binary_op_as_fp32(a, b, [](const __m512& x, const __m512& y) { return _mm512_sub_ps(x, y); });
+}
+Vec512<BFloat16> inline operator*(const Vec512<BFloat16>& a, const Vec512<BFloat16>& b) {
+  return bfloat16_binary_op_as_fp32(a, b, [](const __m512& x, const __m512& y) { return _mm512_mul_ps(x, y); });
+}
+Vec512<BFloat16> inline operator/(const Vec512<BFloat16>& a, const Vec512<BFloat16>& b) {
+  return bfloat16_binary_op_as_fp32(a, b, [](const __m512& x, const __m512& y) { return _mm512_div_ps(x, y); });
+}
+
+Vec512<BFloat16> inline operator&(const Vec512<BFloat16>& a, const Vec512<BFloat16>& b) {
+  return _mm512_and_si512(a, b);
+}
+Vec512<BFloat16> inline operator|(const Vec512<BFloat16>& a, const Vec512<BFloat16>& b) {
+  return _mm512_or_si512(a, b);
+}
+Vec512<BFloat16> inline operator^(const Vec512<BFloat16>& a, const Vec512<BFloat16>& b) {
+  return _mm512_xor_si512(a, b);
+}
+
+Vec512<BFloat16> Vec512<BFloat16>::eq(const Vec512<BFloat16>& other) const {
+  return (*this == other) & Vec512<BFloat16>(1.0f);
+}
+
+Vec512<BFloat16> Vec512<BFloat16>::ne(const Vec512<BFloat16>& other) const {
+  return (*this != other) & Vec512<BFloat16>(1.0f);
+}
+
+Vec512<BFloat16> Vec512<BFloat16>::gt(const Vec512<BFloat16>& other) const {
+  return (*this > other) & Vec512<BFloat16>(1.0f);
+}
+
+Vec512<BFloat16> Vec512<BFloat16>::ge(const Vec512<BFloat16>& other) const {
+  return (*this >= other) & Vec512<BFloat16>(1.0f);
+}
+
+Vec512<BFloat16> Vec512<BFloat16>::lt(const Vec512<BFloat16>& other) const {
+  return (*this < other) & Vec512<BFloat16>(1.0f);
+}
+
+Vec512<BFloat16> Vec512<BFloat16>::le(const Vec512<BFloat16>& other) const {
+  return (*this <= other) & Vec512<BFloat16>(1.0f);
+}
+
+// frac. Implement this here so we can use subtraction
+Vec512<BFloat16> Vec512<BFloat16>::frac() const {
+  return *this - this->trunc();
+}
+
+// Implements the IEEE 754 201X `maximum` operation, which propagates NaN if
+// either input is a NaN.
+template <>
+Vec512<BFloat16> inline maximum(const Vec512<BFloat16>& a, const Vec512<BFloat16>& b) {
+  __m512 a_lo, a_hi;
+  __m512 b_lo, b_hi;
+  cvtbf16_fp32(__m512i(a), a_lo, a_hi);
+  cvtbf16_fp32(__m512i(b), b_lo, b_hi);
+  auto max_lo = _mm512_max_ps(a_lo, b_lo);
+  auto max_hi = _mm512_max_ps(a_hi, b_hi);
+  auto nan_lo = cmp_mask_to_ps(_mm512_cmp_ps_mask(a_lo, b_lo, _CMP_UNORD_Q));
+  auto nan_hi = cmp_mask_to_ps(_mm512_cmp_ps_mask(a_hi, b_hi, _CMP_UNORD_Q));
+  // Exploit the fact that all-ones is a NaN.
+  auto o1 = _mm512_or_ps(max_lo, nan_lo);
+  auto o2 = _mm512_or_ps(max_hi, nan_hi);
+  return cvtfp32_bf16(o1, o2);
+}
+
+// Implements the IEEE 754 201X `minimum` operation, which propagates NaN if
+// either input is a NaN.
+template <>
+Vec512<BFloat16> inline minimum(const Vec512<BFloat16>& a, const Vec512<BFloat16>& b) {
+  __m512 a_lo, a_hi;
+  __m512 b_lo, b_hi;
+  cvtbf16_fp32(__m512i(a), a_lo, a_hi);
+  cvtbf16_fp32(__m512i(b), b_lo, b_hi);
+  auto min_lo = _mm512_min_ps(a_lo, b_lo);
+  auto min_hi = _mm512_min_ps(a_hi, b_hi);
+  auto nan_lo = cmp_mask_to_ps(_mm512_cmp_ps_mask(a_lo, b_lo, _CMP_UNORD_Q));
+  auto nan_hi = cmp_mask_to_ps(_mm512_cmp_ps_mask(a_hi, b_hi, _CMP_UNORD_Q));
+  // Exploit the fact that all-ones is a NaN.
+  auto o1 = _mm512_or_ps(min_lo, nan_lo);
+  auto o2 = _mm512_or_ps(min_hi, nan_hi);
+  return cvtfp32_bf16(o1, o2);
+}
+
+template <>
+Vec512<BFloat16> inline clamp(const Vec512<BFloat16>& a,
+    const Vec512<BFloat16>& min, const Vec512<BFloat16>& max) {
+  __m512 a_lo, a_hi;
+  __m512 min_lo, min_hi;
+  __m512 max_lo, max_hi;
+  cvtbf16_fp32(__m512i(a), a_lo, a_hi);
+  cvtbf16_fp32(__m512i(min), min_lo, min_hi);
+  cvtbf16_fp32(__m512i(max), max_lo, max_hi);
+  auto o1 = _mm512_min_ps(max_lo, _mm512_max_ps(min_lo, a_lo));
+  auto o2 = _mm512_min_ps(max_hi, _mm512_max_ps(min_hi, a_hi));
+  return cvtfp32_bf16(o1, o2);
+}
+
+template <>
+Vec512<BFloat16> inline clamp_max(const Vec512<BFloat16>& a, const Vec512<BFloat16>& max) {
+  __m512 a_lo, a_hi;
+  __m512 max_lo, max_hi;
+  cvtbf16_fp32(__m512i(a), a_lo, a_hi);
+  cvtbf16_fp32(__m512i(max), max_lo, max_hi);
+  auto o1 = _mm512_min_ps(max_lo, a_lo);
+  auto o2 = _mm512_min_ps(max_hi, a_hi);
+  return cvtfp32_bf16(o1, o2);
+}
+
+template <>
+Vec512<BFloat16> inline clamp_min(const Vec512<BFloat16>& a, const Vec512<BFloat16>& min) {
+  __m512 a_lo, a_hi;
+  __m512 min_lo, min_hi;
+  cvtbf16_fp32(__m512i(a), a_lo, a_hi);
+  cvtbf16_fp32(__m512i(min), min_lo, min_hi);
+  auto o1 = _mm512_max_ps(min_lo, a_lo);
+  auto o2 = _mm512_max_ps(min_hi, a_hi);
+  return cvtfp32_bf16(o1, o2);
+}
+
+template <>
+inline void convert(const BFloat16* src, BFloat16* dst, int64_t n) {
+  int64_t i;
+#pragma unroll
+  for (i = 0; i <= (n - Vec512<BFloat16>::size()); i += Vec512<BFloat16>::size()) {
+    auto vsrc = _mm512_loadu_si512(reinterpret_cast<__m512i*>((void*)(src + i)));
+    _mm512_storeu_si512(reinterpret_cast<__m512i*>((void*)(dst + i)), vsrc);
+  }
+#pragma unroll
+  for (; i < n; i++) {
+    dst[i] = src[i];
+  }
+}
+
+template <>
+Vec512<BFloat16> inline fmadd(const Vec512<BFloat16>& a,
+    const Vec512<BFloat16>& b, const Vec512<BFloat16>& c) {
+  __m512 a_lo, a_hi;
+  __m512 b_lo, b_hi;
+  __m512 c_lo, c_hi;
+  cvtbf16_fp32(__m512i(a), a_lo, a_hi);
+  cvtbf16_fp32(__m512i(b), b_lo, b_hi);
+  cvtbf16_fp32(__m512i(c), c_lo, c_hi);
+  auto o1 = _mm512_fmadd_ps(a_lo, b_lo, c_lo);
+  auto o2 = _mm512_fmadd_ps(a_hi, b_hi, c_hi);
+  return cvtfp32_bf16(o1, o2);
+}
+
+#endif
+
+}}}
@@ -0,0 +1,405 @@
+#pragma once
+
+// DO NOT DEFINE STATIC DATA IN THIS HEADER!
+// See Note [Do not compile initializers with AVX]
+
+#include <c10/util/complex_type.h>
+#include <ATen/cpu/vec256/intrinsics.h>
+#include <ATen/cpu/vec512/vec512_base.h>
+#if defined(CPU_CAPABILITY_AVX512) && !defined(_MSC_VER)
+#include <sleef.h>
+#endif
+
+namespace at {
+namespace vec512 {
+// See Note [Acceptable use of anonymous namespace in header]
+namespace {
+
+#if defined(CPU_CAPABILITY_AVX512) && !defined(_MSC_VER)
+
+template <> class Vec512<c10::complex<double>> {
+private:
+  __m512d values;
+  // convert c10::complex<V> index mask to V index mask: xy -> xxyy
+  static inline __mmask8 expand_mask(int64_t mask) {
+    __mmask8 out = 0;
+    for (int i = 0; i < size(); i++) {
+      if (mask & (1LL << i)) {
+        out |= static_cast<__mmask8>(3ULL << (2 * i));
+      }
+    }
+    return out;
+  }
+  static inline __m512d mask_to_vec(__mmask8 mask) {
+    return _mm512_castsi512_pd(_mm512_movm_epi64(mask));
+  }
+  // (a, b) -> (b, a) in every complex lane
+  static inline __m512d swap_re_im(const __m512d& v) {
+    return _mm512_permute_pd(v, 0x55);
+  }
+  static inline __m512d sign_mask_im() {
+    // 0.0, -0.0, 0.0, -0.0, ...
+    return _mm512_maskz_mov_pd(0xAA, _mm512_set1_pd(-0.0));
+  }
+public:
+  using value_type = c10::complex<double>;
+  static constexpr int size() {
+    return 4;
+  }
+  Vec512() {}
+  Vec512(__m512d v) : values(v) {}
+  Vec512(c10::complex<double> val) {
+    double real_value = val.real();
+    double imag_value = val.imag();
+    values = _mm512_mask_blend_pd(0xAA, _mm512_set1_pd(real_value),
+                                  _mm512_set1_pd(imag_value));
+  }
+  operator __m512d() const {
+    return values;
+  }
+  template <int64_t mask>
+  static Vec512<c10::complex<double>> blend(const Vec512<c10::complex<double>>& a, const Vec512<c10::complex<double>>& b) {
+    return _mm512_mask_blend_pd(expand_mask(mask), a.values, b.values);
+  }
+  static Vec512<c10::complex<double>> blendv(const Vec512<c10::complex<double>>& a, const Vec512<c10::complex<double>>& b,
+                                           const Vec512<c10::complex<double>>& mask) {
+    // convert c10::complex<V> index mask to V index mask: xy -> xxyy
+    auto mask_ = _mm512_movedup_pd(mask.values);
+    return _mm512_mask_blend_pd(_mm512_movepi64_mask(_mm512_castpd_si512(mask_)), a.values, b.values);
+  }
+  template<typename step_t>
+  static Vec512<c10::complex<double>> arange(c10::complex<double> base = 0., step_t step = static_cast<step_t>(1)) {
+    __at_align64__ c10::complex<double> tmp_values[size()];
+    for (int i = 0; i < size(); i++) {
+      tmp_values[i] = base + c10::complex<double>(i) * step;
+    }
+    return loadu(tmp_values);
+  }
+  static Vec512<c10::complex<double>> set(const Vec512<c10::complex<double>>& a, const Vec512<c10::complex<double>>& b,
+                                        int64_t count = size()) {
+    if (count >= size()) {
+      return b;
+    }
+    __mmask8 mask = (1ULL << (2 * count)) - 1;
+    return _mm512_mask_blend_pd(mask, a.values, b.values);
+  }
+  static Vec512<c10::complex<double>> loadu(const void* ptr, int64_t count = size()) {
+    if (count == size())
+      return _mm512_loadu_pd(reinterpret_cast<const double*>(ptr));
+    // Masked-off lanes are zeroed and never touch memory.
+    __mmask8 mask = (1ULL << (2 * count)) - 1;
+    return _mm512_maskz_loadu_pd(mask, ptr);
+  }
+  void store(void* ptr, int count = size()) const {
+    if (count == size()) {
+      _mm512_storeu_pd(reinterpret_cast<double*>(ptr), values);
+    } else if (count > 0) {
+      __mmask8 mask = (1ULL << (2 * count)) - 1;
+      _mm512_mask_storeu_pd(reinterpret_cast<double*>(ptr), mask, values);
+    }
+  }
+  const c10::complex<double>& operator[](int idx) const  = delete;
+  c10::complex<double>& operator[](int idx) = delete;
+  Vec512<c10::complex<double>> map(c10::complex<double> (*f)(const c10::complex<double> &)) const {
+    __at_align64__ c10::complex<double> tmp[size()];
+    store(tmp);
+    for (int i = 0; i < size(); i++) {
+      tmp[i] = f(tmp[i]);
+    }
+    return loadu(tmp);
+  }
+  __m512d abs_2_() const {
+    auto val_2 = _mm512_mul_pd(values, values);          // a*a     b*b
+    return _mm512_add_pd(val_2, swap_re_im(val_2));      // a*a+b*b a*a+b*b
+  }
+  __m512d abs_() const {
+    return _mm512_sqrt_pd(abs_2_());                     // abs     abs
+  }
+  Vec512<c10::complex<double>> abs() const {
+    return _mm512_maskz_mov_pd(0x55, abs_());           // abs     0
+  }
+  __m512d angle_() const {
+    //angle = atan2(b/a)
+    auto b_a = swap_re_im(values);                       // b        a
+    return Sleef_atan2d8_u10(values, b_a);            // 90-angle angle
+  }
+  Vec512<c10::complex<double>> angle() const {
+    auto angle = swap_re_im(angle_());                   // angle    90-angle
+    return _mm512_maskz_mov_pd(0x55, angle);            // angle    0
+  }
+  Vec512<c10::complex<double>> real() const {
+    return _mm512_maskz_mov_pd(0x55, values);           // a        0
+  }
+  Vec512<c10::complex<double>> imag() const {
+    return _mm512_maskz_mov_pd(0x55, swap_re_im(values)); // b      0
+  }
+  __m512d conj_() const {
+    return _mm512_xor_pd(values, sign_mask_im());        // a       -b
+  }
+  Vec512<c10::complex<double>> conj() const {
+    return conj_();
+  }
+  Vec512<c10::complex<double>> log() const {
+    // Most trigonomic ops use the log() op to improve complex number performance.
+    return map(std::log);
+  }
+  Vec512<c10::complex<double>> log2() const {
+    const __m512d log2_ = _mm512_set1_pd(std::log(2));
+    return _mm512_div_pd(log(), log2_);
+  }
+  Vec512<c10::complex<double>> log10() const {
+    const __m512d log10_ = _mm512_set1_pd(std::log(10));
+    return _mm512_div_pd(log(), log10_);
+  }
+  Vec512<c10::complex<double>> log1p() const {
+    AT_ERROR("not supported for complex numbers");
+  }
+  Vec512<c10::complex<double>> asin() const {
+    return map(std::asin);
+  }
+  Vec512<c10::complex<double>> acos() const {
+    return map(std::acos);
+  }
+  Vec512<c10::complex<double>> atan() const {
+    return map(std::atan);
+  }
+  Vec512<c10::complex<double>> atan2(const Vec512<c10::complex<double>> &b) const {
+    AT_ERROR("not supported for complex numbers");
+  }
+  Vec512<c10::complex<double>> erf() const {
+    AT_ERROR("not supported for complex numbers");
+  }
+  Vec512<c10::complex<double>> erfc() const {
+    AT_ERROR("not supported for complex numbers");
+  }
+  Vec512<c10::complex<double>> exp() const {
+    //exp(a + bi)
+    // = exp(a)*(cos(b) + sin(b)i)
+    auto exp = Sleef_expd8_u10(values);                        //exp(a)           exp(b)
+    exp = _mm512_movedup_pd(exp);                                     //exp(a)           exp(a)
+
+    auto sin_cos = Sleef_sincosd8_u10(values);                 //[sin(a), cos(a)] [sin(b), cos(b)]
+    auto cos_sin = _mm512_mask_blend_pd(0xAA, swap_re_im(sin_cos.y),
+                                        sin_cos.x);                //cos(b)           sin(b)
+    return _mm512_mul_pd(exp, cos_sin);
+  }
+  Vec512<c10::complex<double>> expm1() const {
+    AT_ERROR("not supported for complex numbers");
+  }
+  Vec512<c10::complex<double>> sin() const {
+    return map(std::sin);
+  }
+  Vec512<c10::complex<double>> sinh() const {
+    return map(std::sinh);
+  }
+  Vec512<c10::complex<double>> cos() const {
+    return map(std::cos);
+  }
+  Vec512<c10::complex<double>> cosh() const {
+    return map(std::cosh);
+  }
+  Vec512<c10::complex<double>> ceil() const {
+    return _mm512_roundscale_pd(values, (_MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC));
+  }
+  Vec512<c10::complex<double>> floor() const {
+    return _mm512_roundscale_pd(values, (_MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC));
+  }
+  Vec512<c10::complex<double>> neg() const {
+    auto zero = _mm512_setzero_pd();
+    return _mm512_sub_pd(zero, values);
+  }
+  Vec512<c10::complex<double>> round() const {
+    return _mm512_roundscale_pd(values, (_MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+  }
+  Vec512<c10::complex<double>> tan() const {
+    return map(std::tan);
+  }
+  Vec512<c10::complex<double>> tanh() const {
+    return map(std::tanh);
+  }
+  Vec512<c10::complex<double>> trunc() const {
+    return _mm512_roundscale_pd(values, (_MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));
+  }
+  Vec512<c10::complex<double>> sqrt() const {
+    //   sqrt(a + bi)
+    // = sqrt(2)/2 * [sqrt(sqrt(a**2 + b**2) + a) + sgn(b)*sqrt(sqrt(a**2 + b**2) - a)i]
+    // = sqrt(2)/2 * [sqrt(abs() + a) + sgn(b)*sqrt(abs() - a)i]
+
+    const __m512d scalar = _mm512_set1_pd(std::sqrt(2)/2);              //sqrt(2)/2      sqrt(2)/2
+    const __m512d sign_mask = sign_mask_im();
+    auto sign = _mm512_and_pd(values, sign_mask);
+    auto factor = _mm512_or_pd(scalar, sign);
+
+    auto a_a = _mm512_xor_pd(_mm512_movedup_pd(values), sign_mask);   // a             -a
+    auto res_re_im = _mm512_sqrt_pd(_mm512_add_pd(abs_(), a_a));       // sqrt(abs + a) sqrt(abs - a)
+    return _mm512_mul_pd(factor, res_re_im);
+  }
+  Vec512<c10::complex<double>> reciprocal() const;
+  Vec512<c10::complex<double>> rsqrt() const {
+    return sqrt().reciprocal();
+  }
+  Vec512<c10::complex<double>> pow(const Vec512<c10::complex<double>> &exp) const {
+    __at_align64__ c10::complex<double> x_tmp[size()];
+    __at_align64__ c10::complex<double> y_tmp[size()];
+    store(x_tmp);
+    exp.store(y_tmp);
+    for (int i = 0; i < size(); i++) {
+      x_tmp[i] = std::pow(x_tmp[i], y_tmp[i]);
+    }
+    return loadu(x_tmp);
+  }
+  // Comparison using the _CMP_**_OQ predicate.
+  //   `O`: get false if an operand is NaN
+  //   `Q`: do not raise if an operand is NaN
+  Vec512<c10::complex<double>> operator==(const Vec512<c10::complex<double>>& other) const {
+    return mask_to_vec(_mm512_cmp_pd_mask(values, other.values, _CMP_EQ_OQ));
+  }
+  Vec512<c10::complex<double>> operator!=(const Vec512<c10::complex<double>>& other) const {
+    return mask_to_vec(_mm512_cmp_pd_mask(values, other.values, _CMP_NEQ_OQ));
+  }
+  Vec512<c10::complex<double>> operator<(const Vec512<c10::complex<double>>& other) const {
+    TORCH_CHECK(false, "not supported for complex numbers");
+  }
+  Vec512<c10::complex<double>> operator<=(const Vec512<c10::complex<double>>& other) const {
+    TORCH_CHECK(false, "not supported for complex numbers");
+  }
+  Vec512<c10::complex<double>> operator>(const Vec512<c10::complex<double>>& other) const {
+    TORCH_CHECK(false, "not supported for complex numbers");
+  }
+  Vec512<c10::complex<double>> operator>=(const Vec512<c10::complex<double>>& other) const {
+    TORCH_CHECK(false, "not supported for complex numbers");
+  }
+
+  Vec512<c10::complex<double>> eq(const Vec512<c10::complex<double>>& other) const;
+  Vec512<c10::complex<double>> ne(const Vec512<c10::complex<double>>& other) const;
+  Vec512<c10::complex<double>> lt(const Vec512<c10::complex<double>>& other) const {
+    TORCH_CHECK(false, "not supported for complex numbers");
+  }
+  Vec512<c10::complex<double>> le(const Vec512<c10::complex<double>>& other) const {
+    TORCH_CHECK(false, "not supported for complex numbers");
+  }
+  Vec512<c10::complex<double>> gt(const Vec512<c10::complex<double>>& other) const {
+    TORCH_CHECK(false, "not supported for complex numbers");
+  }
+  Vec512<c10::complex<double>> ge(const Vec512<c10::complex<double>>& other) const {
+    TORCH_CHECK(false, "not supported for complex numbers");
+  }
+};
+
+template <> Vec512<c10::complex<double>> inline operator+(const Vec512<c10::complex<double>> &a, const Vec512<c10::complex<double>> &b) {
+  return _mm512_add_pd(a, b);
+}
+
+template <> Vec512<c10::complex<double>> inline operator-(const Vec512<c10::complex<double>> &a, const Vec512<c10::complex<double>> &b) {
+  return _mm512_sub_pd(a, b);
+}
+
+template <> Vec512<c10::complex<double>> inline operator*(const Vec512<c10::complex<double>> &a, const Vec512<c10::complex<double>> &b) {
+  //(a + bi)  * (c + di) = (ac - bd) + (ad + bc)i
+  // AVX512 has no horizontal add/sub; fmaddsub alternates sub (even lanes)
+  // and add (odd lanes) instead.
+  auto a_a = _mm512_movedup_pd(a);                                     //a        a
+  auto b_b = _mm512_permute_pd(a, 0xFF);                                     //b        b
+  auto d_c = _mm512_permute_pd(b, 0x55);                                       //d        c
+  auto bd_bc = _mm512_mul_pd(b_b, d_c);                    //bd       bc
+  return _mm512_fmaddsub_pd(a_a, b, bd_bc);                //ac - bd  ad + bc
+}
+
+template <> Vec512<c10::complex<double>> inline operator/(const Vec512<c10::complex<double>> &a, const Vec512<c10::complex<double>> &b) {
+  //re + im*i = (a + bi)  / (c + di)
+  //re = (ac + bd)/abs_2()
+  //im = (bc - ad)/abs_2()
+  auto a_a = _mm512_movedup_pd(a);                                     //a        a
+  auto b_b = _mm512_permute_pd(a, 0xFF);                                     //b        b
+  auto d_c = _mm512_permute_pd(b, 0x55);                                       //d        c
+  auto bd_bc = _mm512_mul_pd(b_b, d_c);                    //bd       bc
+  auto re_im = _mm512_fmsubadd_pd(a_a, b, bd_bc);          //ac + bd  ad - bc
+  const __m512d sign_mask = _mm512_maskz_mov_pd(0xAA, _mm512_set1_pd(-0.0));
+  re_im = _mm512_xor_pd(re_im, sign_mask);                 //ac + bd  bc - ad
+  return _mm512_div_pd(re_im, b.abs_2_());
+}
+
+// reciprocal. Implement this here so we can use multiplication.
+Vec512<c10::complex<double>> Vec512<c10::complex<double>>::reciprocal() const {
+  //re + im*i = (a + bi)  / (c + di)
+  //re = (ac + bd)/abs_2() = c/abs_2()
+  //im = (bc - ad)/abs_2() = d/abs_2()
+  return _mm512_div_pd(conj_(), abs_2_());
+}
+
+template <>
+Vec512<c10::complex<double>> inline maximum(const Vec512<c10::complex<double>>& a, const Vec512<c10::complex<double>>& b) {
+  auto abs_a = a.abs_2_();
+  auto abs_b = b.abs_2_();
+  auto mask = _mm512_cmp_pd_mask(abs_a, abs_b, _CMP_LT_OQ);
+  auto max = _mm512_mask_blend_pd(mask, a, b);
+  // Exploit the fact that all-ones is a NaN.
+  auto isnan = _mm512_cmp_pd_mask(abs_a, abs_b, _CMP_UNORD_Q);
+  return _mm512_castsi512_pd(_mm512_mask_set1_epi64(_mm512_castpd_si512(max), isnan, -1));
+}
+
+template <>
+Vec512<c10::complex<double>> inline minimum(const Vec512<c10::complex<double>>& a, const Vec512<c10::complex<double>>& b) {
+  auto abs_a = a.abs_2_();
+  auto abs_b = b.abs_2_();
+  auto mask = _mm512_cmp_pd_mask(abs_a, abs_b, _CMP_GT_OQ);
+  auto min = _mm512_mask_blend_pd(mask, a, b);
+  // Exploit the fact that all-ones is a NaN.
+  auto isnan = _mm512_cmp_pd_mask(abs_a, abs_b, _CMP_UNORD_Q);
+  return _mm512_castsi512_pd(_mm512_mask_set1_epi64(_mm512_castpd_si512(min), isnan, -1));
+}
+
+template <>
+Vec512<c10::complex<double>> inline clamp(const Vec512<c10::complex<double>>& a, const Vec512<c10::complex<double>>& min, const Vec512<c10::complex<double>>& max) {
+  auto abs_a = a.abs_2_();
+  auto abs_min = min.abs_2_();
+  auto max_mask = _mm512_cmp_pd_mask(abs_a, abs_min, _CMP_LT_OQ);
+  auto abs_max = max.abs_2_();
+  auto min_mask = _mm512_cmp_pd_mask(abs_a, abs_max, _CMP_GT_OQ);
+  return _mm512_mask_blend_pd(min_mask, _mm512_mask_blend_pd(max_mask, a, min), max);
+}
+
+template <>
+Vec512<c10::complex<double>> inline clamp_min(const Vec512<c10::complex<double>>& a, const Vec512<c10::complex<double>>& min) {
+  auto abs_a = a.abs_2_();
+  auto abs_min = min.abs_2_();
+  auto max_mask = _mm512_cmp_pd_mask(abs_a, abs_min, _CMP_LT_OQ);
+  return _mm512_mask_blend_pd(max_mask, a, min);
+}
+
+template <>
+Vec512<c10::complex<double>> inline clamp_max(const Vec512<c10::complex<double>>& a, const Vec512<c10::complex<double>>& max) {
+  auto abs_a = a.abs_2_();
+  auto abs_max = max.abs_2_();
+  auto min_mask = _mm512_cmp_pd_mask(abs_a, abs_max, _CMP_GT_OQ);
+  return _mm512_mask_blend_pd(min_mask, a, max);
+}
+
+template <>
+Vec512<c10::complex<double>> inline operator&(const Vec512<c10::complex<double>>& a, const Vec512<c10::complex<double>>& b) {
+  return _mm512_and_pd(a, b);
+}
+
+template <>
+Vec512<c10::complex<double>> inline operator|(const Vec512<c10::complex<double>>& a, const Vec512<c10::complex<double>>& b) {
+  return _mm512_or_pd(a, b);
+}
+
+template <>
+Vec512<c10::complex<double>> inline operator^(const Vec512<c10::complex<double>>& a, const Vec512<c10::complex<double>>& b) {
+  return _mm512_xor_pd(a, b);
+}
+
+Vec512<c10::complex<double>> Vec512<c10::complex<double>>::eq(
+    const Vec512<c10::complex<double>>& other) const {
+  return (*this == other) & Vec512<c10::complex<double>>(_mm512_set1_pd(1.0));
+}
+
+Vec512<c10::complex<double>> Vec512<c10::complex<double>>::ne(
+    const Vec512<c10::complex<double>>& other) const {
+  return (*this != other) & Vec512<c10::complex<double>>(_mm512_set1_pd(1.0));
+}
+
+#endif
+
+}}}
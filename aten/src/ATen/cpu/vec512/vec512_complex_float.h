@@ -0,0 +1,405 @@
+#pragma once
+
+// DO NOT DEFINE STATIC DATA IN THIS HEADER!
+// See Note [Do not compile initializers with AVX]
+
+#include <c10/util/complex_type.h>
+#include <ATen/cpu/vec256/intrinsics.h>
+#include <ATen/cpu/vec512/vec512_base.h>
+#if defined(CPU_CAPABILITY_AVX512) && !defined(_MSC_VER)
+#include <sleef.h>
+#endif
+
+namespace at {
+namespace vec512 {
+// See Note [Acceptable use of anonymous namespace in header]
+namespace {
+
+#if defined(CPU_CAPABILITY_AVX512) && !defined(_MSC_VER)
+
+template <> class Vec512<c10::complex<float>> {
+private:
+  __m512 values;
+  // convert c10::complex<V> index mask to V index mask: xy -> xxyy
+  static inline __mmask16 expand_mask(int64_t mask) {
+    __mmask16 out = 0;
+    for (int i = 0; i < size(); i++) {
+      if (mask & (1LL << i)) {
+        out |= static_cast<__mmask16>(3ULL << (2 * i));
+      }
+    }
+    return out;
+  }
+  static inline __m512 mask_to_vec(__mmask16 mask) {
+    return _mm512_castsi512_ps(_mm512_movm_epi32(mask));
+  }
+  // (a, b) -> (b, a) in every complex lane
+  static inline __m512 swap_re_im(const __m512& v) {
+    return _mm512_permute_ps(v, 0xB1);
+  }
+  static inline __m512 sign_mask_im() {
+    // 0.0, -0.0, 0.0, -0.0, ...
+    return _mm512_maskz_mov_ps(0xAAAA, _mm512_set1_ps(-0.0));
+  }
+public:
+  using value_type = c10::complex<float>;
+  static constexpr int size() {
+    return 8;
+  }
+  Vec512() {}
+  Vec512(__m512 v) : values(v) {}
+  Vec512(c10::complex<float> val) {
+    float real_value = val.real();
+    float imag_value = val.imag();
+    values = _mm512_mask_blend_ps(0xAAAA, _mm512_set1_ps(real_value),
+                                  _mm512_set1_ps(imag_value));
+  }
+  operator __m512() const {
+    return values;
+  }
+  template <int64_t mask>
+  static Vec512<c10::complex<float>> blend(const Vec512<c10::complex<float>>& a, const Vec512<c10::complex<float>>& b) {
+    return _mm512_mask_blend_ps(expand_mask(mask), a.values, b.values);
+  }
+  static Vec512<c10::complex<float>> blendv(const Vec512<c10::complex<float>>& a, const Vec512<c10::complex<float>>& b,
+                                           const Vec512<c10::complex<float>>& mask) {
+    // convert c10::complex<V> index mask to V index mask: xy -> xxyy
+    auto mask_ = _mm512_moveldup_ps(mask.values);
+    return _mm512_mask_blend_ps(_mm512_movepi32_mask(_mm512_castps_si512(mask_)), a.values, b.values);
+  }
+  template<typename step_t>
+  static Vec512<c10::complex<float>> arange(c10::complex<float> base = 0., step_t step = static_cast<step_t>(1)) {
+    __at_align64__ c10::complex<float> tmp_values[size()];
+    for (int i = 0; i < size(); i++) {
+      tmp_values[i] = base + c10::complex<float>(i) * step;
+    }
+    return loadu(tmp_values);
+  }
+  static Vec512<c10::complex<float>> set(const Vec512<c10::complex<float>>& a, const Vec512<c10::complex<float>>& b,
+                                        int64_t count = size()) {
+    if (count >= size()) {
+      return b;
+    }
+    __mmask16 mask = (1ULL << (2 * count)) - 1;
+    return _mm512_mask_blend_ps(mask, a.values, b.values);
+  }
+  static Vec512<c10::complex<float>> loadu(const void* ptr, int64_t count = size()) {
+    if (count == size())
+      return _mm512_loadu_ps(reinterpret_cast<const float*>(ptr));
+    // Masked-off lanes are zeroed and never touch memory.
+    __mmask16 mask = (1ULL << (2 * count)) - 1;
+    return _mm512_maskz_loadu_ps(mask, ptr);
+  }
+  void store(void* ptr, int count = size()) const {
+    if (count == size()) {
+      _mm512_storeu_ps(reinterpret_cast<float*>(ptr), values);
+    } else if (count > 0) {
+      __mmask16 mask = (1ULL << (2 * count)) - 1;
+      _mm512_mask_storeu_ps(reinterpret_cast<float*>(ptr), mask, values);
+    }
+  }
+  const c10::complex<float>& operator[](int idx) const  = delete;
+  c10::complex<float>& operator[](int idx) = delete;
+  Vec512<c10::complex<float>> map(c10::complex<float> (*f)(const c10::complex<float> &)) const {
+    __at_align64__ c10::complex<float> tmp[size()];
+    store(tmp);
+    for (int i = 0; i < size(); i++) {
+      tmp[i] = f(tmp[i]);
+    }
+    return loadu(tmp);
+  }
+  __m512 abs_2_() const {
+    auto val_2 = _mm512_mul_ps(values, values);          // a*a     b*b
+    return _mm512_add_ps(val_2, swap_re_im(val_2));      // a*a+b*b a*a+b*b
+  }
+  __m512 abs_() const {
+    return _mm512_sqrt_ps(abs_2_());                     // abs     abs
+  }
+  Vec512<c10::complex<float>> abs() const {
+    return _mm512_maskz_mov_ps(0x5555, abs_());           // abs     0
+  }
+  __m512 angle_() const {
+    //angle = atan2(b/a)
+    auto b_a = swap_re_im(values);                       // b        a
+    return Sleef_atan2f16_u10(values, b_a);            // 90-angle angle
+  }
+  Vec512<c10::complex<float>> angle() const {
+    auto angle = swap_re_im(angle_());                   // angle    90-angle
+    return _mm512_maskz_mov_ps(0x5555, angle);            // angle    0
+  }
+  Vec512<c10::complex<float>> real() const {
+    return _mm512_maskz_mov_ps(0x5555, values);           // a        0
+  }
+  Vec512<c10::complex<float>> imag() const {
+    return _mm512_maskz_mov_ps(0x5555, swap_re_im(values)); // b      0
+  }
+  __m512 conj_() const {
+    return _mm512_xor_ps(values, sign_mask_im());        // a       -b
+  }
+  Vec512<c10::complex<float>> conj() const {
+    return conj_();
+  }
+  Vec512<c10::complex<float>> log() const {
+    // Most trigonomic ops use the log() op to improve complex number performance.
+    return map(std::log);
+  }
+  Vec512<c10::complex<float>> log2() const {
+    const __m512 log2_ = _mm512_set1_ps(std::log(2));
+    return _mm512_div_ps(log(), log2_);
+  }
+  Vec512<c10::complex<float>> log10() const {
+    const __m512 log10_ = _mm512_set1_ps(std::log(10));
+    return _mm512_div_ps(log(), log10_);
+  }
+  Vec512<c10::complex<float>> log1p() const {
+    AT_ERROR("not supported for complex numbers");
+  }
+  Vec512<c10::complex<float>> asin() const {
+    return map(std::asin);
+  }
+  Vec512<c10::complex<float>> acos() const {
+    return map(std::acos);
+  }
+  Vec512<c10::complex<float>> atan() const {
+    return map(std::atan);
+  }
+  Vec512<c10::complex<float>> atan2(const Vec512<c10::complex<float>> &b) const {
+    AT_ERROR("not supported for complex numbers");
+  }
+  Vec512<c10::complex<float>> erf() const {
+    AT_ERROR("not supported for complex numbers");
+  }
+  Vec512<c10::complex<float>> erfc() const {
+    AT_ERROR("not supported for complex numbers");
+  }
+  Vec512<c10::complex<float>> exp() const {
+    //exp(a + bi)
+    // = exp(a)*(cos(b) + sin(b)i)
+    auto exp = Sleef_expf16_u10(values);                        //exp(a)           exp(b)
+    exp = _mm512_moveldup_ps(exp);                                     //exp(a)           exp(a)
+
+    auto sin_cos = Sleef_sincosf16_u10(values);                 //[sin(a), cos(a)] [sin(b), cos(b)]
+    auto cos_sin = _mm512_mask_blend_ps(0xAAAA, swap_re_im(sin_cos.y),
+                                        sin_cos.x);                //cos(b)           sin(b)
+    return _mm512_mul_ps(exp, cos_sin);
+  }
+  Vec512<c10::complex<float>> expm1() const {
+    AT_ERROR("not supported for complex numbers");
+  }
+  Vec512<c10::complex<float>> sin() const {
+    return map(std::sin);
+  }
+  Vec512<c10::complex<float>> sinh() const {
+    return map(std::sinh);
+  }
+  Vec512<c10::complex<float>> cos() const {
+    return map(std::cos);
+  }
+  Vec512<c10::complex<float>> cosh() const {
+    return map(std::cosh);
+  }
+  Vec512<c10::complex<float>> ceil() const {
+    return _mm512_roundscale_ps(values, (_MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC));
+  }
+  Vec512<c10::complex<float>> floor() const {
+    return _mm512_roundscale_ps(values, (_MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC));
+  }
+  Vec512<c10::complex<float>> neg() const {
+    auto zero = _mm512_setzero_ps();
+    return _mm512_sub_ps(zero, values);
+  }
+  Vec512<c10::complex<float>> round() const {
+    return _mm512_roundscale_ps(values, (_MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+  }
+  Vec512<c10::complex<float>> tan() const {
+    return map(std::tan);
+  }
+  Vec512<c10::complex<float>> tanh() const {
+    return map(std::tanh);
+  }
+  Vec512<c10::complex<float>> trunc() const {
+    return _mm512_roundscale_ps(values, (_MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));
+  }
+  Vec512<c10::complex<float>> sqrt() const {
+    //   sqrt(a + bi)
+    // = sqrt(2)/2 * [sqrt(sqrt(a**2 + b**2) + a) + sgn(b)*sqrt(sqrt(a**2 + b**2) - a)i]
+    // = sqrt(2)/2 * [sqrt(abs() + a) + sgn(b)*sqrt(abs() - a)i]
+
+    const __m512 scalar = _mm512_set1_ps(std::sqrt(2)/2);              //sqrt(2)/2      sqrt(2)/2
+    const __m512 sign_mask = sign_mask_im();
+    auto sign = _mm512_and_ps(values, sign_mask);
+    auto factor = _mm512_or_ps(scalar, sign);
+
+    auto a_a = _mm512_xor_ps(_mm512_moveldup_ps(values), sign_mask);   // a             -a
+    auto res_re_im = _mm512_sqrt_ps(_mm512_add_ps(abs_(), a_a));       // sqrt(abs + a) sqrt(abs - a)
+    return _mm512_mul_ps(factor, res_re_im);
+  }
+  Vec512<c10::complex<float>> reciprocal() const;
+  Vec512<c10::complex<float>> rsqrt() const {
+    return sqrt().reciprocal();
+  }
+  Vec512<c10::complex<float>> pow(const Vec512<c10::complex<float>> &exp) const {
+    __at_align64__ c10::complex<float> x_tmp[size()];
+    __at_align64__ c10::complex<float> y_tmp[size()];
+    store(x_tmp);
+    exp.store(y_tmp);
+    for (int i = 0; i < size(); i++) {
+      x_tmp[i] = std::pow(x_tmp[i], y_tmp[i]);
+    }
+    return loadu(x_tmp);
+  }
+  // Comparison using the _CMP_**_OQ predicate.
+  //   `O`: get false if an operand is NaN
+  //   `Q`: do not raise if an operand is NaN
+  Vec512<c10::complex<float>> operator==(const Vec512<c10::complex<float>>& other) const {
+    return mask_to_vec(_mm512_cmp_ps_mask(values, other.values, _CMP_EQ_OQ));
+  }
+  Vec512<c10::complex<float>> operator!=(const Vec512<c10::complex<float>>& other) const {
+    return mask_to_vec(_mm512_cmp_ps_mask(values, other.values, _CMP_NEQ_OQ));
+  }
+  Vec512<c10::complex<float>> operator<(const Vec512<c10::complex<float>>& other) const {
+    TORCH_CHECK(false, "not supported for complex numbers");
+  }
+  Vec512<c10::complex<float>> operator<=(const Vec512<c10::complex<float>>& other) const {
+    TORCH_CHECK(false, "not supported for complex numbers");
+  }
+  Vec512<c10::complex<float>> operator>(const Vec512<c10::complex<float>>& other) const {
+    TORCH_CHECK(false, "not supported for complex numbers");
+  }
+  Vec512<c10::complex<float>> operator>=(const Vec512<c10::complex<float>>& other) const {
+    TORCH_CHECK(false, "not supported for complex numbers");
+  }
+
+  Vec512<c10::complex<float>> eq(const Vec512<c10::complex<float>>& other) const;
+  Vec512<c10::complex<float>> ne(const Vec512<c10::complex<float>>& other) const;
+  Vec512<c10::complex<float>> lt(const Vec512<c10::complex<float>>& other) const {
+    TORCH_CHECK(false, "not supported for complex numbers");
+  }
+  Vec512<c10::complex<float>> le(const Vec512<c10::complex<float>>& other) const {
+    TORCH_CHECK(false, "not supported for complex numbers");
+  }
+  Vec512<c10::complex<float>> gt(const Vec512<c10::complex<float>>& other) const {
+    TORCH_CHECK(false, "not supported for complex numbers");
+  }
+  Vec512<c10::complex<float>> ge(const Vec512<c10::complex<float>>& other) const {
+    TORCH_CHECK(false, "not supported for complex numbers");
+  }
+};
+
+template <> Vec512<c10::complex<float>> inline operator+(const Vec512<c10::complex<float>> &a, const Vec512<c10::complex<float>> &b) {
+  return _mm512_add_ps(a, b);
+}
+
+template <> Vec512<c10::complex<float>> inline operator-(const Vec512<c10::complex<float>> &a, const Vec512<c10::complex<float>> &b) {
+  return _mm512_sub_ps(a, b);
+}
+
+template <> Vec512<c10::complex<float>> inline operator*(const Vec512<c10::complex<float>> &a, const Vec512<c10::complex<float>> &b) {
+  //(a + bi)  * (c + di) = (ac - bd) + (ad + bc)i
+  // AVX512 has no horizontal add/sub; fmaddsub alternates sub (even lanes)
+  // and add (odd lanes) instead.
+  auto a_a = _mm512_moveldup_ps(a);                                     //a        a
+  auto b_b = _mm512_movehdup_ps(a);                                     //b        b
+  auto d_c = _mm512_permute_ps(b, 0xB1);                                       //d        c
+  auto bd_bc = _mm512_mul_ps(b_b, d_c);                    //bd       bc
+  return _mm512_fmaddsub_ps(a_a, b, bd_bc);                //ac - bd  ad + bc
+}
+
+template <> Vec512<c10::complex<float>> inline operator/(const Vec512<c10::complex<float>> &a, const Vec512<c10::complex<float>> &b) {
+  //re + im*i = (a + bi)  / (c + di)
+  //re = (ac + bd)/abs_2()
+  //im = (bc - ad)/abs_2()
+  auto a_a = _mm512_moveldup_ps(a);                                     //a        a
+  auto b_b = _mm512_movehdup_ps(a);                                     //b        b
+  auto d_c = _mm512_permute_ps(b, 0xB1);                                       //d        c
+  auto bd_bc = _mm512_mul_ps(b_b, d_c);                    //bd       bc
+  auto re_im = _mm512_fmsubadd_ps(a_a, b, bd_bc);          //ac + bd  ad - bc
+  const __m512 sign_mask = _mm512_maskz_mov_ps(0xAAAA, _mm512_set1_ps(-0.0));
+  re_im = _mm512_xor_ps(re_im, sign_mask);                 //ac + bd  bc - ad
+  return _mm512_div_ps(re_im, b.abs_2_());
+}
+
+// reciprocal. Implement this here so we can use multiplication.
+Vec512<c10::complex<float>> Vec512<c10::complex<float>>::reciprocal() const {
+  //re + im*i = (a + bi)  / (c + di)
+  //re = (ac + bd)/abs_2() = c/abs_2()
+  //im = (bc - ad)/abs_2() = d/abs_2()
+  return _mm512_div_ps(conj_(), abs_2_());
+}
+
+template <>
+Vec512<c10::complex<float>> inline maximum(const Vec512<c10::complex<float>>& a, const Vec512<c10::complex<float>>& b) {
+  auto abs_a = a.abs_2_();
+  auto abs_b = b.abs_2_();
+  auto mask = _mm512_cmp_ps_mask(abs_a, abs_b, _CMP_LT_OQ);
+  auto max = _mm512_mask_blend_ps(mask, a, b);
+  // Exploit the fact that all-ones is a NaN.
+  auto isnan = _mm512_cmp_ps_mask(abs_a, abs_b, _CMP_UNORD_Q);
+  return _mm512_castsi512_ps(_mm512_mask_set1_epi32(_mm512_castps_si512(max), isnan, -1));
+}
+
+template <>
+Vec512<c10::complex<float>> inline minimum(const Vec512<c10::complex<float>>& a, const Vec512<c10::complex<float>>& b) {
+  auto abs_a = a.abs_2_();
+  auto abs_b = b.abs_2_();
+  auto mask = _mm512_cmp_ps_mask(abs_a, abs_b, _CMP_GT_OQ);
+  auto min = _mm512_mask_blend_ps(mask, a, b);
+  // Exploit the fact that all-ones is a NaN.
+  auto isnan = _mm512_cmp_ps_mask(abs_a, abs_b, _CMP_UNORD_Q);
+  return _mm512_castsi512_ps(_mm512_mask_set1_epi32(_mm512_castps_si512(min), isnan, -1));
+}
+
+template <>
+Vec512<c10::complex<float>> inline clamp(const Vec512<c10::complex<float>>& a, const Vec512<c10::complex<float>>& min, const Vec512<c10::complex<float>>& max) {
+  auto abs_a = a.abs_2_();
+  auto abs_min = min.abs_2_();
+  auto max_mask = _mm512_cmp_ps_mask(abs_a, abs_min, _CMP_LT_OQ);
+  auto abs_max = max.abs_2_();
+  auto min_mask = _mm512_cmp_ps_mask(abs_a, abs_max, _CMP_GT_OQ);
+  return _mm512_mask_blend_ps(min_mask, _mm512_mask_blend_ps(max_mask, a, min), max);
+}
+
+template <>
+Vec512<c10::complex<float>> inline clamp_min(const Vec512<c10::complex<float>>& a, const Vec512<c10::complex<float>>& min) {
+  auto abs_a = a.abs_2_();
+  auto abs_min = min.abs_2_();
+  auto max_mask = _mm512_cmp_ps_mask(abs_a, abs_min, _CMP_LT_OQ);
+  return _mm512_mask_blend_ps(max_mask, a, min);
+}
+
+template <>
+Vec512<c10::complex<float>> inline clamp_max(const Vec512<c10::complex<float>>& a, const Vec512<c10::complex<float>>& max) {
+  auto abs_a = a.abs_2_();
+  auto abs_max = max.abs_2_();
+  auto min_mask = _mm512_cmp_ps_mask(abs_a, abs_max, _CMP_GT_OQ);
+  return _mm512_mask_blend_ps(min_mask, a, max);
+}
+
+template <>
+Vec512<c10::complex<float>> inline operator&(const Vec512<c10::complex<float>>& a, const Vec512<c10::complex<float>>& b) {
+  return _mm512_and_ps(a, b);
+}
+
+template <>
+Vec512<c10::complex<float>> inline operator|(const Vec512<c10::complex<float>>& a, const Vec512<c10::complex<float>>& b) {
+  return _mm512_or_ps(a, b);
+}
+
+template <>
+Vec512<c10::complex<float>> inline operator^(const Vec512<c10::complex<float>>& a, const Vec512<c10::complex<float>>& b) {
+  return _mm512_xor_ps(a, b);
+}
+
+Vec512<c10::complex<float>> Vec512<c10::complex<float>>::eq(
+    const Vec512<c10::complex<float>>& other) const {
+  return (*this == other) & Vec512<c10::complex<float>>(_mm512_set1_ps(1.0));
+}
+
+Vec512<c10::complex<float>> Vec512<c10::complex<float>>::ne(
+    const Vec512<c10::complex<float>>& other) const {
+  return (*this != other) & Vec512<c10::complex<float>>(_mm512_set1_ps(1.0));
+}
+
+#endif
+
+}}}
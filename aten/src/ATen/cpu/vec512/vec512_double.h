@@ -0,0 +1,363 @@
+#pragma once
+
+// DO NOT DEFINE STATIC DATA IN THIS HEADER!
+// See Note [Do not compile initializers with AVX]
+
+#include <ATen/cpu/vec256/intrinsics.h>
+#include <ATen/cpu/vec512/vec512_base.h>
+#if defined(CPU_CAPABILITY_AVX512) && !defined(_MSC_VER)
+#include <sleef.h>
+#endif
+
+namespace at {
+namespace vec512 {
+// See Note [Acceptable use of anonymous namespace in header]
+namespace {
+
+#if defined(CPU_CAPABILITY_AVX512) && !defined(_MSC_VER)
+
+template <> class Vec512<double> {
+private:
+  __m512d values;
+  // AVX512 comparisons produce a k-mask; expand it to the all-ones lanes the
+  // Vec256 API promises.
+  static inline __m512d mask_to_vec(__mmask8 mask) {
+    return _mm512_castsi512_pd(
+        _mm512_mask_set1_epi64(_mm512_setzero_si512(), mask, -1));
+  }
+public:
+  using value_type = double;
+  static constexpr int size() {
+    return 8;
+  }
+  Vec512() {}
+  Vec512(__m512d v) : values(v) {}
+  Vec512(double val) {
+    values = _mm512_set1_pd(val);
+  }
+  Vec512(double val1, double val2, double val3, double val4,
+         double val5, double val6, double val7, double val8) {
+    values = _mm512_setr_pd(val1, val2, val3, val4, val5, val6, val7, val8);
+  }
+  operator __m512d() const {
+    return values;
+  }
+  template <int64_t mask>
+  static Vec512<double> blend(const Vec512<double>& a, const Vec512<double>& b) {
+    return _mm512_mask_blend_pd(static_cast<__mmask8>(mask), a.values, b.values);
+  }
+  static Vec512<double> blendv(const Vec512<double>& a, const Vec512<double>& b,
+                               const Vec512<double>& mask) {
+    // Like _mm256_blendv_pd, only the sign bit of each mask lane is used.
+    auto mmask = _mm512_movepi64_mask(_mm512_castpd_si512(mask.values));
+    return _mm512_mask_blend_pd(mmask, a.values, b.values);
+  }
+  template<typename step_t>
+  static Vec512<double> arange(double base = 0., step_t step = static_cast<step_t>(1)) {
+    return Vec512<double>(
+      base,            base +     step, base + 2 * step, base + 3 * step,
+      base + 4 * step, base + 5 * step, base + 6 * step, base + 7 * step);
+  }
+  static Vec512<double> set(const Vec512<double>& a, const Vec512<double>& b,
+                            int64_t count = size()) {
+    if (count >= size()) {
+      return b;
+    }
+    __mmask8 mask = (1ULL << count) - 1;
+    return _mm512_mask_blend_pd(mask, a.values, b.values);
+  }
+  static Vec512<double> loadu(const void* ptr, int64_t count = size()) {
+    if (count == size())
+      return _mm512_loadu_pd(reinterpret_cast<const double*>(ptr));
+    // Masked-off lanes are zeroed and never touch memory, so a partial load
+    // can neither fault nor pick up uninitialized values (see
+    // https://github.com/pytorch/pytorch/issues/32502).
+    __mmask8 mask = (1ULL << count) - 1;
+    return _mm512_maskz_loadu_pd(mask, ptr);
+  }
+  void store(void* ptr, int64_t count = size()) const {
+    if (count == size()) {
+      _mm512_storeu_pd(reinterpret_cast<double*>(ptr), values);
+    } else if (count > 0) {
+      __mmask8 mask = (1ULL << count) - 1;
+      _mm512_mask_storeu_pd(reinterpret_cast<double*>(ptr), mask, values);
+    }
+  }
+  const double& operator[](int idx) const  = delete;
+  double& operator[](int idx) = delete;
+  int zero_mask() const {
+    // returns an integer mask where all zero elements are translated to 1-bit and others are translated to 0-bit
+    return _mm512_cmp_pd_mask(values, _mm512_setzero_pd(), _CMP_EQ_OQ);
+  }
+  Vec512<double> map(double (*f)(double)) const {
+    __at_align64__ double tmp[size()];
+    store(tmp);
+    for (int64_t i = 0; i < size(); i++) {
+      tmp[i] = f(tmp[i]);
+    }
+    return loadu(tmp);
+  }
+  Vec512<double> abs() const {
+    auto mask = _mm512_set1_pd(-0.);
+    return _mm512_andnot_pd(mask, values);
+  }
+  Vec512<double> angle() const {
+    return _mm512_set1_pd(0);
+  }
+  Vec512<double> real() const {
+    return *this;
+  }
+  Vec512<double> imag() const {
+    return _mm512_set1_pd(0);
+  }
+  Vec512<double> conj() const {
+    return *this;
+  }
+  Vec512<double> acos() const {
+    return Vec512<double>(Sleef_acosd8_u10(values));
+  }
+  Vec512<double> asin() const {
+    return Vec512<double>(Sleef_asind8_u10(values));
+  }
+  Vec512<double> atan() const {
+    return Vec512<double>(Sleef_atand8_u10(values));
+  }
+  Vec512<double> atan2(const Vec512<double> &b) const {
+    return Vec512<double>(Sleef_atan2d8_u10(values, b));
+  }
+  Vec512<double> erf() const {
+    return Vec512<double>(Sleef_erfd8_u10(values));
+  }
+  Vec512<double> erfc() const {
+    return Vec512<double>(Sleef_erfcd8_u15(values));
+  }
+  Vec512<double> erfinv() const {
+    return map(calc_erfinv);
+  }
+  Vec512<double> exp() const {
+    return Vec512<double>(Sleef_expd8_u10(values));
+  }
+  Vec512<double> expm1() const {
+    return Vec512<double>(Sleef_expm1d8_u10(values));
+  }
+  Vec512<double> fmod(const Vec512<double>& q) const {
+    return Vec512<double>(Sleef_fmodd8(values, q));
+  }
+  Vec512<double> log() const {
+    return Vec512<double>(Sleef_logd8_u10(values));
+  }
+  Vec512<double> log2() const {
+    return Vec512<double>(Sleef_log2d8_u10(values));
+  }
+  Vec512<double> log10() const {
+    return Vec512<double>(Sleef_log10d8_u10(values));
+  }
+  Vec512<double> log1p() const {
+    return Vec512<double>(Sleef_log1pd8_u10(values));
+  }
+  Vec512<double> frac() const;
+  Vec512<double> sin() const {
+    return Vec512<double>(Sleef_sind8_u10(values));
+  }
+  Vec512<double> sinh() const {
+    return Vec512<double>(Sleef_sinhd8_u10(values));
+  }
+  Vec512<double> cos() const {
+    return Vec512<double>(Sleef_cosd8_u10(values));
+  }
+  Vec512<double> cosh() const {
+    return Vec512<double>(Sleef_coshd8_u10(values));
+  }
+  Vec512<double> ceil() const {
+    return _mm512_roundscale_pd(values, (_MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC));
+  }
+  Vec512<double> floor() const {
+    return _mm512_roundscale_pd(values, (_MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC));
+  }
+  Vec512<double> neg() const {
+    return _mm512_xor_pd(_mm512_set1_pd(-0.), values);
+  }
+  Vec512<double> round() const {
+    return _mm512_roundscale_pd(values, (_MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+  }
+  Vec512<double> tan() const {
+    return Vec512<double>(Sleef_tand8_u10(values));
+  }
+  Vec512<double> tanh() const {
+    return Vec512<double>(Sleef_tanhd8_u10(values));
+  }
+  Vec512<double> trunc() const {
+    return _mm512_roundscale_pd(values, (_MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));
+  }
+  Vec512<double> lgamma() const {
+    return Vec512<double>(Sleef_lgammad8_u10(values));
+  }
+  Vec512<double> sqrt() const {
+    return _mm512_sqrt_pd(values);
+  }
+  Vec512<double> reciprocal() const {
+    return _mm512_div_pd(_mm512_set1_pd(1), values);
+  }
+  Vec512<double> rsqrt() const {
+    return _mm512_div_pd(_mm512_set1_pd(1), _mm512_sqrt_pd(values));
+  }
+  Vec512<double> pow(const Vec512<double> &b) const {
+    return Vec512<double>(Sleef_powd8_u10(values, b));
+  }
+  // Comparison using the _CMP_**_OQ predicate.
+  //   `O`: get false if an operand is NaN
+  //   `Q`: do not raise if an operand is NaN
+  Vec512<double> operator==(const Vec512<double>& other) const {
+    return mask_to_vec(_mm512_cmp_pd_mask(values, other.values, _CMP_EQ_OQ));
+  }
+
+  Vec512<double> operator!=(const Vec512<double>& other) const {
+    return mask_to_vec(_mm512_cmp_pd_mask(values, other.values, _CMP_NEQ_OQ));
+  }
+
+  Vec512<double> operator<(const Vec512<double>& other) const {
+    return mask_to_vec(_mm512_cmp_pd_mask(values, other.values, _CMP_LT_OQ));
+  }
+
+  Vec512<double> operator<=(const Vec512<double>& other) const {
+    return mask_to_vec(_mm512_cmp_pd_mask(values, other.values, _CMP_LE_OQ));
+  }
+
+  Vec512<double> operator>(const Vec512<double>& other) const {
+    return mask_to_vec(_mm512_cmp_pd_mask(values, other.values, _CMP_GT_OQ));
+  }
+
+  Vec512<double> operator>=(const Vec512<double>& other) const {
+    return mask_to_vec(_mm512_cmp_pd_mask(values, other.values, _CMP_GE_OQ));
+  }
+
+  Vec512<double> eq(const Vec512<double>& other) const;
+  Vec512<double> ne(const Vec512<double>& other) const;
+  Vec512<double> gt(const Vec512<double>& other) const;
+  Vec512<double> ge(const Vec512<double>& other) const;
+  Vec512<double> lt(const Vec512<double>& other) const;
+  Vec512<double> le(const Vec512<double>& other) const;
+};
+
+template <>
+Vec512<double> inline operator+(const Vec512<double>& a, const Vec512<double>& b) {
+  return _mm512_add_pd(a, b);
+}
+
+template <>
+Vec512<double> inline operator-(const Vec512<double>& a, const Vec512<double>& b) {
+  return _mm512_sub_pd(a, b);
+}
+
+template <>
+Vec512<double> inline operator*(const Vec512<double>& a, const Vec512<double>& b) {
+  return _mm512_mul_pd(a, b);
+}
+
+template <>
+Vec512<double> inline operator/(const Vec512<double>& a, const Vec512<double>& b) {
+  return _mm512_div_pd(a, b);
+}
+
+// frac. Implement this here so we can use subtraction
+Vec512<double> Vec512<double>::frac() const {
+  return *this - this->trunc();
+}
+
+// Implements the IEEE 754 201X `maximum` operation, which propagates NaN if
+// either input is a NaN.
+template <>
+Vec512<double> inline maximum(const Vec512<double>& a, const Vec512<double>& b) {
+  __m512d max = _mm512_max_pd(a, b);
+  __mmask8 isnan = _mm512_cmp_pd_mask(a, b, _CMP_UNORD_Q);
+  // Exploit the fact that all-ones is a NaN.
+  return _mm512_castsi512_pd(_mm512_mask_set1_epi64(
+      _mm512_castpd_si512(max), isnan, -1));
+}
+
+// Implements the IEEE 754 201X `minimum` operation, which propagates NaN if
+// either input is a NaN.
+template <>
+Vec512<double> inline minimum(const Vec512<double>& a, const Vec512<double>& b) {
+  __m512d min = _mm512_min_pd(a, b);
+  __mmask8 isnan = _mm512_cmp_pd_mask(a, b, _CMP_UNORD_Q);
+  // Exploit the fact that all-ones is a NaN.
+  return _mm512_castsi512_pd(_mm512_mask_set1_epi64(
+      _mm512_castpd_si512(min), isnan, -1));
+}
+
+template <>
+Vec512<double> inline clamp(const Vec512<double>& a, const Vec512<double>& min, const Vec512<double>& max) {
+  return _mm512_min_pd(max, _mm512_max_pd(min, a));
+}
+
+template <>
+Vec512<double> inline clamp_max(const Vec512<double>& a, const Vec512<double>& max) {
+  return _mm512_min_pd(max, a);
+}
+
+template <>
+Vec512<double> inline clamp_min(const Vec512<double>& a, const Vec512<double>& min) {
+  return _mm512_max_pd(min, a);
+}
+
+template <>
+Vec512<double> inline operator&(const Vec512<double>& a, const Vec512<double>& b) {
+  return _mm512_and_pd(a, b);
+}
+
+template <>
+Vec512<double> inline operator|(const Vec512<double>& a, const Vec512<double>& b) {
+  return _mm512_or_pd(a, b);
+}
+
+template <>
+Vec512<double> inline operator^(const Vec512<double>& a, const Vec512<double>& b) {
+  return _mm512_xor_pd(a, b);
+}
+
+Vec512<double> Vec512<double>::eq(const Vec512<double>& other) const {
+  return (*this == other) & Vec512<double>(1.0);
+}
+
+Vec512<double> Vec512<double>::ne(const Vec512<double>& other) const {
+  return (*this != other) & Vec512<double>(1.0);
+}
+
+Vec512<double> Vec512<double>::gt(const Vec512<double>& other) const {
+  return (*this > other) & Vec512<double>(1.0);
+}
+
+Vec512<double> Vec512<double>::ge(const Vec512<double>& other) const {
+  return (*this >= other) & Vec512<double>(1.0);
+}
+
+Vec512<double> Vec512<double>::lt(const Vec512<double>& other) const {
+  return (*this < other) & Vec512<double>(1.0);
+}
+
+Vec512<double> Vec512<double>::le(const Vec512<double>& other) const {
+  return (*this <= other) & Vec512<double>(1.0);
+}
+
+template <>
+inline void convert(const double* src, double* dst, int64_t n) {
+  int64_t i;
+#pragma unroll
+  for (i = 0; i <= (n - Vec512<double>::size()); i += Vec512<double>::size()) {
+    _mm512_storeu_pd(dst + i, _mm512_loadu_pd(src + i));
+  }
+#pragma unroll
+  for (; i < n; i++) {
+    dst[i] = src[i];
+  }
+}
+
+template <>
+Vec512<double> inline fmadd(const Vec512<double>& a, const Vec512<double>& b, const Vec512<double>& c) {
+  return _mm512_fmadd_pd(a, b, c);
+}
+
+#endif
+
+}}}
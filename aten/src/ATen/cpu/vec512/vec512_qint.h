@@ -0,0 +1,480 @@
+#pragma once
+
+// DO NOT DEFINE STATIC DATA IN THIS HEADER!
+// See Note [Do not compile initializers with AVX]
+
+#include <ATen/cpu/vec256/intrinsics.h>
+#include <ATen/cpu/vec512/vec512_base.h>
+#include <ATen/cpu/vec512/vec512_float.h>
+#include <ATen/native/quantized/affine_quantizer.h>
+#include <c10/util/qint32.h>
+#include <c10/util/qint8.h>
+#include <c10/util/quint8.h>
+
+#include <array>
+
+// This file defines Vec512<> for the quantized types.
+//
+// Unlike Vec256, there are no hand-written AVX512 integer paths yet: the
+// quantized types are portable converters between the quantized
+// representation and Vec512<float>, so dequantize -> float math -> quantize
+// pipelines still run their floating-point part 16 lanes wide.
+//
+// Conversions are as follows:
+//  Vec512<qint8> -> 4x Vec512<float>
+//  Vec512<quint8> -> 4x Vec512<float>
+//  Vec512<qint32> -> 1x Vec512<float>
+//
+// See ATen/cpu/vec256/vec256_qint.h for the meaning of float_num_vecs,
+// float_vec_return_type and int_vec_return_type.
+
+namespace at {
+namespace vec512 {
+namespace {
+
+template <
+    typename T,
+    typename float_vec_return_type_,
+    typename int_vec_return_type_,
+    int size_>
+struct Vec512QuantizedConverter {
+  static constexpr int size() {
+    return size_;
+  }
+
+  static constexpr int float_num_vecs() {
+    return size() / 16;
+  }
+
+  static constexpr int int_num_vecs() {
+    return size() / 16;
+  }
+
+  using float_vec_return_type = float_vec_return_type_;
+  using int_vec_return_type = int_vec_return_type_;
+
+  using value_type = typename T::underlying;
+  std::array<value_type, size_> vals;
+
+  Vec512QuantizedConverter(T val) {
+    for (size_t i = 0; i < size(); ++i) {
+      vals[i] = val.val_;
+    }
+  }
+
+  Vec512QuantizedConverter(const void* ptr) {
+    memcpy(vals.data(), ptr, sizeof(value_type) * size());
+  }
+
+  void store(void* ptr, int count = size()) const {
+    memcpy(ptr, vals.data(), count * sizeof(value_type));
+  }
+
+  float_vec_return_type dequantize(
+      Vec512<float> scale,
+      Vec512<float> zero_point,
+      Vec512<float> scale_zp_premul) const {
+    // Vec512<float> is not indexable when it wraps __m512, so go through
+    // plain arrays.
+    __at_align64__ float scale_arr[16];
+    __at_align64__ float zero_point_arr[16];
+    __at_align64__ float out_arr[16];
+    scale.store(scale_arr);
+    zero_point.store(zero_point_arr);
+    float_vec_return_type rv;
+    for (int i = 0; i < float_num_vecs(); ++i) {
+      for (int j = 0; j < 16; ++j) {
+        out_arr[j] = at::native::dequantize_val<T>(
+            scale_arr[j], zero_point_arr[j], T(vals[16 * i + j]));
+      }
+      rv[i] = Vec512<float>::loadu(out_arr);
+    }
+    return rv;
+  }
+
+  void dump() const {
+      for (int i = 0; i < size(); ++i) {
+          std::cout << vals[i] << " ";
+      }
+      std::cout << std::endl;
+  }
+
+ protected:
+  Vec512QuantizedConverter() {}
+};
+
+template <>
+struct Vec512<c10::qint32> : public Vec512QuantizedConverter<
+                                 c10::qint32,
+                                 std::array<Vec512<float>, 1>,
+                                 std::array<Vec512<c10::qint32>, 1>,
+                                 16> {
+  Vec512()
+      : Vec512QuantizedConverter<
+            c10::qint32,
+            std::array<Vec512<float>, 1>,
+            std::array<Vec512<c10::qint32>, 1>,
+            16>() {}
+  Vec512(c10::qint32 val)
+      : Vec512QuantizedConverter<
+            c10::qint32,
+            std::array<Vec512<float>, 1>,
+            std::array<Vec512<c10::qint32>, 1>,
+            16>(val) {}
+  Vec512(const void* ptr)
+      : Vec512QuantizedConverter<
+            c10::qint32,
+            std::array<Vec512<float>, 1>,
+            std::array<Vec512<c10::qint32>, 1>,
+            16>(ptr) {}
+
+  static Vec512<c10::qint32> loadu(const void* ptr) {
+    return Vec512<c10::qint32>(ptr);
+  }
+
+  static Vec512<c10::qint32> quantize(
+      const float_vec_return_type& rhs,
+      float scale,
+      int32_t zero_point,
+      float inverse_scale) {
+    std::array<value_type, size()> qvals;
+    std::array<float, float_num_vecs() * 16> float_vals;
+
+    for (int i = 0; i < float_num_vecs(); ++i) {
+      rhs[i].store(&float_vals[i * 16], 16);
+    }
+
+    at::native::quantize_vec<c10::qint32, /*precision=*/32>(
+        scale,
+        zero_point,
+        float_vals.data(),
+        (c10::qint32*)qvals.data(),
+        16 * float_num_vecs());
+
+    return Vec512<c10::qint32>::loadu(qvals.data());
+  }
+
+  Vec512<c10::qint32> maximum(Vec512<c10::qint32> b) const {
+    Vec512<c10::qint32> retval;
+    for (size_t i = 0; i < size(); ++i) {
+      retval.vals[i] = std::max<value_type>(vals[i], b.vals[i]);
+    }
+    return retval;
+  }
+
+  Vec512<c10::qint32> minimum(Vec512<c10::qint32> b) const {
+    Vec512<c10::qint32> retval;
+    for (size_t i = 0; i < size(); ++i) {
+      retval.vals[i] = std::min<value_type>(vals[i], b.vals[i]);
+    }
+    return retval;
+  }
+
+  Vec512<c10::qint32> relu(Vec512<c10::qint32> zero_point) const  {
+    return maximum(zero_point);
+  }
+
+
+  Vec512<c10::qint32> relu6(
+      Vec512<c10::qint32> zero_point,
+      Vec512<c10::qint32> q_six) {
+    Vec512<c10::qint32> retval;
+    for (size_t i = 0; i < size(); ++i) {
+      retval.vals[i] = std::min<value_type>(
+          std::max<value_type>(vals[i], zero_point.vals[i]), q_six.vals[i]);
+    }
+    return retval;
+  }
+
+  int_vec_return_type widening_subtract(Vec512<c10::qint32> b) const {
+    int_vec_return_type retval;
+    for (size_t i = 0; i < size(); ++i) {
+      retval[0].vals[i] = vals[i] - b.vals[i];
+    }
+    return retval;
+  }
+
+  static Vec512<c10::qint32> requantize_from_int(
+      const int_vec_return_type& inp,
+      float multiplier,
+      int32_t zero_point) {
+    Vec512<c10::qint32> retval;
+    for (size_t i = 0; i < size(); ++i) {
+      retval.vals[i] =
+          nearbyint(static_cast<float>(inp[0].vals[i]) * multiplier) +
+          zero_point;
+    }
+    return retval;
+  }
+};
+
+template <>
+Vec512<c10::qint32> inline maximum(const Vec512<c10::qint32>& a, const Vec512<c10::qint32>& b) {
+  return a.maximum(b);
+}
+
+template <>
+Vec512<c10::qint32> inline operator*(
+    const Vec512<c10::qint32>& a,
+    const Vec512<c10::qint32>& b) {
+  Vec512<c10::qint32> retval;
+  for (size_t i = 0; i < std::decay_t<decltype(a)>::size(); ++i) {
+    retval.vals[i] = a.vals[i] * b.vals[i];
+  }
+  return retval;
+}
+
+template <>
+Vec512<c10::qint32> inline operator+(
+    const Vec512<c10::qint32>& a,
+    const Vec512<c10::qint32>& b) {
+  Vec512<c10::qint32> retval;
+  for (size_t i = 0; i < std::decay_t<decltype(a)>::size(); ++i) {
+    retval.vals[i] = a.vals[i] + b.vals[i];
+  }
+  return retval;
+}
+
+template <>
+struct Vec512<c10::qint8> : public Vec512QuantizedConverter<
+                                c10::qint8,
+                                std::array<Vec512<float>, 4>,
+                                std::array<Vec512<c10::qint32>, 4>,
+                                64> {
+  Vec512()
+      : Vec512QuantizedConverter<
+            c10::qint8,
+            std::array<Vec512<float>, 4>,
+            std::array<Vec512<c10::qint32>, 4>,
+            64>() {}
+  Vec512(c10::qint8 val)
+      : Vec512QuantizedConverter<
+            c10::qint8,
+            std::array<Vec512<float>, 4>,
+            std::array<Vec512<c10::qint32>, 4>,
+            64>(val) {}
+  Vec512(const void* ptr)
+      : Vec512QuantizedConverter<
+            c10::qint8,
+            std::array<Vec512<float>, 4>,
+            std::array<Vec512<c10::qint32>, 4>,
+            64>(ptr) {}
+
+  static Vec512<c10::qint8> loadu(const void* ptr) {
+    return Vec512<c10::qint8>(ptr);
+  }
+
+  static Vec512<c10::qint8> quantize(
+      const float_vec_return_type& rhs,
+      float scale,
+      int32_t zero_point,
+      float inverse_scale) {
+    std::array<value_type, size()> qvals;
+    std::array<float, float_num_vecs() * 16> float_vals;
+
+    for (int i = 0; i < float_num_vecs(); ++i) {
+      rhs[i].store(&float_vals[i * 16], 16);
+    }
+
+    at::native::quantize_vec<c10::qint8>(
+        scale,
+        zero_point,
+        float_vals.data(),
+        (c10::qint8*)qvals.data(),
+        16 * float_num_vecs());
+
+    return Vec512<c10::qint8>::loadu(qvals.data());
+  }
+
+  Vec512<c10::qint8> maximum(Vec512<c10::qint8> b) const {
+    Vec512<c10::qint8> retval;
+    for (size_t i = 0; i < size(); ++i) {
+      retval.vals[i] = std::max<value_type>(vals[i], b.vals[i]);
+    }
+    return retval;
+  }
+
+  Vec512<c10::qint8> minimum(Vec512<c10::qint8> b) const {
+    Vec512<c10::qint8> retval;
+    for (size_t i = 0; i < size(); ++i) {
+      retval.vals[i] = std::min<value_type>(vals[i], b.vals[i]);
+    }
+    return retval;
+  }
+
+  Vec512<c10::qint8> relu(Vec512<c10::qint8> zero_point) const {
+    return maximum(zero_point);
+  }
+
+  Vec512<c10::qint8> relu6(
+      Vec512<c10::qint8> zero_point,
+      Vec512<c10::qint8> q_six) {
+    Vec512<c10::qint8> retval;
+    for (size_t i = 0; i < size(); ++i) {
+      retval.vals[i] = std::min<value_type>(
+          std::max<value_type>(vals[i], zero_point.vals[i]), q_six.vals[i]);
+    }
+    return retval;
+  }
+
+  int_vec_return_type widening_subtract(Vec512<c10::qint8> b) const {
+    int_vec_return_type retval;
+    constexpr int elem_per_int_vec = size() / int_num_vecs();
+    for (size_t i = 0; i < int_num_vecs(); ++i) {
+      for (size_t j = 0; j < elem_per_int_vec; ++j) {
+        retval[i].vals[j] =
+            static_cast<int32_t>(vals[i * elem_per_int_vec + j]) -
+            static_cast<int32_t>(b.vals[i * elem_per_int_vec + j]);
+      }
+    }
+    return retval;
+  }
+  static Vec512<c10::qint8> requantize_from_int(
+      const int_vec_return_type& inp,
+      float multiplier,
+      int32_t zero_point) {
+    constexpr int elem_per_int_vec = size() / int_num_vecs();
+    constexpr auto min_val = std::numeric_limits<value_type>::min();
+    constexpr auto max_val = std::numeric_limits<value_type>::max();
+    Vec512<c10::qint8> retval;
+    for (size_t i = 0; i < int_num_vecs(); ++i) {
+      for (size_t j = 0; j < elem_per_int_vec; ++j) {
+        int32_t rounded =
+            nearbyint(static_cast<float>(inp[i].vals[j]) * multiplier) +
+            zero_point;
+        retval.vals[i * elem_per_int_vec + j] =
+            std::min<int32_t>(std::max<int32_t>(rounded, min_val), max_val);
+      }
+    }
+    return retval;
+  }
+};
+
+template <>
+Vec512<c10::qint8> inline maximum(const Vec512<c10::qint8>& a, const Vec512<c10::qint8>& b) {
+  return a.maximum(b);
+}
+
+template <>
+struct Vec512<c10::quint8> : public Vec512QuantizedConverter<
+                                 c10::quint8,
+                                 std::array<Vec512<float>, 4>,
+                                 std::array<Vec512<c10::qint32>, 4>,
+                                 64> {
+  Vec512()
+      : Vec512QuantizedConverter<
+            c10::quint8,
+            std::array<Vec512<float>, 4>,
+            std::array<Vec512<c10::qint32>, 4>,
+            64>() {}
+  Vec512(c10::quint8 val)
+      : Vec512QuantizedConverter<
+            c10::quint8,
+            std::array<Vec512<float>, 4>,
+            std::array<Vec512<c10::qint32>, 4>,
+            64>(val) {}
+  Vec512(const void* ptr)
+      : Vec512QuantizedConverter<
+            c10::quint8,
+            std::array<Vec512<float>, 4>,
+            std::array<Vec512<c10::qint32>, 4>,
+            64>(ptr) {}
+
+  static Vec512<c10::quint8> loadu(const void* ptr) {
+    return Vec512<c10::quint8>(ptr);
+  }
+
+  static Vec512<c10::quint8> quantize(
+      const float_vec_return_type& rhs,
+      float scale,
+      int32_t zero_point,
+      float inverse_scale) {
+    std::array<value_type, size()> qvals;
+    std::array<float, float_num_vecs() * 16> float_vals;
+
+    for (int i = 0; i < float_num_vecs(); ++i) {
+      rhs[i].store(&float_vals[i * 16], 16);
+    }
+
+    at::native::quantize_vec<c10::quint8>(
+        scale,
+        zero_point,
+        float_vals.data(),
+        (c10::quint8*)qvals.data(),
+        16 * float_num_vecs());
+
+    return Vec512<c10::quint8>::loadu(qvals.data());
+  }
+
+  Vec512<c10::quint8> maximum(Vec512<c10::quint8> b) const {
+    Vec512<c10::quint8> retval;
+    for (size_t i = 0; i < size(); ++i) {
+      retval.vals[i] = std::max<value_type>(vals[i], b.vals[i]);
+    }
+    return retval;
+  }
+
+  Vec512<c10::quint8> minimum(Vec512<c10::quint8> b) const {
+    Vec512<c10::quint8> retval;
+    for (size_t i = 0; i < size(); ++i) {
+      retval.vals[i] = std::min<value_type>(vals[i], b.vals[i]);
+    }
+    return retval;
+  }
+
+  Vec512<c10::quint8> relu(Vec512<c10::quint8> zero_point) const {
+    return maximum(zero_point);
+  }
+
+
+  Vec512<c10::quint8> relu6(
+      Vec512<c10::quint8> zero_point,
+      Vec512<c10::quint8> q_six) {
+    Vec512<c10::quint8> retval;
+    for (size_t i = 0; i < size(); ++i) {
+      retval.vals[i] = std::min<value_type>(
+          std::max<value_type>(vals[i], zero_point.vals[i]), q_six.vals[i]);
+    }
+    return retval;
+  }
+
+  int_vec_return_type widening_subtract(Vec512<c10::quint8> b) const {
+    int_vec_return_type retval;
+    constexpr int elem_per_int_vec = size() / int_num_vecs();
+    for (size_t i = 0; i < int_num_vecs(); ++i) {
+      for (size_t j = 0; j < elem_per_int_vec; ++j) {
+        retval[i].vals[j] =
+            static_cast<int32_t>(vals[i * elem_per_int_vec + j]) -
+            static_cast<int32_t>(b.vals[i * elem_per_int_vec + j]);
+      }
+    }
+    return retval;
+  }
+  static Vec512<c10::quint8> requantize_from_int(
+      const int_vec_return_type& inp,
+      float multiplier,
+      int32_t zero_point) {
+    constexpr int elem_per_int_vec = size() / int_num_vecs();
+    constexpr auto min_val = std::numeric_limits<value_type>::min();
+    constexpr auto max_val = std::numeric_limits<value_type>::max();
+    Vec512<c10::quint8> retval;
+    for (size_t i = 0; i < int_num_vecs(); ++i) {
+      for (size_t j = 0; j < elem_per_int_vec; ++j) {
+        int32_t rounded =
+            nearbyint(static_cast<float>(inp[i].vals[j]) * multiplier) +
+            zero_point;
+        retval.vals[i * elem_per_int_vec + j] =
+            std::min<int32_t>(std::max<int32_t>(rounded, min_val), max_val);
+      }
+    }
+    return retval;
+  }
+};
+
+template <>
+Vec512<c10::quint8> inline maximum(const Vec512<c10::quint8>& a, const Vec512<c10::quint8>& b) {
+  return a.maximum(b);
+}
+
+
+}}}
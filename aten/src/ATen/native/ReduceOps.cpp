@@ -501,6 +501,44 @@ Tensor norm(const Tensor& self, Scalar p) {
   return at::native::_norm(self, p);
 }
 
+// renorm rescales the slices of self along `dim` whose p-norm exceeds
+// maxnorm. The norms of all slices are computed in one parallel reduction
+// over the other dimensions, and the scaling is a broadcasting mul.
+Tensor& renorm_out_cpu(Tensor& result, const Tensor& self, Scalar p, int64_t dim, Scalar maxnorm) {
+  TORCH_CHECK(self.dim() > 1, "renorm: need at least 2 dimensions, got ", self.dim(), " dimensions");
+  dim = maybe_wrap_dim(dim, self.dim());
+  TORCH_CHECK(p.toDouble() > 0, "renorm: non-positive-norm not supported");
+  TORCH_CHECK(at::isFloatingType(self.scalar_type()),
+              "renorm: expected a floating point tensor, but got ", self.scalar_type());
+
+  DimVector reduce_dims;
+  for (int64_t d = 0; d < self.dim(); d++) {
+    if (d != dim) {
+      reduce_dims.push_back(d);
+    }
+  }
+  // One element per slice, freshly allocated and thus contiguous.
+  auto factor = at::norm(self, p, reduce_dims, /*keepdim=*/true);
+  AT_DISPATCH_FLOATING_TYPES(self.scalar_type(), "renorm_cpu", [&] {
+    const scalar_t maxnorm_value = maxnorm.to<scalar_t>();
+    scalar_t* factor_data = factor.data_ptr<scalar_t>();
+    for (int64_t i = 0; i < factor.numel(); i++) {
+      const scalar_t norm = factor_data[i];
+      factor_data[i] = norm > maxnorm_value ? maxnorm_value / (norm + 1e-7) : scalar_t(1);
+    }
+  });
+  return at::mul_out(result, self, factor);
+}
+
+Tensor renorm_cpu(const Tensor& self, Scalar p, int64_t dim, Scalar maxnorm) {
+  Tensor result = at::empty({0}, self.options());
+  return renorm_out_cpu(result, self, p, dim, maxnorm);
+}
+
+Tensor& renorm_cpu_(Tensor& self, Scalar p, int64_t dim, Scalar maxnorm) {
+  return renorm_out_cpu(self, self, p, dim, maxnorm);
+}
+
 inline Tensor & _all(Tensor & result, TensorIterator & iter) {
   if (iter.numel() == 0) {
     result.fill_(1);
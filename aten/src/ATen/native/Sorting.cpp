@@ -303,7 +303,101 @@ Tensor median_cpu(const Tensor& self) {
   return result.view({});
 }
 
+std::tuple<Tensor&, Tensor&> sort_out_cpu_stable(
+    Tensor& values,
+    Tensor& indices,
+    const Tensor& self,
+    c10::optional<bool> stable,
+    int64_t dim_,
+    bool descending) {
+  int64_t dim = maybe_wrap_dim(dim_, self.dim(), /*wrap_scalar=*/true);
+  TORCH_CHECK(
+      self.options().type_equal(values.options()),
+      "output values must be of same type as input");
+  TORCH_CHECK(
+      indices.dtype() == kLong, "output indices must be of scalar type Long");
+  values.resize_(self.sizes());
+  indices.resize_(self.sizes());
+  if (self.numel() == 0) {
+    return std::forward_as_tuple(values, indices);
+  }
+  values.copy_(self);
+  if (self.dim() == 0) {
+    indices.zero_();
+    return std::forward_as_tuple(values, indices);
+  }
+  sort_stub(kCPU, values, indices, dim, descending, stable.value_or(false));
+  return std::forward_as_tuple(values, indices);
+}
+
+std::tuple<Tensor&, Tensor&> sort_out_cpu(
+    Tensor& values,
+    Tensor& indices,
+    const Tensor& self,
+    int64_t dim,
+    bool descending) {
+  return at::native::sort_out_cpu_stable(
+      values, indices, self, /*stable=*/false, dim, descending);
+}
+
+std::tuple<Tensor, Tensor> sort_cpu_stable(
+    const Tensor& self,
+    c10::optional<bool> stable,
+    int64_t dim,
+    bool descending) {
+  Tensor values = at::empty({0}, self.options());
+  Tensor indices = at::empty({0}, self.options().dtype(kLong));
+  at::native::sort_out_cpu_stable(
+      values, indices, self, stable, dim, descending);
+  return std::make_tuple(values, indices);
+}
+
+std::tuple<Tensor, Tensor> sort_cpu(
+    const Tensor& self,
+    int64_t dim,
+    bool descending) {
+  return at::native::sort_cpu_stable(self, /*stable=*/false, dim, descending);
+}
+
+std::tuple<Tensor&, Tensor&> _mode_out_cpu(
+    Tensor& values,
+    Tensor& indices,
+    const Tensor& self,
+    int64_t dim_,
+    bool keepdim) {
+  int64_t dim = maybe_wrap_dim(dim_, self.dim(), /*wrap_scalar=*/true);
+  TORCH_CHECK(
+      self.numel() > 0,
+      "cannot perform reduction function mode",
+      " on tensor with no elements because the operation does not have an identity");
+  _reduction_with_indices_allocate_or_resize_output(
+      values, indices, self, dim_, keepdim);
+  if (self.dim() == 0) {
+    values.copy_(self);
+    indices.zero_();
+    return std::forward_as_tuple(values, indices);
+  }
+  mode_stub(kCPU, values, indices, self, dim);
+  if (!keepdim) {
+    values.squeeze_(dim);
+    indices.squeeze_(dim);
+  }
+  return std::forward_as_tuple(values, indices);
+}
+
+std::tuple<Tensor, Tensor> _mode_cpu(
+    const Tensor& self,
+    int64_t dim,
+    bool keepdim) {
+  Tensor values = at::empty({0}, self.options());
+  Tensor indices = at::empty({0}, self.options().dtype(kLong));
+  at::native::_mode_out_cpu(values, indices, self, dim, keepdim);
+  return std::make_tuple(values, indices);
+}
+
 DEFINE_DISPATCH(topk_stub);
+DEFINE_DISPATCH(sort_stub);
+DEFINE_DISPATCH(mode_stub);
 
 } // namespace native
 } // namespace at
@@ -6,7 +6,16 @@
 namespace at { namespace native {
 
 using topk_fn = void(*)(Tensor&, Tensor&, const Tensor&, int64_t, int64_t, bool, bool);
+// Sorts `values` in place along `dim` and writes the original positions of
+// the sorted elements to `indices`.
+using sort_fn = void(*)(Tensor& values, Tensor& indices, int64_t dim, bool descending, bool stable);
+// Writes the most frequent value of every slice of `self` along `dim`, and
+// the position of its last occurrence, to `values` and `indices`, which have
+// the shape of `self` with size 1 along `dim`.
+using mode_fn = void(*)(Tensor& values, Tensor& indices, const Tensor& self, int64_t dim);
 
 DECLARE_DISPATCH(topk_fn, topk_stub);
+DECLARE_DISPATCH(sort_fn, sort_stub);
+DECLARE_DISPATCH(mode_fn, mode_stub);
 
 }} // at::native
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+namespace at { namespace native {
+
+// Writes the number of elements of `self` that fall into each of the
+// hist.size(0) equally wide bins spanning [min, max] to `hist`.
+using histc_fn = void(*)(Tensor& hist, const Tensor& self, Scalar min, Scalar max);
+
+DECLARE_DISPATCH(histc_fn, histc_stub);
+
+}} // namespace at::native
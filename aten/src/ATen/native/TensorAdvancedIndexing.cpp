@@ -57,6 +57,7 @@
 #include <ATen/native/TensorIterator.h>
 #include <ATen/native/BinaryOps.h>
 #include <ATen/native/Copy.h>
+#include <ATen/native/ReduceOpsUtils.h>
 #include <ATen/Parallel.h>
 
 #include <algorithm>
@@ -73,6 +74,11 @@ DEFINE_DISPATCH(masked_fill_stub);
 REGISTER_NO_CPU_DISPATCH(index_put_accum_stub, index_put_accum_fn);
 DEFINE_DISPATCH(masked_select_serial_stub);
 DEFINE_DISPATCH(masked_select_stub);
+DEFINE_DISPATCH(index_copy_stub);
+DEFINE_DISPATCH(index_fill_stub);
+DEFINE_DISPATCH(take_stub);
+DEFINE_DISPATCH(put_stub);
+DEFINE_DISPATCH(nonzero_stub);
 
 DEFINE_DISPATCH(gather_stub);
 DEFINE_DISPATCH(scatter_stub);
@@ -337,6 +343,48 @@ Tensor index_copy(const Tensor & self, int64_t dim, const Tensor & index, const
   return self.clone(at::MemoryFormat::Preserve).index_copy_(dim, index, source);
 }
 
+// Restrides `index` (a vector, or a scalar) to `sizes`, such that its elements
+// run along `dim` and are broadcast along all other dimensions.
+static Tensor restride_index(const Tensor& index, int64_t dim, IntArrayRef sizes) {
+  auto index_vector = index.reshape({-1});
+  std::vector<int64_t> strides(sizes.size(), 0);
+  strides[dim] = index_vector.stride(0);
+  return index_vector.as_strided(sizes, strides);
+}
+
+// index_copy_ is computed elementwise over the source tensor, with self
+// restrided to the shape of the source (stride 0 along `dim`) and the index
+// broadcast along all dimensions but `dim`. The kernel adds
+// index[...] * self.stride(dim) to the address of each element of self.
+Tensor & index_copy_cpu_(Tensor & self, int64_t dim, const Tensor & index, const Tensor & source) {
+  // Most of the error checking is done in index_copy_.
+  NoNamesGuard guard;
+  dim = maybe_wrap_dim(dim, self.dim());
+  TORCH_CHECK(self.scalar_type() == source.scalar_type(),
+              "index_copy_(): self and source expected to have the same dtype, but got (self) ",
+              self.scalar_type(), " and (source) ", source.scalar_type());
+  if (index.numel() == 0) {
+    return self;
+  }
+
+  // A scalar self or source holds a single slice.
+  auto source_nonempty = (self.dim() == 0 || source.dim() == 0) ? source.reshape({1}) : source;
+  auto self_restrided = restride_dim(self, dim, source_nonempty.sizes());
+  auto index_restrided = restride_index(index, dim, source_nonempty.sizes());
+
+  auto iter = TensorIteratorConfig()
+    .check_all_same_dtype(false)
+    .dont_resize_outputs()
+    .add_output(self_restrided)
+    .add_input(index_restrided)
+    .add_input(source_nonempty)
+    .build();
+
+  index_copy_stub(iter.device_type(), iter, dim,
+                  ensure_nonempty_size(self, dim), ensure_nonempty_stride(self, dim));
+  return self;
+}
+
 
 Tensor& index_add_cpu_(Tensor & self, int64_t dim, const Tensor & index, const Tensor & source) {
   dim = maybe_wrap_dim(dim, self.dim());
@@ -507,6 +555,34 @@ Tensor index_select_cpu_(const Tensor & self, int64_t dim, const Tensor & index)
   return index_select_out_cpu_(result, self, dim, index);
 }
 
+// Like index_copy_, but with a value instead of the source tensor. The
+// iteration runs over self restrided to index.numel() slices along `dim`.
+Tensor & index_fill_cpu_(Tensor & self, int64_t dim, const Tensor & index, Scalar value) {
+  NoNamesGuard guard;
+  dim = maybe_wrap_dim(dim, self.dim());
+  TORCH_CHECK_INDEX(index.dim() <= 1, "index_fill_(): Index is supposed to be a vector");
+  TORCH_CHECK(index.scalar_type() == ScalarType::Long, "index_fill_(): Expected dtype int64 for index");
+  if (index.numel() == 0) {
+    return self;
+  }
+
+  auto index_sizes = ensure_nonempty_vec(self.sizes().vec());
+  index_sizes[dim] = index.numel();
+  auto self_restrided = restride_dim(self, dim, index_sizes);
+  auto index_restrided = restride_index(index, dim, index_sizes);
+
+  auto iter = TensorIteratorConfig()
+    .check_all_same_dtype(false)
+    .dont_resize_outputs()
+    .add_output(self_restrided)
+    .add_input(index_restrided)
+    .build();
+
+  index_fill_stub(iter.device_type(), iter, dim,
+                  ensure_nonempty_size(self, dim), ensure_nonempty_stride(self, dim), value);
+  return self;
+}
+
 Tensor & index_fill_(Tensor & self, int64_t dim, const Tensor & index, const Tensor & source) {
   TORCH_CHECK(source.dim() == 0, "index_fill_ only supports a 0-dimensional value tensor, but got tensor "
       "with ", source.dim(), " dimension(s).");
@@ -583,6 +659,44 @@ static Tensor & masked_fill_impl_cpu(Tensor & self, const Tensor & mask, Scalar
   return self;
 }
 
+Tensor & take_out_cpu(Tensor & result, const Tensor & self, const Tensor & index) {
+  TORCH_CHECK(index.scalar_type() == ScalarType::Long, "take(): Expected dtype int64 for index");
+  TORCH_CHECK(self.scalar_type() == result.scalar_type(),
+              "take(): self and result must have the same scalar type");
+  result.resize_(index.sizes());
+  if (index.numel() == 0) {
+    return result;
+  }
+
+  auto iter = TensorIteratorConfig()
+    .check_all_same_dtype(false)
+    .dont_resize_outputs()
+    .add_output(result)
+    .add_input(index)
+    .build();
+
+  take_stub(iter.device_type(), iter, self.contiguous());
+  return result;
+}
+
+Tensor take_cpu(const Tensor & self, const Tensor & index) {
+  Tensor result = at::empty({0}, self.options());
+  return take_out_cpu(result, self, index);
+}
+
+Tensor & put_cpu_(Tensor & self, const Tensor & index, const Tensor & source, bool accumulate) {
+  TORCH_CHECK(index.scalar_type() == ScalarType::Long, "put_(): Expected dtype int64 for index");
+  TORCH_CHECK(self.scalar_type() == source.scalar_type(),
+              "put_(): self and source must have the same scalar type");
+  TORCH_CHECK(index.numel() == source.numel(),
+              "put_(): src should have the same number of elements as index");
+  if (index.numel() == 0) {
+    return self;
+  }
+  put_stub(self.device().type(), self, index.contiguous(), source.contiguous(), accumulate);
+  return self;
+}
+
 Tensor & masked_fill__cpu(Tensor& self, const Tensor & mask, Scalar value) {
   auto maybe_outnames = namedinference::broadcast_to_outnames(self, mask, "masked_fill_");
 
@@ -725,6 +839,18 @@ Tensor _gather_sparse_backward(const Tensor& self, int64_t dim, const Tensor& in
     return at::_sparse_coo_tensor_unsafe(sparse_ind, grad.reshape(-1), self.sizes());
 }
 
+Tensor & nonzero_out_cpu(Tensor & result, const Tensor & self) {
+  TORCH_CHECK(result.scalar_type() == ScalarType::Long,
+              "nonzero(): Expected dtype int64 for out, but got ", result.scalar_type());
+  nonzero_stub(self.device().type(), result, self);
+  return result;
+}
+
+Tensor nonzero_cpu(const Tensor & self) {
+  Tensor result = at::empty({0}, self.options().dtype(kLong));
+  return nonzero_out_cpu(result, self);
+}
+
 std::vector<Tensor> nonzero_numpy(const Tensor& self) {
   // special case scalar for compatibility with numpy:
   //
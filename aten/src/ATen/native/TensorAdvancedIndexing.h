@@ -16,6 +16,11 @@ using index_put_fn = void(*)(TensorIterator &, IntArrayRef indexed_sizes, IntArr
 using index_put_accum_fn = void(*)(Tensor &, TensorList , const Tensor &, bool unsafe);
 using masked_fill_fn = void(*)(TensorIterator &, Scalar scalar);
 using masked_select_fn = void(*)(TensorIterator &);
+using index_copy_fn = void(*)(TensorIterator &, int64_t dim, int64_t self_dim_size, int64_t self_dim_stride);
+using index_fill_fn = void(*)(TensorIterator &, int64_t dim, int64_t self_dim_size, int64_t self_dim_stride, Scalar value);
+using take_fn = void(*)(TensorIterator &, const Tensor & input);
+using put_fn = void(*)(Tensor & self, const Tensor & index, const Tensor & source, bool accumulate);
+using nonzero_fn = void(*)(Tensor & result, const Tensor & self);
 
 using gather_fn = void (*)(Tensor & result, const Tensor & self, int64_t dim, const Tensor & index);
 using scatter_fn = void(*)(Tensor& self, int64_t dim, const Tensor& index, const Tensor& src);
@@ -28,6 +33,11 @@ DECLARE_DISPATCH(index_put_accum_fn, index_put_accum_stub);
 DECLARE_DISPATCH(masked_fill_fn, masked_fill_stub);
 DECLARE_DISPATCH(masked_select_fn, masked_select_serial_stub);
 DECLARE_DISPATCH(masked_select_fn, masked_select_stub);
+DECLARE_DISPATCH(index_copy_fn, index_copy_stub);
+DECLARE_DISPATCH(index_fill_fn, index_fill_stub);
+DECLARE_DISPATCH(take_fn, take_stub);
+DECLARE_DISPATCH(put_fn, put_stub);
+DECLARE_DISPATCH(nonzero_fn, nonzero_stub);
 
 DECLARE_DISPATCH(gather_fn, gather_stub);
 DECLARE_DISPATCH(scatter_fn, scatter_stub);
@@ -2,17 +2,26 @@
 
 #include <ATen/ATen.h>
 #include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <c10/util/flat_hash_map.h>
 
 #include <set>
 #include <tuple>
-#include <unordered_map>
-#include <unordered_set>
 
 namespace at {
 namespace native{
 
 namespace {
 
+// Mixes the bits of a hash, so that its lowest bits can pick a partition
+// independently of the bits that the hash maps use to pick a slot.
+inline uint64_t mix_hash(uint64_t h) {
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  return h;
+}
+
 template <typename scalar_t>
 std::tuple<Tensor, Tensor, Tensor> unique_cpu_template(
     const Tensor& self,
@@ -22,48 +31,138 @@ std::tuple<Tensor, Tensor, Tensor> unique_cpu_template(
   const Tensor& input = self.contiguous();
   const scalar_t* input_data = input.data_ptr<scalar_t>();
   int64_t numel = input.numel();
-  Tensor output;
   Tensor inverse_indices = at::empty({0}, self.options().dtype(kLong));
   Tensor counts = at::empty({0}, self.options().dtype(kLong));
-
-  std::unordered_set<scalar_t> set(input_data, input_data + numel);
-  output = at::empty({static_cast<int64_t>(set.size())}, input.options());
-  scalar_t *output_data = output.data_ptr<scalar_t>();
-
-  if (sorted) {
-    std::vector<scalar_t> vec(set.begin(), set.end());
-    std::sort(vec.begin(), vec.end());
-    std::copy(vec.begin(), vec.end(), output_data);
-  } else {
-    std::copy(set.begin(), set.end(), output_data);
+  int64_t* inverse_data = nullptr;
+  if (return_inverse) {
+    inverse_indices.resize_(input.sizes());
+    inverse_data = inverse_indices.data_ptr<int64_t>();
   }
 
-  if (return_inverse || return_counts) {
-    inverse_indices.resize_(input.sizes());
-    int64_t* inverse_indices_data = inverse_indices.data_ptr<int64_t>();
-    std::unordered_map<scalar_t, int64_t> inverse_map;
-    inverse_map.reserve(output.numel());
-    for (int64_t i = 0; i < output.numel(); ++i) {
-      inverse_map[output_data[i]] = i;
+  // The elements are split into partitions by their hash, so that equal
+  // elements end up in the same partition, and every partition is
+  // deduplicated by one thread with its own hash map. Within a partition,
+  // elements are visited in their original order.
+  int64_t num_partitions = 1;
+  if (numel >= at::internal::GRAIN_SIZE && !at::in_parallel_region()) {
+    while (num_partitions < 4 * at::get_num_threads()) {
+      num_partitions *= 2;
     }
-    for(int64_t i = 0; i < numel; ++i) {
-      inverse_indices_data[i] = inverse_map[input_data[i]];
+  }
+  std::hash<scalar_t> hash;
+  auto partition_of = [&](scalar_t value) -> int64_t {
+    return mix_hash(hash(value)) & (num_partitions - 1);
+  };
+
+  // Positions of the elements of every partition, stored one partition
+  // after the other.
+  std::vector<int64_t> positions;
+  std::vector<int64_t> partition_begin(num_partitions + 1, 0);
+  if (num_partitions > 1) {
+    const int64_t num_chunks = at::get_num_threads();
+    auto chunk_begin = [&](int64_t chunk) { return numel * chunk / num_chunks; };
+    std::vector<int64_t> offsets(num_chunks * num_partitions, 0);
+    at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+      for (int64_t chunk = begin; chunk < end; chunk++) {
+        int64_t* hist = offsets.data() + chunk * num_partitions;
+        for (int64_t i = chunk_begin(chunk); i < chunk_begin(chunk + 1); i++) {
+          hist[partition_of(input_data[i])]++;
+        }
+      }
+    });
+    int64_t total = 0;
+    for (int64_t p = 0; p < num_partitions; p++) {
+      partition_begin[p] = total;
+      for (int64_t chunk = 0; chunk < num_chunks; chunk++) {
+        int64_t& offset = offsets[chunk * num_partitions + p];
+        const int64_t count = offset;
+        offset = total;
+        total += count;
+      }
     }
-    if (return_counts) {
-      std::unordered_map<scalar_t, int64_t> counts_map;
-      counts_map.reserve(output.numel());
-      for (int64_t i = 0; i < output.numel(); ++i) {
-        counts_map[output_data[i]] = 0;
+    partition_begin[num_partitions] = total;
+    positions.resize(numel);
+    at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+      for (int64_t chunk = begin; chunk < end; chunk++) {
+        int64_t* offset = offsets.data() + chunk * num_partitions;
+        for (int64_t i = chunk_begin(chunk); i < chunk_begin(chunk + 1); i++) {
+          positions[offset[partition_of(input_data[i])]++] = i;
+        }
       }
-      for(int64_t i = 0; i < numel; i++) {
-        counts_map[input_data[i]] += 1;
+    });
+  } else {
+    partition_begin[1] = numel;
+  }
+
+  // Unique values of every partition in order of first occurrence, with
+  // their counts. Inverse indices are local to the partition at first.
+  std::vector<std::vector<scalar_t>> partition_values(num_partitions);
+  std::vector<std::vector<int64_t>> partition_counts(num_partitions);
+  at::parallel_for(0, num_partitions, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t p = begin; p < end; p++) {
+      ska::flat_hash_map<scalar_t, int64_t> ids;
+      auto& values = partition_values[p];
+      auto& value_counts = partition_counts[p];
+      for (int64_t j = partition_begin[p]; j < partition_begin[p + 1]; j++) {
+        const int64_t i = num_partitions > 1 ? positions[j] : j;
+        auto result = ids.emplace(input_data[i], values.size());
+        if (result.second) {
+          values.push_back(input_data[i]);
+          value_counts.push_back(0);
+        }
+        const int64_t id = result.first->second;
+        if (return_inverse) {
+          inverse_data[i] = id;
+        }
+        value_counts[id]++;
       }
-      counts.resize_(output.sizes());
-      counts.fill_(0);
-      int64_t *counts_data = counts.data_ptr<int64_t>();
-      for(int64_t i = 0; i < output.numel(); i++) {
-        counts_data[i] = counts_map[output_data[i]];
+    }
+  });
+
+  std::vector<int64_t> partition_offset(num_partitions + 1, 0);
+  for (int64_t p = 0; p < num_partitions; p++) {
+    partition_offset[p + 1] =
+        partition_offset[p] + partition_values[p].size();
+  }
+  const int64_t num_unique = partition_offset[num_partitions];
+  Tensor output = at::empty({num_unique}, input.options());
+  scalar_t* output_data = output.data_ptr<scalar_t>();
+  if (return_counts) {
+    counts.resize_({num_unique});
+  }
+  at::parallel_for(0, num_partitions, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t p = begin; p < end; p++) {
+      const int64_t offset = partition_offset[p];
+      std::copy(
+          partition_values[p].begin(),
+          partition_values[p].end(),
+          output_data + offset);
+      if (return_counts) {
+        std::copy(
+            partition_counts[p].begin(),
+            partition_counts[p].end(),
+            counts.data_ptr<int64_t>() + offset);
       }
+      if (return_inverse && offset > 0) {
+        for (int64_t j = partition_begin[p]; j < partition_begin[p + 1]; j++) {
+          inverse_data[positions[j]] += offset;
+        }
+      }
+    }
+  });
+
+  if (sorted) {
+    Tensor permutation;
+    std::tie(output, permutation) = output.sort();
+    if (return_inverse) {
+      // Position of every unique value in the sorted output.
+      Tensor rank = at::empty_like(permutation)
+          .scatter_(0, permutation, at::arange(num_unique, permutation.options()));
+      inverse_indices = rank.index_select(0, inverse_indices.view(-1))
+          .view(input.sizes());
+    }
+    if (return_counts) {
+      counts = counts.index_select(0, permutation);
     }
   }
   return std::make_tuple(output, inverse_indices, counts);
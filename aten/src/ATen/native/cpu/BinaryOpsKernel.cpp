@@ -4,6 +4,8 @@
 #include <ATen/Parallel.h>
 #include <ATen/cpu/vec256/vec256.h>
 #include <ATen/cpu/vec256/functional.h>
+#include <ATen/cpu/vec512/vec512.h>
+#include <ATen/cpu/vec512/functional.h>
 #include <ATen/native/TensorIterator.h>
 #include <ATen/native/BinaryOps.h>
 #include <ATen/native/cpu/Loops.h>
@@ -25,11 +27,11 @@ void add_kernel(TensorIterator& iter, Scalar alpha_scalar) {
   } else {
     AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND2(kBFloat16, kHalf, iter.dtype(), "add_cpu/sub_cpu", [&]() {
       auto alpha = alpha_scalar.to<scalar_t>();
-      auto alpha_vec = Vec256<scalar_t>(alpha);
+      auto alpha_vec = Vectorized<scalar_t>(alpha);
       cpu_kernel_vec(iter,
         [=](scalar_t a, scalar_t b) __ubsan_ignore_undefined__ -> scalar_t { return a + alpha * b; },
-        [=](Vec256<scalar_t> a, Vec256<scalar_t> b) __ubsan_ignore_undefined__ {
-          return vec256::fmadd(b, alpha_vec, a);
+        [=](Vectorized<scalar_t> a, Vectorized<scalar_t> b) __ubsan_ignore_undefined__ {
+          return vec::fmadd(b, alpha_vec, a);
         });
       });
   }
@@ -40,7 +42,7 @@ void atan2_kernel(TensorIterator& iter) {
     cpu_kernel_vec(iter, [=](scalar_t a, scalar_t b) -> scalar_t {
     return std::atan2(a, b);
   },
-    [=](Vec256<scalar_t> a, Vec256<scalar_t> b) {
+    [=](Vectorized<scalar_t> a, Vectorized<scalar_t> b) {
       return a.atan2(b);
     });
   });
@@ -59,7 +61,7 @@ void mul_kernel(TensorIterator& iter) {
     AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND2(kBFloat16, kHalf, iter.dtype(), "mul_cpu", [&]() {
       cpu_kernel_vec(iter,
         [=](scalar_t a, scalar_t b) -> scalar_t { return a * b; },
-        [=](Vec256<scalar_t> a, Vec256<scalar_t> b) {
+        [=](Vectorized<scalar_t> a, Vectorized<scalar_t> b) {
           return a * b;
         });
     });
@@ -82,7 +84,7 @@ void div_kernel(TensorIterator& iter) {
           [](scalar_t a, scalar_t b) __ubsan_ignore_float_divide_by_zero__ -> scalar_t {
              return a / b;
           },
-          [](Vec256<scalar_t> a, Vec256<scalar_t> b) {
+          [](Vectorized<scalar_t> a, Vectorized<scalar_t> b) {
             return a / b;
           });
       });
@@ -92,7 +94,7 @@ void div_kernel(TensorIterator& iter) {
           [=](scalar_t a, scalar_t b) __ubsan_ignore_float_divide_by_zero__ -> scalar_t {
             return a / b;
           },
-          [=](Vec256<scalar_t> a, Vec256<scalar_t> b) {
+          [=](Vectorized<scalar_t> a, Vectorized<scalar_t> b) {
             return a / b;
           });
       });
@@ -119,11 +121,11 @@ void remainder_kernel(TensorIterator& iter) {
           if ((mod != 0) && ((b < 0) != (mod < 0))) mod += b;
           return mod;
         },
-        [=](Vec256<scalar_t> a, Vec256<scalar_t> b) {
+        [=](Vectorized<scalar_t> a, Vectorized<scalar_t> b) {
           auto mod = a.fmod(b);
-          const auto zero = Vec256<scalar_t>(0);
+          const auto zero = Vectorized<scalar_t>(0);
           auto mask = (mod != zero) & ((b < zero) ^ (mod < zero));
-          return Vec256<scalar_t>::blendv(mod, mod + b, mask);
+          return Vectorized<scalar_t>::blendv(mod, mod + b, mask);
         });
     });
   }
@@ -143,7 +145,7 @@ void bitwise_and_kernel(TensorIterator& iter) {
           [](scalar_t a, scalar_t b) -> scalar_t {
             return a & b;
           },
-          [](Vec256<scalar_t> a, Vec256<scalar_t> b) {
+          [](Vectorized<scalar_t> a, Vectorized<scalar_t> b) {
             return a & b;
           });
     });
@@ -164,7 +166,7 @@ void bitwise_or_kernel(TensorIterator& iter) {
           [](scalar_t a, scalar_t b) -> scalar_t {
             return a | b;
           },
-          [](Vec256<scalar_t> a, Vec256<scalar_t> b) {
+          [](Vectorized<scalar_t> a, Vectorized<scalar_t> b) {
             return a | b;
           });
     });
@@ -187,7 +189,7 @@ void bitwise_xor_kernel(TensorIterator& iter) {
           [](scalar_t a, scalar_t b) -> scalar_t {
             return a ^ b;
           },
-          [](Vec256<scalar_t> a, Vec256<scalar_t> b) {
+          [](Vectorized<scalar_t> a, Vectorized<scalar_t> b) {
             return a ^ b;
           });
     });
@@ -197,13 +199,13 @@ void bitwise_xor_kernel(TensorIterator& iter) {
 void lshift_kernel(TensorIterator& iter) {
   if (iter.dtype() == ScalarType::Float || iter.dtype() == ScalarType::Double) {
     AT_DISPATCH_FLOATING_TYPES(iter.dtype(), "lshift_cpu", [&]() {
-      auto base_vec = Vec256<scalar_t>((scalar_t)(2));
+      auto base_vec = Vectorized<scalar_t>((scalar_t)(2));
       cpu_kernel_vec(
         iter,
         [=](scalar_t a, scalar_t b) -> scalar_t {
           return a * std::pow((scalar_t)(2), b);
         },
-        [=](Vec256<scalar_t> a, Vec256<scalar_t> b) {
+        [=](Vectorized<scalar_t> a, Vectorized<scalar_t> b) {
           return a * base_vec.pow(b);
       });
     });
@@ -280,13 +282,13 @@ void logical_xor_kernel(TensorIterator& iter) {
 void rshift_kernel(TensorIterator& iter) {
   if (iter.dtype() == ScalarType::Float || iter.dtype() == ScalarType::Double) {
     AT_DISPATCH_FLOATING_TYPES(iter.dtype(), "rshift_cpu", [&]() {
-      auto base_vec = Vec256<scalar_t>((scalar_t)(2));
+      auto base_vec = Vectorized<scalar_t>((scalar_t)(2));
       cpu_kernel_vec(
         iter,
         [=](scalar_t a, scalar_t b) -> scalar_t {
           return a / std::pow((scalar_t)(2), b);
         },
-        [=](Vec256<scalar_t> a, Vec256<scalar_t> b) {
+        [=](Vectorized<scalar_t> a, Vectorized<scalar_t> b) {
           return a / base_vec.pow(b);
       });
     });
@@ -315,7 +317,7 @@ void lt_kernel(TensorIterator& iter) {
         [](scalar_t a, scalar_t b) -> scalar_t {
           return a < b;
         },
-        [](Vec256<scalar_t> a, Vec256<scalar_t> b) -> Vec256<scalar_t> {
+        [](Vectorized<scalar_t> a, Vectorized<scalar_t> b) -> Vectorized<scalar_t> {
           return a.lt(b);
         });
       });
@@ -337,7 +339,7 @@ void le_kernel(TensorIterator& iter) {
         [](scalar_t a, scalar_t b) -> scalar_t {
           return a <= b;
         },
-        [](Vec256<scalar_t> a, Vec256<scalar_t> b) -> Vec256<scalar_t> {
+        [](Vectorized<scalar_t> a, Vectorized<scalar_t> b) -> Vectorized<scalar_t> {
           return a.le(b);
         });
       });
@@ -359,7 +361,7 @@ void gt_kernel(TensorIterator& iter) {
         [](scalar_t a, scalar_t b) -> scalar_t {
           return a > b;
         },
-        [](Vec256<scalar_t> a, Vec256<scalar_t> b) -> Vec256<scalar_t> {
+        [](Vectorized<scalar_t> a, Vectorized<scalar_t> b) -> Vectorized<scalar_t> {
           return a.gt(b);
         });
       });
@@ -381,7 +383,7 @@ void ge_kernel(TensorIterator& iter) {
         [](scalar_t a, scalar_t b) -> scalar_t {
           return a >= b;
         },
-        [](Vec256<scalar_t> a, Vec256<scalar_t> b) -> Vec256<scalar_t> {
+        [](Vectorized<scalar_t> a, Vectorized<scalar_t> b) -> Vectorized<scalar_t> {
           return a.ge(b);
         });
       });
@@ -403,7 +405,7 @@ void eq_kernel(TensorIterator& iter) {
         [](scalar_t a, scalar_t b) -> scalar_t {
           return a == b;
         },
-        [](Vec256<scalar_t> a, Vec256<scalar_t> b) -> Vec256<scalar_t> {
+        [](Vectorized<scalar_t> a, Vectorized<scalar_t> b) -> Vectorized<scalar_t> {
           return a.eq(b);
         });
       });
@@ -425,7 +427,7 @@ void ne_kernel(TensorIterator& iter) {
         [](scalar_t a, scalar_t b) -> scalar_t {
           return a != b;
         },
-        [](Vec256<scalar_t> a, Vec256<scalar_t> b) -> Vec256<scalar_t> {
+        [](Vectorized<scalar_t> a, Vectorized<scalar_t> b) -> Vectorized<scalar_t> {
           return a.ne(b);
         });
       });
@@ -442,7 +444,7 @@ void max_elementwise_kernel(TensorIterator& iter) {
     AT_DISPATCH_INTEGRAL_TYPES(iter.dtype(), "max_lementwise_cpu", [&]() {
       cpu_kernel_vec(iter,
         [](scalar_t a, scalar_t b) -> scalar_t { return std::max(a, b); },
-        [](Vec256<scalar_t> a, Vec256<scalar_t> b) { return at::vec256::maximum(a, b); });
+        [](Vectorized<scalar_t> a, Vectorized<scalar_t> b) { return vec::maximum(a, b); });
     });
   } else {
     AT_DISPATCH_FLOATING_TYPES_AND_HALF(iter.dtype(), "max_elementwise_cpu", [&]() {
@@ -454,7 +456,7 @@ void max_elementwise_kernel(TensorIterator& iter) {
             return std::max(a, b);
           }
         },
-        [](Vec256<scalar_t> a, Vec256<scalar_t> b) { return at::vec256::maximum(a, b); });
+        [](Vectorized<scalar_t> a, Vectorized<scalar_t> b) { return vec::maximum(a, b); });
     });
   }
 }
@@ -469,7 +471,7 @@ void min_elementwise_kernel(TensorIterator& iter) {
     AT_DISPATCH_INTEGRAL_TYPES(iter.dtype(), "min_elementwise_cpu", [&]() {
       cpu_kernel_vec(iter,
         [](scalar_t a, scalar_t b) -> scalar_t { return std::min(a, b); },
-        [](Vec256<scalar_t> a, Vec256<scalar_t> b) { return at::vec256::minimum(a, b); });
+        [](Vectorized<scalar_t> a, Vectorized<scalar_t> b) { return vec::minimum(a, b); });
     });
   } else {
     AT_DISPATCH_FLOATING_TYPES_AND_HALF(iter.dtype(), "min_elementwise_cpu", [&]() {
@@ -481,7 +483,7 @@ void min_elementwise_kernel(TensorIterator& iter) {
             return std::min(a, b);
           }
         },
-        [](Vec256<scalar_t> a, Vec256<scalar_t> b) { return at::vec256::minimum(a, b); });
+        [](Vectorized<scalar_t> a, Vectorized<scalar_t> b) { return vec::minimum(a, b); });
     });
   }
 }
@@ -489,7 +491,7 @@ void min_elementwise_kernel(TensorIterator& iter) {
 void smooth_l1_kernel(TensorIterator& iter) {
   AT_DISPATCH_FLOATING_TYPES_AND2(
         kBFloat16, kHalf, iter.dtype(), "smooth_l1_cpu", [&]() {
-        using Vec = Vec256<scalar_t>;
+        using Vec = Vectorized<scalar_t>;
         const Vec one_vec(static_cast<scalar_t>(1));
         const Vec point_five_vec(static_cast<scalar_t>(0.5));
         cpu_kernel_vec(
@@ -510,12 +512,12 @@ void smooth_l1_kernel(TensorIterator& iter) {
 
 void sigmoid_backward_kernel(TensorIterator& iter) {
   AT_DISPATCH_FLOATING_TYPES(iter.dtype(), "sigmoid_backward_cpu", [&]() {
-    auto one_vec = Vec256<scalar_t>((scalar_t)(1));
+    auto one_vec = Vectorized<scalar_t>((scalar_t)(1));
     cpu_kernel_vec(iter,
       [=](scalar_t a, scalar_t b) -> scalar_t {
         return a * (scalar_t(1) - b) * b;
       },
-      [=](Vec256<scalar_t> a, Vec256<scalar_t> b) {
+      [=](Vectorized<scalar_t> a, Vectorized<scalar_t> b) {
         return a * (one_vec - b) * b;
       });
   });
@@ -524,25 +526,25 @@ void sigmoid_backward_kernel(TensorIterator& iter) {
 void tanh_backward_kernel(TensorIterator& iter) {
   if (isComplexType(iter.dtype())) {
     AT_DISPATCH_COMPLEX_TYPES(iter.dtype(), "tanh_backward_cpu", [&]() {
-      auto one_vec = Vec256<scalar_t>(scalar_t{1, 0});
+      auto one_vec = Vectorized<scalar_t>(scalar_t{1, 0});
       cpu_kernel_vec(
           iter,
           [=](scalar_t a, scalar_t b) -> scalar_t {
             return a * (scalar_t{1, 0} - b * b);
           },
-          [=](Vec256<scalar_t> a, Vec256<scalar_t> b) {
+          [=](Vectorized<scalar_t> a, Vectorized<scalar_t> b) {
             return a * (one_vec - b * b);
           });
     });
   } else {
     AT_DISPATCH_FLOATING_TYPES(iter.dtype(), "tanh_backward_cpu", [&]() {
-      auto one_vec = Vec256<scalar_t>(scalar_t{1});
+      auto one_vec = Vectorized<scalar_t>(scalar_t{1});
       cpu_kernel_vec(
           iter,
           [=](scalar_t a, scalar_t b) -> scalar_t {
             return a * (scalar_t{1} - b * b);
           },
-          [=](Vec256<scalar_t> a, Vec256<scalar_t> b) {
+          [=](Vectorized<scalar_t> a, Vectorized<scalar_t> b) {
             return a * (one_vec - b * b);
           });
     });
@@ -561,7 +563,7 @@ void mse_kernel(TensorIterator& iter) {
         auto diff = a - b;
         return diff * diff;
       },
-      [=](Vec256<scalar_t> a, Vec256<scalar_t> b) {
+      [=](Vectorized<scalar_t> a, Vectorized<scalar_t> b) {
       auto diff =  a - b;
       return diff * diff;
       });
@@ -583,7 +585,7 @@ void fmod_kernel(TensorIterator& iter) {
         [](scalar_t x, scalar_t d) -> scalar_t {
           return std::fmod(x, d);
         },
-        [](Vec256<scalar_t> x, Vec256<scalar_t> d) {
+        [](Vectorized<scalar_t> x, Vectorized<scalar_t> d) {
           return x.fmod(d);
         });
       });
@@ -601,13 +603,13 @@ void fmod_scalar_kernel(TensorIterator& iter, Scalar divisor) {
   } else {
     AT_DISPATCH_FLOATING_TYPES_AND(kHalf, iter.dtype(), "fmod_scalar_cpu", [&]() {
       const auto div = divisor.to<scalar_t>();
-      const auto div_vec = Vec256<scalar_t>(div);
+      const auto div_vec = Vectorized<scalar_t>(div);
       cpu_kernel_vec(
         iter,
         [=](scalar_t x) -> scalar_t {
           return std::fmod(x, div);
         },
-        [=](Vec256<scalar_t> x) {
+        [=](Vectorized<scalar_t> x) {
           return x.fmod(div_vec);
         });
       });
@@ -627,11 +629,11 @@ void logaddexp_kernel(TensorIterator& iter) {
             return m + std::log((scalar_t)(1.0) + std::exp(-std::abs(a - b)));
           }
         },
-        [=](Vec256<scalar_t> a, Vec256<scalar_t> b) {
-          Vec256<scalar_t> inf(std::numeric_limits<scalar_t>::infinity());
-          Vec256<scalar_t> one(1.0);
-          Vec256<scalar_t> m = maximum(a, b);
-          return Vec256<scalar_t>::blendv(
+        [=](Vectorized<scalar_t> a, Vectorized<scalar_t> b) {
+          Vectorized<scalar_t> inf(std::numeric_limits<scalar_t>::infinity());
+          Vectorized<scalar_t> one(1.0);
+          Vectorized<scalar_t> m = maximum(a, b);
+          return Vectorized<scalar_t>::blendv(
               m + (one + (a - b).abs().neg().exp()).log(),
               a,
               (a == b) & (a.abs() == inf));
@@ -651,12 +653,12 @@ void logaddexp2_kernel(TensorIterator& iter) {
             return m + std::log2((scalar_t)(1.0) + std::pow((scalar_t)(2), -std::abs(a - b)));
           }
         },
-        [=](Vec256<scalar_t> a, Vec256<scalar_t> b) {
-          Vec256<scalar_t> inf(std::numeric_limits<scalar_t>::infinity());
-          Vec256<scalar_t> one(1.0);
-          Vec256<scalar_t> two(2.0);
-          Vec256<scalar_t> m = maximum(a, b);
-          return Vec256<scalar_t>::blendv(
+        [=](Vectorized<scalar_t> a, Vectorized<scalar_t> b) {
+          Vectorized<scalar_t> inf(std::numeric_limits<scalar_t>::infinity());
+          Vectorized<scalar_t> one(1.0);
+          Vectorized<scalar_t> two(2.0);
+          Vectorized<scalar_t> m = maximum(a, b);
+          return Vectorized<scalar_t>::blendv(
               m + (one + two.pow((a - b).abs().neg())).log2(),
               a,
               (a == b) & (a.abs() == inf));
@@ -1,7 +1,9 @@
 #include <ATen/native/TensorAdvancedIndexing.h>
 
 #include <cmath>
+#include <cstring>
 #include <iostream>
+#include <numeric>
 #include <ATen/Dispatch.h>
 #include <ATen/native/TensorIterator.h>
 #include <ATen/Parallel.h>
@@ -241,6 +243,221 @@ void masked_select_kernel(TensorIterator& iter) {
     });
 }
 
+// index_copy_ and index_fill_ iterate over self restrided to stride 0 along
+// `dim` and the index broadcast along all other dimensions (see
+// index_copy_cpu_). Runs of elements in the inner loop often share an index,
+// in which case it is checked once and the elements are copied in one go.
+// Elements copied to the same slice of self (duplicate indices) race, so
+// which of them ends up in self is undefined.
+static inline int64_t checked_slice_index(
+    const char* index_data, int64_t dim, int64_t self_dim_size, const char* op) {
+  int64_t idx = *(const int64_t*)index_data;
+  TORCH_CHECK_INDEX(idx >= 0 && idx < self_dim_size,
+                    op, "(): index ", idx, " is out of bounds for dimension ", dim,
+                    " with size ", self_dim_size);
+  return idx;
+}
+
+void index_copy_kernel(TensorIterator& iter, int64_t dim, int64_t self_dim_size, int64_t self_dim_stride) {
+  AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND3(at::ScalarType::Half, at::ScalarType::Bool, at::ScalarType::BFloat16,
+    iter.dtype(), "index_copy_cpu", [&] {
+    const int64_t self_dim_stride_bytes = self_dim_stride * sizeof(scalar_t);
+    auto loop = [&](char** data, const int64_t* strides, int64_t n) {
+      char* self_data = data[0];
+      char* index_data = data[1];
+      char* source_data = data[2];
+      if (strides[1] == 0) {
+        int64_t idx = checked_slice_index(index_data, dim, self_dim_size, "index_copy_");
+        char* dst = self_data + idx * self_dim_stride_bytes;
+        if (strides[0] == sizeof(scalar_t) && strides[2] == sizeof(scalar_t)) {
+          std::memcpy(dst, source_data, n * sizeof(scalar_t));
+        } else {
+          for (int64_t i = 0; i < n; i++) {
+            *(scalar_t*)(dst + strides[0] * i) = *(scalar_t*)(source_data + strides[2] * i);
+          }
+        }
+      } else {
+        for (int64_t i = 0; i < n; i++) {
+          int64_t idx = checked_slice_index(index_data + strides[1] * i, dim, self_dim_size, "index_copy_");
+          *(scalar_t*)(self_data + strides[0] * i + idx * self_dim_stride_bytes) =
+              *(scalar_t*)(source_data + strides[2] * i);
+        }
+      }
+    };
+    iter.for_each(loop);
+  });
+}
+
+void index_fill_kernel(TensorIterator& iter, int64_t dim, int64_t self_dim_size, int64_t self_dim_stride, Scalar value) {
+  AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND3(at::ScalarType::Half, at::ScalarType::Bool, at::ScalarType::BFloat16,
+    iter.dtype(), "index_fill_cpu", [&] {
+    const scalar_t fill_value = value.to<scalar_t>();
+    const int64_t self_dim_stride_bytes = self_dim_stride * sizeof(scalar_t);
+    auto loop = [&](char** data, const int64_t* strides, int64_t n) {
+      char* self_data = data[0];
+      char* index_data = data[1];
+      if (strides[1] == 0) {
+        int64_t idx = checked_slice_index(index_data, dim, self_dim_size, "index_fill_");
+        char* dst = self_data + idx * self_dim_stride_bytes;
+        if (strides[0] == sizeof(scalar_t)) {
+          std::fill_n((scalar_t*)dst, n, fill_value);
+        } else {
+          for (int64_t i = 0; i < n; i++) {
+            *(scalar_t*)(dst + strides[0] * i) = fill_value;
+          }
+        }
+      } else {
+        for (int64_t i = 0; i < n; i++) {
+          int64_t idx = checked_slice_index(index_data + strides[1] * i, dim, self_dim_size, "index_fill_");
+          *(scalar_t*)(self_data + strides[0] * i + idx * self_dim_stride_bytes) = fill_value;
+        }
+      }
+    };
+    iter.for_each(loop);
+  });
+}
+
+// take and put_ treat the indexed tensor as 1-D and accept negative indices,
+// which count from its end.
+static inline int64_t checked_linear_index(int64_t idx, int64_t numel) {
+  TORCH_CHECK_INDEX(idx >= -numel && idx < numel,
+                    "out of range: tried to access index ", idx, " on a tensor of ", numel, " elements");
+  return idx < 0 ? idx + numel : idx;
+}
+
+// Offset of the element at `linear_index` (in row-major order) of a strided
+// tensor.
+static inline int64_t linear_index_to_offset(int64_t linear_index, IntArrayRef sizes, IntArrayRef strides) {
+  int64_t offset = 0;
+  for (int64_t d = static_cast<int64_t>(sizes.size()) - 1; d >= 0; d--) {
+    offset += (linear_index % sizes[d]) * strides[d];
+    linear_index /= sizes[d];
+  }
+  return offset;
+}
+
+// `input` is contiguous.
+void take_kernel(TensorIterator& iter, const Tensor& input) {
+  AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND3(at::ScalarType::Half, at::ScalarType::Bool, at::ScalarType::BFloat16,
+    iter.dtype(), "take_cpu", [&] {
+    const scalar_t* input_data = input.data_ptr<scalar_t>();
+    const int64_t numel = input.numel();
+    auto loop = [&](char** data, const int64_t* strides, int64_t n) {
+      char* dst = data[0];
+      char* index_data = data[1];
+      for (int64_t i = 0; i < n; i++) {
+        int64_t idx = checked_linear_index(*(int64_t*)(index_data + strides[1] * i), numel);
+        *(scalar_t*)(dst + strides[0] * i) = input_data[idx];
+      }
+    };
+    iter.for_each(loop);
+  });
+}
+
+// `index` and `source` are contiguous and have the same number of elements.
+void put_kernel(Tensor& self, const Tensor& index, const Tensor& source, bool accumulate) {
+  AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND3(at::ScalarType::Half, at::ScalarType::Bool, at::ScalarType::BFloat16,
+    self.scalar_type(), "put_cpu", [&] {
+    scalar_t* self_data = self.data_ptr<scalar_t>();
+    const int64_t* index_data = index.data_ptr<int64_t>();
+    const scalar_t* source_data = source.data_ptr<scalar_t>();
+    const int64_t numel = self.numel();
+    const bool is_contiguous = self.is_contiguous();
+    auto sizes = self.sizes();
+    auto strides = self.strides();
+    auto offset = [&](int64_t i) {
+      int64_t idx = checked_linear_index(index_data[i], numel);
+      return is_contiguous ? idx : linear_index_to_offset(idx, sizes, strides);
+    };
+    if (accumulate) {
+      // Duplicate indices accumulate into the same element, so this stays
+      // serial.
+      for (int64_t i = 0; i < index.numel(); i++) {
+        self_data[offset(i)] += source_data[i];
+      }
+    } else {
+      // As with index_put_, which of several values put to the same index
+      // ends up in self is undefined.
+      at::parallel_for(0, index.numel(), internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; i++) {
+          self_data[offset(i)] = source_data[i];
+        }
+      });
+    }
+  });
+}
+
+// nonzero makes two passes over the (contiguous) input, which is split into
+// one chunk per thread. The first pass counts the nonzero elements of every
+// chunk, and a prefix sum over the counts yields the row of the result at
+// which each chunk starts. The second pass writes the coordinates, which are
+// tracked incrementally from the first element of the chunk on.
+template <typename scalar_t>
+void cpu_nonzero_kernel(Tensor& result, const Tensor& self) {
+  const int64_t numel = self.numel();
+  const int64_t ndim = self.dim();
+  const auto self_contig = self.contiguous();
+  const scalar_t* self_data = self_contig.data_ptr<scalar_t>();
+  const scalar_t zero(0);
+
+  const int64_t num_chunks = std::max<int64_t>(1,
+      std::min<int64_t>(at::get_num_threads(), divup(numel, internal::GRAIN_SIZE)));
+  const int64_t chunk_size = divup(numel, num_chunks);
+  std::vector<int64_t> chunk_offsets(num_chunks + 1, 0);
+  at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t chunk = begin; chunk < end; chunk++) {
+      const int64_t chunk_begin = chunk * chunk_size;
+      const int64_t chunk_end = std::min(numel, chunk_begin + chunk_size);
+      int64_t count = 0;
+      for (int64_t i = chunk_begin; i < chunk_end; i++) {
+        count += static_cast<int64_t>(self_data[i] != zero);
+      }
+      chunk_offsets[chunk + 1] = count;
+    }
+  });
+  std::partial_sum(chunk_offsets.begin(), chunk_offsets.end(), chunk_offsets.begin());
+
+  result.resize_({chunk_offsets[num_chunks], ndim});
+  if (result.numel() == 0) {
+    return;
+  }
+  int64_t* result_data = result.data_ptr<int64_t>();
+  const int64_t row_stride = result.stride(0);
+  const int64_t col_stride = result.stride(1);
+  const auto sizes = self.sizes();
+  at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+    std::vector<int64_t> coords(ndim);
+    for (int64_t chunk = begin; chunk < end; chunk++) {
+      const int64_t chunk_begin = chunk * chunk_size;
+      const int64_t chunk_end = std::min(numel, chunk_begin + chunk_size);
+      int64_t linear_index = chunk_begin;
+      for (int64_t d = ndim - 1; d >= 0; d--) {
+        coords[d] = linear_index % sizes[d];
+        linear_index /= sizes[d];
+      }
+      int64_t* row = result_data + chunk_offsets[chunk] * row_stride;
+      for (int64_t i = chunk_begin; i < chunk_end; i++) {
+        if (self_data[i] != zero) {
+          for (int64_t d = 0; d < ndim; d++) {
+            row[d * col_stride] = coords[d];
+          }
+          row += row_stride;
+        }
+        for (int64_t d = ndim - 1; d >= 0 && ++coords[d] == sizes[d]; d--) {
+          coords[d] = 0;
+        }
+      }
+    }
+  });
+}
+
+void nonzero_kernel(Tensor& result, const Tensor& self) {
+  AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND3(at::ScalarType::Half, at::ScalarType::Bool, at::ScalarType::BFloat16,
+    self.scalar_type(), "nonzero_cpu", [&] {
+    cpu_nonzero_kernel<scalar_t>(result, self);
+  });
+}
+
 } // anonymous namespace
 
 REGISTER_DISPATCH(index_stub, &index_kernel);
@@ -248,5 +465,10 @@ REGISTER_DISPATCH(index_put_stub, &index_put_kernel);
 REGISTER_DISPATCH(masked_fill_stub, &masked_fill_kernel);
 REGISTER_DISPATCH(masked_select_serial_stub, &masked_select_serial_kernel);
 REGISTER_DISPATCH(masked_select_stub, &masked_select_kernel);
+REGISTER_DISPATCH(index_copy_stub, &index_copy_kernel);
+REGISTER_DISPATCH(index_fill_stub, &index_fill_kernel);
+REGISTER_DISPATCH(take_stub, &take_kernel);
+REGISTER_DISPATCH(put_stub, &put_kernel);
+REGISTER_DISPATCH(nonzero_stub, &nonzero_kernel);
 
 }} // namespace at::native
@@ -20,10 +20,12 @@
 //
 //   cpu_kernel_vec(iter,
 //     [](float a, float b) { return a * b; },
-//     [](Vec256<float> a, Vec256<float> b) { return a * b; });
+//     [](Vectorized<float> a, Vectorized<float> b) { return a * b; });
 //
 // See BinaryOpsKernel.cpp for the complete implementation
 //
+// The vector width is taken from the return type of the vectorized lambda,
+// so the same loop serves Vec256 and Vec512 (see Note [Vectorized and at::vec]).
 //
 
 #include <stdint.h>
@@ -33,6 +35,7 @@
 #include <ATen/native/TensorIterator.h>
 #include <ATen/native/TensorIteratorDynamicCasting.h>
 #include <ATen/cpu/vec256/vec256.h>
+#include <ATen/cpu/vec512/vec512.h>
 
 #ifndef _MSC_VER
 #pragma GCC diagnostic push
@@ -136,7 +139,7 @@ static inline void
 vectorized_loop(char** C10_RESTRICT data_, int64_t n, int64_t S, func_t&& op, vec_func_t&& vop) {
   using traits = function_traits<vec_func_t>;
   using scalar_t = typename function_traits<func_t>::result_type;
-  using Vec = Vec256<scalar_t>;
+  using Vec = typename traits::result_type;
   constexpr int ntensors = traits::arity + 1;
 
   char* C10_RESTRICT data[ntensors];
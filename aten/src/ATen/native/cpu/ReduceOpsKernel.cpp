@@ -4,6 +4,7 @@
 
 #include <ATen/Dispatch.h>
 #include <ATen/cpu/vec256/vec256.h>
+#include <ATen/cpu/vec512/vec512.h>
 #include <ATen/native/ReduceOps.h>
 #include <ATen/native/ReduceOpsUtils.h>
 #include <ATen/native/TensorIterator.h>
@@ -129,7 +130,7 @@ static void sum_kernel_impl(TensorIterator& iter) {
       ScalarType::BFloat16, ScalarType::Half, ScalarType::Bool, iter.dtype(), "sum_cpu", [&] {
         binary_kernel_reduce_vec(
             iter, [=](scalar_t a, scalar_t b) -> scalar_t { return a + b; },
-            [=](Vec256<scalar_t> a, Vec256<scalar_t> b) { return a + b; });
+            [=](Vectorized<scalar_t> a, Vectorized<scalar_t> b) { return a + b; });
       });
 }
 
@@ -159,7 +160,7 @@ static void prod_kernel_impl(TensorIterator& iter) {
     binary_kernel_reduce_vec(
       iter,
       [=](scalar_t a, scalar_t b) -> scalar_t { return a * b; },
-      [=](Vec256<scalar_t> a, Vec256<scalar_t> b) { return a * b; },
+      [=](Vectorized<scalar_t> a, Vectorized<scalar_t> b) { return a * b; },
       /*identity=*/1);
   });
 }
@@ -232,7 +233,7 @@ static void and_kernel_impl(TensorIterator& iter) {
   binary_kernel_reduce_vec(
     iter,
     [=](uint8_t a, uint8_t b) -> uint8_t { return a && b; },
-    [=](Vec256<uint8_t> a, Vec256<uint8_t> b) {
+    [=](Vectorized<uint8_t> a, Vectorized<uint8_t> b) {
       // Adding the implementation here instead of in vec256_base to avoid
       // return value inconsistency. Other comparison operators in vec256_base
       // return -1/0 (all bit 1 / all bit 0) as true/false to follow the AVX2
@@ -243,8 +244,8 @@ static void and_kernel_impl(TensorIterator& iter) {
       //
       // In this method, users would expect, e.g., all(), to return 1/0 as
       // true/false.
-      Vec256<uint8_t> c = Vec256<uint8_t>();
-      for (int i = 0; i != Vec256<uint8_t>::size(); i++) {
+      Vectorized<uint8_t> c = Vectorized<uint8_t>();
+      for (int i = 0; i != Vectorized<uint8_t>::size(); i++) {
         c[i] = a[i] && b[i];
       }
       return c;
@@ -256,9 +257,9 @@ static void or_kernel_impl(TensorIterator& iter) {
   binary_kernel_reduce_vec(
     iter,
     [=](uint8_t a, uint8_t b) -> uint8_t { return a || b; },
-    [=](Vec256<uint8_t> a, Vec256<uint8_t> b) {
-      Vec256<uint8_t> c = Vec256<uint8_t>();
-      for (int i = 0; i != Vec256<uint8_t>::size(); i++) {
+    [=](Vectorized<uint8_t> a, Vectorized<uint8_t> b) {
+      Vectorized<uint8_t> c = Vectorized<uint8_t>();
+      for (int i = 0; i != Vectorized<uint8_t>::size(); i++) {
         c[i] = a[i] || b[i];
       }
       return c;
@@ -271,7 +272,7 @@ static void min_values_kernel_impl(TensorIterator& iter) {
     binary_kernel_reduce_vec(
       iter,
       [](scalar_t a, scalar_t b) -> scalar_t { return min_impl(a, b); },
-      [](Vec256<scalar_t> a, Vec256<scalar_t> b) { return minimum(a, b); });
+      [](Vectorized<scalar_t> a, Vectorized<scalar_t> b) { return minimum(a, b); });
   });
 }
 
@@ -280,7 +281,7 @@ static void max_values_kernel_impl(TensorIterator& iter) {
     binary_kernel_reduce_vec(
       iter,
       [](scalar_t a, scalar_t b) -> scalar_t { return max_impl(a, b); },
-      [](Vec256<scalar_t> a, Vec256<scalar_t> b) { return maximum(a, b); });
+      [](Vectorized<scalar_t> a, Vectorized<scalar_t> b) { return maximum(a, b); });
   });
 }
 
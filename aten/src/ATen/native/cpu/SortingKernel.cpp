@@ -2,13 +2,660 @@
 #include <ATen/Dispatch.h>
 #include <ATen/Parallel.h>
 #include <ATen/NumericUtils.h>
+#include <ATen/cpu/vec256/vec256.h>
 #include <ATen/native/Sorting.h>
 #include <ATen/native/SortingUtils.h>
 
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
 namespace at { namespace native {
 
 namespace {
 
+// Slices at least this long are radix sorted. Shorter ones are sorted with
+// std::sort or std::stable_sort, which have less overhead.
+constexpr int64_t kRadixSortMinSize = 256;
+// Slices at least this long are split across threads, unless there are
+// enough slices to keep all threads busy.
+constexpr int64_t kParallelRadixSortMinSize = 1 << 16;
+constexpr int kRadixBits = 8;
+constexpr int kRadixSize = 1 << kRadixBits;
+
+// Maps values to unsigned integers of the same width whose order is the
+// ascending sort order of the values, with NaN last. Only defined for the
+// types that are radix sorted.
+template <typename scalar_t, typename = void>
+struct RadixKey {
+  static constexpr bool enabled = false;
+};
+
+template <typename scalar_t>
+struct RadixKey<
+    scalar_t,
+    typename std::enable_if<
+        std::is_integral<scalar_t>::value &&
+        !std::is_same<scalar_t, bool>::value>::type> {
+  static constexpr bool enabled = true;
+  using key_t = typename std::make_unsigned<scalar_t>::type;
+
+  static key_t get(scalar_t value) {
+    constexpr key_t sign_bit = std::is_signed<scalar_t>::value
+        ? key_t(1) << (sizeof(key_t) * 8 - 1)
+        : key_t(0);
+    return static_cast<key_t>(value) ^ sign_bit;
+  }
+};
+
+template <typename scalar_t, typename bits_t>
+struct FloatRadixKey {
+  static constexpr bool enabled = true;
+  using key_t = bits_t;
+
+  static key_t get(scalar_t value) {
+    constexpr key_t sign_bit = key_t(1) << (sizeof(key_t) * 8 - 1);
+    if (_isnan(value)) {
+      return ~key_t(0);
+    }
+    // -0.0 and 0.0 compare equal, so they must get the same key.
+    if (value == 0) {
+      value = 0;
+    }
+    key_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (bits & sign_bit) ? ~bits : (bits | sign_bit);
+  }
+};
+
+template <>
+struct RadixKey<float> : FloatRadixKey<float, uint32_t> {};
+
+template <>
+struct RadixKey<double> : FloatRadixKey<double, uint64_t> {};
+
+// Stable LSD radix sort of `keys` and `idx`, using `keys_tmp` and `idx_tmp`
+// (of the same length) as scratch space. The range is split into chunks
+// that are histogrammed and scattered in parallel; scattering the chunks in
+// order keeps the sort stable. Passes in which all keys share the same digit
+// are skipped, so keys of a small range cost few passes.
+template <typename key_t>
+void radix_sort_pairs(
+    key_t* keys,
+    int64_t* idx,
+    key_t* keys_tmp,
+    int64_t* idx_tmp,
+    int64_t n) {
+  const int64_t num_chunks = at::in_parallel_region()
+      ? 1
+      : std::max<int64_t>(
+            1,
+            std::min<int64_t>(
+                at::get_num_threads(), n / kParallelRadixSortMinSize));
+  auto chunk_begin = [&](int64_t chunk) { return n * chunk / num_chunks; };
+  std::vector<int64_t> offsets(num_chunks * kRadixSize);
+
+  key_t* src_keys = keys;
+  int64_t* src_idx = idx;
+  key_t* dst_keys = keys_tmp;
+  int64_t* dst_idx = idx_tmp;
+  for (size_t shift = 0; shift < sizeof(key_t) * 8; shift += kRadixBits) {
+    std::fill(offsets.begin(), offsets.end(), 0);
+    at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+      for (int64_t chunk = begin; chunk < end; chunk++) {
+        int64_t* hist = offsets.data() + chunk * kRadixSize;
+        for (int64_t i = chunk_begin(chunk); i < chunk_begin(chunk + 1); i++) {
+          hist[(src_keys[i] >> shift) & (kRadixSize - 1)]++;
+        }
+      }
+    });
+
+    // Turn the histograms into the position of the first key of every
+    // (digit, chunk) pair.
+    int64_t total = 0;
+    bool single_digit = false;
+    for (int digit = 0; digit < kRadixSize; digit++) {
+      int64_t digit_count = 0;
+      for (int64_t chunk = 0; chunk < num_chunks; chunk++) {
+        int64_t& offset = offsets[chunk * kRadixSize + digit];
+        const int64_t count = offset;
+        offset = total;
+        total += count;
+        digit_count += count;
+      }
+      single_digit |= digit_count == n;
+    }
+    if (single_digit) {
+      continue;
+    }
+
+    at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+      for (int64_t chunk = begin; chunk < end; chunk++) {
+        int64_t* offset = offsets.data() + chunk * kRadixSize;
+        for (int64_t i = chunk_begin(chunk); i < chunk_begin(chunk + 1); i++) {
+          const int64_t pos = offset[(src_keys[i] >> shift) & (kRadixSize - 1)]++;
+          dst_keys[pos] = src_keys[i];
+          dst_idx[pos] = src_idx[i];
+        }
+      }
+    });
+    std::swap(src_keys, dst_keys);
+    std::swap(src_idx, dst_idx);
+  }
+  if (src_idx != idx) {
+    std::copy(src_idx, src_idx + n, idx);
+  }
+}
+
+// Offset of the first element of the `slice`-th slice along `dim` of `t`,
+// with the slices numbered in row-major order of the other dimensions.
+static int64_t slice_offset(const Tensor& t, int64_t dim, int64_t slice) {
+  const auto sizes = t.sizes();
+  const auto strides = t.strides();
+  int64_t offset = 0;
+  for (int64_t d = t.dim() - 1; d >= 0; d--) {
+    if (d != dim) {
+      offset += (slice % sizes[d]) * strides[d];
+      slice /= sizes[d];
+    }
+  }
+  return offset;
+}
+
+// Buffers reused across the slices sorted by one thread.
+template <typename scalar_t>
+struct SortBuffers {
+  std::vector<scalar_t> values;
+  std::vector<int64_t> indices;
+  std::vector<int64_t> indices_tmp;
+  std::vector<uint64_t> keys;
+  std::vector<std::pair<scalar_t, int64_t>> pairs;
+};
+
+template <typename scalar_t>
+void sort_slice_radix(
+    scalar_t* values,
+    int64_t values_stride,
+    int64_t* indices,
+    int64_t indices_stride,
+    int64_t n,
+    bool descending,
+    SortBuffers<scalar_t>& buffers,
+    std::true_type /* radix sortable */) {
+  using key_t = typename RadixKey<scalar_t>::key_t;
+  buffers.values.resize(n);
+  buffers.indices.resize(n);
+  buffers.indices_tmp.resize(n);
+  // uint64_t storage for up to 2 * n keys of any width.
+  buffers.keys.resize((2 * n * sizeof(key_t) + sizeof(uint64_t) - 1) /
+                      sizeof(uint64_t));
+  key_t* keys = reinterpret_cast<key_t*>(buffers.keys.data());
+  scalar_t* original = buffers.values.data();
+  int64_t* idx = buffers.indices.data();
+
+  at::parallel_for(0, n, at::internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) {
+      original[i] = values[i * values_stride];
+      const key_t key = RadixKey<scalar_t>::get(original[i]);
+      // Inverting the keys reverses the order, but keeps equal elements in
+      // their original order.
+      keys[i] = descending ? static_cast<key_t>(~key) : key;
+      idx[i] = i;
+    }
+  });
+  radix_sort_pairs(keys, idx, keys + n, buffers.indices_tmp.data(), n);
+  at::parallel_for(0, n, at::internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) {
+      values[i * values_stride] = original[idx[i]];
+      indices[i * indices_stride] = idx[i];
+    }
+  });
+}
+
+template <typename scalar_t>
+void sort_slice_radix(
+    scalar_t*,
+    int64_t,
+    int64_t*,
+    int64_t,
+    int64_t,
+    bool,
+    SortBuffers<scalar_t>&,
+    std::false_type /* radix sortable */) {
+  TORCH_INTERNAL_ASSERT(false, "radix sort is not supported for this type");
+}
+
+template <typename scalar_t>
+void sort_slice(
+    scalar_t* values,
+    int64_t values_stride,
+    int64_t* indices,
+    int64_t indices_stride,
+    int64_t n,
+    bool descending,
+    bool stable,
+    SortBuffers<scalar_t>& buffers) {
+  constexpr bool radix_sortable = RadixKey<scalar_t>::enabled;
+  if (radix_sortable && n >= kRadixSortMinSize) {
+    sort_slice_radix(
+        values,
+        values_stride,
+        indices,
+        indices_stride,
+        n,
+        descending,
+        buffers,
+        std::integral_constant<bool, radix_sortable>());
+    return;
+  }
+
+  using elem_t = std::pair<scalar_t, int64_t>;
+  auto& pairs = buffers.pairs;
+  pairs.resize(n);
+  for (int64_t i = 0; i < n; i++) {
+    pairs[i] = elem_t(values[i * values_stride], i);
+  }
+  // we want NaN to be sorted as top for numpy compatibility
+  auto sort = [&](auto comp) {
+    if (stable) {
+      std::stable_sort(pairs.begin(), pairs.end(), comp);
+    } else {
+      std::sort(pairs.begin(), pairs.end(), comp);
+    }
+  };
+  if (descending) {
+    sort([](const elem_t& x, const elem_t& y) -> bool {
+      return (_isnan(x.first) && !_isnan(y.first)) ||
+          (x.first > y.first);
+    });
+  } else {
+    sort([](const elem_t& x, const elem_t& y) -> bool {
+      return (!_isnan(x.first) && _isnan(y.first)) ||
+          (x.first < y.first);
+    });
+  }
+  for (int64_t i = 0; i < n; i++) {
+    values[i * values_stride] = pairs[i].first;
+    indices[i * indices_stride] = pairs[i].second;
+  }
+}
+
+static void sort_kernel(
+    Tensor& values,
+    Tensor& indices,
+    int64_t dim,
+    bool descending,
+    bool stable) {
+  const int64_t n = values.size(dim);
+  const int64_t num_slices = values.numel() / n;
+  const int64_t values_dim_stride = values.stride(dim);
+  const int64_t indices_dim_stride = indices.stride(dim);
+
+  AT_DISPATCH_ALL_TYPES_AND3(
+      ScalarType::Half, ScalarType::BFloat16, ScalarType::Bool,
+      values.scalar_type(), "sort_cpu", [&] {
+    scalar_t* values_data = values.data_ptr<scalar_t>();
+    int64_t* indices_data = indices.data_ptr<int64_t>();
+    auto sort_slices = [&](int64_t begin, int64_t end) {
+      SortBuffers<scalar_t> buffers;
+      for (int64_t slice = begin; slice < end; slice++) {
+        sort_slice(
+            values_data + slice_offset(values, dim, slice),
+            values_dim_stride,
+            indices_data + slice_offset(indices, dim, slice),
+            indices_dim_stride,
+            n,
+            descending,
+            stable,
+            buffers);
+      }
+    };
+
+    // Parallelize across slices if there are enough of them to keep every
+    // thread busy. Otherwise sort one slice at a time, which lets long
+    // slices be radix sorted in parallel.
+    if (num_slices >= at::get_num_threads() || n < kParallelRadixSortMinSize) {
+      at::parallel_for(
+          0,
+          num_slices,
+          std::max<int64_t>(1, at::internal::GRAIN_SIZE / n),
+          sort_slices);
+    } else {
+      sort_slices(0, num_slices);
+    }
+  });
+}
+
+// topk picks one of these strategies for every slice, based on k and the
+// slice length n:
+//  - A bounded heap holding the k best elements seen so far, for k << n.
+//    Blocks of contiguous elements that cannot beat the worst element of the
+//    heap are skipped after a vectorized max (or min), so most of the work
+//    is a streaming reduction over the slice.
+//  - Radix select for larger k: the k-th best key is found from radix digit
+//    histograms, starting with the most significant digit, after which
+//    everything that ranks before it is collected. Linear in n for any k.
+//  - Sorting the whole slice, when the result must be sorted and k is close
+//    to n, so that sorting the selection would cost about as much.
+// Long slices are split into chunks whose top k are computed in parallel and
+// then merged, if there are not enough slices to keep all threads busy.
+constexpr int64_t kHeapTopkMaxRatio = 64;
+constexpr int64_t kParallelTopkMinChunkSize = 1 << 15;
+
+template <typename scalar_t>
+struct TopkBuffers {
+  using elem_t = std::pair<scalar_t, int64_t>;
+  std::vector<elem_t> elems;
+  std::vector<elem_t> chunk_elems;
+  std::vector<uint64_t> keys;
+  std::vector<int64_t> indices;
+  std::vector<int64_t> indices_tmp;
+};
+
+// Whether `x` ranks before `y` in the output of topk. NaN is the largest
+// value, for numpy compatibility.
+template <typename scalar_t>
+inline bool topk_before(scalar_t x, scalar_t y, bool largest) {
+  return largest ? ((_isnan(x) && !_isnan(y)) || (x > y))
+                 : ((!_isnan(x) && _isnan(y)) || (x < y));
+}
+
+template <typename scalar_t>
+void topk_sort_elems(
+    std::vector<std::pair<scalar_t, int64_t>>& elems,
+    bool largest) {
+  using elem_t = std::pair<scalar_t, int64_t>;
+  std::sort(
+      elems.begin(), elems.end(), [largest](const elem_t& x, const elem_t& y) {
+        return topk_before(x.first, y.first, largest) ||
+            (!topk_before(y.first, x.first, largest) && x.second < y.second);
+      });
+}
+
+template <typename scalar_t>
+void topk_heap(
+    const scalar_t* data,
+    int64_t stride,
+    int64_t n,
+    int64_t k,
+    bool largest,
+    std::vector<std::pair<scalar_t, int64_t>>& heap) {
+  using elem_t = std::pair<scalar_t, int64_t>;
+  using Vec = vec256::Vec256<scalar_t>;
+  // The front of the heap is its worst element.
+  auto heap_comp = [largest](const elem_t& x, const elem_t& y) {
+    return topk_before(x.first, y.first, largest);
+  };
+  heap.resize(k);
+  for (int64_t i = 0; i < k; i++) {
+    heap[i] = elem_t(data[i * stride], i);
+  }
+  std::make_heap(heap.begin(), heap.end(), heap_comp);
+  auto push = [&](scalar_t value, int64_t i) {
+    if (topk_before(value, heap.front().first, largest)) {
+      std::pop_heap(heap.begin(), heap.end(), heap_comp);
+      heap.back() = elem_t(value, i);
+      std::push_heap(heap.begin(), heap.end(), heap_comp);
+    }
+  };
+
+  int64_t i = k;
+  if (stride == 1) {
+    constexpr int64_t kBlockSize = 4 * Vec::size();
+    scalar_t best[Vec::size()];
+    for (; i + kBlockSize <= n; i += kBlockSize) {
+      const scalar_t* block = data + i;
+      Vec v0 = Vec::loadu(block);
+      Vec v1 = Vec::loadu(block + Vec::size());
+      Vec v2 = Vec::loadu(block + 2 * Vec::size());
+      Vec v3 = Vec::loadu(block + 3 * Vec::size());
+      Vec reduced = largest ? maximum(maximum(v0, v1), maximum(v2, v3))
+                            : minimum(minimum(v0, v1), minimum(v2, v3));
+      reduced.store(best);
+      // maximum and minimum propagate NaN, so a NaN lane may hide other
+      // candidates and always requires a closer look.
+      const scalar_t threshold = heap.front().first;
+      bool has_candidate = false;
+      for (int64_t j = 0; j < Vec::size(); j++) {
+        has_candidate |=
+            _isnan(best[j]) || topk_before(best[j], threshold, largest);
+      }
+      if (has_candidate) {
+        for (int64_t j = 0; j < kBlockSize; j++) {
+          push(block[j], i + j);
+        }
+      }
+    }
+  }
+  for (; i < n; i++) {
+    push(data[i * stride], i);
+  }
+}
+
+template <typename scalar_t>
+void topk_radix_select(
+    const scalar_t* data,
+    int64_t stride,
+    int64_t n,
+    int64_t k,
+    bool largest,
+    TopkBuffers<scalar_t>& buffers,
+    std::true_type /* radix sortable */) {
+  using elem_t = std::pair<scalar_t, int64_t>;
+  using key_t = typename RadixKey<scalar_t>::key_t;
+  // Keys in the order of the output of topk.
+  auto get_key = [largest](scalar_t value) -> key_t {
+    const key_t key = RadixKey<scalar_t>::get(value);
+    return largest ? static_cast<key_t>(~key) : key;
+  };
+
+  // Narrow down the k-th key one digit at a time. After the first pass only
+  // the keys that share the digits found so far are kept.
+  buffers.keys.resize(
+      (n * sizeof(key_t) + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+  key_t* candidates = reinterpret_cast<key_t*>(buffers.keys.data());
+  int64_t num_candidates = 0;
+  key_t kth_key = 0;
+  int64_t remaining = k;
+  int64_t hist[kRadixSize];
+  for (int shift = sizeof(key_t) * 8 - kRadixBits; shift >= 0;
+       shift -= kRadixBits) {
+    std::fill(hist, hist + kRadixSize, 0);
+    if (num_candidates == 0) {
+      for (int64_t i = 0; i < n; i++) {
+        hist[(get_key(data[i * stride]) >> shift) & (kRadixSize - 1)]++;
+      }
+    } else {
+      for (int64_t i = 0; i < num_candidates; i++) {
+        hist[(candidates[i] >> shift) & (kRadixSize - 1)]++;
+      }
+    }
+    int digit = 0;
+    while (hist[digit] < remaining) {
+      remaining -= hist[digit];
+      digit++;
+    }
+    kth_key |= static_cast<key_t>(digit) << shift;
+
+    const int next_shift = shift - kRadixBits;
+    if (next_shift < 0) {
+      break;
+    }
+    const key_t mask = static_cast<key_t>(~key_t(0)) << shift;
+    if (num_candidates == 0) {
+      for (int64_t i = 0; i < n; i++) {
+        const key_t key = get_key(data[i * stride]);
+        if ((key & mask) == kth_key) {
+          candidates[num_candidates++] = key;
+        }
+      }
+    } else {
+      int64_t kept = 0;
+      for (int64_t i = 0; i < num_candidates; i++) {
+        if ((candidates[i] & mask) == kth_key) {
+          candidates[kept++] = candidates[i];
+        }
+      }
+      num_candidates = kept;
+    }
+  }
+
+  // `remaining` is the number of elements equal to the k-th key that belong
+  // in the output. Take the first ones.
+  auto& elems = buffers.elems;
+  elems.resize(k);
+  int64_t out = 0;
+  for (int64_t i = 0; i < n && out < k; i++) {
+    const scalar_t value = data[i * stride];
+    const key_t key = get_key(value);
+    if (key < kth_key || (key == kth_key && remaining-- > 0)) {
+      elems[out++] = elem_t(value, i);
+    }
+  }
+}
+
+template <typename scalar_t>
+void topk_radix_sort(
+    const scalar_t* data,
+    int64_t stride,
+    int64_t n,
+    int64_t k,
+    bool largest,
+    TopkBuffers<scalar_t>& buffers,
+    std::true_type /* radix sortable */) {
+  using elem_t = std::pair<scalar_t, int64_t>;
+  using key_t = typename RadixKey<scalar_t>::key_t;
+  buffers.keys.resize(
+      (2 * n * sizeof(key_t) + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+  buffers.indices.resize(n);
+  buffers.indices_tmp.resize(n);
+  key_t* keys = reinterpret_cast<key_t*>(buffers.keys.data());
+  int64_t* idx = buffers.indices.data();
+  for (int64_t i = 0; i < n; i++) {
+    const key_t key = RadixKey<scalar_t>::get(data[i * stride]);
+    keys[i] = largest ? static_cast<key_t>(~key) : key;
+    idx[i] = i;
+  }
+  radix_sort_pairs(keys, idx, keys + n, buffers.indices_tmp.data(), n);
+  auto& elems = buffers.elems;
+  elems.resize(k);
+  for (int64_t i = 0; i < k; i++) {
+    elems[i] = elem_t(data[idx[i] * stride], idx[i]);
+  }
+}
+
+template <typename scalar_t>
+void topk_radix_select(
+    const scalar_t*,
+    int64_t,
+    int64_t,
+    int64_t,
+    bool,
+    TopkBuffers<scalar_t>&,
+    std::false_type /* radix sortable */) {
+  TORCH_INTERNAL_ASSERT(false, "radix select is not supported for this type");
+}
+
+template <typename scalar_t>
+void topk_radix_sort(
+    const scalar_t*,
+    int64_t,
+    int64_t,
+    int64_t,
+    bool,
+    TopkBuffers<scalar_t>&,
+    std::false_type /* radix sortable */) {
+  TORCH_INTERNAL_ASSERT(false, "radix sort is not supported for this type");
+}
+
+// Computes the top k of a slice into buffers.elems, sorted if `sorted`.
+template <typename scalar_t>
+void topk_slice(
+    const scalar_t* data,
+    int64_t stride,
+    int64_t n,
+    int64_t k,
+    bool largest,
+    bool sorted,
+    TopkBuffers<scalar_t>& buffers) {
+  using elem_t = std::pair<scalar_t, int64_t>;
+  constexpr bool radix_sortable = RadixKey<scalar_t>::enabled;
+  using radix_tag = std::integral_constant<bool, radix_sortable>;
+  auto& elems = buffers.elems;
+  if (k * kHeapTopkMaxRatio <= n) {
+    topk_heap(data, stride, n, k, largest, elems);
+  } else if (!radix_sortable || n < kRadixSortMinSize) {
+    elems.resize(n);
+    for (int64_t i = 0; i < n; i++) {
+      elems[i] = elem_t(data[i * stride], i);
+    }
+    std::nth_element(
+        elems.begin(),
+        elems.begin() + k - 1,
+        elems.end(),
+        [largest](const elem_t& x, const elem_t& y) {
+          return topk_before(x.first, y.first, largest);
+        });
+    elems.resize(k);
+  } else if (sorted && k * 2 > n) {
+    // Already in order.
+    topk_radix_sort(data, stride, n, k, largest, buffers, radix_tag());
+    return;
+  } else {
+    topk_radix_select(data, stride, n, k, largest, buffers, radix_tag());
+  }
+  if (sorted) {
+    topk_sort_elems(elems, largest);
+  }
+}
+
+// Computes the top k of a long slice into buffers.elems, by merging the top
+// k of chunks of the slice that are processed in parallel.
+template <typename scalar_t>
+void topk_slice_parallel(
+    const scalar_t* data,
+    int64_t stride,
+    int64_t n,
+    int64_t k,
+    int64_t num_chunks,
+    bool largest,
+    bool sorted,
+    TopkBuffers<scalar_t>& buffers) {
+  using elem_t = std::pair<scalar_t, int64_t>;
+  auto chunk_begin = [&](int64_t chunk) { return n * chunk / num_chunks; };
+  std::vector<elem_t> candidates(num_chunks * k);
+  at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+    TopkBuffers<scalar_t> chunk_buffers;
+    for (int64_t chunk = begin; chunk < end; chunk++) {
+      const int64_t offset = chunk_begin(chunk);
+      topk_slice(
+          data + offset * stride,
+          stride,
+          chunk_begin(chunk + 1) - offset,
+          k,
+          largest,
+          /*sorted=*/false,
+          chunk_buffers);
+      for (int64_t i = 0; i < k; i++) {
+        const elem_t& elem = chunk_buffers.elems[i];
+        candidates[chunk * k + i] = elem_t(elem.first, elem.second + offset);
+      }
+    }
+  });
+
+  auto comp = [largest](const elem_t& x, const elem_t& y) {
+    return topk_before(x.first, y.first, largest) ||
+        (!topk_before(y.first, x.first, largest) && x.second < y.second);
+  };
+  std::nth_element(
+      candidates.begin(), candidates.begin() + k - 1, candidates.end(), comp);
+  candidates.resize(k);
+  if (sorted) {
+    std::sort(candidates.begin(), candidates.end(), comp);
+  }
+  buffers.elems = std::move(candidates);
+}
+
 static void topk_kernel(
     Tensor& values,
     Tensor& indices,
@@ -17,74 +664,173 @@ static void topk_kernel(
     int64_t dim,
     bool largest,
     bool sorted) {
+  if (k == 0 || self.numel() == 0) {
+    return;
+  }
+  const int64_t n = self.size(dim);
+  const int64_t num_slices = self.numel() / n;
+  const int64_t self_dim_stride = self.stride(dim);
+  const int64_t values_dim_stride = values.stride(dim);
+  const int64_t indices_dim_stride = indices.stride(dim);
+
+  // Chunks of a long slice are only worth processing in parallel if they
+  // hold many more elements than the k candidates each of them produces.
+  const int64_t num_chunks = std::min<int64_t>(
+      at::get_num_threads(),
+      std::min(
+          n / kParallelTopkMinChunkSize, n / (k * kHeapTopkMaxRatio + 1)));
+  const bool parallel_slice = num_chunks > 1 &&
+      num_slices < at::get_num_threads() && !at::in_parallel_region();
+
   AT_DISPATCH_ALL_TYPES(self.scalar_type(), "topk_cpu", [&] {
-    dim_apply(
-        {self, values, indices},
-        dim,
-        [&](int64_t i, TensorList tl) {
-          auto tmp_values = tl[0].accessor<scalar_t, 1>();
-          auto mode_values = tl[1].accessor<scalar_t, 1>();
-          auto mode_indices = tl[2].accessor<int64_t, 1>();
-
-          auto n = tmp_values.size(0);
-          auto use_partial_sort = k * 64 <= n;
-
-          using elem_t = std::pair<scalar_t, int64_t>;
-          std::vector<elem_t> queue(n);
-          for (int64_t j = 0; j < n; j++) {
-            queue[j].first = tmp_values[j];
-            queue[j].second = j;
-          }
-
-          // we want NaN to be sorted as top for numpy compatibility
-          if (use_partial_sort) {
-            if (largest) {
-              std::partial_sort(queue.begin(), queue.begin() + k, queue.end(),
-                [](const elem_t& x, const elem_t& y) -> bool {
-                  return ((_isnan<scalar_t>(x.first) && !_isnan<scalar_t>(y.first)) || (x.first > y.first));
-                });
-            } else {
-              std::partial_sort(queue.begin(), queue.begin() + k, queue.end(),
-                [](const elem_t& x, const elem_t& y) -> bool {
-                  return ((!_isnan<scalar_t>(x.first) && _isnan<scalar_t>(y.first)) || (x.first < y.first));
-                });
-            }
-          } else {
-            if (largest) {
-              std::nth_element(queue.begin(), queue.begin() + k - 1, queue.end(),
-                [](const elem_t& x, const elem_t& y) -> bool {
-                  return ((_isnan<scalar_t>(x.first) && !_isnan<scalar_t>(y.first)) || (x.first > y.first));
-                });
-              if (sorted) {
-                std::sort(queue.begin(), queue.begin() + k - 1,
-                  [](const elem_t& x, const elem_t& y) -> bool {
-                    return ((_isnan<scalar_t>(x.first) && !_isnan<scalar_t>(y.first)) || (x.first > y.first));
-                  });
-              }
-            } else {
-              std::nth_element(queue.begin(), queue.begin() + k -1, queue.end(),
-                [](const elem_t& x, const elem_t& y) -> bool {
-                  return ((!_isnan<scalar_t>(x.first) && _isnan<scalar_t>(y.first)) || (x.first < y.first));
-                });
-              if (sorted) {
-                std::sort(queue.begin(), queue.begin() + k -1,
-                  [](const elem_t& x, const elem_t& y) -> bool {
-                    return ((!_isnan<scalar_t>(x.first) && _isnan<scalar_t>(y.first)) || (x.first < y.first));
-                  });
-              }
-            }
-          }
-
-          for (int64_t j = 0; j < k; j++) {
-            mode_values[j] = queue[j].first;
-            mode_indices[j] = queue[j].second;
-          }
-        });
+    const scalar_t* self_data = self.data_ptr<scalar_t>();
+    scalar_t* values_data = values.data_ptr<scalar_t>();
+    int64_t* indices_data = indices.data_ptr<int64_t>();
+    auto topk_slices = [&](int64_t begin, int64_t end) {
+      TopkBuffers<scalar_t> buffers;
+      for (int64_t slice = begin; slice < end; slice++) {
+        const scalar_t* slice_data =
+            self_data + slice_offset(self, dim, slice);
+        if (parallel_slice) {
+          topk_slice_parallel(
+              slice_data,
+              self_dim_stride,
+              n,
+              k,
+              num_chunks,
+              largest,
+              sorted,
+              buffers);
+        } else {
+          topk_slice(
+              slice_data, self_dim_stride, n, k, largest, sorted, buffers);
+        }
+        scalar_t* slice_values = values_data + slice_offset(values, dim, slice);
+        int64_t* slice_indices =
+            indices_data + slice_offset(indices, dim, slice);
+        for (int64_t i = 0; i < k; i++) {
+          slice_values[i * values_dim_stride] = buffers.elems[i].first;
+          slice_indices[i * indices_dim_stride] = buffers.elems[i].second;
+        }
+      }
+    };
+
+    if (parallel_slice) {
+      topk_slices(0, num_slices);
+    } else {
+      at::parallel_for(
+          0,
+          num_slices,
+          std::max<int64_t>(1, at::internal::GRAIN_SIZE / n),
+          topk_slices);
+    }
+  });
+}
+
+// mode sorts every slice in ascending order, with NaN last and equal values
+// kept in their original order, and picks the longest run of equal values.
+// Of several equally long runs the first (smallest value) wins, and the last
+// index of the run is the position of the last occurrence of the mode.
+template <typename scalar_t>
+void mode_slice(
+    const scalar_t* data,
+    int64_t stride,
+    int64_t n,
+    scalar_t* mode_value,
+    int64_t* mode_index,
+    SortBuffers<scalar_t>& buffers) {
+  auto& original = buffers.values;
+  auto& idx = buffers.indices;
+  original.resize(n);
+  idx.resize(n);
+  for (int64_t i = 0; i < n; i++) {
+    original[i] = data[i * stride];
+    idx[i] = i;
+  }
+  if (n >= kRadixSortMinSize) {
+    using key_t = typename RadixKey<scalar_t>::key_t;
+    buffers.indices_tmp.resize(n);
+    buffers.keys.resize((2 * n * sizeof(key_t) + sizeof(uint64_t) - 1) /
+                        sizeof(uint64_t));
+    key_t* keys = reinterpret_cast<key_t*>(buffers.keys.data());
+    for (int64_t i = 0; i < n; i++) {
+      keys[i] = RadixKey<scalar_t>::get(original[i]);
+    }
+    radix_sort_pairs(keys, idx.data(), keys + n, buffers.indices_tmp.data(), n);
+  } else {
+    std::sort(idx.begin(), idx.end(), [&](int64_t i, int64_t j) {
+      const scalar_t x = original[i];
+      const scalar_t y = original[j];
+      const bool x_nan = _isnan(x);
+      const bool y_nan = _isnan(y);
+      if (x_nan || y_nan) {
+        return x_nan == y_nan ? i < j : y_nan;
+      }
+      return x < y || (x == y && i < j);
+    });
+  }
+
+  int64_t max_freq = 0;
+  int64_t freq = 0;
+  for (int64_t i = 0; i < n; i++) {
+    freq++;
+    // NaNs compare unequal, so each of them is a run of its own.
+    if (i == n - 1 || original[idx[i]] != original[idx[i + 1]]) {
+      if (freq > max_freq) {
+        *mode_value = original[idx[i]];
+        *mode_index = idx[i];
+        max_freq = freq;
+      }
+      freq = 0;
+    }
+  }
+}
+
+static void mode_kernel(
+    Tensor& values,
+    Tensor& indices,
+    const Tensor& self,
+    int64_t dim) {
+  const int64_t n = self.size(dim);
+  const int64_t num_slices = self.numel() / n;
+  const int64_t self_dim_stride = self.stride(dim);
+
+  AT_DISPATCH_ALL_TYPES(self.scalar_type(), "mode_cpu", [&] {
+    static_assert(RadixKey<scalar_t>::enabled, "mode radix sorts all types");
+    const scalar_t* self_data = self.data_ptr<scalar_t>();
+    scalar_t* values_data = values.data_ptr<scalar_t>();
+    int64_t* indices_data = indices.data_ptr<int64_t>();
+    auto mode_slices = [&](int64_t begin, int64_t end) {
+      SortBuffers<scalar_t> buffers;
+      for (int64_t slice = begin; slice < end; slice++) {
+        mode_slice(
+            self_data + slice_offset(self, dim, slice),
+            self_dim_stride,
+            n,
+            values_data + slice_offset(values, dim, slice),
+            indices_data + slice_offset(indices, dim, slice),
+            buffers);
+      }
+    };
+
+    // Same policy as sort: long slices are radix sorted in parallel, one at
+    // a time, unless there are enough slices to keep every thread busy.
+    if (num_slices >= at::get_num_threads() || n < kParallelRadixSortMinSize) {
+      at::parallel_for(
+          0,
+          num_slices,
+          std::max<int64_t>(1, at::internal::GRAIN_SIZE / n),
+          mode_slices);
+    } else {
+      mode_slices(0, num_slices);
+    }
   });
 }
 
 } // anonymous namespace
 
 REGISTER_DISPATCH(topk_stub, &topk_kernel);
+REGISTER_DISPATCH(sort_stub, &sort_kernel);
+REGISTER_DISPATCH(mode_stub, &mode_kernel);
 
 }} //at::native
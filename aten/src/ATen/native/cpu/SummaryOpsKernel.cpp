@@ -0,0 +1,64 @@
+#include <ATen/native/SummaryOps.h>
+
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace at { namespace native {
+namespace {
+
+// The input is split into chunks that are counted into histograms of their
+// own in parallel, which are summed up afterwards. Chunks hold at least as
+// many elements as there are bins, so the partial histograms never take up
+// more memory than the input. Counting in int64_t keeps the counts exact
+// beyond the range of integers that the output type can represent.
+template <typename scalar_t>
+void cpu_histc_kernel(Tensor& hist, const Tensor& self, scalar_t minval, scalar_t maxval) {
+  const int64_t nbins = hist.size(0);
+  const int64_t numel = self.numel();
+  const auto self_contig = self.contiguous();
+  const scalar_t* self_data = self_contig.data_ptr<scalar_t>();
+
+  const int64_t num_chunks = std::max<int64_t>(1, std::min<int64_t>(
+      at::get_num_threads(), numel / std::max<int64_t>(internal::GRAIN_SIZE, nbins)));
+  const int64_t chunk_size = divup(numel, num_chunks);
+  std::vector<int64_t> counts(num_chunks * nbins, 0);
+  at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t chunk = begin; chunk < end; chunk++) {
+      int64_t* chunk_counts = counts.data() + chunk * nbins;
+      const int64_t chunk_end = std::min(numel, (chunk + 1) * chunk_size);
+      for (int64_t i = chunk * chunk_size; i < chunk_end; i++) {
+        const scalar_t x = self_data[i];
+        if (x >= minval && x <= maxval) {
+          const int64_t bin = static_cast<int64_t>((x - minval) / (maxval - minval) * nbins);
+          chunk_counts[std::min(bin, nbins - 1)] += 1;
+        }
+      }
+    }
+  });
+
+  auto hist_accessor = hist.accessor<scalar_t, 1>();
+  at::parallel_for(0, nbins, internal::GRAIN_SIZE / num_chunks, [&](int64_t begin, int64_t end) {
+    for (int64_t bin = begin; bin < end; bin++) {
+      int64_t count = 0;
+      for (int64_t chunk = 0; chunk < num_chunks; chunk++) {
+        count += counts[chunk * nbins + bin];
+      }
+      hist_accessor[bin] = static_cast<scalar_t>(count);
+    }
+  });
+}
+
+void histc_kernel(Tensor& hist, const Tensor& self, Scalar min, Scalar max) {
+  AT_DISPATCH_FLOATING_TYPES(self.scalar_type(), "histc_cpu", [&] {
+    cpu_histc_kernel<scalar_t>(hist, self, min.to<scalar_t>(), max.to<scalar_t>());
+  });
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(histc_stub, &histc_kernel);
+
+}} // namespace at::native
@@ -10,6 +10,8 @@
 #include <ATen/cpu/vml.h>
 #include <ATen/cpu/vec256/vec256.h>
 #include <ATen/cpu/vec256/functional.h>
+#include <ATen/cpu/vec512/vec512.h>
+#include <ATen/cpu/vec512/functional.h>
 
 #include <ATen/native/Distributions.h>
 #include <ATen/native/TensorIterator.h>
@@ -36,10 +38,10 @@ static void sigmoid_kernel(TensorIterator& iter) {
     cpu_kernel_vec(
         iter,
         [=](scalar_t a) -> scalar_t { return (static_cast<scalar_t>(1) / (static_cast<scalar_t>(1) + std::exp((-a)))); },
-        [=](Vec256<scalar_t> a) {
-          a = Vec256<scalar_t>(static_cast<scalar_t>(0)) - a;
+        [=](Vectorized<scalar_t> a) {
+          a = Vectorized<scalar_t>(static_cast<scalar_t>(0)) - a;
           a = a.exp();
-          a = Vec256<scalar_t>(static_cast<scalar_t>(1)) + a;
+          a = Vectorized<scalar_t>(static_cast<scalar_t>(1)) + a;
           a = a.reciprocal();
           return a;
         });
@@ -60,7 +62,7 @@ static void abs_kernel(TensorIterator& iter) {
     cpu_kernel_vec(
         iter,
         [=](scalar_t a) -> scalar_t { return abs_impl(a); },
-        [=](Vec256<scalar_t> a) { return a.abs(); });
+        [=](Vectorized<scalar_t> a) { return a.abs(); });
   });
 }
 
@@ -69,7 +71,7 @@ static void angle_kernel(TensorIterator& iter) {
     cpu_kernel_vec(
         iter,
         [=](scalar_t a) -> scalar_t { return angle_impl(a); },
-        [=](Vec256<scalar_t> a) { return a.angle(); });
+        [=](Vectorized<scalar_t> a) { return a.angle(); });
   });
 }
 
@@ -78,7 +80,7 @@ static void real_kernel(TensorIterator& iter) {
     cpu_kernel_vec(
         iter,
         [=](scalar_t a) -> scalar_t { return real_impl(a); },
-        [=](Vec256<scalar_t> a) { return a.real(); });
+        [=](Vectorized<scalar_t> a) { return a.real(); });
   });
 }
 
@@ -87,7 +89,7 @@ static void imag_kernel(TensorIterator& iter) {
     cpu_kernel_vec(
         iter,
         [=](scalar_t a) -> scalar_t { return imag_impl(a); },
-        [=](Vec256<scalar_t> a) { return a.imag(); });
+        [=](Vectorized<scalar_t> a) { return a.imag(); });
   });
 }
 
@@ -96,7 +98,7 @@ static void conj_kernel(TensorIterator& iter) {
     cpu_kernel_vec(
         iter,
         [=](scalar_t a) -> scalar_t { return conj_impl(a); },
-        [=](Vec256<scalar_t> a) { return a.conj(); });
+        [=](Vectorized<scalar_t> a) { return a.conj(); });
   });
 }
 
@@ -125,7 +127,7 @@ static void frac_kernel(TensorIterator& iter) {
     cpu_kernel_vec(
         iter,
         [=](scalar_t a) -> scalar_t { return a - std::trunc(a); },
-        [=](Vec256<scalar_t> a) { return a.frac(); });
+        [=](Vectorized<scalar_t> a) { return a.frac(); });
   });
 }
 
@@ -146,7 +148,7 @@ static void reciprocal_kernel(TensorIterator& iter) {
     cpu_kernel_vec(
         iter,
         [=](scalar_t a) -> scalar_t { return static_cast<scalar_t>(1.0) / a; },
-        [=](Vec256<scalar_t> a) { return a.reciprocal(); });
+        [=](Vectorized<scalar_t> a) { return a.reciprocal(); });
   });
 }
 
@@ -155,7 +157,7 @@ static void neg_kernel(TensorIterator& iter) {
     cpu_kernel_vec(
         iter,
         [=](scalar_t a) -> scalar_t { return -a; },
-        [=](Vec256<scalar_t> a) { return a.neg(); });
+        [=](Vectorized<scalar_t> a) { return a.neg(); });
   });
 }
 
@@ -164,17 +166,17 @@ static void sign_kernel(TensorIterator& iter){
       cpu_kernel(iter, [=](bool x) -> bool { return x; });
   } else {
     AT_DISPATCH_ALL_TYPES_AND2(kBFloat16, ScalarType::Half, iter.dtype(), "sign_cpu", [&]() {
-        auto zero_vec = Vec256<scalar_t>(static_cast<scalar_t>(0));
-        auto one_vec = Vec256<scalar_t>(static_cast<scalar_t>(1));
+        auto zero_vec = Vectorized<scalar_t>(static_cast<scalar_t>(0));
+        auto one_vec = Vectorized<scalar_t>(static_cast<scalar_t>(1));
 
         cpu_kernel_vec(
             iter,
             [=](scalar_t a) -> scalar_t { return (0 < a) - (a < 0); },
-            [=](Vec256<scalar_t> self_vec){
+            [=](Vectorized<scalar_t> self_vec){
 
                 // Comparision operators returns bitmask.
-                auto left = Vec256<scalar_t>::blendv(zero_vec, one_vec, zero_vec < self_vec);
-                auto right = Vec256<scalar_t>::blendv(zero_vec, one_vec, self_vec < zero_vec);
+                auto left = Vectorized<scalar_t>::blendv(zero_vec, one_vec, zero_vec < self_vec);
+                auto right = Vectorized<scalar_t>::blendv(zero_vec, one_vec, self_vec < zero_vec);
 
                 return left - right;
             });
@@ -251,11 +253,11 @@ static void clamp_kernel(TensorIterator& iter, Scalar min_scalar, Scalar max_sca
     c10::scalar_value_type<scalar_t>::type (*zabs_)(scalar_t) = zabs;
     auto min = min_scalar.to<scalar_t>();
     auto max = max_scalar.to<scalar_t>();
-    auto min_vec = Vec256<scalar_t>(min);
-    auto max_vec = Vec256<scalar_t>(max);
+    auto min_vec = Vectorized<scalar_t>(min);
+    auto max_vec = Vectorized<scalar_t>(max);
     cpu_kernel_vec(iter,
      [=](scalar_t a) -> scalar_t { return zabs_(a) < zabs_(min) ? min : (zabs_(a) > zabs_(max) ? max : a); },
-     [=](Vec256<scalar_t> a) { return vec256::clamp(a, min_vec, max_vec); });
+     [=](Vectorized<scalar_t> a) { return vec::clamp(a, min_vec, max_vec); });
   });
 }
 
@@ -263,10 +265,10 @@ static void clamp_max_kernel(TensorIterator& iter, Scalar max_scalar) {
   AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND(kBFloat16, iter.dtype(), "clamp_max_cpu", [&]() {
     c10::scalar_value_type<scalar_t>::type (*zabs_)(scalar_t) = zabs;
     auto max = max_scalar.to<scalar_t>();
-    auto max_vec = Vec256<scalar_t>(max);
+    auto max_vec = Vectorized<scalar_t>(max);
     cpu_kernel_vec(iter,
      [=](scalar_t a) -> scalar_t { return zabs_(a) > zabs_(max) ? max : a; },
-     [=](Vec256<scalar_t> a) { return vec256::clamp_max(a, max_vec); });
+     [=](Vectorized<scalar_t> a) { return vec::clamp_max(a, max_vec); });
   });
 }
 
@@ -274,10 +276,10 @@ static void clamp_min_kernel(TensorIterator& iter, Scalar min_scalar) {
   AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND(kBFloat16, iter.dtype(), "clamp_min_cpu", [&]() {
     c10::scalar_value_type<scalar_t>::type (*zabs_)(scalar_t) = zabs;
     auto min = min_scalar.to<scalar_t>();
-    auto min_vec = Vec256<scalar_t>(min);
+    auto min_vec = Vectorized<scalar_t>(min);
     cpu_kernel_vec(iter,
      [=](scalar_t a) -> scalar_t { return zabs_(a) < zabs_(min) ? min : a; },
-     [=](Vec256<scalar_t> a) { return vec256::clamp_min(a, min_vec); });
+     [=](Vectorized<scalar_t> a) { return vec::clamp_min(a, min_vec); });
   });
 }
 
@@ -408,7 +410,7 @@ static void rsqrt_kernel(TensorIterator& iter) {
         [=](scalar_t a) -> scalar_t {
           return (static_cast<scalar_t>(1)) / std::sqrt(a);
         },
-        [=](Vec256<scalar_t> a) { return a.rsqrt(); });
+        [=](Vectorized<scalar_t> a) { return a.rsqrt(); });
   });
 }
 
@@ -101,4 +101,14 @@ Tensor & fmod_cuda_(Tensor & self, const Tensor & other) {
   return legacy::cuda::_th_fmod_(self, b_other);
 }
 
+std::tuple<Tensor&, Tensor&> sort_out_stable_cuda(Tensor& values, Tensor& indices, const Tensor& self, c10::optional<bool> stable, int64_t dim, bool descending) {
+  TORCH_CHECK(!stable.value_or(false), "stable sort is not implemented for CUDA tensors");
+  return legacy::cuda::_th_sort_out(values, indices, self, dim, descending);
+}
+
+std::tuple<Tensor, Tensor> sort_stable_cuda(const Tensor& self, c10::optional<bool> stable, int64_t dim, bool descending) {
+  TORCH_CHECK(!stable.value_or(false), "stable sort is not implemented for CUDA tensors");
+  return legacy::cuda::_th_sort(self, dim, descending);
+}
+
 }} // namespace at::native
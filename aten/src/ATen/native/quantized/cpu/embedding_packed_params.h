@@ -0,0 +1,16 @@
+#pragma once
+
+#include <ATen/core/ivalue.h>
+
+struct EmbeddingPackedParamsBase : public torch::jit::CustomClassHolder {
+  virtual at::Tensor embeddingbag(
+      const at::Tensor& indices,
+      const c10::optional<at::Tensor>& offsets,
+      int64_t mode,
+      const c10::optional<at::Tensor>& per_sample_weights,
+      bool include_last_offset) = 0;
+
+  virtual at::Tensor unpack() = 0;
+
+  virtual int64_t bit_rate() const = 0;
+};
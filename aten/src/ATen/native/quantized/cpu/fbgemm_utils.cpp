@@ -14,9 +14,11 @@
 #include <torch/custom_class.h>
 
 #include <ATen/native/quantized/cpu/packed_params.h>
+#include <ATen/native/quantized/cpu/qembeddingbag.h>
 #include <ATen/native/quantized/cpu/qnnpack_utils.h>
 
 torch::jit::class_<LinearPackedParamsBase> register_linear_params();
+torch::jit::class_<EmbeddingPackedParamsBase> register_embedding_params();
 
 #ifdef USE_FBGEMM
 
@@ -385,10 +387,38 @@ torch::jit::class_<LinearPackedParamsBase> register_linear_params() {
   return register_linear_params;
 }
 
+torch::jit::class_<EmbeddingPackedParamsBase> register_embedding_params() {
+  // The packed table is serialized as is, since its quantization does not
+  // depend on the qengine.
+  using SerializationType = std::tuple<at::Tensor, int64_t>;
+  static auto register_embedding_params =
+      torch::jit::class_<EmbeddingPackedParamsBase>(
+          "quantized", "EmbeddingPackedParamsBase")
+          .def_pickle(
+              [](const c10::intrusive_ptr<EmbeddingPackedParamsBase>& params)
+                  -> SerializationType { // __getstate__
+                auto* packed =
+                    dynamic_cast<PackedEmbeddingBagWeight*>(params.get());
+                TORCH_CHECK(
+                    packed, "Unknown type of EmbeddingPackedParamsBase");
+                return std::make_tuple(packed->packed_w, packed->bit_rate());
+              },
+              [](SerializationType state)
+                  -> c10::intrusive_ptr<
+                      EmbeddingPackedParamsBase> { // __setstate__
+                return c10::make_intrusive<PackedEmbeddingBagWeight>(
+                    std::move(std::get<0>(state)), std::get<1>(state));
+              })
+          .def("bit_rate", &EmbeddingPackedParamsBase::bit_rate)
+          .def("unpack", &EmbeddingPackedParamsBase::unpack);
+  return register_embedding_params;
+}
+
 namespace {
 
 static auto conv2d_params = register_conv_params<2>();
 static auto conv3d_params = register_conv_params<3>();
 static auto linear_params = register_linear_params();
+static auto embedding_params = register_embedding_params();
 
 } // namespace
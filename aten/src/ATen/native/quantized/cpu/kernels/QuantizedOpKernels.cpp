@@ -2137,6 +2137,106 @@ void quantized_normalize_kernel(
   });
 }
 
+// Rows of a fused rowwise quantized embedding table hold 8 / kBitRate values
+// per byte, followed by the scale and bias of the row: two floats for 8-bit
+// tables and two halves for 4-bit ones. The inner loops are left to the
+// compiler to vectorize for each CPU capability.
+template <int kBitRate, typename index_t>
+void qembedding_bag_nbit_impl(
+    Tensor& output,
+    const Tensor& packed_weight,
+    const Tensor& indices,
+    const Tensor& offsets,
+    const Tensor& per_sample_weights,
+    bool normalize_by_lengths) {
+  using scale_bias_t =
+      typename std::conditional<kBitRate == 8, float, at::Half>::type;
+  constexpr int64_t kElementsPerByte = 8 / kBitRate;
+  constexpr int kMask = (1 << kBitRate) - 1;
+
+  const int64_t num_rows = packed_weight.size(0);
+  const int64_t row_bytes = packed_weight.size(1);
+  const int64_t data_bytes = row_bytes - 2 * sizeof(scale_bias_t);
+  const int64_t block_size = output.size(1);
+  const uint8_t* weight_data = packed_weight.data_ptr<uint8_t>();
+  const index_t* indices_data = indices.data_ptr<index_t>();
+  const int64_t* offsets_data = offsets.data_ptr<int64_t>();
+  const float* weights_data = per_sample_weights.defined()
+      ? per_sample_weights.data_ptr<float>()
+      : nullptr;
+  float* output_data = output.data_ptr<float>();
+
+  at::parallel_for(0, output.size(0), 1, [&](int64_t start, int64_t end) {
+    for (int64_t bag = start; bag < end; ++bag) {
+      float* out = output_data + bag * block_size;
+      std::fill(out, out + block_size, 0.f);
+      const int64_t bag_begin = offsets_data[bag];
+      const int64_t bag_end = offsets_data[bag + 1];
+      for (int64_t i = bag_begin; i < bag_end; ++i) {
+        const int64_t idx = indices_data[i];
+        TORCH_CHECK(
+            idx >= 0 && idx < num_rows,
+            "embedding_bag: index ",
+            idx,
+            " is out of range for a table with ",
+            num_rows,
+            " rows");
+        const uint8_t* row = weight_data + idx * row_bytes;
+        const scale_bias_t* scale_bias =
+            reinterpret_cast<const scale_bias_t*>(row + data_bytes);
+        const float weight = weights_data ? weights_data[i] : 1.f;
+        const float scale = weight * static_cast<float>(scale_bias[0]);
+        const float bias = weight * static_cast<float>(scale_bias[1]);
+        for (int64_t j = 0; j < block_size; ++j) {
+          const int quantized =
+              (row[j / kElementsPerByte] >>
+               ((j % kElementsPerByte) * kBitRate)) &
+              kMask;
+          out[j] += scale * quantized + bias;
+        }
+      }
+      if (normalize_by_lengths && bag_end > bag_begin) {
+        const float inverse_length = 1.f / (bag_end - bag_begin);
+        for (int64_t j = 0; j < block_size; ++j) {
+          out[j] *= inverse_length;
+        }
+      }
+    }
+  });
+}
+
+void qembedding_bag_nbit_kernel(
+    Tensor& output,
+    const Tensor& packed_weight,
+    const Tensor& indices,
+    const Tensor& offsets,
+    const Tensor& per_sample_weights,
+    int64_t bit_rate,
+    bool normalize_by_lengths) {
+  TORCH_INTERNAL_ASSERT(bit_rate == 8 || bit_rate == 4);
+  if (indices.scalar_type() == kInt) {
+    if (bit_rate == 8) {
+      qembedding_bag_nbit_impl<8, int32_t>(
+          output, packed_weight, indices, offsets, per_sample_weights,
+          normalize_by_lengths);
+    } else {
+      qembedding_bag_nbit_impl<4, int32_t>(
+          output, packed_weight, indices, offsets, per_sample_weights,
+          normalize_by_lengths);
+    }
+  } else {
+    if (bit_rate == 8) {
+      qembedding_bag_nbit_impl<8, int64_t>(
+          output, packed_weight, indices, offsets, per_sample_weights,
+          normalize_by_lengths);
+    } else {
+      qembedding_bag_nbit_impl<4, int64_t>(
+          output, packed_weight, indices, offsets, per_sample_weights,
+          normalize_by_lengths);
+    }
+  }
+}
+
 #ifdef USE_FBGEMM
 void quantize_tensor_per_tensor_affine_cpu(
     Tensor rtensor,
@@ -2444,6 +2544,7 @@ REGISTER_DISPATCH(
     dequantize_tensor_per_channel_affine_stub,
     &dequantize_tensor_per_channel_affine_cpu);
 REGISTER_DISPATCH(quantized_normalize_stub, &quantized_normalize_kernel);
+REGISTER_DISPATCH(qembedding_bag_nbit_stub, &qembedding_bag_nbit_kernel);
 
 } // namespace native
 } // namespace at
@@ -0,0 +1,281 @@
+#include <ATen/ATen.h>
+#include <ATen/Parallel.h>
+#include <ATen/native/quantized/cpu/qembeddingbag.h>
+#include <ATen/native/quantized/cpu/quantized_ops.h>
+#include <torch/custom_class.h>
+#include <torch/library.h>
+
+#ifndef C10_MOBILE
+#include <caffe2/perfkernels/fused_8bit_rowwise_embedding_lookup_idx.h>
+#endif
+
+torch::jit::class_<EmbeddingPackedParamsBase> register_embedding_params();
+
+at::Tensor PackedEmbeddingBagWeight::embeddingbag(
+    const at::Tensor& indices,
+    const c10::optional<at::Tensor>& offsets,
+    int64_t mode,
+    const c10::optional<at::Tensor>& per_sample_weights,
+    bool include_last_offset) {
+  return at::native::qembeddingbag_rowwise_offsets(
+      packed_w,
+      bit_rate_,
+      indices,
+      offsets,
+      mode,
+      per_sample_weights,
+      include_last_offset);
+}
+
+namespace at {
+namespace native {
+
+DEFINE_DISPATCH(qembedding_bag_nbit_stub);
+
+namespace {
+
+const int64_t MODE_SUM = 0;
+const int64_t MODE_MEAN = 1;
+
+#ifndef C10_MOBILE
+template <typename index_t>
+void fused_8bit_rowwise_embedding_lookup(
+    Tensor& output,
+    const Tensor& packed_weight,
+    const Tensor& indices,
+    const Tensor& offsets,
+    const Tensor& per_sample_weights,
+    bool normalize_by_lengths) {
+  const int64_t block_size = output.size(1);
+  const uint8_t* weight_data = packed_weight.data_ptr<uint8_t>();
+  const index_t* indices_data = indices.data_ptr<index_t>();
+  const int64_t* offsets_data = offsets.data_ptr<int64_t>();
+  const float* weights_data = per_sample_weights.defined()
+      ? per_sample_weights.data_ptr<float>()
+      : nullptr;
+  float* output_data = output.data_ptr<float>();
+
+  at::parallel_for(0, output.size(0), 1, [&](int64_t start, int64_t end) {
+    const int64_t index_start = offsets_data[start];
+    caffe2::Fused8BitRowwiseEmbeddingLookupIdx<index_t, uint8_t, float>(
+        /*block_size=*/block_size,
+        /*output_size=*/end - start,
+        /*index_size=*/offsets_data[end] - index_start,
+        /*data_size=*/packed_weight.size(0),
+        /*input=*/weight_data,
+        /*indices=*/indices_data + index_start,
+        /*offsets=*/offsets_data + start,
+        /*weights=*/weights_data ? weights_data + index_start : nullptr,
+        /*normalize_by_lengths=*/normalize_by_lengths,
+        /*out=*/output_data + start * block_size);
+  });
+}
+#endif
+
+} // namespace
+
+Tensor qembeddingbag_rowwise_offsets(
+    const Tensor& packed_weight,
+    int64_t bit_rate,
+    const Tensor& indices,
+    const c10::optional<Tensor>& offsets,
+    int64_t mode,
+    const c10::optional<Tensor>& per_sample_weights,
+    bool include_last_offset) {
+  TORCH_CHECK(
+      bit_rate == 8 || bit_rate == 4,
+      "embedding_bag: bit_rate must be 8 or 4, got ",
+      bit_rate);
+  TORCH_CHECK(
+      packed_weight.dim() == 2 && packed_weight.scalar_type() == kByte,
+      "embedding_bag: expected a 2-dimensional uint8 packed weight");
+  TORCH_CHECK(
+      mode == MODE_SUM || mode == MODE_MEAN,
+      "embedding_bag: quantized weights only support the sum (0) and mean (1) "
+      "modes, got mode ",
+      mode);
+  TORCH_CHECK(
+      indices.scalar_type() == kInt || indices.scalar_type() == kLong,
+      "embedding_bag: expected indices to be an int or long tensor, got ",
+      indices.scalar_type());
+
+  // As in embedding_bag, 2-D indices are bags of equal size, one per row.
+  Tensor flat_indices;
+  Tensor offsets_with_last;
+  if (indices.dim() == 2) {
+    TORCH_CHECK(
+        !offsets.has_value() || !offsets->defined(),
+        "embedding_bag: offsets must be None for 2-dimensional indices");
+    flat_indices = indices.reshape({-1}).contiguous();
+    offsets_with_last =
+        at::arange(indices.size(0) + 1, indices.options().dtype(kLong))
+            .mul_(indices.size(1));
+  } else {
+    TORCH_CHECK(
+        indices.dim() == 1,
+        "embedding_bag: expected indices to be 1- or 2-dimensional, got ",
+        indices.dim(),
+        " dimensions");
+    TORCH_CHECK(
+        offsets.has_value() && offsets->defined(),
+        "embedding_bag: offsets must be given for 1-dimensional indices");
+    TORCH_CHECK(
+        offsets->dim() == 1,
+        "embedding_bag: expected offsets to be 1-dimensional, got ",
+        offsets->dim(),
+        " dimensions");
+    flat_indices = indices.contiguous();
+    offsets_with_last = offsets->to(kLong).contiguous();
+    if (!include_last_offset) {
+      offsets_with_last = at::cat(
+          {offsets_with_last,
+           at::full({1}, indices.numel(), offsets_with_last.options())});
+    }
+  }
+  const int64_t output_size = offsets_with_last.numel() - 1;
+  TORCH_CHECK(
+      output_size >= 0,
+      "embedding_bag: offsets must have at least one element if "
+      "include_last_offset is set");
+  const int64_t* offsets_data = offsets_with_last.data_ptr<int64_t>();
+  TORCH_CHECK(
+      offsets_data[0] == 0,
+      "embedding_bag: the first offset must be 0, got ",
+      offsets_data[0]);
+  for (int64_t i = 0; i < output_size; ++i) {
+    TORCH_CHECK(
+        offsets_data[i] <= offsets_data[i + 1],
+        "embedding_bag: offsets must be non-decreasing");
+  }
+  TORCH_CHECK(
+      offsets_data[output_size] == flat_indices.numel(),
+      "embedding_bag: the last offset must equal the number of indices (",
+      flat_indices.numel(),
+      "), got ",
+      offsets_data[output_size]);
+
+  Tensor weights;
+  if (per_sample_weights.has_value() && per_sample_weights->defined()) {
+    TORCH_CHECK(
+        mode == MODE_SUM,
+        "embedding_bag: per_sample_weights are only supported for mode='sum'");
+    TORCH_CHECK(
+        per_sample_weights->scalar_type() == kFloat,
+        "embedding_bag: expected per_sample_weights to be a float tensor, got ",
+        per_sample_weights->scalar_type());
+    TORCH_CHECK(
+        per_sample_weights->numel() == flat_indices.numel(),
+        "embedding_bag: expected per_sample_weights to have as many elements "
+        "as indices (",
+        flat_indices.numel(),
+        "), got ",
+        per_sample_weights->numel());
+    weights = per_sample_weights->reshape({-1}).contiguous();
+  }
+
+  const auto packed_contig = packed_weight.contiguous();
+  const int64_t scale_bias_bytes =
+      bit_rate == 8 ? 2 * sizeof(float) : 2 * sizeof(at::Half);
+  TORCH_CHECK(
+      packed_weight.size(1) > scale_bias_bytes,
+      "embedding_bag: packed weight rows must be longer than their ",
+      scale_bias_bytes,
+      " bytes of scale and bias, got ",
+      packed_weight.size(1));
+  const int64_t block_size =
+      (packed_weight.size(1) - scale_bias_bytes) * (8 / bit_rate);
+  auto output = at::empty(
+      {output_size, block_size}, packed_weight.options().dtype(kFloat));
+  if (output_size == 0) {
+    return output;
+  }
+
+#ifndef C10_MOBILE
+  // The caffe2 kernel is hand-vectorized for AVX2 and prefetches the rows
+  // of the next index.
+  if (bit_rate == 8) {
+    if (flat_indices.scalar_type() == kInt) {
+      fused_8bit_rowwise_embedding_lookup<int32_t>(
+          output, packed_contig, flat_indices, offsets_with_last, weights,
+          mode == MODE_MEAN);
+    } else {
+      fused_8bit_rowwise_embedding_lookup<int64_t>(
+          output, packed_contig, flat_indices, offsets_with_last, weights,
+          mode == MODE_MEAN);
+    }
+    return output;
+  }
+#endif
+  qembedding_bag_nbit_stub(
+      kCPU,
+      output,
+      packed_contig,
+      flat_indices,
+      offsets_with_last,
+      weights,
+      bit_rate,
+      mode == MODE_MEAN);
+  return output;
+}
+
+namespace {
+
+template <int64_t bit_rate>
+class QEmbeddingBag final {
+ public:
+  static Tensor run(
+      const Tensor& packed_weight,
+      const Tensor& indices,
+      const c10::optional<Tensor>& offsets,
+      bool /* scale_grad_by_freq */,
+      int64_t mode,
+      bool /* sparse */,
+      const c10::optional<Tensor>& per_sample_weights,
+      bool include_last_offset) {
+    return qembeddingbag_rowwise_offsets(
+        packed_weight,
+        bit_rate,
+        indices,
+        offsets,
+        mode,
+        per_sample_weights,
+        include_last_offset);
+  }
+};
+
+template <int64_t bit_rate>
+class QEmbeddingBagPacked final {
+ public:
+  static Tensor run(
+      const c10::intrusive_ptr<EmbeddingPackedParamsBase>& packed_weight,
+      const Tensor& indices,
+      const c10::optional<Tensor>& offsets,
+      bool /* scale_grad_by_freq */,
+      int64_t mode,
+      bool /* sparse */,
+      const c10::optional<Tensor>& per_sample_weights,
+      bool include_last_offset) {
+    TORCH_CHECK(
+        packed_weight->bit_rate() == bit_rate,
+        "embedding_bag: expected a ",
+        bit_rate,
+        "-bit packed weight, got a ",
+        packed_weight->bit_rate(),
+        "-bit one");
+    return packed_weight->embeddingbag(
+        indices, offsets, mode, per_sample_weights, include_last_offset);
+  }
+};
+
+TORCH_LIBRARY_IMPL(quantized, CPU, m) {
+  m.impl(
+      "embedding_bag_byte_rowwise_offsets", TORCH_FN(QEmbeddingBag<8>::run));
+  m.impl(
+      "embedding_bag_4bit_rowwise_offsets", TORCH_FN(QEmbeddingBag<4>::run));
+  m.impl("embedding_bag_byte", TORCH_FN(QEmbeddingBagPacked<8>::run));
+  m.impl("embedding_bag_4bit", TORCH_FN(QEmbeddingBagPacked<4>::run));
+}
+
+} // namespace
+} // namespace native
+} // namespace at
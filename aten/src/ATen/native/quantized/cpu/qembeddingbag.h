@@ -0,0 +1,59 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/quantized/cpu/embedding_packed_params.h>
+
+namespace at {
+namespace native {
+
+// Quantizes each row of the float embedding table `weight` to `bit_rate` (8 or
+// 4) bits with a scale and bias of its own. The result is a uint8 tensor with
+// one row per embedding, in the fused layout of the caffe2 perfkernels: the
+// quantized values, followed by the scale and bias as floats (8-bit) or halves
+// (4-bit).
+Tensor qembeddingbag_prepack(const Tensor& weight, int64_t bit_rate);
+
+// Inverse of `qembeddingbag_prepack`. 4-bit rows of an odd width come back
+// with one extra column.
+Tensor qembeddingbag_unpack(const Tensor& packed_weight, int64_t bit_rate);
+
+// `embedding_bag` on a table packed by `qembeddingbag_prepack`. Supports the
+// sum and mean modes and returns a float tensor with one row per bag.
+Tensor qembeddingbag_rowwise_offsets(
+    const Tensor& packed_weight,
+    int64_t bit_rate,
+    const Tensor& indices,
+    const c10::optional<Tensor>& offsets,
+    int64_t mode,
+    const c10::optional<Tensor>& per_sample_weights,
+    bool include_last_offset);
+
+} // namespace native
+} // namespace at
+
+// A fused rowwise quantized embedding table, as produced by
+// `at::native::qembeddingbag_prepack`.
+struct CAFFE2_API PackedEmbeddingBagWeight : public EmbeddingPackedParamsBase {
+  PackedEmbeddingBagWeight(at::Tensor packed_w, int64_t bit_rate)
+      : packed_w(std::move(packed_w)), bit_rate_(bit_rate) {}
+
+  at::Tensor packed_w;
+  int64_t bit_rate_;
+
+  at::Tensor embeddingbag(
+      const at::Tensor& indices,
+      const c10::optional<at::Tensor>& offsets,
+      int64_t mode,
+      const c10::optional<at::Tensor>& per_sample_weights,
+      bool include_last_offset) override;
+
+  at::Tensor unpack() override;
+
+  int64_t bit_rate() const override {
+    return bit_rate_;
+  }
+
+  static c10::intrusive_ptr<EmbeddingPackedParamsBase> prepack(
+      const at::Tensor& weight,
+      int64_t bit_rate);
+};
@@ -0,0 +1,93 @@
+#include <ATen/ATen.h>
+#include <ATen/Parallel.h>
+#include <ATen/native/quantized/cpu/qembeddingbag.h>
+#include <caffe2/perfkernels/fused_nbit_rowwise_conversion.h>
+#include <torch/custom_class.h>
+#include <torch/library.h>
+
+torch::jit::class_<EmbeddingPackedParamsBase> register_embedding_params();
+
+c10::intrusive_ptr<EmbeddingPackedParamsBase> PackedEmbeddingBagWeight::
+    prepack(const at::Tensor& weight, int64_t bit_rate) {
+  return c10::make_intrusive<PackedEmbeddingBagWeight>(
+      at::native::qembeddingbag_prepack(weight, bit_rate), bit_rate);
+}
+
+namespace at {
+namespace native {
+
+Tensor qembeddingbag_prepack(const Tensor& weight, int64_t bit_rate) {
+  TORCH_CHECK(
+      bit_rate == 8 || bit_rate == 4,
+      "embedding_bag_prepack: bit_rate must be 8 or 4, got ",
+      bit_rate);
+  TORCH_CHECK(
+      weight.dim() == 2,
+      "embedding_bag_prepack: weight must be 2-dimensional, got ",
+      weight.dim(),
+      " dimensions");
+  TORCH_CHECK(
+      weight.scalar_type() == kFloat,
+      "embedding_bag_prepack: weight must be a float tensor, got ",
+      weight.scalar_type());
+  TORCH_CHECK(
+      weight.size(1) > 0,
+      "embedding_bag_prepack: weight must have at least one column");
+
+  const auto weight_contig = weight.contiguous();
+  const int64_t rows = weight.size(0);
+  const int64_t columns = weight.size(1);
+  const int64_t elements_per_byte = 8 / bit_rate;
+  const int64_t packed_columns = bit_rate == 8
+      ? columns + 2 * sizeof(float)
+      : (columns + elements_per_byte - 1) / elements_per_byte +
+          2 * sizeof(at::Half);
+  auto packed_weight =
+      at::empty({rows, packed_columns}, weight.options().dtype(kByte));
+
+  const float* weight_data = weight_contig.data_ptr<float>();
+  uint8_t* packed_data = packed_weight.data_ptr<uint8_t>();
+  const int64_t grain_size = std::max<int64_t>(1, internal::GRAIN_SIZE / columns);
+  at::parallel_for(0, rows, grain_size, [&](int64_t start, int64_t end) {
+    if (bit_rate == 8) {
+      caffe2::FloatToFused8BitRowwiseQuantized(
+          weight_data + start * columns,
+          end - start,
+          columns,
+          packed_data + start * packed_columns);
+    } else {
+      caffe2::FloatToFusedNBitRowwiseQuantizedSBHalf(
+          bit_rate,
+          weight_data + start * columns,
+          end - start,
+          columns,
+          packed_data + start * packed_columns);
+    }
+  });
+  return packed_weight;
+}
+
+namespace {
+
+class QEmbeddingPackWeights final {
+ public:
+  static c10::intrusive_ptr<EmbeddingPackedParamsBase> run(
+      const Tensor& weight,
+      int64_t bit_rate) {
+    return PackedEmbeddingBagWeight::prepack(weight, bit_rate);
+  }
+};
+
+TORCH_LIBRARY_IMPL(quantized, CPU, m) {
+  m.impl("embedding_bag_byte_prepack", [](const Tensor& weight) {
+    return qembeddingbag_prepack(weight, 8);
+  });
+  m.impl("embedding_bag_4bit_prepack", [](const Tensor& weight) {
+    return qembeddingbag_prepack(weight, 4);
+  });
+  m.impl("embedding_bag_prepack", TORCH_FN(QEmbeddingPackWeights::run));
+}
+
+} // namespace
+} // namespace native
+} // namespace at
@@ -0,0 +1,89 @@
+#include <ATen/ATen.h>
+#include <ATen/Parallel.h>
+#include <ATen/native/quantized/cpu/qembeddingbag.h>
+#include <caffe2/perfkernels/fused_nbit_rowwise_conversion.h>
+#include <torch/custom_class.h>
+#include <torch/library.h>
+
+torch::jit::class_<EmbeddingPackedParamsBase> register_embedding_params();
+
+at::Tensor PackedEmbeddingBagWeight::unpack() {
+  return at::native::qembeddingbag_unpack(packed_w, bit_rate_);
+}
+
+namespace at {
+namespace native {
+
+Tensor qembeddingbag_unpack(const Tensor& packed_weight, int64_t bit_rate) {
+  TORCH_CHECK(
+      bit_rate == 8 || bit_rate == 4,
+      "embedding_bag_unpack: bit_rate must be 8 or 4, got ",
+      bit_rate);
+  TORCH_CHECK(
+      packed_weight.dim() == 2 && packed_weight.scalar_type() == kByte,
+      "embedding_bag_unpack: expected a 2-dimensional uint8 packed weight");
+  const int64_t scale_bias_bytes =
+      bit_rate == 8 ? 2 * sizeof(float) : 2 * sizeof(at::Half);
+  TORCH_CHECK(
+      packed_weight.size(1) > scale_bias_bytes,
+      "embedding_bag_unpack: packed weight rows must be longer than their ",
+      scale_bias_bytes,
+      " bytes of scale and bias, got ",
+      packed_weight.size(1));
+
+  const auto packed_contig = packed_weight.contiguous();
+  const int64_t rows = packed_weight.size(0);
+  const int64_t packed_columns = packed_weight.size(1);
+  const int64_t columns =
+      (packed_columns - scale_bias_bytes) * (8 / bit_rate);
+  auto weight =
+      at::empty({rows, columns}, packed_weight.options().dtype(kFloat));
+
+  const uint8_t* packed_data = packed_contig.data_ptr<uint8_t>();
+  float* weight_data = weight.data_ptr<float>();
+  const int64_t grain_size = std::max<int64_t>(1, internal::GRAIN_SIZE / columns);
+  at::parallel_for(0, rows, grain_size, [&](int64_t start, int64_t end) {
+    if (bit_rate == 8) {
+      caffe2::Fused8BitRowwiseQuantizedToFloat(
+          packed_data + start * packed_columns,
+          end - start,
+          packed_columns,
+          weight_data + start * columns);
+    } else {
+      caffe2::FusedNBitRowwiseQuantizedSBHalfToFloat(
+          bit_rate,
+          packed_data + start * packed_columns,
+          end - start,
+          packed_columns,
+          weight_data + start * columns);
+    }
+  });
+  return weight;
+}
+
+namespace {
+
+class QEmbeddingUnpackWeights final {
+ public:
+  static Tensor run(
+      const c10::intrusive_ptr<EmbeddingPackedParamsBase>& packed_weight) {
+    return packed_weight->unpack();
+  }
+};
+
+TORCH_LIBRARY_IMPL(quantized, CPU, m) {
+  m.impl("embedding_bag_byte_unpack", [](const Tensor& packed_weight) {
+    return qembeddingbag_unpack(packed_weight, 8);
+  });
+  m.impl("embedding_bag_4bit_unpack", [](const Tensor& packed_weight) {
+    return qembeddingbag_unpack(packed_weight, 4);
+  });
+}
+
+TORCH_LIBRARY_IMPL(quantized, CatchAll, m) {
+  m.impl("embedding_bag_unpack", TORCH_FN(QEmbeddingUnpackWeights::run));
+}
+
+} // namespace
+} // namespace native
+} // namespace at
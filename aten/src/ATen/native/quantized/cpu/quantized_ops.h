@@ -135,6 +135,15 @@ using qnormalize_fn = void (*)(
     double /* eps */,
     Tensor* /* Y */);
 
+using qembedding_bag_nbit_fn = void (*)(
+    Tensor& /* output */,
+    const Tensor& /* packed_weight */,
+    const Tensor& /* indices */,
+    const Tensor& /* offsets */,
+    const Tensor& /* per_sample_weights */,
+    int64_t /* bit_rate */,
+    bool /* normalize_by_lengths */);
+
 // using qavg_pool2d_fn
 DECLARE_DISPATCH(qrelu_fn, qrelu_stub);
 DECLARE_DISPATCH(qrelu_fn, qrelu6_stub);
@@ -163,6 +172,7 @@ DECLARE_DISPATCH(qtopk_fn, qtopk_stub);
 DECLARE_DISPATCH(qbatch_norm_fn, qbatch_norm_stub);
 DECLARE_DISPATCH(qbatch_norm_fn, qbatch_norm_relu_stub);
 DECLARE_DISPATCH(qnormalize_fn, quantized_normalize_stub);
+DECLARE_DISPATCH(qembedding_bag_nbit_fn, qembedding_bag_nbit_stub);
 
 } // namespace native
 } // namespace at
@@ -12,6 +12,8 @@
 #include <TH/THBlasUtils.h>
 
 #include <algorithm>
+#include <memory>
+#include <vector>
 
 namespace at { namespace native {
 
@@ -42,6 +44,98 @@ namespace {
     return csr;
   }
 
+  // Checks that the row and column indices of the elements of a `rows` x
+  // `cols` matrix are in bounds.
+  void check_csr_index_bounds(
+      const LongTensor& row_indices,
+      const LongTensor& col_indices,
+      int64_t rows,
+      int64_t cols,
+      const char* op) {
+    if (row_indices.numel() > 0) {
+      const int64_t min_col = col_indices.min().item<int64_t>();
+      const int64_t max_col = col_indices.max().item<int64_t>();
+      TORCH_CHECK(min_col >= 0 && max_col < cols,
+          op, ": index out of column bound: ", min_col < 0 ? min_col : max_col,
+          " not between 1 and ", cols);
+      const int64_t min_row = row_indices.min().item<int64_t>();
+      const int64_t max_row = row_indices.max().item<int64_t>();
+      TORCH_CHECK(min_row >= 0 && max_row < rows,
+          op, ": index out of row bound: ", min_row < 0 ? min_row : max_row,
+          " not between 1 and ", rows);
+    }
+  }
+
+  // Computes the CSR row pointers of a matrix with `rows` rows from the row
+  // indices of its elements, which must already be in bounds. Unless
+  // `sorted_by_row`, the elements are ordered by row with a stable counting
+  // sort, so that each row still accumulates its elements in order.
+  SparseCsrIndices build_csr_indices(
+      const LongTensor& row_indices,
+      int64_t rows,
+      bool sorted_by_row) {
+    const int64_t nnz = row_indices.numel();
+    SparseCsrIndices csr;
+    LongTensor row_indices_contig = row_indices.contiguous();
+    const int64_t* row_data = row_indices_contig.data_ptr<int64_t>();
+    if (sorted_by_row) {
+      csr.row_ptr = _to_csr(row_data, rows, nnz);
+      return csr;
+    }
+    csr.row_ptr = native::zeros({rows + 1}, kLong);
+    csr.perm = at::empty({nnz}, kLong);
+    int64_t* row_ptr = csr.row_ptr.data_ptr<int64_t>();
+    int64_t* perm = csr.perm.data_ptr<int64_t>();
+    for (int64_t i = 0; i < nnz; i++) {
+      row_ptr[row_data[i] + 1]++;
+    }
+    for (int64_t h = 0; h < rows; h++) {
+      row_ptr[h + 1] += row_ptr[h];
+    }
+    std::vector<int64_t> next(row_ptr, row_ptr + rows);
+    for (int64_t i = 0; i < nnz; i++) {
+      perm[next[row_data[i]]++] = i;
+    }
+    return csr;
+  }
+
+  // Like build_csr_indices, but checks the bounds of the indices first.
+  SparseCsrIndices compute_csr_indices(
+      const LongTensor& row_indices,
+      const LongTensor& col_indices,
+      int64_t rows,
+      int64_t cols,
+      bool sorted_by_row,
+      const char* op) {
+    check_csr_index_bounds(row_indices, col_indices, rows, cols, op);
+    return build_csr_indices(row_indices, rows, sorted_by_row);
+  }
+
+  // Returns the CSR row pointers of the 2-D sparse matrix `sparse`, which are
+  // cached on it until its indices, sizes or coalesced flag change. Repeated
+  // products with the same sparse matrix (and with the same indices tensor,
+  // e.g. a detached copy) thus only compute them once.
+  std::shared_ptr<const SparseCsrIndices> sparse_csr_indices(const SparseTensor& sparse, const char* op) {
+    auto* impl = get_sparse_impl(sparse);
+    LongTensor indices = impl->indices();
+    const uint32_t version = indices.unsafeGetTensorImpl()->version_counter().current_version();
+    auto cached = impl->csr_indices();
+    if (cached && cached->indices.is_same(indices) &&
+        cached->indices_version == version &&
+        sparse.sizes().equals(cached->sizes) &&
+        cached->coalesced == impl->coalesced()) {
+      return cached;
+    }
+    auto csr = std::make_shared<SparseCsrIndices>(compute_csr_indices(
+        indices.select(0, 0), indices.select(0, 1), sparse.size(0), sparse.size(1), impl->coalesced(), op));
+    csr->indices = indices;
+    csr->indices_version = version;
+    csr->sizes = sparse.sizes().vec();
+    csr->coalesced = impl->coalesced();
+    impl->set_csr_indices(csr);
+    return csr;
+  }
+
 }
 
 // --------------------------------------------------------------------
@@ -765,9 +859,7 @@ SparseTensor& mul_out_sparse_cpu(SparseTensor& r, const Tensor& t_, const Tensor
 // --------------------------------------------------------------------
 
 template <typename scalar_t>
-void s_addmm_out_sparse_dense_worker(int64_t nnz, int64_t dim_i, int64_t dim_j, int64_t dim_k, Tensor& r, Scalar beta, const Tensor& t, Scalar alpha, const Tensor& indices, const Tensor& values, const Tensor& dense) {
-  int64_t i;
-
+void s_addmm_out_sparse_dense_worker(int64_t dim_i, int64_t dim_k, Tensor& r, Scalar beta, const Tensor& t, Scalar alpha, const SparseCsrIndices& csr, const Tensor& col_indices, const Tensor& values, const Tensor& dense) {
   // r_ = alpha * sparse * dense
   scalar_t cast_alpha = alpha.to<scalar_t>();
   scalar_t cast_beta = beta.to<scalar_t>();
@@ -781,8 +873,9 @@ void s_addmm_out_sparse_dense_worker(int64_t nnz, int64_t dim_i, int64_t dim_j,
     at::mul_out(r, t, scalar_to_tensor(beta));
   }
 
-  auto indices_accessor = indices.accessor<int64_t, 2>();
-
+  const int64_t* row_ptr = csr.row_ptr.data_ptr<int64_t>();
+  const int64_t* perm = csr.perm.defined() ? csr.perm.data_ptr<int64_t>() : nullptr;
+  auto col_accessor = col_indices.accessor<int64_t, 1>();
   auto values_accessor = values.accessor<scalar_t, 1>();
   scalar_t* dense_ptr = dense.data_ptr<scalar_t>();
   scalar_t* r_ptr = r.data_ptr<scalar_t>();
@@ -791,23 +884,33 @@ void s_addmm_out_sparse_dense_worker(int64_t nnz, int64_t dim_i, int64_t dim_j,
   int64_t dense_stride1 = dense.stride(1);
   int64_t r_stride0 = r.stride(0);
   int64_t r_stride1 = r.stride(1);
-  for (i = 0; i < nnz; i++) {
-    scalar_t val = values_accessor[i];
-    int64_t row = indices_accessor[0][i];
-    int64_t col = indices_accessor[1][i];
-    if (col >= 0 && col < dim_j && row >= 0 && row < dim_i) {
-      THBlas_axpy<scalar_t>(dim_k,
-            cast_alpha * val,
-            dense_ptr + col * dense_stride0, dense_stride1,
-            r_ptr + row * r_stride0, r_stride1);
-    } else {
-      if (col < 0 || col >= dim_j) {
-        AT_ERROR("addmm: index out of column bound: ", col, " not between 1 and ", dim_j);
-      } else {
-        AT_ERROR("addmm: index out of row bound: ", row, " not between 1 and ", dim_i);
+
+  // Every row of r is only written by the thread that owns it.
+  const int64_t nnz = values.size(0);
+  const int64_t row_cost = std::max<int64_t>(1, nnz / std::max<int64_t>(1, dim_i) * dim_k);
+  const int64_t grain_size = std::max<int64_t>(1, at::internal::GRAIN_SIZE / row_cost);
+  at::parallel_for(0, dim_i, grain_size, [&](int64_t start, int64_t end) {
+    for (int64_t h = start; h < end; h++) {
+      scalar_t* r_row = r_ptr + h * r_stride0;
+      if (dim_k == 1) {
+        // Matrix-vector products: one dot product per row.
+        scalar_t sum = 0;
+        for (int64_t p = row_ptr[h]; p < row_ptr[h + 1]; p++) {
+          int64_t i = perm ? perm[p] : p;
+          sum += values_accessor[i] * dense_ptr[col_accessor[i] * dense_stride0];
+        }
+        *r_row += cast_alpha * sum;
+        continue;
+      }
+      for (int64_t p = row_ptr[h]; p < row_ptr[h + 1]; p++) {
+        int64_t i = perm ? perm[p] : p;
+        THBlas_axpy<scalar_t>(dim_k,
+              cast_alpha * values_accessor[i],
+              dense_ptr + col_accessor[i] * dense_stride0, dense_stride1,
+              r_row, r_stride1);
       }
     }
-  }
+  });
 };
 
 Tensor& s_addmm_out_sparse_dense_cpu(
@@ -849,12 +952,13 @@ Tensor& s_addmm_out_sparse_dense_cpu(
     return r;
   }
 
+  auto csr           = sparse_csr_indices(sparse_, "addmm");
   LongTensor indices = sparse_._indices();
   Tensor values      = sparse_._values();
 
   AT_DISPATCH_ALL_TYPES(
       values.scalar_type(), "addmm_sparse_dense", [&] {
-        s_addmm_out_sparse_dense_worker<scalar_t>(nnz, dim_i, dim_j, dim_k, r, beta, t, alpha, indices, values, dense);
+        s_addmm_out_sparse_dense_worker<scalar_t>(dim_i, dim_k, r, beta, t, alpha, *csr, indices[1], values, dense);
       }
   );
 
@@ -1071,7 +1175,7 @@ SparseTensor& _sspaddmm_out_cpu(
   LongTensor indices = sparse._indices();
   Tensor values      = sparse._values();
 
-  LongTensor csr = _to_csr(indices.data_ptr<int64_t>(), dim_i, nnz);
+  LongTensor csr = sparse_csr_indices(sparse, "sspmm")->row_ptr;
 
   int64_t t_nnz = t._nnz();
   int64_t r_nnz = nnz * dim_k + t_nnz;
@@ -1511,6 +1615,9 @@ Tensor& bmm_out_sparse_cpu(Tensor& result, const SparseTensor& self, const Tenso
 
   int64_t num_matrices = self_coalesced.size(0);
 
+  check_csr_index_bounds(
+    indices_dim1_dim2[0], indices_dim1_dim2[1], dim_i, dim_j, "bmm_sparse");
+
   // Iterate through each set of 2D matrices within the 3D
   // tensor inputs, performing a matrix multiply with each one.
   int64_t start_mat_num = indices_dim0_accessor[0];
@@ -1549,14 +1656,16 @@ Tensor& bmm_out_sparse_cpu(Tensor& result, const SparseTensor& self, const Tenso
           Tensor result_matrix = result[cur_mat_num];
           LongTensor sparse_indices = indices_dim1_dim2.slice(1, mat_el_begin_idx, mat_el_end_idx);
           Tensor sparse_values = values.slice(0, mat_el_begin_idx, mat_el_end_idx);
-          int64_t sparse_nnz = mat_el_end_idx - mat_el_begin_idx;
+          // Within a matrix, the elements of a coalesced tensor are ordered by
+          // row. The bounds were checked for the whole batch above.
+          SparseCsrIndices csr = build_csr_indices(
+            sparse_indices[0], dim_i, /*sorted_by_row=*/true);
 
           s_addmm_out_sparse_dense_worker<scalar_t>(
-            sparse_nnz,
-            dim_i, dim_j, dim_k,
+            dim_i, dim_k,
             result_matrix,
             beta, t_dummy, alpha,
-            sparse_indices, sparse_values,
+            csr, sparse_indices[1], sparse_values,
             dense_matrix
           );
           mat_el_begin_idx = mat_el_end_idx;
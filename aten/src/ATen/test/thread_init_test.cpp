@@ -1,6 +1,7 @@
 #include <ATen/ATen.h>
 #include <ATen/Parallel.h>
 #include <test/cpp/jit/test_base.h>
+#include <atomic>
 #include <thread>
 
 
@@ -16,6 +17,21 @@ void test(int given_num_threads) {
   for (int i = 0; i < 1000; ++i) {
     t_sum = t_sum + t.sum();
   }
+  // Reductions keep a partial result per get_thread_num(), which must be
+  // unique among the threads of a parallel region.
+  ASSERT_EQ(t.sum().item<float>(), 1000 * 1000);
+
+  std::vector<std::atomic<int>> calls(given_num_threads);
+  at::parallel_for(0, 1000 * 1000, 1, [&](int64_t begin, int64_t end) {
+    int thread_num = at::get_thread_num();
+    ASSERT_TRUE(thread_num >= 0 && thread_num < given_num_threads);
+    calls[thread_num]++;
+  });
+  #if !AT_PARALLEL_NATIVE_TBB
+  for (auto& c : calls) {
+    ASSERT_TRUE(c <= 1);
+  }
+  #endif
 }
 
 int main() {
@@ -29,7 +45,7 @@ int main() {
   });
   t1.join();
 
-  #if !AT_PARALLEL_NATIVE
+  #if !AT_PARALLEL_NATIVE && !AT_PARALLEL_WORK_STEALING
   at::set_num_threads(5);
   ASSERT_TRUE(at::get_num_threads() == 5);
   #endif
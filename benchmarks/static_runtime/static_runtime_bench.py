@@ -0,0 +1,83 @@
+"""Compares the per-inference latency of the static runtime
+(torch._C._jit_to_static_runtime) against the GraphExecutor that runs a
+scripted module's forward.
+
+The model is a small deep & wide network with batch size 1, where the
+runtime overhead per op is a large part of the total time.
+
+Usage:
+    python static_runtime_bench.py [--num_features 50] [--embedding_size 32]
+"""
+import argparse
+import statistics
+import timeit
+
+import torch
+
+
+class DeepAndWide(torch.nn.Module):
+    def __init__(self, num_features):
+        super(DeepAndWide, self).__init__()
+        self.mu = torch.nn.Parameter(torch.randn(1, num_features))
+        self.sigma = torch.nn.Parameter(torch.randn(1, num_features))
+        self.fc_w = torch.nn.Parameter(torch.randn(1, num_features + 1))
+        self.fc_b = torch.nn.Parameter(torch.randn(1))
+
+    def forward(self, ad_emb_packed, user_emb, wide):
+        wide_offset = wide + self.mu
+        wide_normalized = wide_offset * self.sigma
+        wide_preproc = torch.clamp(wide_normalized, 0., 10.)
+        user_emb_t = torch.transpose(user_emb, 1, 2)
+        dp_unflatten = torch.bmm(ad_emb_packed, user_emb_t)
+        dp = torch.flatten(dp_unflatten, 1)
+        inp = torch.cat([dp, wide_preproc], 1)
+        fc1 = torch.addmm(self.fc_b, inp, torch.t(self.fc_w))
+        return torch.sigmoid(fc1)
+
+
+def bench(fn, repeat, number):
+    runtimes = timeit.repeat(fn, repeat=repeat, number=number)
+    return [t / number * 1e6 for t in runtimes]
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--num_features", type=int, default=50)
+    parser.add_argument("--embedding_size", type=int, default=32)
+    parser.add_argument("--batch_size", type=int, default=1)
+    parser.add_argument("--repeat", type=int, default=20)
+    parser.add_argument("--number", type=int, default=1000)
+    args = parser.parse_args()
+
+    torch.set_num_threads(1)
+    model = DeepAndWide(args.num_features).eval()
+    ad_emb_packed = torch.randn(args.batch_size, 1, args.embedding_size)
+    user_emb = torch.randn(args.batch_size, 1, args.embedding_size)
+    wide = torch.randn(args.batch_size, args.num_features)
+    inputs = [ad_emb_packed, user_emb, wide]
+
+    scripted = torch.jit.script(model)
+    frozen = torch._C._freeze_module(scripted._c)
+    static_runtime = torch._C._jit_to_static_runtime(scripted._c)
+
+    with torch.no_grad():
+        expected = scripted(*inputs)
+        actual = static_runtime.run(inputs)[0]
+        assert torch.allclose(expected, actual)
+
+        results = {
+            "GraphExecutor": bench(
+                lambda: scripted(*inputs), args.repeat, args.number),
+            "GraphExecutor (frozen)": bench(
+                lambda: frozen.forward(*inputs), args.repeat, args.number),
+            "StaticRuntime": bench(
+                lambda: static_runtime.run(inputs), args.repeat, args.number),
+        }
+
+    for name, times in results.items():
+        print("{:>24}: {:8.2f} us/iter (stddev {:.2f})".format(
+            name, statistics.median(times), statistics.stdev(times)))
+
+
+if __name__ == "__main__":
+    main()
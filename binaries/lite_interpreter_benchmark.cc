@@ -0,0 +1,94 @@
+#include "ATen/ATen.h"
+#include <torch/csrc/jit/api/module.h>
+#include <torch/csrc/autograd/generated/variable_factories.h>
+#include <torch/csrc/jit/mobile/import.h>
+#include <torch/csrc/jit/mobile/module.h>
+#include <torch/csrc/jit/serialization/import.h>
+#include "torch/script.h"
+
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+
+C10_DEFINE_string(model, "", "The bytecode model to benchmark. If it is empty, "
+    "a small model that stresses the interpreter is used.");
+C10_DEFINE_string(
+    input_dims,
+    "1",
+    "The sizes of the float input of the model, separated by commas.");
+C10_DEFINE_int(warmup, 10, "The number of iterations to warm up.");
+C10_DEFINE_int(iter, 1000, "The number of iterations to run.");
+
+// Scalar ops in a loop, so that the time goes to dispatching instructions
+// rather than to the kernels.
+static std::stringstream small_model() {
+  torch::jit::Module m("m");
+  m.register_parameter("scale", torch::ones({1}), false);
+  m.register_parameter("bias", torch::zeros({1}), false);
+  m.define(R"(
+    def forward(self, x):
+      y = x
+      for i in range(100):
+        y = y * self.scale + self.bias
+      return y
+  )");
+  std::stringstream ss;
+  m._save_for_mobile(ss);
+  return ss;
+}
+
+int main(int argc, char** argv) {
+  c10::SetUsageMessage(
+    "Measure the load time and the latency of a model in the lite_interpreter.\n"
+    "Build it before and after a change to the interpreter to compare them.\n"
+    "Example usage:\n"
+    "./lite_interpreter_benchmark"
+    " --model=<model_file>"
+    " --input_dims=1,3,224,224"
+    " --iter=100");
+
+  if (!c10::ParseCommandLineFlags(&argc, &argv)) {
+    std::cerr << "Failed to parse command line flags!" << std::endl;
+    return 1;
+  }
+
+  std::vector<int64_t> input_dims;
+  std::stringstream dims(FLAGS_input_dims);
+  std::string dim;
+  while (std::getline(dims, dim, ',')) {
+    input_dims.push_back(c10::stoi(dim));
+  }
+  std::vector<c10::IValue> inputs{torch::ones(input_dims)};
+
+  std::stringstream small_model_stream;
+  if (FLAGS_model.empty()) {
+    small_model_stream = small_model();
+  }
+
+  // TODO: avoid having to set this guard for custom mobile build with mobile
+  // interpreter.
+  torch::AutoNonVariableTypeMode non_var_guard{true};
+
+  auto load_start = std::chrono::high_resolution_clock::now();
+  torch::jit::mobile::Module bc = FLAGS_model.empty()
+      ? torch::jit::_load_for_mobile(small_model_stream)
+      : torch::jit::_load_for_mobile(FLAGS_model);
+  auto load_end = std::chrono::high_resolution_clock::now();
+
+  for (int i = 0; i < FLAGS_warmup; ++i) {
+    bc.forward(inputs);
+  }
+  auto run_start = std::chrono::high_resolution_clock::now();
+  for (int i = 0; i < FLAGS_iter; ++i) {
+    bc.forward(inputs);
+  }
+  auto run_end = std::chrono::high_resolution_clock::now();
+
+  std::chrono::duration<double, std::micro> load_us = load_end - load_start;
+  std::chrono::duration<double, std::micro> run_us = run_end - run_start;
+  std::cout << "Load: " << load_us.count() << " us" << std::endl;
+  std::cout << "Forward: " << run_us.count() / std::max(FLAGS_iter, 1)
+            << " us per iteration over " << FLAGS_iter << " iterations"
+            << std::endl;
+  return 0;
+}
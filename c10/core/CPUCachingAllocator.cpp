@@ -0,0 +1,398 @@
+#include <c10/core/CPUCachingAllocator.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+
+#include <c10/core/CPUAllocator.h>
+#include <c10/core/DeviceType.h>
+#include <c10/util/llvmMathExtras.h>
+
+namespace c10 {
+namespace CPUCachingAllocator {
+
+namespace {
+
+// Size classes: 64, 128, ..., 512, then four per power of two
+// (640, 768, 896, 1024, 1280, ...) up to kMaxCachedSize.
+constexpr size_t kSmallClassStep = 64;
+constexpr size_t kNumSmallClasses = 8;
+constexpr size_t kSmallClassMax = kSmallClassStep * kNumSmallClasses;
+constexpr unsigned kSmallClassMaxLog2 = 9;
+constexpr unsigned kClassesPerPow2Log2 = 2;
+constexpr unsigned kMaxCachedSizeLog2 = 28;
+constexpr size_t kMaxCachedSize = size_t(1) << kMaxCachedSizeLog2;
+constexpr size_t kNumSizeClasses = kNumSmallClasses +
+    ((kMaxCachedSizeLog2 - kSmallClassMaxLog2) << kClassesPerPow2Log2);
+// Size class recorded for blocks larger than kMaxCachedSize.
+constexpr size_t kUncached = kNumSizeClasses;
+
+// Only blocks up to this size are kept in thread caches, and each thread
+// caches at most kMaxThreadCacheBytes.
+constexpr size_t kMaxThreadCachedSize = size_t(1) << 20;
+constexpr size_t kMaxThreadCacheBytes = size_t(8) << 20;
+
+constexpr size_t kDefaultMaxCachedBytes = size_t(1) << 30;
+
+static_assert(kSmallClassMax == size_t(1) << kSmallClassMaxLog2, "");
+
+size_t sizeClassIndex(size_t nbytes) {
+  if (nbytes <= kSmallClassMax) {
+    return (nbytes - 1) / kSmallClassStep;
+  }
+  // 2^k <= nbytes - 1 < 2^(k+1); the interval (2^k, 2^(k+1)] is split into
+  // equal steps.
+  unsigned k = llvm::Log2_64(nbytes - 1);
+  size_t step = size_t(1) << (k - kClassesPerPow2Log2);
+  size_t sub = ((nbytes - 1) - (size_t(1) << k)) / step;
+  return kNumSmallClasses + ((k - kSmallClassMaxLog2) << kClassesPerPow2Log2) +
+      sub;
+}
+
+size_t sizeClassBytes(size_t index) {
+  if (index < kNumSmallClasses) {
+    return (index + 1) * kSmallClassStep;
+  }
+  index -= kNumSmallClasses;
+  unsigned k = kSmallClassMaxLog2 + (index >> kClassesPerPow2Log2);
+  size_t sub = index & ((size_t(1) << kClassesPerPow2Log2) - 1);
+  return (size_t(1) << k) + (sub + 1) * (size_t(1) << (k - kClassesPerPow2Log2));
+}
+
+// Every block starts with a header; the memory handed out follows it. The
+// header size keeps the returned pointer gAlignment-aligned, and while the
+// block sits in a free list `next` links it to the next free block.
+struct BlockHeader {
+  size_t size_class;
+  size_t size;
+  BlockHeader* next;
+};
+
+constexpr size_t kHeaderSize = 64;
+static_assert(sizeof(BlockHeader) <= kHeaderSize, "");
+static_assert(kHeaderSize % gAlignment == 0, "");
+
+void* blockData(BlockHeader* block) {
+  return reinterpret_cast<char*>(block) + kHeaderSize;
+}
+
+BlockHeader* blockHeader(void* data) {
+  return reinterpret_cast<BlockHeader*>(
+      reinterpret_cast<char*>(data) - kHeaderSize);
+}
+
+BlockHeader* newBlock(size_t size_class, size_t size) {
+  auto* block = static_cast<BlockHeader*>(alloc_cpu(kHeaderSize + size));
+  block->size_class = size_class;
+  block->size = size;
+  block->next = nullptr;
+  return block;
+}
+
+struct FreeList {
+  BlockHeader* head = nullptr;
+
+  void push(BlockHeader* block) {
+    block->next = head;
+    head = block;
+  }
+
+  BlockHeader* pop() {
+    BlockHeader* block = head;
+    if (block) {
+      head = block->next;
+    }
+    return block;
+  }
+};
+
+struct Counters {
+  std::atomic<int64_t> allocated_bytes{0};
+  std::atomic<int64_t> peak_allocated_bytes{0};
+  std::atomic<int64_t> cached_bytes{0};
+  std::atomic<int64_t> num_allocations{0};
+  std::atomic<int64_t> num_cache_hits{0};
+
+  void onAllocate(size_t size, bool hit) {
+    num_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (hit) {
+      num_cache_hits.fetch_add(1, std::memory_order_relaxed);
+      cached_bytes.fetch_sub(size, std::memory_order_relaxed);
+    }
+    int64_t now =
+        allocated_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+    int64_t peak = peak_allocated_bytes.load(std::memory_order_relaxed);
+    while (now > peak &&
+           !peak_allocated_bytes.compare_exchange_weak(
+               peak, now, std::memory_order_relaxed)) {
+    }
+  }
+};
+
+Counters& counters() {
+  static Counters counters_;
+  return counters_;
+}
+
+// Free blocks shared by all threads.
+class GlobalPool {
+ public:
+  BlockHeader* pop(size_t size_class) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    BlockHeader* block = bins_[size_class].pop();
+    if (block) {
+      bytes_ -= block->size;
+    }
+    return block;
+  }
+
+  // Takes ownership of `block`, caching it unless that would exceed the cap.
+  void push(BlockHeader* block) {
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      if (bytes_ + block->size <= max_bytes_) {
+        bins_[block->size_class].push(block);
+        bytes_ += block->size;
+        return;
+      }
+    }
+    counters().cached_bytes.fetch_sub(block->size, std::memory_order_relaxed);
+    free_cpu(block);
+  }
+
+  void setMaxBytes(size_t max_bytes) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    max_bytes_ = max_bytes;
+    trimLocked();
+  }
+
+  void release() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    size_t old_max = max_bytes_;
+    max_bytes_ = 0;
+    trimLocked();
+    max_bytes_ = old_max;
+  }
+
+ private:
+  // Releases blocks, largest size class first, until bytes_ <= max_bytes_.
+  void trimLocked() {
+    for (size_t i = kNumSizeClasses; i-- > 0 && bytes_ > max_bytes_;) {
+      while (bytes_ > max_bytes_) {
+        BlockHeader* block = bins_[i].pop();
+        if (!block) {
+          break;
+        }
+        bytes_ -= block->size;
+        counters().cached_bytes.fetch_sub(
+            block->size, std::memory_order_relaxed);
+        free_cpu(block);
+      }
+    }
+  }
+
+  std::mutex mutex_;
+  std::array<FreeList, kNumSizeClasses> bins_;
+  size_t bytes_ = 0;
+  size_t max_bytes_ = kDefaultMaxCachedBytes;
+};
+
+GlobalPool& globalPool() {
+  // Leaked so that thread caches flushed during process exit still find it.
+  static GlobalPool* pool = new GlobalPool();
+  return *pool;
+}
+
+// Per-thread free lists, only touched by their owning thread.
+class ThreadCache;
+
+// Trivially destructible, so they remain usable while other thread-locals
+// (which may free tensors) are being destroyed.
+thread_local ThreadCache* tls_cache = nullptr;
+thread_local bool tls_cache_destroyed = false;
+
+class ThreadCache {
+ public:
+  ~ThreadCache() {
+    flush();
+    tls_cache = nullptr;
+    tls_cache_destroyed = true;
+  }
+
+  BlockHeader* pop(size_t size_class) {
+    BlockHeader* block = bins_[size_class].pop();
+    if (block) {
+      bytes_ -= block->size;
+    }
+    return block;
+  }
+
+  bool tryPush(BlockHeader* block) {
+    if (bytes_ + block->size > kMaxThreadCacheBytes) {
+      return false;
+    }
+    bins_[block->size_class].push(block);
+    bytes_ += block->size;
+    return true;
+  }
+
+  void flush() {
+    for (auto& bin : bins_) {
+      while (BlockHeader* block = bin.pop()) {
+        globalPool().push(block);
+      }
+    }
+    bytes_ = 0;
+  }
+
+ private:
+  std::array<FreeList, kNumSizeClasses> bins_;
+  size_t bytes_ = 0;
+};
+
+// Returns nullptr once the calling thread's cache has been destroyed.
+ThreadCache* localCache() {
+  if (C10_LIKELY(tls_cache != nullptr)) {
+    return tls_cache;
+  }
+  if (tls_cache_destroyed) {
+    return nullptr;
+  }
+  static thread_local ThreadCache cache;
+  tls_cache = &cache;
+  return tls_cache;
+}
+
+void fillNewAllocation(void* data, size_t nbytes) {
+  if (FLAGS_caffe2_cpu_allocator_do_zero_fill) {
+    memset(data, 0, nbytes);
+  } else if (FLAGS_caffe2_cpu_allocator_do_junk_fill) {
+    memset_junk(data, nbytes);
+  }
+}
+
+struct CachingCPUAllocator final : at::Allocator {
+  at::DataPtr allocate(size_t nbytes) const override {
+    if (nbytes == 0) {
+      return {nullptr, nullptr, &Delete, at::Device(at::DeviceType::CPU)};
+    }
+    BlockHeader* block = nullptr;
+    bool hit = false;
+    if (nbytes > kMaxCachedSize) {
+      // alloc_cpu does the zero/junk fill for fresh memory.
+      block = newBlock(kUncached, nbytes);
+    } else {
+      size_t size_class = sizeClassIndex(nbytes);
+      size_t size = sizeClassBytes(size_class);
+      if (size <= kMaxThreadCachedSize) {
+        if (ThreadCache* cache = localCache()) {
+          block = cache->pop(size_class);
+        }
+      }
+      if (!block) {
+        block = globalPool().pop(size_class);
+      }
+      if (block) {
+        hit = true;
+        fillNewAllocation(blockData(block), block->size);
+      } else {
+        block = newBlock(size_class, size);
+      }
+    }
+    counters().onAllocate(block->size, hit);
+    void* data = blockData(block);
+    profiledCPUMemoryReporter().New(data, block->size);
+    return {data, data, &Delete, at::Device(at::DeviceType::CPU)};
+  }
+
+  static void Delete(void* ptr) {
+    if (!ptr) {
+      return;
+    }
+    profiledCPUMemoryReporter().Delete(ptr);
+    BlockHeader* block = blockHeader(ptr);
+    counters().allocated_bytes.fetch_sub(
+        block->size, std::memory_order_relaxed);
+    if (block->size_class == kUncached) {
+      free_cpu(block);
+      return;
+    }
+    counters().cached_bytes.fetch_add(block->size, std::memory_order_relaxed);
+    if (block->size <= kMaxThreadCachedSize) {
+      ThreadCache* cache = localCache();
+      if (cache && cache->tryPush(block)) {
+        return;
+      }
+    }
+    globalPool().push(block);
+  }
+
+  at::DeleterFnPtr raw_deleter() const override {
+    return &Delete;
+  }
+};
+
+CachingCPUAllocator g_caching_cpu_alloc;
+
+bool enabledByEnvironment() {
+  const char* val = std::getenv("PYTORCH_CPU_CACHING_ALLOCATOR");
+  return val && *val && strcmp(val, "0") != 0;
+}
+
+// Priority 1 so that the choice holds regardless of whether this runs before
+// or after the default CPU allocator registers itself.
+struct EnvRegisterer {
+  EnvRegisterer() {
+    if (enabledByEnvironment()) {
+      enable(/*priority=*/1);
+    }
+  }
+};
+
+EnvRegisterer g_env_registerer;
+
+} // namespace
+
+at::Allocator* get() {
+  return &g_caching_cpu_alloc;
+}
+
+void enable(uint8_t priority) {
+  SetCPUAllocator(get(), priority);
+}
+
+void emptyCache() {
+  if (ThreadCache* cache = localCache()) {
+    cache->flush();
+  }
+  globalPool().release();
+}
+
+void setMaxCachedBytes(size_t max_bytes) {
+  globalPool().setMaxBytes(max_bytes);
+}
+
+Stats getStats() {
+  auto& c = counters();
+  Stats stats;
+  stats.allocated_bytes = c.allocated_bytes.load(std::memory_order_relaxed);
+  stats.peak_allocated_bytes =
+      c.peak_allocated_bytes.load(std::memory_order_relaxed);
+  stats.cached_bytes = c.cached_bytes.load(std::memory_order_relaxed);
+  stats.num_allocations = c.num_allocations.load(std::memory_order_relaxed);
+  stats.num_cache_hits = c.num_cache_hits.load(std::memory_order_relaxed);
+  return stats;
+}
+
+void resetPeakStats() {
+  auto& c = counters();
+  c.peak_allocated_bytes.store(
+      c.allocated_bytes.load(std::memory_order_relaxed),
+      std::memory_order_relaxed);
+}
+
+} // namespace CPUCachingAllocator
+} // namespace c10
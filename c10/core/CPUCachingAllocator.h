@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <c10/core/Allocator.h>
+#include <c10/macros/Macros.h>
+
+namespace c10 {
+
+// Caching allocator for CPU memory.
+//
+// The default CPU allocator hands every request to posix_memalign/free. For
+// workloads that allocate and free tensors of the same shapes over and over
+// (e.g. serving a model one small batch at a time) this spends a noticeable
+// fraction of the time in the system allocator, and large blocks, which libc
+// serves with fresh mmaps, additionally pay for page faults on every use.
+//
+// This allocator rounds requests up to a size class (multiples of 64 bytes up
+// to 512 bytes, then four classes per power of two up to 256MB) and keeps
+// freed blocks around for reuse:
+//
+// - Each thread has a small cache of blocks up to 1MB, which it allocates
+//   from and frees into without taking any lock.
+// - Blocks that do not fit in the thread's cache, and everything a thread
+//   had cached when it exits, go to a global pool shared by all threads.
+//   The global pool is capped (see setMaxCachedBytes); blocks that would
+//   push it past the cap are returned to the system right away.
+// - Requests above the largest size class bypass the cache.
+//
+// The allocator is opt-in: call enable(), or set the environment variable
+// PYTORCH_CPU_CACHING_ALLOCATOR=1, to make it the CPU allocator used by ATen.
+// It does not add the guard bytes that QNNPACK/XNNPACK expect on mobile.
+
+namespace CPUCachingAllocator {
+
+// Summary statistics. Byte counts are in size-class-rounded bytes.
+struct Stats {
+  // SUM: bytes in blocks currently handed out to client code
+  int64_t allocated_bytes = 0;
+  // SUM: high-water mark of allocated_bytes since the last resetPeakStats()
+  int64_t peak_allocated_bytes = 0;
+  // SUM: bytes in free blocks held by the global pool and all thread caches
+  int64_t cached_bytes = 0;
+  // COUNT: non-empty allocations requested by client code
+  int64_t num_allocations = 0;
+  // COUNT: allocations served from a thread cache or the global pool
+  int64_t num_cache_hits = 0;
+
+  double hitRate() const {
+    return num_allocations == 0
+        ? 0.0
+        : static_cast<double>(num_cache_hits) / num_allocations;
+  }
+};
+
+C10_API at::Allocator* get();
+// Registers the caching allocator as the CPU allocator via SetCPUAllocator.
+// Memory handed out before the switch is still freed correctly.
+C10_API void enable(uint8_t priority = 0);
+// Returns the global pool and the calling thread's cache to the system.
+// Other threads' caches are left alone; they are bounded and are flushed
+// into the global pool when those threads exit.
+C10_API void emptyCache();
+// Caps the number of bytes kept in the global pool, releasing blocks
+// (largest first) if it currently holds more.
+C10_API void setMaxCachedBytes(size_t max_bytes);
+C10_API Stats getStats();
+C10_API void resetPeakStats();
+
+} // namespace CPUCachingAllocator
+} // namespace c10
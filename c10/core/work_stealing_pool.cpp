@@ -0,0 +1,429 @@
+#include <c10/core/work_stealing_pool.h>
+
+#include <c10/util/Exception.h>
+#include <c10/util/Logging.h>
+
+#include <algorithm>
+#include <exception>
+
+namespace c10 {
+
+namespace detail {
+
+WorkStealingDeque::WorkStealingDeque(int64_t log_capacity) {
+  buffers_.emplace_back(new Buffer(log_capacity));
+  buffer_.store(buffers_.back().get(), std::memory_order_relaxed);
+}
+
+WorkStealingDeque::~WorkStealingDeque() = default;
+
+WorkStealingDeque::Buffer* WorkStealingDeque::grow(
+    Buffer* old,
+    int64_t bottom,
+    int64_t top) {
+  buffers_.emplace_back(new Buffer(old->log_capacity + 1));
+  Buffer* bigger = buffers_.back().get();
+  for (int64_t i = top; i < bottom; ++i) {
+    bigger->put(i, old->get(i));
+  }
+  buffer_.store(bigger, std::memory_order_release);
+  return bigger;
+}
+
+void WorkStealingDeque::push(WorkStealingTask* task) {
+  int64_t b = bottom_.load(std::memory_order_relaxed);
+  int64_t t = top_.load(std::memory_order_acquire);
+  Buffer* a = buffer_.load(std::memory_order_relaxed);
+  if (b - t > a->capacity() - 1) {
+    a = grow(a, b, t);
+  }
+  a->put(b, task);
+  std::atomic_thread_fence(std::memory_order_release);
+  bottom_.store(b + 1, std::memory_order_relaxed);
+}
+
+WorkStealingTask* WorkStealingDeque::pop() {
+  int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+  Buffer* a = buffer_.load(std::memory_order_relaxed);
+  bottom_.store(b, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  int64_t t = top_.load(std::memory_order_relaxed);
+  if (t > b) {
+    // Empty.
+    bottom_.store(b + 1, std::memory_order_relaxed);
+    return nullptr;
+  }
+  WorkStealingTask* task = a->get(b);
+  if (t == b) {
+    // Last element: race against thieves for it.
+    if (!top_.compare_exchange_strong(
+            t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+      task = nullptr;
+    }
+    bottom_.store(b + 1, std::memory_order_relaxed);
+  }
+  return task;
+}
+
+WorkStealingTask* WorkStealingDeque::steal() {
+  int64_t t = top_.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  int64_t b = bottom_.load(std::memory_order_acquire);
+  if (t >= b) {
+    return nullptr;
+  }
+  Buffer* a = buffer_.load(std::memory_order_acquire);
+  WorkStealingTask* task = a->get(t);
+  if (!top_.compare_exchange_strong(
+          t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+    return nullptr;
+  }
+  return task;
+}
+
+} // namespace detail
+
+namespace {
+
+// Identifies the pool (and worker slot) the current thread belongs to.
+thread_local const WorkStealingPool* current_pool_ = nullptr;
+thread_local int current_index_ = -1;
+
+// Number of find-task rounds an idle worker makes, yielding in between,
+// before it parks on the condition variable. Keeps workers hot across the
+// short gaps between back-to-back parallel regions.
+constexpr int kSpinRounds = 64;
+
+// Ranges are not split below 1/kTasksPerThread of the per-thread share, so
+// tiny grain sizes do not turn into one heap-allocated task per element.
+constexpr int64_t kTasksPerThread = 8;
+
+} // namespace
+
+constexpr size_t WorkStealingPool::kMaxExternalThreads;
+
+class WorkStealingPool::FunctionTask : public detail::WorkStealingTask {
+ public:
+  explicit FunctionTask(std::function<void()> func) : func_(std::move(func)) {}
+
+  void execute(WorkStealingPool& /*pool*/, detail::WorkStealingDeque& /*local*/)
+      override {
+    try {
+      func_();
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "Exception in thread pool task: " << e.what();
+    } catch (...) {
+      LOG(ERROR) << "Exception in thread pool task: unknown";
+    }
+    delete this;
+  }
+
+ private:
+  std::function<void()> func_;
+};
+
+class WorkStealingPool::RangeTask : public detail::WorkStealingTask {
+ public:
+  // Shared by all the pieces of one parallelFor call; lives on the stack of
+  // the calling thread, which does not return before `remaining` reaches 0.
+  struct Job {
+    const std::function<void(int64_t, int64_t)>* fn;
+    int64_t min_chunk;
+    std::atomic<int64_t> remaining;
+    std::atomic<bool> failed{false};
+    std::atomic_flag err_flag = ATOMIC_FLAG_INIT;
+    std::exception_ptr eptr;
+  };
+
+  RangeTask(Job* job, int64_t begin, int64_t end)
+      : job_(job), begin_(begin), end_(end) {}
+
+  void execute(WorkStealingPool& pool, detail::WorkStealingDeque& local)
+      override {
+    Job* job = job_;
+    int64_t begin = begin_;
+    int64_t end = end_;
+    delete this;
+
+    // Keep the lower half, hand out the upper half; repeat until the piece
+    // left is too small to be worth sharing. Thieves take from the top of
+    // the deque, i.e. the largest pieces pushed first.
+    while (end - begin >= 2 * job->min_chunk) {
+      int64_t mid = begin + (end - begin) / 2;
+      local.push(new RangeTask(job, mid, end));
+      pool.notifyWork();
+      end = mid;
+    }
+
+    if (!job->failed.load(std::memory_order_relaxed)) {
+      try {
+        (*job->fn)(begin, end);
+      } catch (...) {
+        if (!job->err_flag.test_and_set()) {
+          job->eptr = std::current_exception();
+        }
+        job->failed.store(true, std::memory_order_relaxed);
+      }
+    }
+    // `job` may be destroyed as soon as this reaches zero.
+    job->remaining.fetch_sub(end - begin, std::memory_order_acq_rel);
+  }
+
+ private:
+  Job* job_;
+  int64_t begin_;
+  int64_t end_;
+};
+
+WorkStealingPool::WorkStealingPool(
+    int pool_size,
+    std::function<void()> init_thread)
+    : external_in_use_(new std::atomic<bool>[kMaxExternalThreads]),
+      threads_(pool_size < 0 ? defaultNumThreads() : pool_size) {
+  for (size_t i = 0; i < threads_.size() + kMaxExternalThreads; ++i) {
+    deques_.emplace_back(new detail::WorkStealingDeque());
+  }
+  for (size_t i = 0; i < kMaxExternalThreads; ++i) {
+    external_in_use_[i].store(false, std::memory_order_relaxed);
+  }
+  for (size_t i = 0; i < threads_.size(); ++i) {
+    threads_[i] = std::thread([this, i, init_thread]() {
+      if (init_thread) {
+        init_thread();
+      }
+      this->mainLoop(i);
+    });
+  }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+  {
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    running_.store(false);
+    ++wake_epoch_;
+  }
+  sleep_cv_.notify_all();
+
+  for (auto& t : threads_) {
+    try {
+      t.join();
+    } catch (const std::exception&) {
+    }
+  }
+
+  // Only fire-and-forget tasks can be left at this point: parallelFor does not
+  // return while any of its pieces are queued.
+  for (auto& deque : deques_) {
+    while (auto* task = deque->steal()) {
+      delete task;
+    }
+  }
+  for (auto* task : injection_) {
+    delete task;
+  }
+}
+
+size_t WorkStealingPool::size() const {
+  return threads_.size();
+}
+
+size_t WorkStealingPool::numAvailable() const {
+  return threads_.size() - num_busy_.load(std::memory_order_relaxed);
+}
+
+bool WorkStealingPool::inThreadPool() const {
+  return current_pool_ == this;
+}
+
+int WorkStealingPool::currentWorkerIndex() const {
+  return current_pool_ == this ? current_index_ : -1;
+}
+
+void WorkStealingPool::run(std::function<void()> func) {
+  if (threads_.size() == 0) {
+    throw std::runtime_error("No threads to run a task");
+  }
+  auto* task = new FunctionTask(std::move(func));
+  int index = currentWorkerIndex();
+  if (index >= 0) {
+    deques_[index]->push(task);
+  } else {
+    std::lock_guard<std::mutex> guard(injection_mutex_);
+    injection_.push_back(task);
+    injection_size_.fetch_add(1, std::memory_order_relaxed);
+  }
+  notifyWork();
+}
+
+void WorkStealingPool::parallelFor(
+    int64_t begin,
+    int64_t end,
+    int64_t grain_size,
+    const std::function<void(int64_t, int64_t)>& fn) {
+  if (begin >= end) {
+    return;
+  }
+  const int64_t n = end - begin;
+  const int64_t num_threads = threads_.size() + 1;
+  const int64_t min_chunk = std::max<int64_t>(
+      {grain_size, (n + num_threads * kTasksPerThread - 1) /
+           (num_threads * kTasksPerThread), 1});
+  if (threads_.empty() || n < 2 * min_chunk) {
+    fn(begin, end);
+    return;
+  }
+
+  // Find a deque for this thread to split into.
+  detail::WorkStealingDeque* local = nullptr;
+  int external_slot = -1;
+  int index = currentWorkerIndex();
+  if (index >= 0) {
+    local = deques_[index].get();
+  } else {
+    for (size_t i = 0; i < kMaxExternalThreads; ++i) {
+      bool expected = false;
+      if (!external_in_use_[i].load(std::memory_order_relaxed) &&
+          external_in_use_[i].compare_exchange_strong(
+              expected, true, std::memory_order_acquire)) {
+        external_slot = i;
+        local = deques_[threads_.size() + i].get();
+        break;
+      }
+    }
+    if (local == nullptr) {
+      // Too many concurrent external callers; don't make this one wait.
+      fn(begin, end);
+      return;
+    }
+  }
+
+  RangeTask::Job job;
+  job.fn = &fn;
+  job.min_chunk = min_chunk;
+  job.remaining.store(n, std::memory_order_relaxed);
+
+  execute(new RangeTask(&job, begin, end), *local);
+
+  // Help until every piece has run. Pieces still on our own deque are popped
+  // first; once it is empty, steal (from anyone: running unrelated work here
+  // still moves the whole pool forward).
+  size_t seed = external_slot >= 0 ? threads_.size() + external_slot : index;
+  while (job.remaining.load(std::memory_order_acquire) != 0) {
+    detail::WorkStealingTask* task = local->pop();
+    if (task == nullptr) {
+      task = stealFromOthers(*local, seed++);
+    }
+    if (task != nullptr) {
+      execute(task, *local);
+    } else {
+      std::this_thread::yield();
+    }
+  }
+
+  if (external_slot >= 0) {
+    external_in_use_[external_slot].store(false, std::memory_order_release);
+  }
+  if (job.eptr) {
+    std::rethrow_exception(job.eptr);
+  }
+}
+
+void WorkStealingPool::execute(
+    detail::WorkStealingTask* task,
+    detail::WorkStealingDeque& local) {
+  task->execute(*this, local);
+}
+
+detail::WorkStealingTask* WorkStealingPool::findTask(
+    detail::WorkStealingDeque& local,
+    size_t seed) {
+  if (auto* task = local.pop()) {
+    return task;
+  }
+  if (injection_size_.load(std::memory_order_relaxed) > 0) {
+    std::lock_guard<std::mutex> guard(injection_mutex_);
+    if (!injection_.empty()) {
+      auto* task = injection_.front();
+      injection_.pop_front();
+      injection_size_.fetch_sub(1, std::memory_order_relaxed);
+      return task;
+    }
+  }
+  return stealFromOthers(local, seed);
+}
+
+detail::WorkStealingTask* WorkStealingPool::stealFromOthers(
+    detail::WorkStealingDeque& local,
+    size_t seed) {
+  const size_t n = deques_.size();
+  for (size_t i = 0; i < n; ++i) {
+    auto& victim = *deques_[(seed + i) % n];
+    if (&victim == &local || victim.empty()) {
+      continue;
+    }
+    if (auto* task = victim.steal()) {
+      return task;
+    }
+  }
+  return nullptr;
+}
+
+bool WorkStealingPool::hasVisibleWork() {
+  if (injection_size_.load(std::memory_order_relaxed) > 0) {
+    return true;
+  }
+  for (auto& deque : deques_) {
+    if (!deque->empty()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void WorkStealingPool::notifyWork() {
+  // Pairs with the fence in mainLoop: either the sleeper sees the new work
+  // when it rechecks, or we see it registered as sleeping and wake it.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (num_sleeping_.load(std::memory_order_relaxed) > 0) {
+    {
+      std::lock_guard<std::mutex> guard(sleep_mutex_);
+      ++wake_epoch_;
+    }
+    sleep_cv_.notify_one();
+  }
+}
+
+void WorkStealingPool::mainLoop(size_t index) {
+  current_pool_ = this;
+  current_index_ = index;
+  auto& local = *deques_[index];
+  // Each worker starts its steal scan at a different victim.
+  size_t seed = index + 1;
+
+  while (running_.load(std::memory_order_relaxed)) {
+    detail::WorkStealingTask* task = findTask(local, seed++);
+    for (int spin = 0; task == nullptr && spin < kSpinRounds; ++spin) {
+      std::this_thread::yield();
+      task = findTask(local, seed++);
+    }
+    if (task != nullptr) {
+      num_busy_.fetch_add(1, std::memory_order_relaxed);
+      execute(task, local);
+      num_busy_.fetch_sub(1, std::memory_order_relaxed);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    uint64_t epoch = wake_epoch_;
+    num_sleeping_.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!hasVisibleWork()) {
+      sleep_cv_.wait(lock, [&] {
+        return wake_epoch_ != epoch || !running_.load(std::memory_order_relaxed);
+      });
+    }
+    num_sleeping_.fetch_sub(1, std::memory_order_relaxed);
+  }
+}
+
+} // namespace c10
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <c10/core/thread_pool.h>
+#include <c10/macros/Macros.h>
+
+namespace c10 {
+
+class WorkStealingPool;
+
+namespace detail {
+
+class WorkStealingDeque;
+
+// Unit of work scheduled on a WorkStealingPool. `execute` is handed the deque
+// of the thread running it so that the task can push more work (e.g. the
+// second half of a range it has just split) without touching shared state.
+class C10_API WorkStealingTask {
+ public:
+  virtual ~WorkStealingTask() = default;
+  virtual void execute(WorkStealingPool& pool, WorkStealingDeque& local) = 0;
+};
+
+// Chase-Lev work-stealing deque, using the memory orderings from
+// "Correct and Efficient Work-Stealing for Weak Memory Models"
+// (Le, Pop, Cohen, Zappa Nardelli, PPoPP'13).
+//
+// The owning thread pushes and pops at the bottom; any other thread may steal
+// from the top. None of the operations take a lock. When the ring buffer
+// fills up the owner replaces it with one twice the size; old buffers are
+// kept alive until the deque is destroyed because a concurrent thief may
+// still be reading from them.
+class C10_API WorkStealingDeque {
+ public:
+  explicit WorkStealingDeque(int64_t log_capacity = 8);
+  ~WorkStealingDeque();
+
+  WorkStealingDeque(const WorkStealingDeque&) = delete;
+  WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+  // Owner only.
+  void push(WorkStealingTask* task);
+  // Owner only. Returns nullptr if the deque is empty.
+  WorkStealingTask* pop();
+  // Any thread. Returns nullptr if the deque is empty or the steal lost a
+  // race with another thief or with the owner.
+  WorkStealingTask* steal();
+
+  bool empty() const {
+    int64_t b = bottom_.load(std::memory_order_relaxed);
+    int64_t t = top_.load(std::memory_order_relaxed);
+    return b <= t;
+  }
+
+ private:
+  struct Buffer {
+    explicit Buffer(int64_t log_capacity)
+        : log_capacity(log_capacity),
+          mask((int64_t(1) << log_capacity) - 1),
+          slots(new std::atomic<WorkStealingTask*>[mask + 1]) {}
+
+    int64_t capacity() const {
+      return mask + 1;
+    }
+    // Acquire/release on the slot itself (rather than relying only on the
+    // fences in push/steal) publishes the task's fields to the thread that
+    // takes it in a way race detectors can see; on x86 it is free.
+    WorkStealingTask* get(int64_t i) const {
+      return slots[i & mask].load(std::memory_order_acquire);
+    }
+    void put(int64_t i, WorkStealingTask* task) {
+      slots[i & mask].store(task, std::memory_order_release);
+    }
+
+    const int64_t log_capacity;
+    const int64_t mask;
+    std::unique_ptr<std::atomic<WorkStealingTask*>[]> slots;
+  };
+
+  Buffer* grow(Buffer* old, int64_t bottom, int64_t top);
+
+  // top_ and bottom_ live on separate cache lines: thieves hammer top_ while
+  // the owner updates bottom_ on every push/pop.
+  alignas(64) std::atomic<int64_t> top_{0};
+  alignas(64) std::atomic<int64_t> bottom_{0};
+  alignas(64) std::atomic<Buffer*> buffer_;
+  // Owner only.
+  std::vector<std::unique_ptr<Buffer>> buffers_;
+};
+
+} // namespace detail
+
+// Thread pool built from one work-stealing deque per worker.
+//
+// Unlike ThreadPool, which serializes every submission and every pickup on a
+// single mutex-protected queue, workers here run tasks from their own deque
+// and only touch other workers' deques (from the opposite end) when they run
+// out of work. The mutex/condition variable pair is used solely to park
+// workers that have found nothing to do.
+//
+// parallelFor() is the main entry point: the range is split recursively, with
+// each split pushing the upper half onto the current thread's deque, so idle
+// threads steal the largest outstanding pieces and uneven per-element costs
+// are balanced dynamically. The calling thread takes part in the work and
+// returns once the whole range has been processed.
+class C10_API WorkStealingPool : public TaskThreadPoolBase {
+ public:
+  WorkStealingPool() = delete;
+
+  explicit WorkStealingPool(
+      int pool_size,
+      std::function<void()> init_thread = nullptr);
+
+  ~WorkStealingPool();
+
+  size_t size() const override;
+
+  size_t numAvailable() const override;
+
+  bool inThreadPool() const override;
+
+  // Fire-and-forget task. Exceptions escaping `func` are logged and
+  // swallowed, as in ThreadPool::run.
+  void run(std::function<void()> func) override;
+
+  // Calls fn(b, e) over disjoint subranges covering [begin, end), each of at
+  // least `grain_size` elements unless the whole range is smaller. Blocks until
+  // every subrange has finished. The first exception thrown by `fn` is
+  // rethrown on the calling thread after the remaining work has drained.
+  void parallelFor(
+      int64_t begin,
+      int64_t end,
+      int64_t grain_size,
+      const std::function<void(int64_t, int64_t)>& fn);
+
+  // Index of the calling thread among this pool's workers, or -1 if the
+  // calling thread does not belong to the pool.
+  int currentWorkerIndex() const;
+
+  // Maximum number of non-pool threads that may be inside parallelFor at the
+  // same time; further callers run their range inline.
+  static constexpr size_t kMaxExternalThreads = 16;
+
+ private:
+  class RangeTask;
+  class FunctionTask;
+
+  void mainLoop(size_t index);
+  void execute(detail::WorkStealingTask* task, detail::WorkStealingDeque& local);
+  // Returns the next task for a thread owning `local`, looking at `local`
+  // first, then at the injection queue, then stealing from other deques.
+  detail::WorkStealingTask* findTask(detail::WorkStealingDeque& local, size_t seed);
+  detail::WorkStealingTask* stealFromOthers(detail::WorkStealingDeque& local, size_t seed);
+  bool hasVisibleWork();
+  // Called after making new work visible.
+  void notifyWork();
+
+  std::vector<std::unique_ptr<detail::WorkStealingDeque>> deques_;
+  // deques_[0, size()) belong to workers, the rest are lent to external
+  // threads for the duration of a parallelFor call.
+  std::unique_ptr<std::atomic<bool>[]> external_in_use_;
+  std::vector<std::thread> threads_;
+
+  // Tasks submitted through run() from threads without a deque.
+  std::mutex injection_mutex_;
+  std::deque<detail::WorkStealingTask*> injection_;
+  std::atomic<size_t> injection_size_{0};
+
+  std::mutex sleep_mutex_;
+  std::condition_variable sleep_cv_;
+  std::atomic<int> num_sleeping_{0};
+  uint64_t wake_epoch_{0};
+  std::atomic<size_t> num_busy_{0};
+  std::atomic<bool> running_{true};
+};
+
+} // namespace c10
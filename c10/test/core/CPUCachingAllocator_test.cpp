@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include <c10/core/CPUAllocator.h>
+#include <c10/core/CPUCachingAllocator.h>
+
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace CPUCachingAllocator = c10::CPUCachingAllocator;
+
+namespace {
+
+bool isAligned(const void* ptr) {
+  return reinterpret_cast<uintptr_t>(ptr) % c10::gAlignment == 0;
+}
+
+} // namespace
+
+TEST(CPUCachingAllocatorTest, ReusesFreedBlocks) {
+  auto* allocator = CPUCachingAllocator::get();
+  CPUCachingAllocator::emptyCache();
+  auto before = CPUCachingAllocator::getStats();
+
+  void* first;
+  {
+    auto ptr = allocator->allocate(1000);
+    first = ptr.get();
+    ASSERT_NE(first, nullptr);
+    EXPECT_TRUE(isAligned(first));
+    std::memset(first, 1, 1000);
+  }
+  // Same size class (1000 and 1010 both round up to 1024 bytes).
+  auto ptr = allocator->allocate(1010);
+  EXPECT_EQ(ptr.get(), first);
+
+  auto after = CPUCachingAllocator::getStats();
+  EXPECT_EQ(after.num_allocations - before.num_allocations, 2);
+  EXPECT_EQ(after.num_cache_hits - before.num_cache_hits, 1);
+  EXPECT_EQ(after.allocated_bytes - before.allocated_bytes, 1024);
+  EXPECT_GT(after.hitRate(), 0.0);
+}
+
+TEST(CPUCachingAllocatorTest, SizeClasses) {
+  auto* allocator = CPUCachingAllocator::get();
+  std::vector<size_t> sizes = {1, 63, 64, 65, 511, 512, 513, 4097, 1 << 20,
+                               (1 << 20) + 1, (size_t(1) << 28) + 1};
+  for (size_t nbytes : sizes) {
+    auto before = CPUCachingAllocator::getStats();
+    auto ptr = allocator->allocate(nbytes);
+    ASSERT_NE(ptr.get(), nullptr);
+    EXPECT_TRUE(isAligned(ptr.get()));
+    auto rounded = CPUCachingAllocator::getStats().allocated_bytes -
+        before.allocated_bytes;
+    EXPECT_GE(rounded, (int64_t)nbytes);
+    // At most 25% (or one 64 byte step) of rounding waste.
+    EXPECT_LE(rounded, (int64_t)std::max(nbytes + 63, nbytes + nbytes / 4));
+    std::memset(ptr.get(), 0, nbytes);
+  }
+}
+
+TEST(CPUCachingAllocatorTest, ZeroSizedAllocation) {
+  auto ptr = CPUCachingAllocator::get()->allocate(0);
+  EXPECT_EQ(ptr.get(), nullptr);
+}
+
+TEST(CPUCachingAllocatorTest, EmptyCacheReleasesMemory) {
+  auto* allocator = CPUCachingAllocator::get();
+  { auto ptr = allocator->allocate(4 << 20); }
+  EXPECT_GE(CPUCachingAllocator::getStats().cached_bytes, 4 << 20);
+  CPUCachingAllocator::emptyCache();
+  EXPECT_EQ(CPUCachingAllocator::getStats().cached_bytes, 0);
+}
+
+TEST(CPUCachingAllocatorTest, MaxCachedBytes) {
+  auto* allocator = CPUCachingAllocator::get();
+  CPUCachingAllocator::emptyCache();
+  CPUCachingAllocator::setMaxCachedBytes(0);
+  // Too large for the thread cache, so it has to go through the global pool.
+  { auto ptr = allocator->allocate(4 << 20); }
+  EXPECT_EQ(CPUCachingAllocator::getStats().cached_bytes, 0);
+  CPUCachingAllocator::setMaxCachedBytes(size_t(1) << 30);
+  { auto ptr = allocator->allocate(4 << 20); }
+  EXPECT_GE(CPUCachingAllocator::getStats().cached_bytes, 4 << 20);
+  CPUCachingAllocator::emptyCache();
+}
+
+TEST(CPUCachingAllocatorTest, FreeOnOtherThread) {
+  auto* allocator = CPUCachingAllocator::get();
+  CPUCachingAllocator::emptyCache();
+  auto before = CPUCachingAllocator::getStats();
+  std::vector<c10::DataPtr> ptrs;
+  for (int i = 0; i < 100; ++i) {
+    ptrs.push_back(allocator->allocate(256));
+  }
+  // The thread frees into its own cache and hands it to the global pool on
+  // exit, where this thread can pick the blocks up again.
+  std::thread([&] { ptrs.clear(); }).join();
+  for (int i = 0; i < 100; ++i) {
+    ptrs.push_back(allocator->allocate(256));
+  }
+  auto after = CPUCachingAllocator::getStats();
+  EXPECT_EQ(after.num_cache_hits - before.num_cache_hits, 100);
+  EXPECT_EQ(after.allocated_bytes - before.allocated_bytes, 100 * 256);
+}
+
+TEST(CPUCachingAllocatorTest, Enable) {
+  auto* previous = c10::GetCPUAllocator();
+  auto ptr = previous->allocate(100);
+  CPUCachingAllocator::enable();
+  EXPECT_EQ(c10::GetCPUAllocator(), CPUCachingAllocator::get());
+  // Memory from the previous allocator is still freed by its own deleter.
+  ptr.clear();
+  c10::SetCPUAllocator(previous);
+}
@@ -0,0 +1,203 @@
+#include <gtest/gtest.h>
+
+#include <c10/core/work_stealing_pool.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using c10::WorkStealingPool;
+
+namespace {
+
+struct CountingTask : c10::detail::WorkStealingTask {
+  explicit CountingTask(int id) : id(id) {}
+  void execute(WorkStealingPool&, c10::detail::WorkStealingDeque&) override {}
+  int id;
+};
+
+void expectEachIndexVisitedOnce(
+    WorkStealingPool& pool,
+    int64_t n,
+    int64_t grain_size) {
+  std::vector<std::atomic<int>> visits(n);
+  for (auto& v : visits) {
+    v.store(0);
+  }
+  pool.parallelFor(0, n, grain_size, [&](int64_t begin, int64_t end) {
+    ASSERT_LT(begin, end);
+    for (int64_t i = begin; i < end; ++i) {
+      visits[i].fetch_add(1);
+    }
+  });
+  for (int64_t i = 0; i < n; ++i) {
+    ASSERT_EQ(visits[i].load(), 1) << "index " << i;
+  }
+}
+
+} // namespace
+
+TEST(WorkStealingDequeTest, OwnerIsLifoThiefIsFifo) {
+  c10::detail::WorkStealingDeque deque(/*log_capacity=*/1);
+  std::vector<std::unique_ptr<CountingTask>> tasks;
+  // Push past the initial capacity to exercise growing.
+  for (int i = 0; i < 10; ++i) {
+    tasks.emplace_back(new CountingTask(i));
+    deque.push(tasks.back().get());
+  }
+  EXPECT_EQ(static_cast<CountingTask*>(deque.steal())->id, 0);
+  EXPECT_EQ(static_cast<CountingTask*>(deque.pop())->id, 9);
+  EXPECT_EQ(static_cast<CountingTask*>(deque.steal())->id, 1);
+  for (int i = 8; i >= 2; --i) {
+    EXPECT_EQ(static_cast<CountingTask*>(deque.pop())->id, i);
+  }
+  EXPECT_EQ(deque.pop(), nullptr);
+  EXPECT_EQ(deque.steal(), nullptr);
+  EXPECT_TRUE(deque.empty());
+}
+
+TEST(WorkStealingDequeTest, ConcurrentStealsTakeEachTaskOnce) {
+  constexpr int kTasks = 100000;
+  constexpr int kThieves = 3;
+  c10::detail::WorkStealingDeque deque;
+  std::vector<std::unique_ptr<CountingTask>> tasks;
+  for (int i = 0; i < kTasks; ++i) {
+    tasks.emplace_back(new CountingTask(i));
+  }
+  std::vector<std::atomic<int>> taken(kTasks);
+  for (auto& t : taken) {
+    t.store(0);
+  }
+  std::atomic<bool> done{false};
+  std::vector<std::thread> thieves;
+  for (int i = 0; i < kThieves; ++i) {
+    thieves.emplace_back([&] {
+      while (!done.load() || !deque.empty()) {
+        if (auto* task = deque.steal()) {
+          taken[static_cast<CountingTask*>(task)->id].fetch_add(1);
+        }
+      }
+    });
+  }
+  for (int i = 0; i < kTasks; ++i) {
+    deque.push(tasks[i].get());
+    if (i % 3 == 0) {
+      if (auto* task = deque.pop()) {
+        taken[static_cast<CountingTask*>(task)->id].fetch_add(1);
+      }
+    }
+  }
+  while (auto* task = deque.pop()) {
+    taken[static_cast<CountingTask*>(task)->id].fetch_add(1);
+  }
+  done.store(true);
+  for (auto& t : thieves) {
+    t.join();
+  }
+  for (int i = 0; i < kTasks; ++i) {
+    ASSERT_EQ(taken[i].load(), 1) << "task " << i;
+  }
+}
+
+TEST(WorkStealingPoolTest, ParallelForCoversRange) {
+  WorkStealingPool pool(4);
+  expectEachIndexVisitedOnce(pool, 1, 1);
+  expectEachIndexVisitedOnce(pool, 1000, 1);
+  expectEachIndexVisitedOnce(pool, 1000, 0);
+  expectEachIndexVisitedOnce(pool, 100000, 37);
+  expectEachIndexVisitedOnce(pool, 100000, 1000000);
+}
+
+TEST(WorkStealingPoolTest, ParallelForRespectsGrainSize) {
+  WorkStealingPool pool(4);
+  std::atomic<int64_t> smallest{INT64_MAX};
+  pool.parallelFor(0, 100000, 1000, [&](int64_t begin, int64_t end) {
+    int64_t len = end - begin;
+    int64_t cur = smallest.load();
+    while (len < cur && !smallest.compare_exchange_weak(cur, len)) {
+    }
+  });
+  EXPECT_GE(smallest.load(), 1000);
+}
+
+TEST(WorkStealingPoolTest, ParallelForWithoutWorkers) {
+  WorkStealingPool pool(0);
+  expectEachIndexVisitedOnce(pool, 1000, 1);
+}
+
+TEST(WorkStealingPoolTest, ParallelForRethrows) {
+  WorkStealingPool pool(4);
+  EXPECT_THROW(
+      pool.parallelFor(
+          0,
+          1000,
+          1,
+          [](int64_t begin, int64_t end) {
+            if (begin <= 500 && 500 < end) {
+              throw std::runtime_error("boom");
+            }
+          }),
+      std::runtime_error);
+  // The pool is still usable afterwards.
+  expectEachIndexVisitedOnce(pool, 1000, 1);
+}
+
+TEST(WorkStealingPoolTest, NestedParallelFor) {
+  WorkStealingPool pool(4);
+  std::atomic<int64_t> sum{0};
+  pool.parallelFor(0, 16, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; ++i) {
+      pool.parallelFor(0, 1000, 10, [&](int64_t b, int64_t e) {
+        sum.fetch_add(e - b);
+      });
+    }
+  });
+  EXPECT_EQ(sum.load(), 16 * 1000);
+}
+
+TEST(WorkStealingPoolTest, ConcurrentExternalCallers) {
+  WorkStealingPool pool(4);
+  // More callers than external deques: the extra ones run inline.
+  std::vector<std::thread> callers;
+  std::atomic<int64_t> sum{0};
+  const int num_callers = WorkStealingPool::kMaxExternalThreads + 4;
+  for (int c = 0; c < num_callers; ++c) {
+    callers.emplace_back([&] {
+      for (int rep = 0; rep < 20; ++rep) {
+        pool.parallelFor(0, 10000, 16, [&](int64_t b, int64_t e) {
+          sum.fetch_add(e - b);
+        });
+      }
+    });
+  }
+  for (auto& t : callers) {
+    t.join();
+  }
+  EXPECT_EQ(sum.load(), int64_t(num_callers) * 20 * 10000);
+}
+
+TEST(WorkStealingPoolTest, RunExecutesTasks) {
+  WorkStealingPool pool(2);
+  EXPECT_EQ(pool.size(), 2);
+  EXPECT_FALSE(pool.inThreadPool());
+  EXPECT_EQ(pool.currentWorkerIndex(), -1);
+
+  constexpr int kTasks = 1000;
+  std::atomic<int> done{0};
+  std::atomic<int> in_pool{0};
+  for (int i = 0; i < kTasks; ++i) {
+    pool.run([&] {
+      if (pool.inThreadPool() && pool.currentWorkerIndex() >= 0) {
+        in_pool.fetch_add(1);
+      }
+      done.fetch_add(1);
+    });
+  }
+  // A throwing task must not take down the worker.
+  pool.run([] { throw std::runtime_error("ignored"); });
+  while (done.load() != kTasks) {
+    std::this_thread::yield();
+  }
+  EXPECT_EQ(in_pool.load(), kTasks);
+}
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+
+#include <c10/core/CPUAllocator.h>
+#include <c10/util/numa.h>
+
+#include <cstring>
+
+namespace {
+
+// Restores the process-wide NUMA settings touched by a test.
+struct NUMAStateGuard {
+  NUMAStateGuard()
+      : enabled_(FLAGS_caffe2_cpu_numa_enabled), policy_(c10::GetNUMAPolicy()) {}
+  ~NUMAStateGuard() {
+    c10::SetNUMAPolicy(policy_);
+    FLAGS_caffe2_cpu_numa_enabled = enabled_;
+  }
+
+ private:
+  bool enabled_;
+  c10::NUMAPolicy policy_;
+};
+
+} // namespace
+
+TEST(NUMATest, SetPolicyKeepsNUMADisabled) {
+  NUMAStateGuard state;
+  FLAGS_caffe2_cpu_numa_enabled = false;
+  c10::SetNUMAPolicy(c10::NUMAPolicy::Interleave);
+  EXPECT_EQ(c10::GetNUMAPolicy(), c10::NUMAPolicy::Interleave);
+  EXPECT_FALSE(FLAGS_caffe2_cpu_numa_enabled);
+  EXPECT_FALSE(c10::IsNUMAEnabled());
+}
+
+TEST(NUMATest, AllocateUnderEveryPolicy) {
+  NUMAStateGuard state;
+  FLAGS_caffe2_cpu_numa_enabled = true;
+  constexpr size_t kBytes = 1 << 20;
+  for (auto policy :
+       {c10::NUMAPolicy::Local,
+        c10::NUMAPolicy::Interleave,
+        c10::NUMAPolicy::FirstTouch}) {
+    c10::SetNUMAPolicy(policy);
+    void* data = c10::alloc_cpu(kBytes);
+    std::memset(data, 0, kBytes);
+    c10::free_cpu(data);
+  }
+}
+
+TEST(NUMATest, PlacementGuard) {
+  NUMAStateGuard state;
+  FLAGS_caffe2_cpu_numa_enabled = true;
+  c10::SetNUMAPolicy(c10::NUMAPolicy::Interleave);
+  constexpr size_t kBytes = 1 << 20;
+  void* data;
+  {
+    c10::NUMAPlacementGuard guard(0);
+    data = c10::alloc_cpu(kBytes);
+  }
+  std::memset(data, 0, kBytes);
+  if (c10::IsNUMAEnabled()) {
+    EXPECT_EQ(c10::GetNUMANode(data), 0);
+    EXPECT_FALSE(c10::GetNUMANodeCPUs(0).empty());
+  } else {
+    EXPECT_EQ(c10::GetNUMANode(data), -1);
+    EXPECT_TRUE(c10::GetNUMANodeCPUs(0).empty());
+  }
+  c10::free_cpu(data);
+}
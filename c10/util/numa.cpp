@@ -2,6 +2,8 @@
 
 C10_DEFINE_bool(caffe2_cpu_numa_enabled, false, "Use NUMA whenever possible.");
 
+#include <atomic>
+
 #if defined(__linux__) && defined(C10_USE_NUMA) && !defined(C10_MOBILE)
 #include <numa.h>
 #include <numaif.h>
@@ -14,6 +16,15 @@ C10_DEFINE_bool(caffe2_cpu_numa_enabled, false, "Use NUMA whenever possible.");
 
 namespace c10 {
 
+namespace {
+
+std::atomic<NUMAPolicy> numa_policy{NUMAPolicy::Local};
+
+// Node set by NUMAPlacementGuard, -1 if none
+thread_local int placement_numa_node = -1;
+
+} // namespace
+
 #ifdef C10_ENABLE_NUMA
 bool IsNUMAEnabled() {
   return FLAGS_caffe2_cpu_numa_enabled && numa_available() >= 0;
@@ -103,6 +114,53 @@ int GetCurrentNUMANode() {
   return n;
 }
 
+std::vector<int> GetNUMANodeCPUs(int numa_node_id) {
+  std::vector<int> cpus;
+  if (numa_node_id < 0) {
+    return cpus;
+  }
+  if (!IsNUMAEnabled()) {
+    return cpus;
+  }
+
+  TORCH_CHECK(
+      numa_node_id <= numa_max_node(),
+      "NUMA node id ",
+      numa_node_id,
+      " is unavailable");
+
+  auto bm = numa_allocate_cpumask();
+  if (numa_node_to_cpus(numa_node_id, bm) == 0) {
+    for (unsigned int cpu = 0; cpu < bm->size; ++cpu) {
+      if (numa_bitmask_isbitset(bm, cpu)) {
+        cpus.push_back(cpu);
+      }
+    }
+  }
+  numa_bitmask_free(bm);
+  return cpus;
+}
+
+void NUMAInterleave(void* ptr, size_t size) {
+  if (!IsNUMAEnabled()) {
+    return;
+  }
+  AT_ASSERT(ptr);
+
+  uintptr_t page_start_ptr =
+      ((reinterpret_cast<uintptr_t>(ptr)) & ~(getpagesize() - 1));
+  ptrdiff_t offset = reinterpret_cast<uintptr_t>(ptr) - page_start_ptr;
+  TORCH_CHECK(
+      mbind(
+          reinterpret_cast<void*>(page_start_ptr),
+          size + offset,
+          MPOL_INTERLEAVE,
+          numa_all_nodes_ptr->maskp,
+          numa_all_nodes_ptr->size + 1,
+          MPOL_MF_MOVE) == 0,
+      "Could not interleave memory across NUMA nodes");
+}
+
 #else // C10_ENABLE_NUMA
 
 bool IsNUMAEnabled() {
@@ -127,6 +185,50 @@ int GetCurrentNUMANode() {
   return -1;
 }
 
+std::vector<int> GetNUMANodeCPUs(int numa_node_id) {
+  return {};
+}
+
+void NUMAInterleave(void* ptr, size_t size) {
+}
+
 #endif // C10_NUMA_ENABLED
 
+void SetNUMAPolicy(NUMAPolicy policy) {
+  numa_policy.store(policy);
+}
+
+NUMAPolicy GetNUMAPolicy() {
+  return numa_policy.load();
+}
+
+void NUMAPlace(void* ptr, size_t size) {
+  if (!IsNUMAEnabled()) {
+    return;
+  }
+  if (placement_numa_node >= 0) {
+    NUMAMove(ptr, size, placement_numa_node);
+    return;
+  }
+  switch (GetNUMAPolicy()) {
+    case NUMAPolicy::Local:
+      NUMAMove(ptr, size, GetCurrentNUMANode());
+      break;
+    case NUMAPolicy::Interleave:
+      NUMAInterleave(ptr, size);
+      break;
+    case NUMAPolicy::FirstTouch:
+      break;
+  }
+}
+
+NUMAPlacementGuard::NUMAPlacementGuard(int numa_node_id)
+    : prev_numa_node_id_(placement_numa_node) {
+  placement_numa_node = numa_node_id;
+}
+
+NUMAPlacementGuard::~NUMAPlacementGuard() {
+  placement_numa_node = prev_numa_node_id_;
+}
+
 } // namespace c10
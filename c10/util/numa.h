@@ -3,6 +3,8 @@
 #include <c10/util/Logging.h>
 #include <c10/util/Optional.h>
 
+#include <vector>
+
 C10_DECLARE_bool(caffe2_cpu_numa_enabled);
 
 namespace c10 {
@@ -37,4 +39,58 @@ C10_API void NUMAMove(void* ptr, size_t size, int numa_node_id);
  */
 C10_API int GetCurrentNUMANode();
 
+/**
+ * Get the ids of the CPUs belonging to a NUMA node
+ */
+C10_API std::vector<int> GetNUMANodeCPUs(int numa_node_id);
+
+/**
+ * Spread the memory pointed to by `ptr` of a given size page by page over all
+ * NUMA nodes
+ */
+C10_API void NUMAInterleave(void* ptr, size_t size);
+
+/**
+ * Placement policy for CPU memory obtained through alloc_cpu:
+ *  - Local: bind the pages to the NUMA node of the allocating thread. This is
+ *    the default.
+ *  - Interleave: spread the pages over all nodes, for data that threads on
+ *    every node read, e.g. weights shared by per-socket workers.
+ *  - FirstTouch: leave placement to the kernel, which puts every page on the
+ *    node of the thread that first writes to it.
+ */
+enum class NUMAPolicy : int8_t { Local, Interleave, FirstTouch };
+
+/**
+ * Set the process-wide placement policy. It only takes effect while NUMA
+ * support is enabled with caffe2_cpu_numa_enabled, which is off by default
+ * and left alone here.
+ */
+C10_API void SetNUMAPolicy(NUMAPolicy policy);
+
+C10_API NUMAPolicy GetNUMAPolicy();
+
+/**
+ * Place freshly allocated memory according to the current policy, or on the
+ * node set by a NUMAPlacementGuard on this thread
+ */
+C10_API void NUMAPlace(void* ptr, size_t size);
+
+/**
+ * Bind the memory allocated by the current thread to a given NUMA node while
+ * the guard is alive, regardless of the policy. A negative id restores the
+ * policy. Memory recycled by a caching allocator keeps its old placement.
+ */
+class C10_API NUMAPlacementGuard {
+ public:
+  explicit NUMAPlacementGuard(int numa_node_id);
+  ~NUMAPlacementGuard();
+
+  NUMAPlacementGuard(const NUMAPlacementGuard&) = delete;
+  NUMAPlacementGuard& operator=(const NUMAPlacementGuard&) = delete;
+
+ private:
+  int prev_numa_node_id_;
+};
+
 } // namespace c10
@@ -1,7 +1,12 @@
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <cstdio>
 #include <cstring>
 #include <cerrno>
+#include <exception>
 #include <istream>
+#include <memory>
 #include <ostream>
 #include <fstream>
 
@@ -180,6 +185,7 @@ static size_t getPadding(
 }
 
 bool PyTorchStreamReader::hasRecord(const std::string& name) {
+  std::lock_guard<std::mutex> guard(reader_lock_);
   std::string ss = archive_name_plus_slash_ + name;
   mz_zip_reader_locate_file(ar_.get(), ss.c_str(), nullptr, 0);
   bool result = ar_->m_last_error != MZ_ZIP_FILE_NOT_FOUND;
@@ -191,6 +197,7 @@ bool PyTorchStreamReader::hasRecord(const std::string& name) {
 }
 
 std::vector<std::string> PyTorchStreamReader::getAllRecords() {
+  std::lock_guard<std::mutex> guard(reader_lock_);
   mz_uint num_files = mz_zip_reader_get_num_files(ar_.get());
   std::vector<std::string> out;
   char buf[MZ_ZIP_MAX_ARCHIVE_FILENAME_SIZE];
@@ -211,12 +218,64 @@ size_t PyTorchStreamReader::getRecordID(const std::string& name) {
   return result;
 }
 
+static int64_t read_le_16(uint8_t* buf) {
+  return buf[0] + (buf[1] << 8);
+}
+
+// offset of a record's data, which follows its variable-length local header
+static size_t getDataOffset(
+    const ReadAdapterInterface& in,
+    uint64_t local_header_ofs) {
+  uint8_t local_header[MZ_ZIP_LOCAL_DIR_HEADER_SIZE];
+  in.read(
+      local_header_ofs,
+      local_header,
+      MZ_ZIP_LOCAL_DIR_HEADER_SIZE,
+      "reading file header");
+  size_t filename_len = read_le_16(local_header + MZ_ZIP_LDH_FILENAME_LEN_OFS);
+  size_t extra_len = read_le_16(local_header + MZ_ZIP_LDH_EXTRA_LEN_OFS);
+  return local_header_ofs + MZ_ZIP_LOCAL_DIR_HEADER_SIZE + filename_len + extra_len;
+}
+
+// Records handed out in place and the ones getRecords() reads itself are not
+// read through miniz, so their CRC-32 is checked here. It doesn't touch the
+// archive and is called without holding reader_lock_.
+static void checkRecordCRC(
+    const std::string& name,
+    const void* data,
+    size_t size,
+    uint32_t crc32) {
+  mz_ulong crc =
+      mz_crc32(MZ_CRC32_INIT, static_cast<const mz_uint8*>(data), size);
+  if (crc != crc32) {
+    CAFFE_THROW("CRC-32 check failed for record ", name);
+  }
+}
+
 // return dataptr, size
 std::tuple<at::DataPtr, size_t> PyTorchStreamReader::getRecord(const std::string& name) {
+  std::unique_lock<std::mutex> guard(reader_lock_);
   size_t key = getRecordID(name);
   mz_zip_archive_file_stat stat;
   mz_zip_reader_file_stat(ar_.get(), key, &stat);
   valid("retrieving file meta-data for ", name.c_str());
+
+  // Records written uncompressed (as PyTorchStreamWriter does by default) can
+  // be handed out in place when the adapter has them in memory. Only aligned
+  // records qualify, since the result may back a tensor of any dtype; archives
+  // from writers that did not pad records take the copying path below.
+  if (stat.m_method == 0 && stat.m_comp_size == stat.m_uncomp_size) {
+    size_t offset = getDataOffset(*in_, stat.m_local_header_ofs);
+    if (offset % kFieldAlignment == 0) {
+      at::DataPtr alias = in_->aliasRange(offset, stat.m_uncomp_size);
+      if (alias) {
+        guard.unlock();
+        checkRecordCRC(name, alias.get(), stat.m_uncomp_size, stat.m_crc32);
+        return std::make_tuple(std::move(alias), stat.m_uncomp_size);
+      }
+    }
+  }
+
   void * ptr = malloc(stat.m_uncomp_size);
   mz_zip_reader_extract_to_mem(ar_.get(), key, ptr, stat.m_uncomp_size, 0);
   valid("reading file ", name.c_str());
@@ -225,23 +284,140 @@ std::tuple<at::DataPtr, size_t> PyTorchStreamReader::getRecord(const std::string
   return std::make_tuple(std::move(retval), stat.m_uncomp_size);
 }
 
-static int64_t read_le_16(uint8_t* buf) {
-  return buf[0] + (buf[1] << 8);
+namespace {
+
+// A stored record that getRecords() still has to read into `buf` and check,
+// or only check when it is aliased in place.
+struct PendingRead {
+  const std::string* name;
+  uint64_t offset;
+  size_t size;
+  uint32_t crc32;
+  void* buf;
+  bool aliased;
+};
+
+// State shared by the tasks of one getRecords() call. Tasks claim reads by
+// bumping `next`; ones that start after everything has been claimed touch
+// nothing but this struct, so it is reference counted rather than owned by
+// the caller.
+struct ParallelReadState {
+  std::vector<PendingRead> reads;
+  std::atomic<size_t> next{0};
+  std::mutex mutex;
+  std::condition_variable cv;
+  size_t done = 0;
+  std::exception_ptr error;
+};
+
+} // namespace
+
+std::vector<std::tuple<at::DataPtr, size_t>> PyTorchStreamReader::getRecords(
+    const std::vector<std::string>& names,
+    const std::function<void(std::function<void()>)>& launcher,
+    size_t max_parallelism) {
+  std::vector<std::tuple<at::DataPtr, size_t>> records(names.size());
+  auto state = std::make_shared<ParallelReadState>();
+  {
+    // Metadata lookups go through miniz and are done up front.
+    std::lock_guard<std::mutex> guard(reader_lock_);
+    for (size_t i = 0; i < names.size(); ++i) {
+      const std::string& name = names[i];
+      size_t key = getRecordID(name);
+      mz_zip_archive_file_stat stat;
+      mz_zip_reader_file_stat(ar_.get(), key, &stat);
+      valid("retrieving file meta-data for ", name.c_str());
+
+      if (stat.m_method == 0 && stat.m_comp_size == stat.m_uncomp_size) {
+        size_t offset = getDataOffset(*in_, stat.m_local_header_ofs);
+        // Same aliasing rules as getRecord().
+        if (offset % kFieldAlignment == 0) {
+          at::DataPtr alias = in_->aliasRange(offset, stat.m_uncomp_size);
+          if (alias) {
+            state->reads.push_back({&name,
+                                    offset,
+                                    stat.m_uncomp_size,
+                                    stat.m_crc32,
+                                    alias.get(),
+                                    /*aliased=*/true});
+            records[i] = std::make_tuple(std::move(alias), stat.m_uncomp_size);
+            continue;
+          }
+        }
+        void* ptr = malloc(stat.m_uncomp_size);
+        state->reads.push_back({&name,
+                                offset,
+                                stat.m_uncomp_size,
+                                stat.m_crc32,
+                                ptr,
+                                /*aliased=*/false});
+        records[i] = std::make_tuple(
+            at::DataPtr(ptr, ptr, free, at::kCPU), stat.m_uncomp_size);
+        continue;
+      }
+
+      // Compressed records are rare in TorchScript archives; let miniz
+      // inflate them here.
+      void* ptr = malloc(stat.m_uncomp_size);
+      mz_zip_reader_extract_to_mem(ar_.get(), key, ptr, stat.m_uncomp_size, 0);
+      valid("reading file ", name.c_str());
+      records[i] = std::make_tuple(
+          at::DataPtr(ptr, ptr, free, at::kCPU), stat.m_uncomp_size);
+    }
+  }
+
+  const size_t num_reads = state->reads.size();
+  if (num_reads == 0) {
+    return records;
+  }
+  const bool concurrent = in_->supportsConcurrentReads();
+  auto work = [this, state, concurrent]() {
+    size_t i;
+    while ((i = state->next++) < state->reads.size()) {
+      const PendingRead& r = state->reads[i];
+      try {
+        if (!r.aliased) {
+          if (concurrent) {
+            in_->read(r.offset, r.buf, r.size, "reading file");
+          } else {
+            std::lock_guard<std::mutex> guard(reader_lock_);
+            in_->read(r.offset, r.buf, r.size, "reading file");
+          }
+        }
+        checkRecordCRC(*r.name, r.buf, r.size, r.crc32);
+      } catch (...) {
+        std::lock_guard<std::mutex> guard(state->mutex);
+        if (!state->error) {
+          state->error = std::current_exception();
+        }
+      }
+      std::lock_guard<std::mutex> guard(state->mutex);
+      if (++state->done == state->reads.size()) {
+        state->cv.notify_all();
+      }
+    }
+  };
+  if (launcher) {
+    const size_t num_tasks = std::min(num_reads, max_parallelism);
+    for (size_t i = 1; i < num_tasks; ++i) {
+      launcher(work);
+    }
+  }
+  work();
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->cv.wait(lock, [&] { return state->done == num_reads; });
+  if (state->error) {
+    std::rethrow_exception(state->error);
+  }
+  return records;
 }
 
 size_t PyTorchStreamReader::getRecordOffset(const std::string& name) {
+  std::lock_guard<std::mutex> guard(reader_lock_);
   mz_zip_archive_file_stat stat;
   mz_zip_reader_file_stat(ar_.get(), getRecordID(name), &stat);
   valid("retrieving file meta-data for ", name.c_str());
-  uint8_t local_header[MZ_ZIP_LOCAL_DIR_HEADER_SIZE];
-  in_->read(
-      stat.m_local_header_ofs,
-      local_header,
-      MZ_ZIP_LOCAL_DIR_HEADER_SIZE,
-      "reading file header");
-  size_t filename_len = read_le_16(local_header + MZ_ZIP_LDH_FILENAME_LEN_OFS);
-  size_t extra_len = read_le_16(local_header + MZ_ZIP_LDH_EXTRA_LEN_OFS);
-  return stat.m_local_header_ofs + MZ_ZIP_LOCAL_DIR_HEADER_SIZE + filename_len + extra_len;
+  return getDataOffset(*in_, stat.m_local_header_ofs);
 }
 
 
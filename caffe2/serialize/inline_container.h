@@ -4,8 +4,11 @@
 #include <cstdio>
 #include <cstring>
 #include <fstream>
+#include <functional>
 #include <istream>
+#include <mutex>
 #include <ostream>
+#include <vector>
 
 #include <c10/core/Allocator.h>
 #include <c10/core/Backend.h>
@@ -113,7 +116,19 @@ class CAFFE2_API PyTorchStreamReader final {
   explicit PyTorchStreamReader(std::unique_ptr<ReadAdapterInterface> in);
 
   // return dataptr, size
+  // If the ReadAdapterInterface supports aliasRange() (e.g. MMapAdapter), an
+  // uncompressed record comes back pointing into the adapter's memory rather
+  // than as a fresh copy.
   std::tuple<at::DataPtr, size_t> getRecord(const std::string& name);
+  // Batched getRecord. The stored records are CRC-checked, and the ones that
+  // cannot be aliased read, by up to `max_parallelism` tasks run through
+  // `launcher` (e.g. at::launch); the calling thread takes part as well, so
+  // it is safe to pass a launcher whose tasks may not start until the call
+  // returns. An empty launcher reads everything on the calling thread.
+  std::vector<std::tuple<at::DataPtr, size_t>> getRecords(
+      const std::vector<std::string>& names,
+      const std::function<void(std::function<void()>)>& launcher = nullptr,
+      size_t max_parallelism = 8);
   size_t getRecordOffset(const std::string& name);
   bool hasRecord(const std::string& name);
   std::vector<std::string> getAllRecords();
@@ -136,6 +151,9 @@ class CAFFE2_API PyTorchStreamReader final {
   std::string archive_name_plus_slash_;
   std::unique_ptr<ReadAdapterInterface> in_;
   int64_t version_;
+  // Guards ar_, and in_ when it does not support concurrent reads, so that
+  // the reader can be shared by threads.
+  std::mutex reader_lock_;
 };
 
 class CAFFE2_API PyTorchStreamWriter final {
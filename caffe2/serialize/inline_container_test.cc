@@ -1,10 +1,14 @@
 #include <cstdio>
+#include <fstream>
 #include <string>
 #include <array>
+#include <thread>
+#include <vector>
 
 #include <gtest/gtest.h>
 
 #include "caffe2/serialize/inline_container.h"
+#include "caffe2/serialize/mmap_adapter.h"
 
 namespace caffe2 {
 namespace serialize {
@@ -63,6 +67,128 @@ TEST(PyTorchStreamWriterAndReader, SaveAndLoad) {
   ASSERT_EQ(memcmp(the_file.c_str() + off2, data2.data(), data2.size()), 0);
 }
 
+TEST(PyTorchStreamWriterAndReader, GetRecords) {
+  std::ostringstream oss;
+  PyTorchStreamWriter writer([&](const void* b, size_t n) -> size_t {
+    oss.write(static_cast<const char*>(b), n);
+    return oss ? n : 0;
+  });
+  std::vector<std::string> names;
+  std::vector<std::vector<char>> contents;
+  for (int i = 0; i < 50; ++i) {
+    names.push_back("data/" + c10::to_string(i));
+    contents.emplace_back(i * 37 + 1);
+    for (size_t j = 0; j < contents.back().size(); ++j) {
+      contents.back()[j] = static_cast<char>(i + j);
+    }
+    writer.writeRecord(
+        names.back(),
+        contents.back().data(),
+        contents.back().size(),
+        /*compress=*/i % 7 == 0);
+  }
+  writer.writeEndOfFile();
+  std::string the_file = oss.str();
+
+  std::vector<std::thread> threads;
+  auto launcher = [&](std::function<void()> fn) {
+    threads.emplace_back(std::move(fn));
+  };
+  {
+    std::istringstream iss(the_file);
+    PyTorchStreamReader reader(&iss);
+    auto records = reader.getRecords(names, launcher, 4);
+    for (auto& t : threads) {
+      t.join();
+    }
+    ASSERT_EQ(threads.size(), 3);
+    ASSERT_EQ(records.size(), names.size());
+    for (size_t i = 0; i < names.size(); ++i) {
+      ASSERT_EQ(std::get<1>(records[i]), contents[i].size());
+      ASSERT_EQ(
+          memcmp(
+              std::get<0>(records[i]).get(),
+              contents[i].data(),
+              contents[i].size()),
+          0);
+    }
+  }
+
+  // corrupt one byte of a stored record
+  size_t offset;
+  {
+    std::istringstream iss(the_file);
+    PyTorchStreamReader reader(&iss);
+    offset = reader.getRecordOffset(names[1]);
+  }
+  the_file[offset] ^= 1;
+  std::istringstream iss(the_file);
+  PyTorchStreamReader reader(&iss);
+  threads.clear();
+  ASSERT_ANY_THROW(reader.getRecords(names, launcher));
+  for (auto& t : threads) {
+    t.join();
+  }
+  ASSERT_ANY_THROW(reader.getRecords({names[1]}));
+  ASSERT_EQ(reader.getRecords({names[2]}).size(), 1);
+}
+
+#ifndef _WIN32
+TEST(PyTorchStreamWriterAndReader, MMapZeroCopy) {
+  const std::string file_name = "output_mmap.zip";
+  std::array<char, 127> data1;
+  for (int i = 0; i < data1.size(); ++i) {
+    data1[i] = data1.size() - i;
+  }
+  std::array<char, 64> data2;
+  for (int i = 0; i < data2.size(); ++i) {
+    data2[i] = i;
+  }
+  {
+    PyTorchStreamWriter writer(file_name);
+    writer.writeRecord("key1", data1.data(), data1.size());
+    writer.writeRecord("key2", data2.data(), data2.size(), /*compress=*/true);
+    writer.writeEndOfFile();
+  }
+
+  at::DataPtr data_ptr1;
+  at::DataPtr data_ptr2;
+  int64_t size;
+  {
+    PyTorchStreamReader reader(std::make_unique<MMapAdapter>(file_name));
+    std::tie(data_ptr1, size) = reader.getRecord("key1");
+    ASSERT_EQ(size, data1.size());
+    // uncompressed records alias the mapping, compressed ones are copied
+    ASSERT_NE(data_ptr1.get_deleter(), &free);
+    std::tie(data_ptr2, size) = reader.getRecord("key2");
+    ASSERT_EQ(size, data2.size());
+    ASSERT_EQ(data_ptr2.get_deleter(), &free);
+  }
+  // both outlive the reader and its adapter
+  ASSERT_EQ(memcmp(data_ptr1.get(), data1.data(), data1.size()), 0);
+  ASSERT_EQ(memcmp(data_ptr2.get(), data2.data(), data2.size()), 0);
+
+  // writes through the alias stay private to this process
+  static_cast<char*>(data_ptr1.get())[0] = 42;
+  PyTorchStreamReader reader(std::make_unique<MMapAdapter>(file_name));
+  at::DataPtr reread;
+  std::tie(reread, size) = reader.getRecord("key1");
+  ASSERT_EQ(memcmp(reread.get(), data1.data(), data1.size()), 0);
+
+  // aliased records are still checked against their CRC-32
+  size_t offset = reader.getRecordOffset("key1");
+  {
+    std::fstream file(
+        file_name, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(offset);
+    file.put(static_cast<char>(data1[0] + 1));
+  }
+  PyTorchStreamReader corrupted(std::make_unique<MMapAdapter>(file_name));
+  ASSERT_THROW(corrupted.getRecord("key1"), c10::Error);
+  std::remove(file_name.c_str());
+}
+#endif
+
 } // namespace
 } // namespace serialize
 } // namespace caffe2
@@ -0,0 +1,108 @@
+#include "caffe2/serialize/mmap_adapter.h"
+
+#include <cerrno>
+#include <cstring>
+
+#include <c10/util/Exception.h>
+#include "caffe2/core/common.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace caffe2 {
+namespace serialize {
+
+struct MMapAdapter::Mapping {
+  Mapping(char* data, size_t size) : data(data), size(size) {}
+  ~Mapping() {
+#ifndef _WIN32
+    if (data != nullptr) {
+      munmap(data, size);
+    }
+#endif
+  }
+
+  char* const data;
+  const size_t size;
+};
+
+namespace {
+
+void deleteMappingRef(void* ctx) {
+  delete static_cast<std::shared_ptr<void>*>(ctx);
+}
+
+} // namespace
+
+MMapAdapter::MMapAdapter(const std::string& file_name) {
+#ifdef _WIN32
+  AT_ERROR("MMapAdapter is not supported on Windows, file path: ", file_name);
+#else
+  int fd = open(file_name.c_str(), O_RDONLY);
+  if (fd == -1) {
+    AT_ERROR(
+        "open file failed, file path: ", file_name, ": ", strerror(errno));
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) == -1) {
+    int err = errno;
+    close(fd);
+    AT_ERROR("fstat failed, file path: ", file_name, ": ", strerror(err));
+  }
+  size_t size = file_stat.st_size;
+  char* data = nullptr;
+  // mmap rejects zero-length mappings; an empty file is left unmapped and
+  // fails later like any other malformed archive.
+  if (size > 0) {
+    // MAP_PRIVATE with PROT_WRITE keeps tensors built on top of the mapping
+    // writable: clean pages stay shared with the page cache, written pages
+    // become private copies.
+    void* ptr =
+        mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    if (ptr == MAP_FAILED) {
+      int err = errno;
+      close(fd);
+      AT_ERROR("mmap failed, file path: ", file_name, ": ", strerror(err));
+    }
+    data = static_cast<char*>(ptr);
+  }
+  // The mapping stays valid after the descriptor is closed.
+  close(fd);
+  mapping_ = std::make_shared<Mapping>(data, size);
+#endif
+}
+
+size_t MMapAdapter::size() const {
+  return mapping_->size;
+}
+
+size_t MMapAdapter::read(uint64_t pos, void* buf, size_t n, const char* what)
+    const {
+  if (pos > mapping_->size || n > mapping_->size - pos) {
+    AT_ERROR("mmap reader failed: ", what, ": read past end of file.");
+  }
+  std::memcpy(buf, mapping_->data + pos, n);
+  return n;
+}
+
+at::DataPtr MMapAdapter::aliasRange(uint64_t pos, size_t n) const {
+  if (n == 0 || pos > mapping_->size || n > mapping_->size - pos) {
+    return at::DataPtr();
+  }
+  // Each DataPtr holds its own reference to the mapping.
+  auto* ctx = new std::shared_ptr<void>(mapping_);
+  return at::DataPtr(mapping_->data + pos, ctx, deleteMappingRef, at::kCPU);
+}
+
+bool MMapAdapter::supportsConcurrentReads() const {
+  return true;
+}
+
+MMapAdapter::~MMapAdapter() {}
+
+} // namespace serialize
+} // namespace caffe2
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "c10/macros/Macros.h"
+#include "caffe2/serialize/read_adapter_interface.h"
+
+namespace caffe2 {
+namespace serialize {
+
+// Reads a file through a private, copy-on-write memory mapping.
+//
+// aliasRange() hands out DataPtrs that point straight into the mapping, so
+// records stored uncompressed in an archive can be used without copying them
+// and the pages backing them are shared, through the page cache, with every
+// other process that maps the same file. Writing through such a DataPtr only
+// copies the touched pages into the writing process; the file is never
+// modified. The mapping is released once the adapter and every DataPtr
+// obtained from it are gone.
+//
+// The file must not be truncated while it is mapped: accessing pages past
+// the new end of file raises SIGBUS. Only available on POSIX systems.
+class CAFFE2_API MMapAdapter final : public ReadAdapterInterface {
+ public:
+  C10_DISABLE_COPY_AND_ASSIGN(MMapAdapter);
+  explicit MMapAdapter(const std::string& file_name);
+  size_t size() const override;
+  size_t read(uint64_t pos, void* buf, size_t n, const char* what = "")
+      const override;
+  at::DataPtr aliasRange(uint64_t pos, size_t n) const override;
+  bool supportsConcurrentReads() const override;
+  ~MMapAdapter();
+
+ private:
+  struct Mapping;
+  std::shared_ptr<Mapping> mapping_;
+};
+
+} // namespace serialize
+} // namespace caffe2
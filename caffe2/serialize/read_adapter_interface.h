@@ -3,6 +3,7 @@
 #include <cstddef>
 #include <cstdint>
 
+#include "c10/core/Allocator.h"
 #include "c10/macros/Macros.h"
 
 namespace caffe2 {
@@ -16,6 +17,16 @@ class CAFFE2_API ReadAdapterInterface {
   virtual size_t size() const = 0;
   virtual size_t read(uint64_t pos, void* buf, size_t n, const char* what = "")
       const = 0;
+  // Adapters whose content is already addressable in memory (e.g. a mapped
+  // file) can return a DataPtr pointing directly at bytes [pos, pos + n).
+  // The DataPtr must keep that memory valid after the adapter is destroyed.
+  // Returning an empty DataPtr (the default) makes the caller copy the bytes
+  // out with read() instead.
+  virtual at::DataPtr aliasRange(uint64_t pos, size_t n) const;
+  // Whether read() may be called from several threads at once. Readers
+  // serialize their calls to read() on adapters that return false (the
+  // default).
+  virtual bool supportsConcurrentReads() const;
   virtual ~ReadAdapterInterface();
 };
 
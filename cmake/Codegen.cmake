@@ -110,6 +110,14 @@ if(INTERN_BUILD_ATEN_OPS)
     endif(MSVC)
   endif(CXX_AVX2_FOUND)
 
+  # The Vec512 headers are disabled under MSVC (see vec512_float.h), so only
+  # build the AVX512 copy of the kernels where it can actually be used.
+  if(CXX_AVX512_FOUND AND NOT MSVC)
+    set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DHAVE_AVX512_CPU_DEFINITION")
+    list(APPEND CPU_CAPABILITY_NAMES "AVX512")
+    list(APPEND CPU_CAPABILITY_FLAGS "${OPT_FLAG} -mavx512f -mavx512bw -mavx512dq -mavx512vl -mfma ${CPU_NO_AVX256_SPLIT_FLAGS}")
+  endif(CXX_AVX512_FOUND AND NOT MSVC)
+
   list(LENGTH CPU_CAPABILITY_NAMES NUM_CPU_CAPABILITY_NAMES)
   math(EXPR NUM_CPU_CAPABILITY_NAMES "${NUM_CPU_CAPABILITY_NAMES}-1")
 
@@ -126,6 +134,11 @@ if(INTERN_BUILD_ATEN_OPS)
       else(MSVC)
         set(EXTRA_FLAGS "-DCPU_CAPABILITY=${CPU_CAPABILITY} -DCPU_CAPABILITY_${CPU_CAPABILITY}")
       endif(MSVC)
+      # AVX512 is a superset of AVX2: keep the existing AVX2-only code paths
+      # (Vec256 specializations, quantized kernels) enabled in the AVX512 copy.
+      if("${CPU_CAPABILITY}" STREQUAL "AVX512")
+        set(EXTRA_FLAGS "${EXTRA_FLAGS} -DCPU_CAPABILITY_AVX2")
+      endif()
       # Disable certain warnings for GCC-9.X
       if(CMAKE_COMPILER_IS_GNUCXX AND (CMAKE_CXX_COMPILER_VERSION VERSION_GREATER 9.0.0))
         if(("${NAME}" STREQUAL "native/cpu/GridSamplerKernel.cpp") AND ("${CPU_CAPABILITY}" STREQUAL "DEFAULT"))
@@ -1552,7 +1552,7 @@ if(NOT INTERN_BUILD_MOBILE)
     add_compile_options(-DUSE_GCC_GET_CPUID)
   endif()
 
-  find_package(AVX) # checks AVX and AVX2
+  find_package(AVX) # checks AVX, AVX2 and AVX512
 
   # we don't set -mavx and -mavx2 flags globally, but only for specific files
   # however, we want to enable the AVX codepaths, so we still need to
@@ -1565,6 +1565,9 @@ if(NOT INTERN_BUILD_MOBILE)
     message(STATUS "AVX2 compiler support found")
     add_compile_options(-DUSE_AVX2)
   endif()
+  if(C_AVX512_FOUND)
+    message(STATUS "AVX512 compiler support found")
+  endif()
 
   if(WIN32 AND NOT CYGWIN)
     set(BLAS_INSTALL_LIBRARIES "OFF"
@@ -25,6 +25,21 @@ SET(AVX2_CODE "
   }
 ")
 
+SET(AVX512_CODE "
+  #include <immintrin.h>
+
+  int main()
+  {
+    __m512i a = _mm512_set1_epi16(0);
+    a = _mm512_abs_epi16(a);             // AVX512BW
+    __m512d b = _mm512_cvtepi64_pd(a);   // AVX512DQ
+    __m256i c = _mm256_mask_mov_epi32(_mm512_castsi512_si256(a), 0, _mm256_set1_epi32(1)); // AVX512VL
+    (void)b;
+    (void)c;
+    return 0;
+  }
+")
+
 MACRO(CHECK_SSE lang type flags)
   SET(__FLAG_I 1)
   SET(CMAKE_REQUIRED_FLAGS_SAVE ${CMAKE_REQUIRED_FLAGS})
@@ -56,6 +71,8 @@ ENDMACRO()
 
 CHECK_SSE(C "AVX" " ;-mavx;/arch:AVX")
 CHECK_SSE(C "AVX2" " ;-mavx2 -mfma;/arch:AVX2")
+CHECK_SSE(C "AVX512" " ;-mavx512f -mavx512bw -mavx512dq -mavx512vl -mfma;/arch:AVX512")
 
 CHECK_SSE(CXX "AVX" " ;-mavx;/arch:AVX")
 CHECK_SSE(CXX "AVX2" " ;-mavx2 -mfma;/arch:AVX2")
+CHECK_SSE(CXX "AVX512" " ;-mavx512f -mavx512bw -mavx512dq -mavx512vl -mfma;/arch:AVX512")
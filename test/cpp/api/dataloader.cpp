@@ -8,6 +8,7 @@
 #include <c10/util/tempfile.h>
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <future>
 #include <iostream>
@@ -21,6 +22,10 @@
 #include <unordered_set>
 #include <vector>
 
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
 using namespace torch::data; // NOLINT
 
 const std::chrono::milliseconds kMillisecond(1);
@@ -485,6 +490,37 @@ TEST(DataTest, StackTransformWorksForTensorExample) {
   ASSERT_TRUE(second.data.allclose(torch::eye(4).slice(/*dim=*/0, 2, 4)));
 }
 
+TEST(DataTest, StackTransformReusesBuffersOfReleasedBatches) {
+  auto d = datasets::TensorDataset(torch::eye(4))
+               .map(transforms::Stack<TensorExample>(
+                   transforms::StackOptions().max_buffers(2)));
+
+  TensorExample batch = d.get_batch({0, 1});
+  void* first_buffer = batch.data.data_ptr();
+  // Still held, so the second batch needs another buffer.
+  TensorExample second = d.get_batch({2, 3});
+  ASSERT_NE(second.data.data_ptr(), first_buffer);
+  ASSERT_TRUE(batch.data.allclose(torch::eye(4).slice(/*dim=*/0, 0, 2)));
+  ASSERT_TRUE(second.data.allclose(torch::eye(4).slice(/*dim=*/0, 2, 4)));
+
+  // A view keeps the buffer in use too.
+  auto view = batch.data.view(-1);
+  batch = TensorExample(torch::Tensor());
+  TensorExample third = d.get_batch({1, 2});
+  ASSERT_NE(third.data.data_ptr(), first_buffer);
+  ASSERT_TRUE(third.data.allclose(torch::eye(4).slice(/*dim=*/0, 1, 3)));
+
+  view = torch::Tensor();
+  TensorExample fourth = d.get_batch({3, 0});
+  ASSERT_EQ(fourth.data.data_ptr(), first_buffer);
+  ASSERT_TRUE(fourth.data[0].allclose(torch::eye(4)[3]));
+  ASSERT_TRUE(fourth.data[1].allclose(torch::eye(4)[0]));
+
+  // Batches of a different size get a different buffer.
+  TensorExample last = d.get_batch({0});
+  ASSERT_EQ(last.data.sizes(), std::vector<int64_t>({1, 4}));
+}
+
 // Template classes cannot be nested in functions.
 template <typename Target>
 struct T : transforms::TensorTransform<Target> {
@@ -688,6 +724,58 @@ TEST(DataTest, QueueClearEmptiesTheQueue) {
   ASSERT_THROWS_WITH(queue.pop(1 * kMillisecond), "Timeout");
 }
 
+TEST(DataTest, QueuePushBlocksWhileFull) {
+  torch::data::detail::Queue<int> queue(2);
+  ASSERT_EQ(queue.capacity(), 2);
+  queue.push(1);
+  queue.push(2);
+  std::atomic<bool> pushed(false);
+  std::thread thread([&] {
+    queue.push(3);
+    pushed = true;
+  });
+  std::this_thread::sleep_for(20 * kMillisecond);
+  ASSERT_FALSE(pushed);
+  ASSERT_EQ(queue.pop(), 1);
+  thread.join();
+  ASSERT_TRUE(pushed);
+  ASSERT_EQ(queue.pop(), 2);
+  ASSERT_EQ(queue.pop(), 3);
+}
+
+TEST(DataTest, QueueMovesElements) {
+  torch::data::detail::Queue<std::unique_ptr<int>> queue;
+  queue.push(torch::make_unique<int>(1));
+  queue.push(torch::make_unique<int>(2));
+  ASSERT_EQ(*queue.pop(), 1);
+  ASSERT_EQ(queue.clear(), 1);
+}
+
+TEST(DataTest, QueueWithManyProducersAndConsumers) {
+  torch::data::detail::Queue<int64_t> queue(4);
+  const int64_t kThreads = 4;
+  const int64_t kElements = 10000;
+  std::atomic<int64_t> sum(0);
+  std::vector<std::thread> threads;
+  for (int64_t t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&] {
+      for (int64_t i = 0; i < kElements; ++i) {
+        queue.push(i);
+      }
+    });
+    threads.emplace_back([&] {
+      for (int64_t i = 0; i < kElements; ++i) {
+        sum += queue.pop();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(sum, kThreads * kElements * (kElements - 1) / 2);
+  ASSERT_EQ(queue.clear(), 0);
+}
+
 TEST(DataTest, DataShuttleCanPushAndPopJob) {
   torch::data::detail::DataShuttle<int, int> shuttle;
   shuttle.push_job(1);
@@ -1030,6 +1118,7 @@ TEST(DataLoaderTest, DataLoaderOptionsDefaultAsExpected) {
   ASSERT_EQ(full_options.max_jobs, 0);
   ASSERT_FALSE(full_options.timeout.has_value());
   ASSERT_TRUE(full_options.enforce_ordering);
+  ASSERT_FALSE(full_options.worker_processes);
 }
 
 TEST(DataLoaderTest, DataLoaderOptionsCoalesceOptionalValues) {
@@ -1455,6 +1544,119 @@ TEST(DataLoaderTest, TestExceptionsArePropagatedFromWorkers) {
   }
 }
 
+#ifndef _WIN32
+namespace worker_process_test {
+const size_t kSize = 20;
+
+// Records the process that loaded each example in its target.
+struct Dataset : datasets::Dataset<Dataset> {
+  torch::data::Example<> get(size_t index) override {
+    if (index == bad_index) {
+      throw std::invalid_argument("badness");
+    }
+    return {torch::full({3}, static_cast<int64_t>(index), torch::kLong),
+            torch::tensor(static_cast<int64_t>(::getpid()))};
+  }
+  torch::optional<size_t> size() const override {
+    return kSize;
+  }
+  size_t bad_index = kSize;
+};
+
+// Fills each example with its index using the intra-op pool, and records the
+// number of intra-op threads in its target.
+struct ParallelDataset : datasets::Dataset<ParallelDataset> {
+  torch::data::Example<> get(size_t index) override {
+    std::vector<int64_t> values(64);
+    at::parallel_for(0, values.size(), 1, [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; ++i) {
+        values[i] = index;
+      }
+    });
+    return {torch::tensor(values),
+            torch::tensor(static_cast<int64_t>(at::get_num_threads()))};
+  }
+  torch::optional<size_t> size() const override {
+    return kSize;
+  }
+};
+} // namespace worker_process_test
+
+TEST(DataLoaderTest, LoadsBatchesInWorkerProcesses) {
+  auto data_loader = torch::data::make_data_loader(
+      worker_process_test::Dataset{}.map(transforms::Stack<>()),
+      samplers::SequentialSampler(worker_process_test::kSize),
+      DataLoaderOptions().batch_size(4).workers(2).worker_processes(true));
+  for (size_t epoch = 0; epoch < 2; ++epoch) {
+    int64_t index = 0;
+    for (auto& batch : *data_loader) {
+      ASSERT_EQ(batch.data.sizes(), std::vector<int64_t>({4, 3}));
+      ASSERT_TRUE(batch.data.select(/*dim=*/1, 2).equal(
+          torch::arange(index, index + 4, torch::kLong)));
+      ASSERT_TRUE(batch.target.ne(::getpid()).all().item<bool>());
+      index += 4;
+    }
+    ASSERT_EQ(index, worker_process_test::kSize);
+  }
+}
+
+TEST(DataLoaderTest, LoadsUncollatedBatchesInWorkerProcesses) {
+  auto data_loader = torch::data::make_data_loader(
+      worker_process_test::Dataset{},
+      samplers::SequentialSampler(worker_process_test::kSize),
+      DataLoaderOptions().batch_size(3).workers(3).worker_processes(true));
+  size_t index = 0;
+  for (auto& batch : *data_loader) {
+    for (auto& example : batch) {
+      ASSERT_TRUE(example.data.equal(
+          torch::full({3}, static_cast<int64_t>(index), torch::kLong)));
+      ++index;
+    }
+  }
+  ASSERT_EQ(index, worker_process_test::kSize);
+}
+
+TEST(DataLoaderTest, WorkerProcessesRunParallelWorkAfterForking) {
+  // Starts the intra-op pool, whose threads don't exist in the workers.
+  at::parallel_for(0, 1000, 1, [](int64_t, int64_t) {});
+  auto data_loader = torch::data::make_data_loader(
+      worker_process_test::ParallelDataset{}.map(transforms::Stack<>()),
+      samplers::SequentialSampler(worker_process_test::kSize),
+      DataLoaderOptions().batch_size(4).workers(2).worker_processes(true));
+  int64_t index = 0;
+  for (auto& batch : *data_loader) {
+    for (int64_t i = 0; i < 4; ++i) {
+      ASSERT_TRUE(batch.data[i].eq(index + i).all().item<bool>());
+    }
+#if !AT_PARALLEL_NATIVE_TBB
+    ASSERT_TRUE(batch.target.eq(1).all().item<bool>());
+#endif
+    index += 4;
+  }
+  ASSERT_EQ(index, worker_process_test::kSize);
+}
+
+TEST(DataLoaderTest, ExceptionsArePropagatedFromWorkerProcesses) {
+  worker_process_test::Dataset dataset;
+  dataset.bad_index = 0;
+  auto data_loader = torch::data::make_data_loader(
+      dataset,
+      samplers::SequentialSampler(worker_process_test::kSize),
+      DataLoaderOptions().workers(2).worker_processes(true));
+  try {
+    (void)*data_loader->begin();
+    FAIL() << "Expected a WorkerException";
+  } catch (torch::data::WorkerException& e) {
+    ASSERT_EQ(
+        e.what(),
+        std::string("Caught exception in DataLoader worker thread. "
+                    "Original message: badness"));
+    ASSERT_THROW(
+        std::rethrow_exception(e.original_exception), std::runtime_error);
+  }
+}
+#endif // _WIN32
+
 TEST(DataLoaderTest, StatefulDatasetWithNoWorkers) {
   const int kNumberOfExamplesAfterWhichTheDatasetExhausts = 10;
 
@@ -121,6 +121,34 @@ void testLiteInterpreterInline() {
   AT_ASSERT(output.toTensor().item<float>() == 7.0);
 }
 
+void testLiteInterpreterLoop() {
+  Module m("m");
+  m.register_parameter("scale", 2 * torch::ones({}), false);
+  m.register_parameter("bias", torch::ones({}), false);
+  // Attributes and loop-carried values feed operators in and out of the
+  // loop, so superinstructions are both jumped over and jumped into.
+  m.define(R"(
+    def forward(self, x, n: int):
+      y = x
+      for i in range(n):
+        if i % 2 == 0:
+          y = y * self.scale
+        else:
+          y = y + self.bias
+      return y + x
+  )");
+
+  std::vector<IValue> inputs({torch::ones({}), 5});
+  auto ref = m.forward(inputs);
+
+  std::stringstream ss;
+  m._save_for_mobile(ss);
+  mobile::Module bc = _load_for_mobile(ss);
+  auto res = bc.forward(inputs);
+  AT_ASSERT(res.toTensor().item<float>() == ref.toTensor().item<float>());
+  AT_ASSERT(res.toTensor().item<float>() == 15.0);
+}
+
 void testLiteInterpreterTuple() {
   Module m("m");
   m.define(R"JIT(
@@ -0,0 +1,149 @@
+#include <torch/csrc/jit/ir/ir.h>
+#include <torch/csrc/jit/ir/irparser.h>
+#include <torch/csrc/jit/passes/memory_planning.h>
+#include <torch/csrc/jit/runtime/interpreter.h>
+#include <torch/csrc/jit/testing/file_check.h>
+#include "test/cpp/jit/test_base.h"
+#include "test/cpp/jit/test_utils.h"
+
+#include <string>
+
+namespace torch {
+namespace jit {
+
+void testMemoryPlanning() {
+  const auto graph_string = R"IR(
+graph(%a : Float(4:4, 4:1),
+      %b : Float(4:4, 4:1)):
+  %one : int = prim::Constant[value=1]()
+  %c : Float(4:4, 4:1) = aten::add(%a, %b, %one)
+  %d : Float(4:4, 4:1) = aten::mul(%c, %b)
+  %e : Float(4:4, 4:1) = aten::mul(%d, %a)
+  %f : Float(4:4, 4:1) = aten::add(%e, %d, %one)
+  return (%f)
+  )IR";
+  {
+    // %c is dead by the time %e is computed, so they can share memory;
+    // %f is returned and has to be allocated normally.
+    auto graph = std::make_shared<Graph>();
+    parseIR(graph_string, graph.get());
+    auto stats = PlanMemory(graph);
+    ASSERT_EQ(stats.planned_values, 3);
+    ASSERT_EQ(stats.planned_bytes, 3 * 64);
+    ASSERT_EQ(stats.arena_bytes, 2 * 64);
+    testing::FileCheck()
+        .check_count("prim::AllocateArena", 1, /*exactly*/ true)
+        ->check_count("prim::ArenaTensor", 3, /*exactly*/ true)
+        ->run(*graph);
+
+    auto a = at::randn({4, 4});
+    auto b = at::randn({4, 4});
+    Code code(graph, "");
+    InterpreterState interp(code);
+    auto outputs = run(interp, {a, b});
+    auto c = a + b;
+    auto d = c * b;
+    auto expected = d * a + d;
+    ASSERT_TRUE(outputs[0].allclose(expected));
+    // Later runs reuse the arena.
+    outputs = run(interp, {b, a});
+    ASSERT_TRUE(outputs[0].allclose((b + a) * a * b + (b + a) * a));
+
+    // Inputs that don't match the recorded shapes or strides run unplanned.
+    auto small_a = at::randn({2, 2});
+    auto small_b = at::randn({2, 2});
+    outputs = run(interp, {small_a, small_b});
+    auto small_d = (small_a + small_b) * small_b;
+    ASSERT_TRUE(outputs[0].allclose(small_d * small_a + small_d));
+    outputs = run(interp, {a.t(), b});
+    auto t_d = (a.t() + b) * b;
+    ASSERT_TRUE(outputs[0].allclose(t_d * a.t() + t_d));
+  }
+  {
+    // Values without complete shapes are left alone.
+    auto graph = std::make_shared<Graph>();
+    parseIR(
+        R"IR(
+graph(%a : Tensor, %b : Tensor):
+  %one : int = prim::Constant[value=1]()
+  %c : Tensor = aten::add(%a, %b, %one)
+  %d : Tensor = aten::mul(%c, %b)
+  return (%d)
+  )IR",
+        graph.get());
+    auto stats = PlanMemory(graph);
+    ASSERT_EQ(stats.planned_values, 0);
+    testing::FileCheck().check_not("prim::AllocateArena")->run(*graph);
+  }
+  {
+    // A view keeps the memory it aliases alive until its own last use.
+    auto graph = std::make_shared<Graph>();
+    parseIR(
+        R"IR(
+graph(%a : Float(4:4, 4:1)):
+  %one : int = prim::Constant[value=1]()
+  %c : Float(4:4, 4:1) = aten::add(%a, %a, %one)
+  %v : Float(4:1, 4:4) = aten::t(%c)
+  %e : Float(4:4, 4:1) = aten::mul(%a, %a)
+  %f : Float(4:4, 4:1) = aten::add(%e, %v, %one)
+  return (%f)
+  )IR",
+        graph.get());
+    auto stats = PlanMemory(graph);
+    ASSERT_EQ(stats.planned_values, 2);
+    ASSERT_EQ(stats.arena_bytes, 2 * 64);
+  }
+  {
+    // %c is only used through the list after %e is computed, so it must not
+    // share memory with %e.
+    auto graph = std::make_shared<Graph>();
+    parseIR(
+        R"IR(
+graph(%a : Float(4:4, 4:1)):
+  %zero : int = prim::Constant[value=0]()
+  %one : int = prim::Constant[value=1]()
+  %c : Float(4:4, 4:1) = aten::add(%a, %a, %one)
+  %l : Tensor[] = prim::ListConstruct(%c)
+  %e : Float(4:4, 4:1) = aten::mul(%a, %a)
+  %f : Float(4:4, 4:1) = aten::cat(%l, %zero)
+  %g : Float(4:4, 4:1) = aten::add(%f, %e, %one)
+  return (%g)
+  )IR",
+        graph.get());
+    auto stats = PlanMemory(graph);
+    // All the planned values are live at aten::cat.
+    ASSERT_EQ(stats.arena_bytes, stats.planned_bytes);
+    auto a = at::randn({4, 4});
+    Code code(graph, "");
+    InterpreterState interp(code);
+    auto outputs = run(interp, {a});
+    ASSERT_TRUE(outputs[0].allclose(a + a + a * a));
+  }
+  {
+    // The size of the output of aten::nonzero depends on the values of its
+    // input, so it and its uses are not planned.
+    auto graph = std::make_shared<Graph>();
+    parseIR(
+        R"IR(
+graph(%a : Float(4:1)):
+  %one : int = prim::Constant[value=1]()
+  %b : Float(4:1) = aten::mul(%a, %a)
+  %c : Long(2:1, 1:1) = aten::nonzero(%b)
+  %d : Long(2:1, 1:1) = aten::add(%c, %c, %one)
+  return (%d)
+  )IR",
+        graph.get());
+    auto stats = PlanMemory(graph);
+    ASSERT_EQ(stats.planned_values, 1);
+    Code code(graph, "");
+    InterpreterState interp(code);
+    for (const auto& a :
+         {at::tensor({1.f, 0.f, 2.f, 0.f}), at::tensor({1.f, 1.f, 1.f, 0.f})}) {
+      auto outputs = run(interp, {a});
+      ASSERT_TRUE(outputs[0].equal(a.nonzero() * 2));
+    }
+  }
+}
+
+} // namespace jit
+} // namespace torch
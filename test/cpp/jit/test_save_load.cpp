@@ -3,6 +3,8 @@
 
 #include <sstream>
 
+#include <c10/util/numa.h>
+
 #include <torch/csrc/jit/serialization/export.h>
 #include <torch/csrc/jit/serialization/import.h>
 #include <torch/csrc/jit/serialization/import_source.h>
@@ -89,5 +91,37 @@ void testTypeTags() {
   }
 }
 
+void testPlaceOnNUMANodes() {
+  const bool numa_enabled = FLAGS_caffe2_cpu_numa_enabled;
+  FLAGS_caffe2_cpu_numa_enabled = true;
+  if (!c10::IsNUMAEnabled()) {
+    FLAGS_caffe2_cpu_numa_enabled = numa_enabled;
+    return;
+  }
+  // Tied weights and a view of them must keep sharing one copy.
+  Module m("m");
+  auto weight = at::randn({4, 4});
+  m.register_parameter("weight", weight, false);
+  m.register_parameter("tied", weight, false);
+  m.register_buffer("row", weight[1]);
+  auto expected = weight.clone();
+  auto original = weight.storage();
+
+  placeOnNUMANodes(m, [](const std::string&) { return 0; });
+  FLAGS_caffe2_cpu_numa_enabled = numa_enabled;
+
+  auto placed = m.attr("weight").toTensor();
+  auto tied = m.attr("tied").toTensor();
+  auto row = m.attr("row").toTensor();
+  ASSERT_FALSE(placed.storage().is_alias_of(original));
+  ASSERT_TRUE(tied.storage().is_alias_of(placed.storage()));
+  ASSERT_TRUE(row.storage().is_alias_of(placed.storage()));
+  ASSERT_EQ(row.storage_offset(), 4);
+  ASSERT_TRUE(placed.equal(expected));
+  ASSERT_TRUE(row.equal(expected[1]));
+  placed.add_(1);
+  ASSERT_TRUE(row.equal(expected[1] + 1));
+}
+
 } // namespace jit
 } // namespace torch
@@ -0,0 +1,101 @@
+#include <torch/csrc/jit/api/module.h>
+#include <torch/csrc/jit/ir/irparser.h>
+#include <torch/csrc/jit/runtime/graph_executor.h>
+#include <torch/csrc/jit/runtime/static/impl.h>
+#include <torch/csrc/jit/testing/file_check.h>
+#include "test/cpp/jit/test_base.h"
+#include "test/cpp/jit/test_utils.h"
+
+namespace torch {
+namespace jit {
+
+void testStaticRuntime() {
+  {
+    // A graph mixing unboxed kernels (addmm, relu) and boxed ops (cat).
+    const auto graph_string = R"IR(
+graph(%x : Tensor, %w : Tensor, %b : Tensor):
+  %one : int = prim::Constant[value=1]()
+  %wt : Tensor = aten::t(%w)
+  %y : Tensor = aten::addmm(%b, %x, %wt, %one, %one)
+  %z : Tensor = aten::relu(%y)
+  %l : Tensor[] = prim::ListConstruct(%z, %x)
+  %out : Tensor = aten::cat(%l, %one)
+  return (%out, %x)
+  )IR";
+    auto graph = std::make_shared<Graph>();
+    parseIR(graph_string, graph.get());
+    StaticRuntime runtime(graph->copy());
+
+    auto x = at::randn({2, 4});
+    auto w = at::randn({3, 4});
+    auto b = at::randn({3});
+    GraphExecutor executor(graph, "");
+    for (int i = 0; i < 2; ++i) {
+      auto outputs = runtime.run({x, w, b});
+      ASSERT_EQ(outputs.size(), 2);
+      Stack stack = {x, w, b};
+      executor.run(stack);
+      ASSERT_TRUE(outputs[0].allclose(stack[0].toTensor()));
+      ASSERT_TRUE(outputs[1].is_same(x));
+    }
+  }
+  {
+    Module m("m");
+    m.register_parameter("weight", at::randn({3, 4}), false);
+    m.register_parameter("bias", at::randn({3}), false);
+    m.define(R"(
+      def forward(self, x):
+          return torch.sigmoid(torch.linear(x, self.weight, self.bias))
+    )");
+    StaticRuntime runtime(m);
+    auto x = at::randn({2, 4});
+    auto outputs = runtime.run({x});
+    ASSERT_EQ(outputs.size(), 1);
+    ASSERT_TRUE(outputs[0].allclose(m.forward({x}).toTensor()));
+    ASSERT_ANY_THROW(runtime.run({x, x}));
+  }
+  {
+    // With memory planning, inputs of other shapes or strides than the ones
+    // the graph was planned for run unplanned.
+    const auto graph_string = R"IR(
+graph(%a : Float(4:4, 4:1),
+      %b : Float(4:4, 4:1)):
+  %one : int = prim::Constant[value=1]()
+  %c : Float(4:4, 4:1) = aten::add(%a, %b, %one)
+  %d : Float(4:4, 4:1) = aten::mul(%c, %b)
+  %e : Float(4:4, 4:1) = aten::add(%d, %a, %one)
+  return (%e)
+  )IR";
+    auto graph = std::make_shared<Graph>();
+    parseIR(graph_string, graph.get());
+    StaticRuntimeOptions opts;
+    opts.plan_memory = true;
+    StaticRuntime runtime(graph, opts);
+    testing::FileCheck().check("prim::AllocateArena")->run(*runtime.graph());
+
+    auto a = at::randn({4, 4});
+    auto b = at::randn({4, 4});
+    auto small = at::randn({2, 2});
+    for (int i = 0; i < 2; ++i) {
+      auto outputs = runtime.run({a, b});
+      ASSERT_TRUE(outputs[0].allclose((a + b) * b + a));
+      outputs = runtime.run({small, small});
+      ASSERT_TRUE(outputs[0].allclose((small + small) * small + small));
+      outputs = runtime.run({a.t(), b});
+      ASSERT_TRUE(outputs[0].allclose((a.t() + b) * b + a.t()));
+    }
+  }
+  {
+    Module m("m");
+    m.define(R"(
+      def forward(self, x):
+          if bool(x.sum() > 0):
+              x = x + 1
+          return x
+    )");
+    ASSERT_ANY_THROW(StaticRuntime{m});
+  }
+}
+
+} // namespace jit
+} // namespace torch
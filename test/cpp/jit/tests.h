@@ -41,6 +41,8 @@ namespace jit {
   _(MemoryDAG)                         \
   _(IRParser)                          \
   _(ConstantPooling)                   \
+  _(MemoryPlanning)                    \
+  _(StaticRuntime)                     \
   _(THNNConv)                          \
   _(ATenNativeBatchNorm)               \
   _(NoneSchemaMatch)                   \
@@ -68,6 +70,7 @@ namespace jit {
   _(ScriptObject)                      \
   _(SaveExtraFilesHook)                \
   _(TypeTags)                          \
+  _(PlaceOnNUMANodes)                  \
   _(DCE)                               \
   _(CustomFusionNestedBlocks)          \
   _(ClassDerive)                       \
@@ -78,6 +81,7 @@ namespace jit {
   _(LiteInterpreterAdd)                \
   _(LiteInterpreterConv)               \
   _(LiteInterpreterInline)             \
+  _(LiteInterpreterLoop)               \
   _(LiteInterpreterTuple)              \
   _(LiteInterpreterUpsampleNearest2d)  \
   _(CommonAncestor)                    \
@@ -3,12 +3,14 @@
 #include <torch/csrc/jit/ir/irparser.h>
 #include <torch/csrc/jit/tensorexpr/buffer.h>
 #include <torch/csrc/jit/tensorexpr/kernel.h>
+#include <torch/csrc/jit/tensorexpr/kernel_cache.h>
 #include <torch/csrc/jit/tensorexpr/loopnest.h>
 #include <torch/csrc/jit/tensorexpr/tensor.h>
 #include <torch/torch.h>
 #include <cmath>
 #include <sstream>
 #include <stdexcept>
+#include <thread>
 
 namespace torch {
 namespace jit {
@@ -105,5 +107,155 @@ void testKernel_3() {
   }
 }
 
+void testKernelSum() {
+  KernelScope kernel_scope;
+
+  const auto graph_string = R"IR(
+      graph(%0 : Float(5:3,3:1)):
+        %1 : int = prim::Constant[value=-1]()
+        %2 : int[] = prim::ListConstruct(%1)
+        %3 : bool = prim::Constant[value=1]()
+        %4 : None = prim::Constant()
+        %5 : Float(5:1,1:1) = aten::sum(%0, %2, %3, %4)
+        %6 : Float(5:3,3:1) = aten::mul(%0, %5)
+        %7 : Float(5:1,1:1) = aten::mean(%0, %2, %3, %4)
+        %8 : Float() = aten::sum(%0, %4)
+        return (%6, %7, %8))IR";
+  auto graph = std::make_shared<Graph>();
+  parseIR(graph_string, &*graph);
+
+  auto a = at::rand({5, 3}, TensorOptions(kCPU).dtype(at::kFloat));
+  auto ref1 = a * a.sum({-1}, true);
+  auto ref2 = a.mean({-1}, true);
+  auto ref3 = a.sum();
+  TensorExprKernel k(graph);
+  std::vector<at::Tensor> inputs = {a};
+  Stmt* s = k.getCodeGenStmt();
+  // TODO: verify stmt
+
+  std::vector<IValue> stack = fmap<IValue>(inputs);
+  k.run(stack);
+  auto o1 = stack[0].toTensor();
+  auto o2 = stack[1].toTensor();
+  auto o3 = stack[2].toTensor();
+  for (size_t i = 0; i < 5 * 3; i++) {
+    ASSERT_NEAR(
+        ((float*)o1.data_ptr())[i], ((float*)ref1.data_ptr())[i], 1e-5);
+  }
+  for (size_t i = 0; i < 5; i++) {
+    ASSERT_NEAR(
+        ((float*)o2.data_ptr())[i], ((float*)ref2.data_ptr())[i], 1e-5);
+  }
+  ASSERT_NEAR(((float*)o3.data_ptr())[0], ((float*)ref3.data_ptr())[0], 1e-5);
+}
+
+void testKernelSoftmax() {
+  KernelScope kernel_scope;
+
+  const auto graph_string = R"IR(
+      graph(%0 : Float(5:3,3:1)):
+        %1 : int = prim::Constant[value=0]()
+        %2 : int = prim::Constant[value=1]()
+        %3 : None = prim::Constant()
+        %4 : Float(5:3,3:1) = aten::softmax(%0, %1, %3)
+        %5 : Float(5:3,3:1) = aten::log_softmax(%0, %2, %3)
+        %6 : bool = prim::Constant[value=0]()
+        %7 : Float(5:1), %8 : Long(5:1) = aten::max(%0, %2, %6)
+        return (%4, %5, %7))IR";
+  auto graph = std::make_shared<Graph>();
+  parseIR(graph_string, &*graph);
+
+  // Negative values check the initial value of the max reductions.
+  auto a = at::rand({5, 3}, TensorOptions(kCPU).dtype(at::kFloat)) - 2.0f;
+  auto ref1 = a.softmax(0);
+  auto ref2 = a.log_softmax(1);
+  auto ref3 = std::get<0>(a.max(1));
+  TensorExprKernel k(graph);
+  std::vector<at::Tensor> inputs = {a};
+  Stmt* s = k.getCodeGenStmt();
+  // TODO: verify stmt
+
+  std::vector<IValue> stack = fmap<IValue>(inputs);
+  k.run(stack);
+  auto o1 = stack[0].toTensor();
+  auto o2 = stack[1].toTensor();
+  auto o3 = stack[2].toTensor();
+  for (size_t i = 0; i < 5 * 3; i++) {
+    ASSERT_NEAR(
+        ((float*)o1.data_ptr())[i], ((float*)ref1.data_ptr())[i], 1e-5);
+    ASSERT_NEAR(
+        ((float*)o2.data_ptr())[i], ((float*)ref2.data_ptr())[i], 1e-5);
+  }
+  for (size_t i = 0; i < 5; i++) {
+    CHECK_EQ(((float*)o3.data_ptr())[i], ((float*)ref3.data_ptr())[i]);
+  }
+}
+
+void testKernelCache() {
+  KernelScope kernel_scope;
+
+  const auto graph_string = R"IR(
+      graph(%0 : Float(5:3,3:1),
+            %1 : Float(5:3,3:1)):
+        %2 : Float(5:3,3:1) = aten::mul(%0, %1)
+        %3 : Float(5:3,3:1) = aten::mul(%0, %2)
+        return (%3))IR";
+  auto graph = std::make_shared<Graph>();
+  parseIR(graph_string, &*graph);
+
+  auto cache = KernelCache::get(graph);
+  ASSERT_EQ(cache, KernelCache::get(graph->copy()));
+  resetKernelCacheStats();
+
+  auto run = [&](int64_t batch, int64_t cols) {
+    auto a = at::rand({batch, cols}, TensorOptions(kCPU).dtype(at::kFloat));
+    auto b = at::rand({batch, cols}, TensorOptions(kCPU).dtype(at::kFloat));
+    std::vector<IValue> stack = fmap<IValue>(std::vector<at::Tensor>{a, b});
+    cache->run(stack);
+    return std::make_pair(stack[0].toTensor(), a * (a * b));
+  };
+  auto check = [](const std::pair<at::Tensor, at::Tensor>& result) {
+    auto const& o = result.first;
+    auto const& ref = result.second;
+    ASSERT_EQ(o.sizes(), ref.sizes());
+    for (int64_t i = 0; i < ref.numel(); i++) {
+      CHECK_EQ(((float*)o.data_ptr())[i], ((float*)ref.data_ptr())[i]);
+    }
+  };
+
+  // The first run uses the kernel of the shapes of the graph. The second
+  // compiles a kernel with a symbolic batch size, which runs the other batch
+  // sizes.
+  for (int64_t batch : {5, 7, 7, 11, 2}) {
+    check(run(batch, 3));
+  }
+
+  KernelCacheStats stats = getKernelCacheStats();
+  ASSERT_EQ(stats.hits, 4u);
+  ASSERT_EQ(stats.compiles, 1u);
+  ASSERT_EQ(stats.fallbacks, 0u);
+
+  // Concurrent runs with new shapes compile their kernel once.
+  std::vector<std::pair<at::Tensor, at::Tensor>> results(4);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < results.size(); i++) {
+    threads.emplace_back([&, i]() {
+      KernelScope thread_scope;
+      results[i] = run(4, 6);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (auto const& result : results) {
+    check(result);
+  }
+
+  stats = getKernelCacheStats();
+  ASSERT_EQ(stats.hits, 7u);
+  ASSERT_EQ(stats.compiles, 2u);
+  ASSERT_EQ(stats.fallbacks, 0u);
+}
+
 } // namespace jit
 } // namespace torch
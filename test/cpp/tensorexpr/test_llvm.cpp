@@ -10,9 +10,14 @@
 #include "torch/csrc/jit/tensorexpr/ir_printer.h"
 #include "torch/csrc/jit/tensorexpr/ir_simplifier.h"
 #include "torch/csrc/jit/tensorexpr/llvm_codegen.h"
+#include "torch/csrc/jit/tensorexpr/llvm_object_cache.h"
 #include "torch/csrc/jit/tensorexpr/loopnest.h"
 #include "torch/csrc/jit/tensorexpr/tensor.h"
 
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+
+#include <fstream>
 #include <numeric>
 
 namespace torch {
@@ -1213,6 +1218,72 @@ void testLLVMDynamicShape2D() {
   testWithSize(37, 11);
 }
 
+void testLLVMParallelFor() {
+  KernelScope kernel_scope;
+  auto testWithSize = [](int32_t M, int32_t N) {
+    VarHandle m("m", kInt);
+    VarHandle n("n", kInt);
+    Buffer a(BufHandle("a", {m, n}, kFloat));
+    Buffer b(BufHandle("b", {m, n}, kFloat));
+    Tensor* c = Compute(
+        "c", {{m, "m"}, {n, "n"}}, [&](const VarHandle& i, const VarHandle& j) {
+          return a(i, j) + b(i, j) * i;
+        });
+    LoopNest l({c});
+    std::vector<For*> loops = l.getLoopStmtsFor(c);
+    l.parallelize(loops[0]);
+    l.prepareForCodegen();
+    Stmt* s = l.root_stmt();
+    LLVMCodeGen cg(s, {a, b, c, m, n});
+    std::vector<float> aData(M * N, 1.0f);
+    std::vector<float> bData(M * N, 2.0f);
+    std::vector<float> cData(M * N, 0.0f);
+    std::vector<float> cRef(M * N);
+    for (int i = 0; i < M; i++) {
+      for (int j = 0; j < N; j++) {
+        cRef[i * N + j] = 1.0f + 2.0f * i;
+      }
+    }
+    cg.call({aData, bData, cData, M, N});
+    ExpectAllNear(cData, cRef, 1e-7);
+  };
+  testWithSize(0, 8);
+  testWithSize(1, 8);
+  testWithSize(37, 11);
+  testWithSize(4096, 64);
+}
+
+void testLLVMParallelForInnerLoop() {
+  KernelScope kernel_scope;
+  const int M = 4;
+  const int N = 100000;
+  Buffer a(BufHandle("a", {M, N}, kFloat));
+  Tensor* b = Compute(
+      "b", {{M, "m"}, {N, "n"}}, [&](const VarHandle& i, const VarHandle& j) {
+        return a(i, j) + cast<float>(j);
+      });
+  LoopNest l({b});
+  std::vector<For*> loops = l.getLoopStmtsFor(b);
+  l.parallelize(loops[1]);
+  l.prepareForCodegen();
+  Stmt* s = IRSimplifier::simplify(l.root_stmt());
+  std::ostringstream oss;
+  oss << *s;
+  ASSERT_NE(oss.str().find("parallel"), std::string::npos);
+
+  LLVMCodeGen cg(s, {a, b});
+  std::vector<float> aData(M * N, 1.0f);
+  std::vector<float> bData(M * N, 0.0f);
+  std::vector<float> bRef(M * N);
+  for (int i = 0; i < M; i++) {
+    for (int j = 0; j < N; j++) {
+      bRef[i * N + j] = 1.0f + j;
+    }
+  }
+  cg.call({aData, bData});
+  ExpectAllNear(bData, bRef, 1e-7);
+}
+
 void testLLVMEmptyStmt() {
   KernelScope kernel_scope;
   Stmt* s = new Block({});
@@ -1383,6 +1454,73 @@ void testLLVMRFactorVectorizedReduction() {
   ExpectAllNear(b_v, b_ref, 1e-5);
 }
 
+void testLLVMObjectCache() {
+  KernelScope kernel_scope;
+  const int N = 1024;
+  Buffer a(BufHandle("a", {N}, kFloat));
+  Buffer b(BufHandle("b", {N}, kFloat));
+  Tensor* c = Compute("c", {{N, "i"}}, [&](const VarHandle& i) {
+    return Load::make(a, {i}, 1) * Load::make(b, {i}, 1);
+  });
+
+  Buffer c_buf(BufHandle(c->func_var()));
+  LoopNest l({c});
+  Stmt* s = l.root_stmt();
+
+  llvm::SmallString<128> dir;
+  ASSERT_FALSE(llvm::sys::fs::createUniqueDirectory("nnc-object-cache", dir));
+  std::string oldDir = getTEObjectCacheDir();
+  getTEObjectCacheDir() = dir.str().str();
+  resetObjectCacheStats();
+
+  auto run = [&]() {
+    LLVMCodeGen cg(s, {a, b, c_buf});
+    std::vector<float> a_vec(N, 21.0f);
+    std::vector<float> b_vec(N, 2.0f);
+    std::vector<float> c_vec(N, 0.0f);
+    std::vector<void*> args({a_vec.data(), b_vec.data(), c_vec.data()});
+    ASSERT_EQ(cg.value<int>(args), 0);
+    assertAllEqual(c_vec, 42.0f);
+  };
+
+  // The first kernel is compiled and stored, the second one is loaded.
+  run();
+  run();
+  ObjectCacheStats stats = getObjectCacheStats();
+  ASSERT_EQ(stats.misses, 1u);
+  ASSERT_EQ(stats.stores, 1u);
+  ASSERT_EQ(stats.hits, 1u);
+  ASSERT_EQ(stats.rejected, 0u);
+
+  // A corrupted entry is deleted and the kernel is compiled again.
+  std::error_code ec;
+  for (llvm::sys::fs::directory_iterator it(dir, ec), end; it != end && !ec;
+       it.increment(ec)) {
+    std::ofstream(it->path(), std::ios::trunc) << "garbage";
+  }
+  run();
+  stats = getObjectCacheStats();
+  ASSERT_EQ(stats.misses, 2u);
+  ASSERT_EQ(stats.stores, 2u);
+  ASSERT_EQ(stats.hits, 1u);
+  ASSERT_EQ(stats.rejected, 1u);
+
+  // Entries above the size limit are evicted.
+  getTEObjectCacheSizeLimit() = 0;
+  llvm::sys::fs::remove_directories(dir);
+  run();
+  stats = getObjectCacheStats();
+  ASSERT_EQ(stats.stores, 3u);
+  ASSERT_EQ(stats.evictions, 1u);
+  run();
+  stats = getObjectCacheStats();
+  ASSERT_EQ(stats.hits, 1u);
+
+  getTEObjectCacheSizeLimit() = 1LL << 30;
+  getTEObjectCacheDir() = oldDir;
+  llvm::sys::fs::remove_directories(dir);
+}
+
 } // namespace jit
 } // namespace torch
 
@@ -62,5 +62,30 @@ void testFuserPass_2() {
       ->run(*g);
 }
 
+void testFuserPass_3() {
+  KernelScope kernel_scope;
+  const auto graph_string = R"IR(
+    graph(%0 : Float(128:1),
+          %1 : Float(128:1)):
+      %2 : None = prim::Constant()
+      %3 : Float(128:1) = aten::mul(%0, %1)
+      %4 : Float() = aten::sum(%3, %2)
+      return (%4))IR";
+  auto g = std::make_shared<Graph>();
+  torch::jit::parseIR(graph_string, g.get());
+
+  g->lint();
+  FuseTensorExprs(g);
+
+  // The reduction should be fused with the elementwise operation feeding it.
+  testing::FileCheck()
+      .check_not("aten::sum")
+      ->check("tensorexpr::Group_0")
+      ->check("return")
+      ->check("aten::mul")
+      ->check("aten::sum")
+      ->run(*g);
+}
+
 } // namespace jit
 } // namespace torch
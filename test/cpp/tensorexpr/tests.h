@@ -191,8 +191,12 @@ namespace jit {
   _(Kernel_1)                               \
   _(Kernel_2)                               \
   _(Kernel_3)                               \
+  _(KernelSum)                              \
+  _(KernelSoftmax)                          \
+  _(KernelCache)                            \
   _(FuserPass_1)                            \
-  _(FuserPass_2)
+  _(FuserPass_2)                            \
+  _(FuserPass_3)
 
 #define TH_FORALL_TENSOREXPR_TESTS_LLVM(_) \
   _(LLVMByteImmTest)                       \
@@ -310,13 +314,16 @@ namespace jit {
   _(LLVMBindDynamicShapeAdd)               \
   _(LLVMTensorDynamicShapeAdd)             \
   _(LLVMDynamicShape2D)                    \
+  _(LLVMParallelFor)                       \
+  _(LLVMParallelForInnerLoop)              \
   _(LLVMEmptyStmt)                         \
   _(LLVMEliminatedStmt)                    \
   _(LLVMIfThenElseTest)                    \
   _(LLVMVectorizerLoadStoreTest)           \
   _(LLVMSimpleReduction)                   \
   _(LLVMRFactorReduction)                  \
-  _(LLVMRFactorVectorizedReduction)
+  _(LLVMRFactorVectorizedReduction)        \
+  _(LLVMObjectCache)
 
 #define TH_FORALL_TENSOREXPR_TESTS_CUDA(_) \
   _(CudaTestVectorAdd01)                   \
@@ -798,6 +798,38 @@ class ProcessGroupGlooTest(MultiProcessTestCase):
     def test_allreduce_basics_cuda(self):
         self._test_allreduce_basics(lambda t: t.clone().cuda())
 
+    def test_allreduce_hierarchical(self):
+        # Pretend that every two ranks share a host.
+        os.environ["GLOO_HIERARCHICAL_ALLREDUCE_HOST"] = "host{}".format(self.rank // 2)
+        store = c10d.FileStore(self.file_name, self.world_size)
+        opts = self.opts()
+        opts.hierarchical_allreduce = True
+        pg = c10d.ProcessGroupGloo(store, self.rank, self.world_size, opts)
+
+        for (op, input, output) in simple_reduce_tests(self.rank, self.world_size):
+            opts = c10d.AllreduceOptions()
+            opts.reduceOp = op
+            tensor = input.clone()
+            work = pg.allreduce([tensor], opts)
+            work.wait()
+            self.assertEqual(output, tensor)
+
+        # Multiple input tensors use the flat allreduce.
+        tensors = [torch.tensor([self.rank + 1.0]), torch.tensor([self.rank + 1.0])]
+        pg.allreduce(tensors).wait()
+        expected = float(self.world_size * (self.world_size + 1))
+        for tensor in tensors:
+            self.assertEqual(torch.tensor([expected]), tensor)
+
+    def test_allreduce_get_future(self):
+        store = c10d.FileStore(self.file_name, self.world_size)
+        pg = c10d.ProcessGroupGloo(store, self.rank, self.world_size, self.opts())
+
+        tensor = torch.tensor([self.rank + 1.0])
+        fut = pg.allreduce([tensor]).get_future()
+        result = fut.then(lambda _: tensor * 2).wait()
+        self.assertEqual(torch.tensor([float(self.world_size * (self.world_size + 1))]), result)
+
     def _test_allreduce_stress(self, inputs):
         store = c10d.FileStore(self.file_name, self.world_size)
         pg = c10d.ProcessGroupGloo(store, self.rank, self.world_size, self.opts(threads=8))
@@ -2006,6 +2038,118 @@ class DistributedDataParallelTest(MultiProcessTestCase):
     def test_gloo_backend_cpu_module(self):
         self._test_gloo_backend([torch.device('cpu')], [])
 
+    def _gloo_process_group(self):
+        store = c10d.FileStore(self.file_name, self.world_size)
+        options = c10d.ProcessGroupGloo.Options()
+        options.devices = [c10d.ProcessGroupGloo.create_device(interface=LOOPBACK)]
+        return c10d.ProcessGroupGloo(store, self.rank, self.world_size, options)
+
+    def _ddp_grads(self, process_group, register_hook=None, iterations=1,
+                   device_id=None, same_input=False):
+        # Returns the gradients of every iteration. With `same_input`, every
+        # iteration computes the same local gradients.
+        if device_id is None:
+            ddp_model = DistributedDataParallel(
+                Net(), process_group=process_group, bucket_cap_mb=0.001)
+        else:
+            ddp_model = DistributedDataParallel(
+                Net().to(device_id), device_ids=[device_id],
+                process_group=process_group, bucket_cap_mb=0.001)
+        if register_hook is not None:
+            register_hook(ddp_model)
+
+        device = torch.device('cpu' if device_id is None else device_id)
+        torch.manual_seed(self.rank)
+        input, target = torch.randn(4, 2), torch.randn(4, 4)
+        grads = []
+        for _ in range(iterations):
+            if not same_input:
+                input, target = torch.randn(4, 2), torch.randn(4, 4)
+            ddp_model.zero_grad()
+            output = ddp_model(input.to(device))
+            F.mse_loss(output, target.to(device)).backward()
+            grads.append([param.grad.clone() for param in ddp_model.parameters()])
+        return grads
+
+    @requires_gloo()
+    def test_gloo_ddp_python_comm_hook(self):
+        def allreduce_hook(process_group, bucket):
+            tensors = [t * 1 for t in bucket.get_tensors()]
+            fut = process_group.allreduce(tensors).get_future()
+            return fut.then(lambda _: tensors)
+
+        process_group = self._gloo_process_group()
+        expected = self._ddp_grads(process_group)[-1]
+        actual = self._ddp_grads(
+            process_group,
+            lambda ddp: ddp.register_comm_hook(process_group, allreduce_hook))[-1]
+        for expected_grad, actual_grad in zip(expected, actual):
+            self.assertEqual(expected_grad, actual_grad)
+
+    @requires_gloo()
+    def test_gloo_ddp_python_comm_hook_invalid_return(self):
+        def hook(state, bucket):
+            return bucket.get_tensors()
+
+        process_group = self._gloo_process_group()
+        with self.assertRaisesRegex(RuntimeError, "must return a torch.futures.Future"):
+            self._ddp_grads(
+                process_group, lambda ddp: ddp.register_comm_hook(None, hook))
+
+    @requires_gloo()
+    def test_gloo_ddp_builtin_fp16_comm_hook(self):
+        process_group = self._gloo_process_group()
+        expected = self._ddp_grads(process_group)[-1]
+        actual = self._ddp_grads(
+            process_group,
+            lambda ddp: ddp._register_builtin_comm_hook(c10d.BuiltinCommHookType.FP16_COMPRESS))[-1]
+        for expected_grad, actual_grad in zip(expected, actual):
+            self.assertEqual(expected_grad, actual_grad, prec=1e-3)
+
+    def _test_ddp_builtin_power_sgd_comm_hook(self, process_group, device_id=None):
+        def register_hook(ddp):
+            ddp._register_builtin_comm_hook(
+                c10d.BuiltinCommHookType.POWER_SGD, matrix_approximation_rank=2)
+
+        # The approximation differs from the exact average, but every process
+        # must end up with the same gradients, including after error feedback.
+        grads = self._ddp_grads(
+            process_group, register_hook, iterations=3, device_id=device_id)[-1]
+        for grad in grads:
+            self.assertTrue(torch.isfinite(grad).all())
+            gathered = [torch.empty_like(grad) for _ in range(self.world_size)]
+            process_group.allgather([gathered], [grad]).wait()
+            for other in gathered:
+                self.assertEqual(grad, other)
+
+        # With the same gradients in every iteration, the error feedback sends
+        # what previous approximations missed, so the mean of the compressed
+        # gradients converges to the exact average.
+        expected = torch.cat([grad.view(-1) for grad in self._ddp_grads(
+            process_group, device_id=device_id, same_input=True)[-1]])
+        history = self._ddp_grads(
+            process_group, register_hook, iterations=40, device_id=device_id,
+            same_input=True)
+        total = torch.zeros_like(expected)
+        errors = []
+        for i, grads in enumerate(history):
+            total += torch.cat([grad.view(-1) for grad in grads])
+            errors.append((total / (i + 1) - expected).norm().item())
+        self.assertGreater(errors[0], 0)
+        self.assertLess(errors[-1], 0.5 * errors[0])
+
+    @requires_gloo()
+    def test_gloo_ddp_builtin_power_sgd_comm_hook(self):
+        self._test_ddp_builtin_power_sgd_comm_hook(self._gloo_process_group())
+
+    @requires_nccl()
+    @skip_if_not_multigpu
+    def test_nccl_ddp_builtin_power_sgd_comm_hook(self):
+        store = c10d.FileStore(self.file_name, self.world_size)
+        process_group = c10d.ProcessGroupNCCL(store, self.rank, self.world_size)
+        device_id = gpus_for_rank(self.world_size)[self.rank][0]
+        self._test_ddp_builtin_power_sgd_comm_hook(process_group, device_id)
+
     @requires_gloo()
     @skip_if_not_multigpu
     def test_gloo_backend_1gpu_module_device_ids_integer_list(self):
@@ -1,6 +1,7 @@
 from __future__ import division
 from builtins import round
 
+import io
 import itertools
 import numpy as np
 import unittest
@@ -3103,6 +3104,104 @@ class TestQuantizedConv(unittest.TestCase):
                 (stride_d, stride_h, stride_w), (pad_d, pad_h, pad_w),
                 channelwise)
 
+class TestQuantizedEmbeddingOps(TestCase):
+    def _get_ops(self, bit_rate):
+        if bit_rate == 8:
+            return (torch.ops.quantized.embedding_bag_byte_prepack,
+                    torch.ops.quantized.embedding_bag_byte_unpack,
+                    torch.ops.quantized.embedding_bag_byte_rowwise_offsets,
+                    torch.ops.quantized.embedding_bag_byte)
+        return (torch.ops.quantized.embedding_bag_4bit_prepack,
+                torch.ops.quantized.embedding_bag_4bit_unpack,
+                torch.ops.quantized.embedding_bag_4bit_rowwise_offsets,
+                torch.ops.quantized.embedding_bag_4bit)
+
+    @given(num_embeddings=st.integers(1, 100),
+           embedding_dim=st.integers(1, 64).filter(lambda x: x % 2 == 0),
+           bit_rate=st.sampled_from([8, 4]))
+    def test_embedding_bag_unpack(self, num_embeddings, embedding_dim, bit_rate):
+        prepack_op, unpack_op, _, _ = self._get_ops(bit_rate)
+        weights = torch.randn(num_embeddings, embedding_dim)
+        unpacked = unpack_op(prepack_op(weights))
+        self.assertEqual(unpacked.size(), weights.size())
+        # Each value is within half a quantization step of the original.
+        step = (weights.max(1, keepdim=True)[0] - weights.min(1, keepdim=True)[0]) / (2 ** bit_rate - 1)
+        # 4-bit tables store their scale and bias as halves.
+        atol = step / 2 + (0 if bit_rate == 8 else 1e-2)
+        self.assertTrue(((unpacked - weights).abs() <= atol + 1e-6).all())
+
+    @given(num_embeddings=st.integers(10, 100),
+           embedding_dim=st.integers(2, 64).filter(lambda x: x % 2 == 0),
+           num_offsets=st.integers(1, 20),
+           mode=st.sampled_from(['sum', 'mean']),
+           use_weights=st.booleans(),
+           include_last_offset=st.booleans(),
+           index_dtype=st.sampled_from([torch.int, torch.long]),
+           bit_rate=st.sampled_from([8, 4]))
+    def test_embedding_bag(self, num_embeddings, embedding_dim, num_offsets,
+                           mode, use_weights, include_last_offset,
+                           index_dtype, bit_rate):
+        prepack_op, unpack_op, qembedding_bag, qembedding_bag_packed = \
+            self._get_ops(bit_rate)
+        weights = torch.randn(num_embeddings, embedding_dim)
+        packed = prepack_op(weights)
+        lengths = torch.randint(0, 8, (num_offsets,))
+        indices = torch.randint(0, num_embeddings, (int(lengths.sum()),),
+                                dtype=index_dtype)
+        offsets = torch.cat([torch.zeros(1, dtype=torch.long), lengths.cumsum(0)])
+        if not include_last_offset:
+            offsets = offsets[:-1]
+        per_sample_weights = torch.rand(indices.numel()) \
+            if use_weights and mode == 'sum' else None
+        mode_enum = {'sum': 0, 'mean': 1}[mode]
+
+        # The reference works on the dequantized table.
+        ref = F.embedding_bag(indices.long(), unpack_op(packed), offsets,
+                              mode=mode, per_sample_weights=per_sample_weights,
+                              include_last_offset=include_last_offset)
+        out = qembedding_bag(packed, indices, offsets, mode=mode_enum,
+                             per_sample_weights=per_sample_weights,
+                             include_last_offset=include_last_offset)
+        self.assertEqual(ref, out, atol=1e-4, rtol=1e-4)
+
+        packed_params = torch.ops.quantized.embedding_bag_prepack(weights, bit_rate)
+        out_packed = qembedding_bag_packed(
+            packed_params, indices, offsets, mode=mode_enum,
+            per_sample_weights=per_sample_weights,
+            include_last_offset=include_last_offset)
+        self.assertEqual(out, out_packed)
+        self.assertEqual(torch.ops.quantized.embedding_bag_unpack(packed_params),
+                         unpack_op(packed))
+
+    def test_embedding_bag_errors(self):
+        packed = torch.ops.quantized.embedding_bag_byte_prepack(torch.randn(10, 8))
+        indices = torch.tensor([0, 3, 10])
+        offsets = torch.tensor([0, 2])
+        with self.assertRaisesRegex(RuntimeError, "out of"):
+            torch.ops.quantized.embedding_bag_byte_rowwise_offsets(packed, indices, offsets)
+        with self.assertRaisesRegex(RuntimeError, "sum \\(0\\) and mean \\(1\\)"):
+            torch.ops.quantized.embedding_bag_byte_rowwise_offsets(
+                packed, indices.clamp(max=9), offsets, mode=2)
+
+    def test_embedding_bag_packed_serialization(self):
+        class EmbeddingBag(torch.nn.Module):
+            def __init__(self, weights):
+                super(EmbeddingBag, self).__init__()
+                self.packed = torch.ops.quantized.embedding_bag_prepack(weights, 4)
+
+            def forward(self, indices, offsets):
+                return torch.ops.quantized.embedding_bag_4bit(self.packed, indices, offsets)
+
+        module = torch.jit.script(EmbeddingBag(torch.randn(20, 16)))
+        indices = torch.tensor([1, 4, 7, 19, 0])
+        offsets = torch.tensor([0, 2])
+        buffer = io.BytesIO()
+        torch.jit.save(module, buffer)
+        buffer.seek(0)
+        loaded = torch.jit.load(buffer)
+        self.assertEqual(module(indices, offsets), loaded(indices, offsets))
+
+
 class TestPadding(TestCase):
     @given(batch_size=st.integers(1, 64),
            channels=st.integers(1, 64),
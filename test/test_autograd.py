@@ -2650,6 +2650,37 @@ class TestAutograd(TestCase):
             # Now validate the json
             json.load(f)
 
+    @unittest.skipIf(IS_WINDOWS, """File open permission error on Windows,
+            https://github.com/pytorch/pytorch/issues/34086""")
+    def test_streaming_profiler(self):
+        from torch.autograd.profiler import streaming_profile
+        x = torch.randn(10, 10)
+        with tempfile.NamedTemporaryFile(mode="w+") as f:
+            with streaming_profile(f.name, flush_interval_ms=60000) as prof:
+                self.assertTrue(torch.autograd._streaming_profiler_enabled())
+                for _ in range(10):
+                    x * 2 + 4
+                prof.flush()
+                # events are appended while the profiler keeps running
+                self.assertTrue(any(e["name"] == "mul" for e in json.loads(f.read() + "]")))
+                x * 2
+
+            self.assertFalse(torch.autograd._streaming_profiler_enabled())
+            f.seek(0)
+            events = json.load(f)
+            self.assertEqual(sum(e["name"] == "mul" for e in events), 11)
+            self.assertEqual(prof.stats.recorded, len(events))
+            self.assertEqual(prof.stats.dropped, 0)
+
+        # A ring buffer that is too small drops events instead of growing
+        with tempfile.NamedTemporaryFile(mode="w+") as f:
+            with streaming_profile(f.name, ring_buffer_size=4, flush_interval_ms=60000) as prof:
+                for _ in range(10):
+                    x * 2
+            self.assertEqual(len(json.load(f)), 4)
+            self.assertEqual(prof.stats.recorded, 4)
+            self.assertGreater(prof.stats.dropped, 0)
+
     def test_profiler(self):
         x = torch.randn(10, 10)
 
@@ -3577,6 +3608,74 @@ for shape in [(1,), ()]:
         v2 = torch.tensor(200.0, requires_grad=True)
         DeepReentrant.apply(v2).sum().backward()
 
+    def _run_with_parallel_cpu_backward(self, fn):
+        engine = Variable._execution_engine
+        prev = engine.is_parallel_cpu_backward_enabled()
+        engine.set_parallel_cpu_backward(True)
+        try:
+            return fn()
+        finally:
+            engine.set_parallel_cpu_backward(prev)
+
+    def test_parallel_cpu_backward(self):
+        def run():
+            torch.manual_seed(0)
+            leaves = [torch.randn(4, requires_grad=True) for _ in range(3)]
+            branches = []
+            for i in range(200):
+                x = leaves[i % 3] * (i + 1)
+                branches.append((x.sin() * x.cos()).sum())
+            out = torch.stack(branches).sum()
+            grads = torch.autograd.grad(out, leaves[:2], retain_graph=True)
+            out.backward()
+            return grads, [leaf.grad for leaf in leaves]
+
+        expected = run()
+        actual = self._run_with_parallel_cpu_backward(run)
+        self.assertEqual(expected, actual)
+
+    def test_parallel_cpu_backward_reentrant(self):
+        class Reentrant(Function):
+            @staticmethod
+            def forward(ctx, x):
+                ctx.save_for_backward(x)
+                return x.clone()
+
+            @staticmethod
+            def backward(ctx, grad):
+                x, = ctx.saved_tensors
+                with torch.enable_grad():
+                    y = x.detach().requires_grad_()
+                    (y * y).sum().backward()
+                return grad * y.grad
+
+        def run():
+            xs = [torch.full((3,), float(i), requires_grad=True) for i in range(8)]
+            sum(Reentrant.apply(x).sum() for x in xs).backward()
+            return [x.grad for x in xs]
+
+        expected = run()
+        actual = self._run_with_parallel_cpu_backward(run)
+        self.assertEqual(expected, actual)
+
+    def test_parallel_cpu_backward_error(self):
+        class Fail(Function):
+            @staticmethod
+            def forward(ctx, x):
+                return x.clone()
+
+            @staticmethod
+            def backward(ctx, grad):
+                raise RuntimeError("Simulate error")
+
+        def run():
+            x = torch.randn(3, requires_grad=True)
+            out = sum((x * i).sum() for i in range(16)) + Fail.apply(x).sum()
+            with self.assertRaisesRegex(RuntimeError, "Simulate error"):
+                out.backward()
+
+        self._run_with_parallel_cpu_backward(run)
+
     def test_reentrant_priority(self):
         order = []
 
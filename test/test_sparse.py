@@ -923,6 +923,25 @@ class TestSparse(TestCase):
         test_shape(10, 100, 0, 0)
         test_shape(10, 100, 0, 20)
 
+    @cpu_only
+    def test_mm_reuses_row_pointers(self):
+        x = self._gen_sparse(2, 50, [30, 40])[0]
+        y = torch.randn(40, 5)
+        expected = torch.mm(self.safeToDense(x), y)
+        self.assertEqual(torch.mm(x, y), expected)
+        # The row pointers computed for the first product are cached on x
+        self.assertEqual(torch.mm(x, y), expected)
+        self.assertEqual(x.matmul(y[:, 0]), expected[:, 0])
+
+        # and recomputed once its indices change
+        rows = x._indices()[0]
+        rows.copy_(rows // 2)
+        self.assertEqual(torch.mm(x, y), torch.mm(self.safeToDense(x), y))
+
+        y.requires_grad_(True)
+        torch.sparse.mm(x, y).sum().backward()
+        self.assertEqual(y.grad, self.safeToDense(x).t().mm(torch.ones(30, 5)))
+
     @unittest.skipIf(
         IS_WINDOWS and TEST_CUDA,
         "bmm sparse-dense CUDA is not yet supported in Windows, at least up to CUDA 10.1"
@@ -1846,6 +1846,17 @@ class AbstractTestCases:
             # input unchanged
             self.assertEqual(x, x0, atol=0, rtol=0)
 
+        def test_mode_long_slices(self):
+            # Long enough for the slices to be sorted with radix sort.
+            x = torch.randint(-20, 20, (4, 1000))
+            values, indices = torch.mode(x, 1)
+            for i, row in enumerate(x.tolist()):
+                counts = {v: row.count(v) for v in set(row)}
+                count = max(counts.values())
+                value = min(v for v, c in counts.items() if c == count)
+                self.assertEqual(values[i].item(), value)
+                self.assertEqual(indices[i].item(), len(row) - 1 - row[::-1].index(value))
+
         def test_trilu_indices(self):
             for test_args in tri_tests_args:
                 _compare_trilu_indices(self, *test_args)
@@ -12909,6 +12920,17 @@ class TestTorchDeviceType(TestCase):
                         for i in range(len(t)):
                             self.assertEqual(t[i].cpu().numpy(), np1[i])
 
+    @unittest.skipIf(not TEST_NUMPY, "Numpy not found")
+    def test_nonzero_large(self, device):
+        # Large enough to be split into several chunks on the CPU.
+        for shape in ((100000,), (300, 400), (50, 60, 70)):
+            tensor = torch.rand(shape, device=device).gt(0.7)
+            expected = np.stack(np.nonzero(tensor.cpu().numpy()), axis=1)
+            self.assertEqual(tensor.nonzero().cpu().numpy(), expected)
+            transposed = tensor.transpose(0, -1)
+            self.assertEqual(transposed.nonzero().cpu().numpy(),
+                             np.stack(np.nonzero(transposed.cpu().numpy()), axis=1))
+
     def test_nonzero_non_diff(self, device):
         x = torch.randn(10, requires_grad=True)
         nz = x.nonzero()
@@ -14389,6 +14411,79 @@ class TestTorchDeviceType(TestCase):
             expected = x / x.norm(p, 0, keepdim=True).clamp(min=1)
             self.assertEqual(res, expected, msg="renorm failed for {}-norm".format(p))
 
+    @onlyCPU
+    @dtypes(torch.uint8, torch.int8, torch.int16, torch.int32, torch.int64,
+            torch.float, torch.double)
+    def test_sort_stable(self, device, dtype):
+        # Lengths below and above the threshold for radix sorting.
+        for n in (100, 5000):
+            x = torch.randint(0, 5, (3, n), dtype=dtype, device=device)
+            for descending in (False, True):
+                values, indices = x.sort(stable=True, descending=descending)
+                keys = -x.double().numpy() if descending else x.numpy()
+                expected = torch.from_numpy(np.argsort(keys, kind='stable'))
+                self.assertEqual(indices, expected, atol=0, rtol=0)
+                self.assertEqual(values, x.gather(1, expected), atol=0, rtol=0)
+
+                res_values = torch.empty(0, dtype=dtype, device=device)
+                res_indices = torch.empty(0, dtype=torch.long, device=device)
+                torch.sort(x, stable=True, descending=descending, out=(res_values, res_indices))
+                self.assertEqual(res_values, values, atol=0, rtol=0)
+                self.assertEqual(res_indices, indices, atol=0, rtol=0)
+
+    @onlyCPU
+    @dtypes(torch.int8, torch.int32, torch.int64, torch.float, torch.double)
+    def test_sort_large(self, device, dtype):
+        if dtype.is_floating_point:
+            x = torch.randn(70000, 3, dtype=dtype, device=device) * 100
+            x[::7] = 0
+            x[::11] = -0.
+        else:
+            info = torch.iinfo(dtype)
+            x = torch.randint(info.min, info.max, (70000, 3), dtype=dtype, device=device)
+        # Sort along a non-contiguous dimension, into non-contiguous outputs.
+        for descending in (False, True):
+            values, indices = x.sort(dim=0, descending=descending)
+            expected = np.sort(x.numpy(), axis=0)
+            if descending:
+                expected = expected[::-1]
+            self.assertEqual(values, torch.from_numpy(expected.copy()), atol=0, rtol=0)
+            self.assertEqual(x.gather(0, indices), values, atol=0, rtol=0)
+
+            res_values = torch.empty(3, 70000, dtype=dtype, device=device).t()
+            res_indices = torch.empty(3, 70000, dtype=torch.long, device=device).t()
+            torch.sort(x, 0, descending, out=(res_values, res_indices))
+            self.assertEqual(res_values, values, atol=0, rtol=0)
+            self.assertEqual(x.gather(0, res_indices), values, atol=0, rtol=0)
+
+        # Many short slices are sorted in parallel.
+        values, indices = x.t().sort()
+        self.assertEqual(values, torch.from_numpy(np.sort(x.t().numpy())), atol=0, rtol=0)
+        self.assertEqual(x.t().gather(1, indices), values, atol=0, rtol=0)
+
+    @dtypes(torch.float, torch.double)
+    def test_sort_nonfinite(self, device, dtype):
+        for n in (6, 3000):
+            x = torch.tensor([float('nan'), float('inf'), 1e4, 0, -1e4, -float('inf')],
+                             device=device, dtype=dtype).repeat(n // 6)
+            values, indices = x.sort()
+            self.assertEqual(values[:n // 6], torch.full((n // 6,), -float('inf'), dtype=dtype, device=device))
+            self.assertTrue(values[-(n // 6):].isnan().all())
+            self.assertEqual(x[indices], values)
+
+            values, indices = x.sort(descending=True)
+            self.assertTrue(values[:n // 6].isnan().all())
+            self.assertEqual(values[-(n // 6):], torch.full((n // 6,), -float('inf'), dtype=dtype, device=device))
+            self.assertEqual(x[indices], values)
+
+    @onlyCUDA
+    def test_sort_stable_cuda_unsupported(self, device):
+        x = torch.randn(10, device=device)
+        with self.assertRaisesRegex(RuntimeError, "stable sort is not implemented"):
+            x.sort(stable=True)
+        # Requesting an unstable sort explicitly is fine.
+        self.assertEqual(x.sort(stable=False)[0], x.sort()[0])
+
     @onlyCUDA
     def test_topk_noncontiguous_gpu(self, device):
         t = torch.randn(20, device=device)[::2]
@@ -14421,6 +14516,28 @@ class TestTorchDeviceType(TestCase):
         self.assertEqual(val, expect)
         self.assertEqual(idx, [5, 4, 3, 2])
 
+    @dtypes(torch.int8, torch.int64, torch.float, torch.double)
+    def test_topk_strategies(self, device, dtype):
+        # The values of k cover the heap, radix select and full sort based
+        # selection of the CPU kernel, on a single long row (which is split
+        # into chunks) and on many non-contiguous rows.
+        n = 200000
+        if dtype.is_floating_point:
+            row = torch.randn(n, dtype=dtype, device=device)
+            row[::97] = float('nan')
+        else:
+            info = torch.iinfo(dtype)
+            row = torch.randint(info.min, info.max, (n,), dtype=dtype, device=device)
+        rows = row.view(-1, 500).t()
+        for t in (row, rows):
+            size = t.size(-1)
+            for k in (1, 10, size // 50, size // 3, size - 1):
+                for largest in (True, False):
+                    values, indices = t.topk(k, largest=largest)
+                    expected = t.sort(descending=largest)[0].narrow(-1, 0, k)
+                    self.assertEqual(values, expected, atol=0, rtol=0)
+                    self.assertEqual(t.gather(-1, indices), values, atol=0, rtol=0)
+
     def test_topk_4d(self, device):
         x = torch.ones(2, 3072, 2, 2, device=device)
         x[:, 1, :, :] *= 2.
@@ -14869,6 +14986,29 @@ class TestTorchDeviceType(TestCase):
                                     count += 1
                             self.assertEqual(j, count)
 
+    @dtypes(torch.bool, torch.uint8, torch.int64, torch.float, torch.double)
+    def test_unique_large(self, device, dtype):
+        # Large enough to be deduplicated in parallel on CPU.
+        n = 100000
+        if dtype is torch.bool:
+            x = torch.rand(n, device=device) < 0.3
+        else:
+            x = torch.randint(0, 200 if dtype is torch.uint8 else 5000, (n,), device=device).to(dtype)
+        x = x.view(100, -1)
+        expected_unique, expected_inverse, expected_counts = (
+            torch.from_numpy(a).to(device) for a in np.unique(
+                x.cpu().numpy(), return_inverse=True, return_counts=True))
+
+        unique, inverse, counts = torch.unique(x, sorted=True, return_inverse=True, return_counts=True)
+        self.assertEqual(unique, expected_unique)
+        self.assertEqual(inverse, expected_inverse.view(x.shape))
+        self.assertEqual(counts, expected_counts)
+
+        unique, inverse, counts = torch.unique(x, sorted=False, return_inverse=True, return_counts=True)
+        self.assertEqual(unique.sort()[0], expected_unique)
+        self.assertEqual(unique[inverse], x)
+        self.assertEqual(counts, torch.bincount(inverse.view(-1), minlength=unique.numel()))
+
     @dtypes(*set(torch.testing.get_all_dtypes()) - {torch.bfloat16, torch.complex64, torch.complex128})
     def test_unique_consecutive(self, device, dtype):
         if dtype is torch.half and self.device_type == 'cpu':
@@ -17480,6 +17620,56 @@ scipy_lobpcg  | {:10.2e}  | {:10.2e}  | {:6} | N/A
         for v in inp:
             self.assertGreater(math.copysign(1.0, v), 0.0)
 
+    # Contiguous inputs take the Vec256/Vec512 paths in the CPU kernels while
+    # strided inputs fall back to the scalar loops, so comparing the two covers
+    # the vectorized main loops and their tails. The avx512 CI shard runs this
+    # with ATEN_CPU_CAPABILITY=avx512 to exercise the Vec512 types.
+    @onlyCPU
+    @dtypes(torch.int16, torch.int32, torch.int64, torch.bfloat16, torch.float, torch.double,
+            torch.complex64, torch.complex128)
+    def test_vectorized_ops_match_scalar(self, device, dtype):
+        def strided(t):
+            return torch.empty(t.numel() * 2, dtype=t.dtype, device=device)[::2].copy_(t)
+
+        # The loops consume two vectors per iteration, which is 64 int16
+        # elements with Vec512; the sizes straddle that and the smaller widths.
+        for n in (1, 7, 16, 31, 32, 63, 64, 65, 129, 1000):
+            if dtype.is_floating_point:
+                a = torch.randn(n, device=device).to(dtype)
+                b = torch.randn(n, device=device).to(dtype)
+            elif dtype.is_complex:
+                a = torch.randn(n, dtype=dtype, device=device)
+                b = torch.randn(n, dtype=dtype, device=device)
+            else:
+                a = torch.randint(-5, 5, (n,), dtype=dtype, device=device)
+                b = torch.randint(-5, 5, (n,), dtype=dtype, device=device)
+            sa, sb = strided(a), strided(b)
+            self.assertFalse(sa.is_contiguous())
+
+            self.assertEqual(a + b, sa + sb)
+            self.assertEqual(a - b, sa - sb)
+            self.assertEqual(a * b, sa * sb)
+            self.assertEqual(a.add(b, alpha=2), sa.add(sb, alpha=2))
+            self.assertEqual(a.neg(), sa.neg())
+            self.assertEqual(a.abs(), sa.abs())
+            if dtype.is_floating_point or dtype.is_complex:
+                self.assertEqual(a / b, sa / sb)
+                self.assertEqual(a.exp(), sa.exp())
+                self.assertEqual(a.abs().sqrt(), sa.abs().sqrt())
+            if not dtype.is_complex:
+                self.assertEqual(torch.max(a, b), torch.max(sa, sb))
+                self.assertEqual(torch.min(a, b), torch.min(sa, sb))
+                self.assertEqual(a.max(), sa.max())
+                self.assertEqual(a.min(), sa.min())
+            if dtype == torch.bfloat16:
+                # Summation order differs between the two paths.
+                self.assertEqual(a.sum(), sa.sum(), atol=0.02 * n, rtol=0.05)
+            else:
+                self.assertEqual(a.sum(), sa.sum())
+            if dtype in (torch.float, torch.double):
+                self.assertEqual(torch.softmax(a, 0), torch.softmax(a.double(), 0).to(dtype))
+                self.assertEqual(torch.log_softmax(a, 0), torch.log_softmax(a.double(), 0).to(dtype))
+
     @dtypes(torch.float)
     def test_absolute(self, device, dtype):
         # absolute is an alias for abs. Just check to see that results
@@ -614,7 +614,7 @@ def get_testing_overrides():
         torch.spmm: lambda input, mat2: -1,
         torch.softmax: lambda input, dim, dtype=None: -1,
         torch.solve: lambda input, A, out=None: -1,
-        torch.sort: lambda input, dim=-1, descending=False, out=None: -1,
+        torch.sort: lambda input, dim=-1, descending=False, stable=False, out=None: -1,
         torch.split: lambda tensor, split_size_or_sections, dim=0: -1,
         torch.split_with_sizes: lambda tensor, split_size_or_sections, dim=0: -1,
         torch.sqrt: lambda input, out=None: -1,
@@ -453,6 +453,49 @@ class record_function(ContextDecorator):
         return profiled_future
 
 
+class streaming_profile(object):
+    """Context manager that continuously streams profiling events to a trace file.
+
+    Unlike :class:`profile`, which keeps every event in memory until it exits,
+    this records into fixed-size per-thread ring buffers and periodically appends
+    the events to ``path`` in the Chrome trace format (viewable in
+    chrome://tracing or Perfetto), so it can be left on for long running
+    processes. Events that do not fit in a thread's ring buffer before the next
+    flush are dropped and counted in :attr:`stats`.
+
+    Arguments:
+        path (str): File the trace is written to. It is overwritten.
+        ring_buffer_size (int, optional): Number of events each thread can
+            buffer between two flushes. Default: ``65536``.
+        sample_period (int, optional): Record one in ``sample_period`` operator
+            calls, chosen at random. Default: ``1``.
+        flush_interval_ms (int, optional): How often the buffered events are
+            written to ``path``. Default: ``1000``.
+
+    Example:
+        >>> with torch.autograd.profiler.streaming_profile("trace.json", sample_period=100) as prof:
+        ...     serve_forever()
+        >>> print(prof.stats.recorded, prof.stats.dropped)
+    """
+    def __init__(self, path, ring_buffer_size=65536, sample_period=1, flush_interval_ms=1000):
+        self.config = torch.autograd.StreamingProfilerConfig(path)
+        self.config.ring_buffer_size = ring_buffer_size
+        self.config.sample_period = sample_period
+        self.config.flush_interval_ms = flush_interval_ms
+        self.stats = None
+
+    def __enter__(self):
+        torch.autograd._enable_streaming_profiler(self.config)
+        return self
+
+    def flush(self):
+        torch.autograd._flush_streaming_profiler()
+
+    def __exit__(self, exc_type, exc_val, exc_tb):
+        self.stats = torch.autograd._disable_streaming_profiler()
+        return False
+
+
 class emit_nvtx(object):
     """Context manager that makes every autograd operation emit an NVTX range.
 
@@ -13,6 +13,7 @@
 
 #include <c10/util/Exception.h>
 
+#include <algorithm>
 #include <cstddef>
 #include <exception>
 #include <memory>
@@ -37,6 +38,7 @@ class DataLoaderBase {
       std::unique_ptr<Dataset> main_thread_dataset = nullptr)
       : options_(std::move(options)),
         main_thread_dataset_(std::move(main_thread_dataset)),
+        shuttle_(std::max<size_t>(options_.max_jobs + options_.workers, 1)),
         sequencer_(new_sequencer()) {}
 
   virtual ~DataLoaderBase() {
@@ -178,8 +180,10 @@ class DataLoaderBase {
     return nullopt;
   }
 
-  /// The function that worker threads run.
-  void worker_thread(Dataset& dataset) {
+  /// The function that worker threads run. `dataset` is either the dataset,
+  /// or a `detail::WorkerProcess` that owns a copy of it.
+  template <typename Source>
+  void worker_thread(Source& dataset) {
     while (true) {
       auto job = shuttle_.pop_job();
       if (job.quit) {
@@ -233,7 +237,9 @@ class DataLoaderBase {
   /// The worker threads, running the `worker_thread()` method.
   std::vector<std::thread> workers_;
 
-  /// The `DataShuttle` which takes care of the life cycle of a job.
+  /// The `DataShuttle` which takes care of the life cycle of a job. Its
+  /// queues have room for all jobs in flight and one `QuitWorker` message per
+  /// worker, so pushing to them never blocks.
   detail::DataShuttle<Job, Result> shuttle_;
 
   /// The `Sequencer`, which handles optional ordering of batches.
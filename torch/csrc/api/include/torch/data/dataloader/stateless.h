@@ -1,6 +1,7 @@
 #pragma once
 
 #include <torch/data/dataloader/base.h>
+#include <torch/data/detail/worker_process.h>
 #include <torch/data/worker_exception.h>
 
 #include <torch/csrc/utils/memory.h>
@@ -8,8 +9,11 @@
 #include <c10/util/Exception.h>
 
 #include <cstddef>
+#include <memory>
 #include <thread>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace torch {
 namespace data {
@@ -40,6 +44,10 @@ class StatelessDataLoader : public DataLoaderBase<
       Sampler sampler,
       DataLoaderOptions options)
       : super(std::move(options)), sampler_(std::move(sampler)) {
+    if (this->options_.worker_processes && this->options_.workers > 0) {
+      start_worker_processes(dataset);
+      return;
+    }
     for (size_t w = 0; w < this->options_.workers; ++w) {
       // Here we copy the dataset into the worker thread closure. Each worker
       // has its own copy of the dataset. This means the dataset must be
@@ -55,6 +63,47 @@ class StatelessDataLoader : public DataLoaderBase<
   }
 
  private:
+  void start_worker_processes(Dataset& dataset) {
+#ifdef _WIN32
+    AT_ERROR("DataLoader worker processes are not supported on Windows");
+#else
+    using Transportable = std::integral_constant<
+        bool,
+        detail::IsProcessTransportable<BatchRequestType>::value &&
+            detail::IsProcessTransportable<
+                typename Dataset::BatchType>::value>;
+    start_worker_processes(dataset, Transportable());
+#endif
+  }
+
+#ifndef _WIN32
+  void start_worker_processes(Dataset& /*dataset*/, std::false_type) {
+    AT_ERROR(
+        "DataLoader worker processes require a specialization of "
+        "torch::data::detail::ProcessTransport for the batch and batch "
+        "request types of the dataset");
+  }
+
+  /// Forks all worker processes, then starts one worker thread per process.
+  /// Forking before any worker thread exists keeps the children from
+  /// inheriting their state.
+  void start_worker_processes(Dataset& dataset, std::true_type) {
+    using Process = detail::
+        WorkerProcess<BatchRequestType, typename Dataset::BatchType>;
+    std::vector<std::shared_ptr<Process>> processes;
+    for (size_t w = 0; w < this->options_.workers; ++w) {
+      processes.push_back(std::make_shared<Process>(dataset));
+    }
+    for (auto& process : processes) {
+      // The process is shut down when the worker thread is done with it.
+      this->workers_.emplace_back([this, process]() mutable {
+        this->worker_thread(*process);
+        process.reset();
+      });
+    }
+  }
+#endif
+
   /// Resets the internal state of the dataloader and the sampler.
   void reset() override {
     sampler_.reset();
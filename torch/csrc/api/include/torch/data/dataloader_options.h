@@ -37,6 +37,14 @@ struct DataLoaderOptions {
   /// Whether to omit the last batch if it contains less than `batch_size`
   /// examples.
   TORCH_ARG(bool, drop_last) = false;
+
+  /// Whether each worker thread should hand its batch requests to a worker
+  /// process, forked from the constructor of the `DataLoader`, which owns a
+  /// copy of the dataset. Batches are returned through shared memory without
+  /// copying their tensors again. Only supported for stateless datasets on
+  /// POSIX systems. The batch and batch request types must have a
+  /// `torch::data::detail::ProcessTransport` specialization.
+  TORCH_ARG(bool, worker_processes) = false;
 };
 
 /// Like `DataLoaderOptions`, but without any unconfigured state.
@@ -52,7 +60,8 @@ struct FullDataLoaderOptions {
         max_jobs(options.max_jobs().value_or(2 * workers)),
         timeout(options.timeout()),
         enforce_ordering(options.enforce_ordering()),
-        drop_last(options.drop_last()) {}
+        drop_last(options.drop_last()),
+        worker_processes(options.worker_processes()) {}
 
   size_t batch_size;
   size_t workers;
@@ -60,6 +69,7 @@ struct FullDataLoaderOptions {
   optional<std::chrono::milliseconds> timeout;
   bool enforce_ordering;
   bool drop_last;
+  bool worker_processes;
 };
 } // namespace data
 } // namespace torch
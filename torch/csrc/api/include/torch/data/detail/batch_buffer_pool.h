@@ -0,0 +1,80 @@
+#pragma once
+
+#include <torch/types.h>
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace torch {
+namespace data {
+namespace detail {
+
+/// A pool of tensors that batches are stacked into, to avoid allocating a new
+/// tensor for every batch. A buffer is handed out again once nothing but the
+/// pool refers to it, i.e. once the batch that was stacked into it, and all
+/// views of it, have been destroyed.
+///
+/// Copies of a collation share their pool, so that the copies of a dataset
+/// used by the worker threads of a `DataLoader` share one.
+class BatchBufferPool {
+ public:
+  /// Keeps up to `max_buffers` buffers for reuse. Pinned buffers are
+  /// allocated through the caching host allocator, which reuses them once
+  /// pending copies from them have completed, instead of being kept here.
+  BatchBufferPool(size_t max_buffers, bool pin_memory)
+      : max_buffers_(max_buffers), pin_memory_(pin_memory) {}
+
+  /// Stacks `tensors` along a new first dimension, like `torch::stack`, into
+  /// a buffer from the pool.
+  Tensor stack(TensorList tensors) {
+    if (tensors.empty()) {
+      return torch::stack(tensors);
+    }
+    std::vector<int64_t> sizes = {static_cast<int64_t>(tensors.size())};
+    const auto& first = tensors.front();
+    sizes.insert(sizes.end(), first.sizes().begin(), first.sizes().end());
+    Tensor buffer = acquire(sizes, first.options());
+    return torch::stack_out(buffer, tensors);
+  }
+
+ private:
+  static bool is_free(const Tensor& buffer) {
+    return buffer.use_count() == 1 && buffer.storage().use_count() == 1;
+  }
+
+  Tensor acquire(IntArrayRef sizes, const TensorOptions& options) {
+    if (pin_memory_) {
+      return torch::empty(sizes, options.pinned_memory(true));
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    Tensor* replaceable = nullptr;
+    for (auto& buffer : buffers_) {
+      if (!is_free(buffer)) {
+        continue;
+      }
+      if (buffer.sizes() == sizes && buffer.dtype() == options.dtype() &&
+          buffer.device() == options.device()) {
+        return buffer;
+      }
+      replaceable = &buffer;
+    }
+    Tensor buffer = torch::empty(sizes, options);
+    if (buffers_.size() < max_buffers_) {
+      buffers_.push_back(buffer);
+    } else if (replaceable != nullptr) {
+      // E.g. the buffer of a smaller last batch.
+      *replaceable = buffer;
+    }
+    return buffer;
+  }
+
+  const size_t max_buffers_;
+  const bool pin_memory_;
+  std::mutex mutex_;
+  std::vector<Tensor> buffers_;
+};
+
+} // namespace detail
+} // namespace data
+} // namespace torch
@@ -25,6 +25,13 @@ namespace detail {
 template <typename Job, typename Result>
 class DataShuttle {
  public:
+  DataShuttle() = default;
+
+  /// Constructs a `DataShuttle` whose job and result queues hold at most
+  /// `capacity` elements each.
+  explicit DataShuttle(size_t capacity)
+      : new_jobs_(capacity), results_(capacity) {}
+
   /// Pushes a new job. Called by the main thread.
   void push_job(Job job) {
     new_jobs_.push(std::move(job));
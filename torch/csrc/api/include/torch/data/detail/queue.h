@@ -4,21 +4,34 @@
 
 #include <c10/util/Exception.h>
 
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <mutex>
-#include <queue>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 namespace torch {
 namespace data {
 namespace detail {
 
-/// A basic locked, blocking MPMC queue.
+/// A bounded, blocking MPMC queue.
 ///
-/// Every `push` and `pop` is guarded by a mutex. A condition variable is used
-/// to communicate insertion of new elements, such that waiting threads will be
-/// woken up if they are currently waiting inside a call to `pop()`.
+/// Elements live in a ring buffer whose slots carry a sequence number, which
+/// tells producers and consumers whether the slot is free for writing or ready
+/// for reading in the current lap around the ring (Dmitry Vyukov's bounded
+/// MPMC queue). `push` and `pop` claim a slot with a single compare-and-swap
+/// and never take a lock while the queue is neither full nor empty. Elements
+/// are moved in and out of the queue, so `T` only needs to be movable.
+///
+/// Only threads that have to wait, because the queue is empty (`pop`) or full
+/// (`push`), go to sleep on a condition variable. The other side checks for
+/// sleeping threads after every operation, and only then takes the mutex to
+/// wake one of them up. A full queue thus exerts backpressure on producers.
 ///
 /// Note that this data structure is written specifically for use with the
 /// `DataLoader`. Its behavior is tailored to this use case and may not be
@@ -26,14 +39,48 @@ namespace detail {
 template <typename T>
 class Queue {
  public:
+  /// The capacity of a default-constructed `Queue`.
+  static constexpr size_t kDefaultCapacity = 1024;
+
+  /// Constructs a `Queue` that holds at most `capacity` elements, rounded up
+  /// to the next power of two (and to at least two, so that the sequence
+  /// numbers of free and occupied slots differ).
+  explicit Queue(size_t capacity = kDefaultCapacity) {
+    TORCH_CHECK(capacity > 0, "Queue capacity must be positive");
+    size_t size = 2;
+    while (size < capacity) {
+      size *= 2;
+    }
+    mask_ = size - 1;
+    slots_.reset(new Slot[size]);
+    for (size_t i = 0; i < size; ++i) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  ~Queue() {
+    clear();
+  }
+
+  Queue(const Queue&) = delete;
+  Queue& operator=(const Queue&) = delete;
+
+  /// Returns the maximum number of elements the `Queue` can hold.
+  size_t capacity() const noexcept {
+    return mask_ + 1;
+  }
+
   /// Pushes a new value to the back of the `Queue` and notifies one thread on
-  /// the waiting side about this event.
+  /// the waiting side about this event. Blocks while the `Queue` is full.
   void push(T value) {
-    {
-      std::lock_guard<std::mutex> lock(mutex_);
-      queue_.push(std::move(value));
+    if (!try_push(value)) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      ++waiting_producers_;
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      not_full_.wait(lock, [this, &value] { return this->try_push(value); });
+      --waiting_producers_;
     }
-    cv_.notify_one();
+    notify(waiting_consumers_, not_empty_);
   }
 
   /// Blocks until at least one element is ready to be popped from the front of
@@ -41,44 +88,142 @@ class Queue {
   /// spent waiting for an element. If the wait times out, an exception is
   /// raised.
   T pop(optional<std::chrono::milliseconds> timeout = nullopt) {
-    std::unique_lock<std::mutex> lock(mutex_);
-    if (timeout) {
-      if (!cv_.wait_for(
-              lock, *timeout, [this] { return !this->queue_.empty(); })) {
-        // clang-format off
-        AT_ERROR(
-            "Timeout in DataLoader queue while waiting for next batch"
-            " (timeout was ", timeout->count(), " ms)");
-        // clang-format on
+    optional<T> value = try_pop();
+    if (!value) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      ++waiting_consumers_;
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      auto ready = [this, &value] {
+        value = this->try_pop();
+        return value.has_value();
+      };
+      if (timeout) {
+        if (!not_empty_.wait_for(lock, *timeout, ready)) {
+          --waiting_consumers_;
+          // clang-format off
+          AT_ERROR(
+              "Timeout in DataLoader queue while waiting for next batch"
+              " (timeout was ", timeout->count(), " ms)");
+          // clang-format on
+        }
+      } else {
+        not_empty_.wait(lock, ready);
       }
-    } else {
-      cv_.wait(lock, [this] { return !this->queue_.empty(); });
+      --waiting_consumers_;
     }
-    AT_ASSERT(!queue_.empty());
-    T value = queue_.front();
-    queue_.pop();
-    lock.unlock();
-    return value;
+    notify(waiting_producers_, not_full_);
+    return std::move(*value);
   }
 
   /// Empties the queue and returns the number of elements that were present at
-  /// the start of the function. No threads are notified about this event as it
-  /// is assumed to be used to drain the queue during shutdown of a
-  /// `DataLoader`.
+  /// the start of the function. Only threads blocked in `push` are notified
+  /// about this event, as it is assumed to be used to drain the queue during
+  /// shutdown of a `DataLoader`.
   size_t clear() {
-    std::lock_guard<std::mutex> lock(this->mutex_);
-    const auto size = queue_.size();
-    while (!queue_.empty()) {
-      queue_.pop();
+    size_t size = 0;
+    while (try_pop()) {
+      ++size;
+    }
+    if (size > 0) {
+      notify(waiting_producers_, not_full_);
     }
     return size;
   }
 
  private:
-  std::queue<T> queue_;
+  struct Slot {
+    /// Equal to the position of the slot in the ring buffer (plus a multiple
+    /// of the capacity) when the slot is free, and to that plus one when it
+    /// holds an element.
+    std::atomic<size_t> sequence;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+  };
+
+  /// Moves `value` into the queue, unless it is full.
+  bool try_push(T& value) {
+    size_t position = enqueue_position_.load(std::memory_order_relaxed);
+    Slot* slot;
+    while (true) {
+      slot = &slots_[position & mask_];
+      const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+      const auto difference =
+          static_cast<std::intptr_t>(sequence) -
+          static_cast<std::intptr_t>(position);
+      if (difference == 0) {
+        if (enqueue_position_.compare_exchange_weak(
+                position, position + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (difference < 0) {
+        return false;
+      } else {
+        position = enqueue_position_.load(std::memory_order_relaxed);
+      }
+    }
+    new (&slot->storage) T(std::move(value));
+    slot->sequence.store(position + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Moves the front element out of the queue, unless it is empty.
+  optional<T> try_pop() {
+    size_t position = dequeue_position_.load(std::memory_order_relaxed);
+    Slot* slot;
+    while (true) {
+      slot = &slots_[position & mask_];
+      const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+      const auto difference =
+          static_cast<std::intptr_t>(sequence) -
+          static_cast<std::intptr_t>(position + 1);
+      if (difference == 0) {
+        if (dequeue_position_.compare_exchange_weak(
+                position, position + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (difference < 0) {
+        return nullopt;
+      } else {
+        position = dequeue_position_.load(std::memory_order_relaxed);
+      }
+    }
+    T* element = reinterpret_cast<T*>(&slot->storage);
+    optional<T> value(std::move(*element));
+    element->~T();
+    slot->sequence.store(position + mask_ + 1, std::memory_order_release);
+    return value;
+  }
+
+  /// Wakes up one of the threads waiting on `condition`, if there are any.
+  void notify(std::atomic<size_t>& waiting, std::condition_variable& condition) {
+    // Orders the preceding push or pop before the load of `waiting`. Waiting
+    // threads increment `waiting` and fence before checking the queue
+    // themselves, so either they see the change, or we see them.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiting.load(std::memory_order_relaxed) > 0) {
+      // Taking the mutex ensures that the waiting thread is either still
+      // before its check or already waiting on the condition variable.
+      { std::lock_guard<std::mutex> lock(mutex_); }
+      condition.notify_one();
+    }
+  }
+
+  std::unique_ptr<Slot[]> slots_;
+  size_t mask_;
+  /// Kept on separate cache lines, since producers only modify the first and
+  /// consumers only modify the second.
+  std::atomic<size_t> enqueue_position_{0};
+  char padding_[64];
+  std::atomic<size_t> dequeue_position_{0};
+
   std::mutex mutex_;
-  std::condition_variable cv_;
+  std::condition_variable not_empty_;
+  std::condition_variable not_full_;
+  std::atomic<size_t> waiting_consumers_{0};
+  std::atomic<size_t> waiting_producers_{0};
 };
+
+template <typename T>
+constexpr size_t Queue<T>::kDefaultCapacity;
 } // namespace detail
 } // namespace data
 } // namespace torch
@@ -0,0 +1,331 @@
+#pragma once
+
+#ifndef _WIN32
+
+#include <torch/csrc/WindowsTorchApiMacro.h>
+#include <torch/data/example.h>
+#include <torch/types.h>
+
+#include <c10/core/Allocator.h>
+
+#include <sys/types.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace torch {
+namespace data {
+namespace detail {
+
+/// Serializes the values of a message to or from a worker process.
+///
+/// Plain values are appended to a byte buffer. Tensors are only described in
+/// the buffer. Their data is copied into a single shared memory segment per
+/// message, at an offset recorded next to their description.
+class TORCH_API ProcessWriter {
+ public:
+  /// Appends `size` bytes at `data` to the message.
+  void write(const void* data, size_t size);
+
+  /// Appends `tensor` to the message. Tensors must live on the CPU. They are
+  /// sent as contiguous tensors that do not require grad.
+  void write_tensor(const Tensor& tensor);
+
+  template <typename T>
+  void write_value(const T& value) {
+    static_assert(std::is_trivially_copyable<T>::value, "");
+    write(&value, sizeof(T));
+  }
+
+  const std::string& bytes() const noexcept {
+    return bytes_;
+  }
+
+  /// The size of the shared memory segment that holds the tensor data.
+  size_t segment_size() const noexcept {
+    return segment_size_;
+  }
+
+  /// Copies the data of all tensors into `segment`.
+  void copy_tensors(void* segment) const;
+
+ private:
+  std::string bytes_;
+  std::vector<std::pair<Tensor, size_t>> tensors_;
+  size_t segment_size_ = 0;
+};
+
+/// Deserializes a message written by a `ProcessWriter`. Tensors read from the
+/// message are views of the mapped shared memory segment, which stays mapped
+/// for as long as any of them is alive.
+class TORCH_API ProcessReader {
+ public:
+  ProcessReader(std::string bytes, std::shared_ptr<at::DataPtr> segment);
+
+  /// Reads the next `size` bytes of the message into `data`.
+  void read(void* data, size_t size);
+
+  Tensor read_tensor();
+
+  template <typename T>
+  T read_value() {
+    static_assert(std::is_trivially_copyable<T>::value, "");
+    T value;
+    read(&value, sizeof(T));
+    return value;
+  }
+
+ private:
+  std::string bytes_;
+  size_t position_ = 0;
+  std::shared_ptr<at::DataPtr> segment_;
+};
+
+/// Describes how values of type `T` are sent to and from worker processes.
+/// Specialize this for the batch (and batch request) types of a dataset to
+/// use it with a `DataLoader` that runs its workers in processes. A
+/// specialization has the members
+///
+///   static void write(ProcessWriter& writer, const T& value);
+///   static T read(ProcessReader& reader);
+template <typename T, typename Enable = void>
+struct ProcessTransport {
+  /// Marks types without a specialization.
+  using Unsupported = void;
+};
+
+/// Whether `ProcessTransport` has been specialized for `T`.
+template <typename T, typename Enable = void>
+struct IsProcessTransportable : std::true_type {};
+
+template <typename T>
+struct IsProcessTransportable<T, typename ProcessTransport<T>::Unsupported>
+    : std::false_type {};
+
+template <typename T>
+struct ProcessTransport<
+    T,
+    typename std::enable_if<std::is_arithmetic<T>::value>::type> {
+  static void write(ProcessWriter& writer, const T& value) {
+    writer.write_value(value);
+  }
+  static T read(ProcessReader& reader) {
+    return reader.read_value<T>();
+  }
+};
+
+template <>
+struct ProcessTransport<std::string> {
+  static void write(ProcessWriter& writer, const std::string& value) {
+    writer.write_value<uint64_t>(value.size());
+    writer.write(value.data(), value.size());
+  }
+  static std::string read(ProcessReader& reader) {
+    std::string value(reader.read_value<uint64_t>(), '\0');
+    reader.read(&value[0], value.size());
+    return value;
+  }
+};
+
+template <>
+struct ProcessTransport<Tensor> {
+  static void write(ProcessWriter& writer, const Tensor& value) {
+    writer.write_tensor(value);
+  }
+  static Tensor read(ProcessReader& reader) {
+    return reader.read_tensor();
+  }
+};
+
+template <typename T>
+struct ProcessTransport<
+    std::vector<T>,
+    typename std::enable_if<IsProcessTransportable<T>::value>::type> {
+  static void write(ProcessWriter& writer, const std::vector<T>& value) {
+    writer.write_value<uint64_t>(value.size());
+    for (const auto& element : value) {
+      ProcessTransport<T>::write(writer, element);
+    }
+  }
+  static std::vector<T> read(ProcessReader& reader) {
+    const auto size = reader.read_value<uint64_t>();
+    std::vector<T> value;
+    value.reserve(size);
+    for (uint64_t i = 0; i < size; ++i) {
+      value.push_back(ProcessTransport<T>::read(reader));
+    }
+    return value;
+  }
+};
+
+template <typename Data, typename Target>
+struct ProcessTransport<
+    Example<Data, Target>,
+    typename std::enable_if<
+        IsProcessTransportable<Data>::value &&
+        IsProcessTransportable<Target>::value>::type> {
+  static void write(ProcessWriter& writer, const Example<Data, Target>& value) {
+    ProcessTransport<Data>::write(writer, value.data);
+    ProcessTransport<Target>::write(writer, value.target);
+  }
+  static Example<Data, Target> read(ProcessReader& reader) {
+    auto data = ProcessTransport<Data>::read(reader);
+    return {std::move(data), ProcessTransport<Target>::read(reader)};
+  }
+};
+
+template <typename Data>
+struct ProcessTransport<
+    Example<Data, example::NoTarget>,
+    typename std::enable_if<IsProcessTransportable<Data>::value>::type> {
+  static void write(
+      ProcessWriter& writer,
+      const Example<Data, example::NoTarget>& value) {
+    ProcessTransport<Data>::write(writer, value.data);
+  }
+  static Example<Data, example::NoTarget> read(ProcessReader& reader) {
+    return {ProcessTransport<Data>::read(reader)};
+  }
+};
+
+/// One end of the connection between the `DataLoader` and a worker process,
+/// a UNIX domain socket. The shared memory segment of a message is unlinked
+/// as soon as it has been created, and travels as a file descriptor alongside
+/// the message. It is thus freed once both processes have unmapped it, even
+/// if one of them crashes.
+class TORCH_API ProcessChannel {
+ public:
+  enum class MessageType : uint8_t { kRequest, kBatch, kError, kQuit };
+
+  struct Message {
+    MessageType type;
+    ProcessReader reader;
+  };
+
+  explicit ProcessChannel(int fd) : fd_(fd) {}
+  ~ProcessChannel();
+
+  ProcessChannel(const ProcessChannel&) = delete;
+  ProcessChannel& operator=(const ProcessChannel&) = delete;
+
+  void send(MessageType type, const ProcessWriter& writer);
+
+  /// Blocks until the next message arrives. Returns `nullopt` if the other
+  /// process closed its end of the connection (e.g. because it exited).
+  optional<Message> receive();
+
+ private:
+  int fd_;
+};
+
+/// A forked worker process and the `DataLoader`'s end of the connection to
+/// it. Destroying the handle tells the process to quit and waits for it.
+class TORCH_API ProcessHandle {
+ public:
+  /// Forks a process that calls `serve` with its end of the connection and
+  /// exits once `serve` returns.
+  explicit ProcessHandle(std::function<void(ProcessChannel&)> serve);
+  ~ProcessHandle();
+
+  ProcessHandle(const ProcessHandle&) = delete;
+  ProcessHandle& operator=(const ProcessHandle&) = delete;
+
+  pid_t pid() const noexcept {
+    return pid_;
+  }
+
+  ProcessChannel& channel() {
+    return *channel_;
+  }
+
+ private:
+  pid_t pid_;
+  std::unique_ptr<ProcessChannel> channel_;
+};
+
+/// A worker process that owns a copy of a stateless dataset and turns batch
+/// requests into batches, like the worker threads of a `DataLoader` do.
+///
+/// The process is forked from the `DataLoader`'s constructor, so it starts
+/// out with the state of the parent at that point. Only the forking thread
+/// exists in the child, which asks for a single intra-op thread. With the
+/// native and work-stealing backends, whose fork handlers drop the parent's
+/// intra-op pool in the child, and with OpenMP, parallel ops then run
+/// serially on that thread.
+template <typename BatchRequest, typename Batch>
+class WorkerProcess {
+ public:
+  template <typename Dataset>
+  explicit WorkerProcess(Dataset& dataset)
+      : process_([&dataset](ProcessChannel& channel) {
+          serve(dataset, channel);
+        }) {}
+
+  pid_t pid() const noexcept {
+    return process_.pid();
+  }
+
+  /// Sends `request` to the worker process and waits for the batch. An
+  /// exception thrown by the dataset in the worker process is rethrown here
+  /// as a `std::runtime_error` with the same message.
+  Batch get_batch(BatchRequest request) {
+    ProcessWriter writer;
+    ProcessTransport<BatchRequest>::write(writer, request);
+    auto& channel = process_.channel();
+    channel.send(ProcessChannel::MessageType::kRequest, writer);
+    auto message = channel.receive();
+    TORCH_CHECK(
+        message.has_value(),
+        "DataLoader worker process ",
+        process_.pid(),
+        " exited unexpectedly");
+    if (message->type == ProcessChannel::MessageType::kError) {
+      throw std::runtime_error(
+          ProcessTransport<std::string>::read(message->reader));
+    }
+    return ProcessTransport<Batch>::read(message->reader);
+  }
+
+ private:
+  template <typename Dataset>
+  static void serve(Dataset& dataset, ProcessChannel& channel) {
+    while (auto message = channel.receive()) {
+      if (message->type == ProcessChannel::MessageType::kQuit) {
+        break;
+      }
+      std::string error;
+      try {
+        auto request = ProcessTransport<BatchRequest>::read(message->reader);
+        Batch batch = dataset.get_batch(std::move(request));
+        ProcessWriter writer;
+        ProcessTransport<Batch>::write(writer, batch);
+        channel.send(ProcessChannel::MessageType::kBatch, writer);
+        continue;
+      } catch (const std::exception& e) {
+        error = e.what();
+      } catch (...) {
+        error = "Unknown exception in DataLoader worker process";
+      }
+      ProcessWriter writer;
+      ProcessTransport<std::string>::write(writer, error);
+      channel.send(ProcessChannel::MessageType::kError, writer);
+    }
+  }
+
+  ProcessHandle process_;
+};
+
+} // namespace detail
+} // namespace data
+} // namespace torch
+
+#endif // _WIN32
@@ -1,9 +1,12 @@
 #pragma once
 
+#include <torch/arg.h>
+#include <torch/data/detail/batch_buffer_pool.h>
 #include <torch/data/example.h>
 #include <torch/data/transforms/collate.h>
 #include <torch/types.h>
 
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -14,10 +17,35 @@ namespace transforms {
 template <typename T = Example<>>
 struct Stack;
 
+/// Options for collations that stack examples into reusable batch buffers.
+struct StackOptions {
+  /// The maximum number of buffers kept for reuse. Should be at least the
+  /// number of batches that are alive at the same time, i.e. the number of
+  /// jobs a `DataLoader` keeps in flight plus the batches held by the
+  /// training loop, for every batch to be stacked into a reused buffer.
+  TORCH_ARG(size_t, max_buffers) = 16;
+
+  /// Whether to stack into page-locked (pinned) memory, from which copies to
+  /// CUDA devices are faster and can be asynchronous. Requires CUDA.
+  TORCH_ARG(bool, pin_memory) = false;
+};
+
 /// A `Collation` for `Example<Tensor, Tensor>` types that stacks all data
 /// tensors into one tensor, and all target (label) tensors into one tensor.
 template <>
 struct Stack<Example<>> : public Collation<Example<>> {
+  Stack() = default;
+
+  /// Stacks the data and target tensors into buffers that are reused across
+  /// batches, configured by `options`.
+  explicit Stack(StackOptions options)
+      : data_buffers_(std::make_shared<detail::BatchBufferPool>(
+            options.max_buffers(),
+            options.pin_memory())),
+        target_buffers_(std::make_shared<detail::BatchBufferPool>(
+            options.max_buffers(),
+            options.pin_memory())) {}
+
   Example<> apply_batch(std::vector<Example<>> examples) override {
     std::vector<torch::Tensor> data, targets;
     data.reserve(examples.size());
@@ -26,8 +54,15 @@ struct Stack<Example<>> : public Collation<Example<>> {
       data.push_back(std::move(example.data));
       targets.push_back(std::move(example.target));
     }
+    if (data_buffers_) {
+      return {data_buffers_->stack(data), target_buffers_->stack(targets)};
+    }
     return {torch::stack(data), torch::stack(targets)};
   }
+
+ private:
+  std::shared_ptr<detail::BatchBufferPool> data_buffers_;
+  std::shared_ptr<detail::BatchBufferPool> target_buffers_;
 };
 
 /// A `Collation` for `Example<Tensor, NoTarget>` types that stacks all data
@@ -35,14 +70,29 @@ struct Stack<Example<>> : public Collation<Example<>> {
 template <>
 struct Stack<TensorExample>
     : public Collation<Example<Tensor, example::NoTarget>> {
+  Stack() = default;
+
+  /// Stacks the data tensors into buffers that are reused across batches,
+  /// configured by `options`.
+  explicit Stack(StackOptions options)
+      : data_buffers_(std::make_shared<detail::BatchBufferPool>(
+            options.max_buffers(),
+            options.pin_memory())) {}
+
   TensorExample apply_batch(std::vector<TensorExample> examples) override {
     std::vector<torch::Tensor> data;
     data.reserve(examples.size());
     for (auto& example : examples) {
       data.push_back(std::move(example.data));
     }
+    if (data_buffers_) {
+      return data_buffers_->stack(data);
+    }
     return torch::stack(data);
   }
+
+ private:
+  std::shared_ptr<detail::BatchBufferPool> data_buffers_;
 };
 } // namespace transforms
 } // namespace data
@@ -0,0 +1,338 @@
+#ifndef _WIN32
+
+#include <torch/data/detail/worker_process.h>
+
+#include <ATen/Parallel.h>
+#include <TH/THAllocator.h>
+#include <c10/util/Exception.h>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/prctl.h>
+#endif
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+
+namespace torch {
+namespace data {
+namespace detail {
+namespace {
+
+/// Tensors in a shared memory segment start at multiples of this, so that
+/// they are as aligned as freshly allocated ones.
+constexpr size_t kTensorAlignment = 64;
+
+/// The header that precedes each message: its type, the size of its bytes and
+/// the size of its shared memory segment.
+using Header = uint64_t[3];
+
+/// Writing to a worker process that has crashed must raise an error rather
+/// than SIGPIPE.
+#ifdef MSG_NOSIGNAL
+constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+constexpr int kSendFlags = 0;
+#endif
+
+void write_all(int fd, const char* data, size_t size) {
+  while (size > 0) {
+    const ssize_t written = ::send(fd, data, size, kSendFlags);
+    if (written == -1 && errno == EINTR) {
+      continue;
+    }
+    TORCH_CHECK(
+        written > 0,
+        "Failed to write to DataLoader worker process channel: ",
+        std::strerror(errno));
+    data += written;
+    size -= written;
+  }
+}
+
+void read_all(int fd, char* data, size_t size) {
+  while (size > 0) {
+    const ssize_t received = ::read(fd, data, size);
+    if (received == -1 && errno == EINTR) {
+      continue;
+    }
+    TORCH_CHECK(
+        received > 0,
+        "Failed to read from DataLoader worker process channel: ",
+        received == 0 ? "connection closed" : std::strerror(errno));
+    data += received;
+    size -= received;
+  }
+}
+
+std::string new_segment_name() {
+  static std::atomic<uint64_t> counter{0};
+  return "/torch_dataloader_" + std::to_string(::getpid()) + "_" +
+      std::to_string(counter++);
+}
+
+} // namespace
+
+void ProcessWriter::write(const void* data, size_t size) {
+  bytes_.append(static_cast<const char*>(data), size);
+}
+
+void ProcessWriter::write_tensor(const Tensor& tensor) {
+  write_value<bool>(tensor.defined());
+  if (!tensor.defined()) {
+    return;
+  }
+  TORCH_CHECK(
+      tensor.device().is_cpu(),
+      "DataLoader worker processes can only send CPU tensors, got a tensor "
+      "on ",
+      tensor.device());
+  Tensor contiguous = tensor.contiguous();
+  write_value<int8_t>(static_cast<int8_t>(contiguous.scalar_type()));
+  write_value<int64_t>(contiguous.dim());
+  for (const auto size : contiguous.sizes()) {
+    write_value<int64_t>(size);
+  }
+  const size_t offset = (segment_size_ + kTensorAlignment - 1) /
+      kTensorAlignment * kTensorAlignment;
+  write_value<uint64_t>(offset);
+  segment_size_ = offset + contiguous.nbytes();
+  tensors_.emplace_back(std::move(contiguous), offset);
+}
+
+void ProcessWriter::copy_tensors(void* segment) const {
+  for (const auto& tensor : tensors_) {
+    std::memcpy(
+        static_cast<char*>(segment) + tensor.second,
+        tensor.first.data_ptr(),
+        tensor.first.nbytes());
+  }
+}
+
+ProcessReader::ProcessReader(
+    std::string bytes,
+    std::shared_ptr<at::DataPtr> segment)
+    : bytes_(std::move(bytes)), segment_(std::move(segment)) {}
+
+void ProcessReader::read(void* data, size_t size) {
+  TORCH_CHECK(
+      position_ + size <= bytes_.size(),
+      "Unexpected end of message from DataLoader worker process");
+  std::memcpy(data, bytes_.data() + position_, size);
+  position_ += size;
+}
+
+Tensor ProcessReader::read_tensor() {
+  if (!read_value<bool>()) {
+    return Tensor();
+  }
+  const auto type = static_cast<ScalarType>(read_value<int8_t>());
+  std::vector<int64_t> sizes(read_value<int64_t>());
+  for (auto& size : sizes) {
+    size = read_value<int64_t>();
+  }
+  const auto offset = read_value<uint64_t>();
+  if (!segment_) {
+    // Only tensors without elements were sent.
+    return torch::empty(sizes, type);
+  }
+  auto segment = segment_;
+  return torch::from_blob(
+      static_cast<char*>(segment->get()) + offset,
+      sizes,
+      [segment](void*) {},
+      type);
+}
+
+ProcessChannel::~ProcessChannel() {
+  ::close(fd_);
+}
+
+void ProcessChannel::send(MessageType type, const ProcessWriter& writer) {
+  at::DataPtr segment;
+  int segment_fd = -1;
+  if (writer.segment_size() > 0) {
+    // The segment is unlinked right away and only reachable through its file
+    // descriptor from then on. Our mapping (and our descriptor) are released
+    // at the end of this function; the descriptor in flight keeps the memory
+    // alive until the other process maps it.
+    segment = THMapAllocator::makeDataPtr(
+        new_segment_name().c_str(),
+        TH_ALLOCATOR_MAPPED_SHAREDMEM | TH_ALLOCATOR_MAPPED_EXCLUSIVE |
+            TH_ALLOCATOR_MAPPED_KEEPFD | TH_ALLOCATOR_MAPPED_UNLINK,
+        writer.segment_size(),
+        nullptr);
+    writer.copy_tensors(segment.get());
+    segment_fd = THMapAllocator::fromDataPtr(segment)->fd();
+  }
+
+  Header header = {static_cast<uint64_t>(type),
+                   writer.bytes().size(),
+                   writer.segment_size()};
+  struct iovec iov;
+  iov.iov_base = header;
+  iov.iov_len = sizeof(header);
+  struct msghdr msg;
+  std::memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  char control[CMSG_SPACE(sizeof(int))];
+  if (segment_fd != -1) {
+    std::memset(control, 0, sizeof(control));
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+    std::memcpy(CMSG_DATA(cmsg), &segment_fd, sizeof(int));
+  }
+  ssize_t sent;
+  do {
+    sent = ::sendmsg(fd_, &msg, kSendFlags);
+  } while (sent == -1 && errno == EINTR);
+  TORCH_CHECK(
+      sent > 0,
+      "Failed to write to DataLoader worker process channel: ",
+      std::strerror(errno));
+  // The file descriptor went out with the first byte of the header.
+  write_all(
+      fd_,
+      reinterpret_cast<const char*>(header) + sent,
+      sizeof(header) - sent);
+  write_all(fd_, writer.bytes().data(), writer.bytes().size());
+}
+
+optional<ProcessChannel::Message> ProcessChannel::receive() {
+  Header header;
+  struct iovec iov;
+  iov.iov_base = header;
+  iov.iov_len = sizeof(header);
+  char control[CMSG_SPACE(sizeof(int))];
+  struct msghdr msg;
+  std::memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+  ssize_t received;
+  do {
+    received = ::recvmsg(fd_, &msg, 0);
+  } while (received == -1 && errno == EINTR);
+  if (received == 0 || (received == -1 && errno == ECONNRESET)) {
+    return nullopt;
+  }
+  TORCH_CHECK(
+      received > 0,
+      "Failed to read from DataLoader worker process channel: ",
+      std::strerror(errno));
+  int segment_fd = -1;
+  for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr;
+       cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+    if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+      std::memcpy(&segment_fd, CMSG_DATA(cmsg), sizeof(int));
+    }
+  }
+  read_all(
+      fd_,
+      reinterpret_cast<char*>(header) + received,
+      sizeof(header) - received);
+
+  std::shared_ptr<at::DataPtr> segment;
+  if (header[2] > 0) {
+    TORCH_CHECK(
+        segment_fd != -1,
+        "Missing shared memory segment in message from DataLoader worker "
+        "process");
+    // Maps the segment and closes the file descriptor.
+    segment = std::make_shared<at::DataPtr>(THMapAllocator::makeDataPtr(
+        WITH_FD,
+        "",
+        segment_fd,
+        TH_ALLOCATOR_MAPPED_SHAREDMEM | TH_ALLOCATOR_MAPPED_NOCREATE |
+            TH_ALLOCATOR_MAPPED_FROMFD,
+        header[2],
+        nullptr));
+  }
+  std::string bytes(header[1], '\0');
+  read_all(fd_, &bytes[0], bytes.size());
+  return Message{static_cast<MessageType>(header[0]),
+                 ProcessReader(std::move(bytes), std::move(segment))};
+}
+
+ProcessHandle::ProcessHandle(std::function<void(ProcessChannel&)> serve) {
+  int fds[2];
+  // Programs that the DataLoader's process or the worker exec must not
+  // inherit the channel.
+#ifdef SOCK_CLOEXEC
+  TORCH_CHECK(
+      ::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) == 0,
+      "Failed to create a channel to a DataLoader worker process: ",
+      std::strerror(errno));
+#else
+  TORCH_CHECK(
+      ::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0,
+      "Failed to create a channel to a DataLoader worker process: ",
+      std::strerror(errno));
+  ::fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+  ::fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+#endif
+#ifdef SO_NOSIGPIPE
+  const int enable = 1;
+  ::setsockopt(fds[0], SOL_SOCKET, SO_NOSIGPIPE, &enable, sizeof(enable));
+  ::setsockopt(fds[1], SOL_SOCKET, SO_NOSIGPIPE, &enable, sizeof(enable));
+#endif
+  pid_ = ::fork();
+  if (pid_ == -1) {
+    ::close(fds[0]);
+    ::close(fds[1]);
+    AT_ERROR(
+        "Failed to fork a DataLoader worker process: ", std::strerror(errno));
+  }
+  if (pid_ == 0) {
+    int status = 0;
+    try {
+      ::close(fds[0]);
+#ifdef __linux__
+      // Don't outlive the DataLoader's process if it is killed.
+      ::prctl(PR_SET_PDEATHSIG, SIGKILL);
+#endif
+      // The intra-op pool of the parent was dropped by the fork handler of
+      // the parallel backend, so this takes effect even if the parent
+      // already ran parallel work.
+      at::set_num_threads(1);
+      ProcessChannel channel(fds[1]);
+      serve(channel);
+    } catch (...) {
+      status = 1;
+    }
+    // Skips the exit handlers and static destructors, which belong to the
+    // parent process.
+    ::_exit(status);
+  }
+  ::close(fds[1]);
+  channel_.reset(new ProcessChannel(fds[0]));
+}
+
+ProcessHandle::~ProcessHandle() {
+  try {
+    channel_->send(ProcessChannel::MessageType::kQuit, ProcessWriter());
+  } catch (...) {
+    // The process has already exited.
+  }
+  channel_.reset();
+  int status;
+  while (::waitpid(pid_, &status, 0) == -1 && errno == EINTR) {
+  }
+}
+
+} // namespace detail
+} // namespace data
+} // namespace torch
+
+#endif // _WIN32
@@ -21,6 +21,7 @@
 #include <atomic>
 #include <condition_variable>
 #include <cstdint>
+#include <cstdlib>
 #include <functional>
 #include <iostream>
 #include <memory>
@@ -156,6 +157,35 @@ static thread_local std::shared_ptr<ReadyQueue> local_ready_queue = nullptr;
 // the leaf streams with the default streams is sufficient to implement
 // the historic behavior.
 
+// Note [Parallel CPU backward]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// By default, all CPU nodes of a backward call run one at a time on the
+// thread that called backward(). For wide graphs made of many small nodes,
+// independent branches then never overlap and most of the time goes into
+// the ReadyQueue's mutex and heap.
+//
+// When Engine::set_parallel_cpu_backward(true) is set, a top-level (i.e. not
+// reentrant) backward call gives its GraphTask a LockFreeReadyQueue. Ready
+// CPU nodes are pushed onto it instead of cpu_ready_queue_, and are run by the
+// owning thread in parallel_cpu_main() and by up to get_num_interop_threads()
+// helpers launched on the inter-op thread pool. A consumer detaches the whole
+// queue at once, runs the node that came latest in the forward pass (the same
+// order ReadyQueue uses), and pushes the rest back for the other threads.
+// Nodes on other devices still go through device_ready_queues_, and
+// exec_info_ filtering and dependency counting are unchanged since both
+// happen in evaluate_function under the GraphTask's mutex.
+//
+// Helpers leave as soon as they find the queue empty, so they never block
+// inter-op threads that nodes may need themselves. The owning thread parks
+// on the queue instead, and is woken up by pushes and on completion. It is
+// also the one to run the final callbacks once the GraphTask is done.
+//
+// Reentrant backward calls keep their usual semantics: a node calling
+// backward() runs the nested GraphTask serially on its thread. Helpers set
+// worker_device to CPU_DEVICE and use a ReadyQueue of their own, so that the
+// nested call is seen as reentrant and never shares a ready queue with the
+// owning thread. See Note [Reentrant backwards]
+
 int NodeTask::getReentrantDepth() const {
   std::shared_ptr<GraphTask> graph_task = base_.lock();
   if (graph_task) {
@@ -211,7 +241,69 @@ bool ReadyQueue::empty() const {
   return heap_.empty();
 }
 
-Engine::Engine() : max_recursion_depth_(MAX_DEPTH), non_reentrant_device_thread_count_(0) {}
+LockFreeReadyQueue::~LockFreeReadyQueue() {
+  Item* item = head_.load();
+  while (item) {
+    Item* next = item->next_;
+    delete item;
+    item = next;
+  }
+}
+
+void LockFreeReadyQueue::push(Item* first, Item* last) {
+  Item* head = head_.load();
+  do {
+    last->next_ = head;
+  } while (!head_.compare_exchange_weak(head, first));
+  // Pairs with the increment of sleepers_ in wait(): either the parked thread
+  // sees the new head, or we see it parked and notify it.
+  if (sleepers_.load() > 0) {
+    notify_all();
+  }
+}
+
+auto LockFreeReadyQueue::pop_all() -> Item* {
+  // Cheap check first, so that idle threads don't keep bouncing the cache line
+  if (!head_.load(std::memory_order_relaxed)) {
+    return nullptr;
+  }
+  return head_.exchange(nullptr);
+}
+
+bool LockFreeReadyQueue::empty() const {
+  return head_.load() == nullptr;
+}
+
+void LockFreeReadyQueue::notify_all() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+  }
+  not_empty_.notify_all();
+}
+
+bool LockFreeReadyQueue::try_add_helper() {
+  int num_helpers = num_helpers_.load();
+  while (num_helpers < max_helpers_) {
+    if (num_helpers_.compare_exchange_weak(num_helpers, num_helpers + 1)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void LockFreeReadyQueue::remove_helper() {
+  --num_helpers_;
+}
+
+static bool parallel_cpu_backward_from_env() {
+  const char* val = std::getenv("PYTORCH_AUTOGRAD_PARALLEL_CPU");
+  return val != nullptr && std::string(val) == "1";
+}
+
+Engine::Engine()
+    : max_recursion_depth_(MAX_DEPTH),
+      parallel_cpu_backward_(parallel_cpu_backward_from_env()),
+      non_reentrant_device_thread_count_(0) {}
 
 // Send shutdown tasks to all device_ready_queues_ if no backward tasks are running
 // Even though readyQueue should be empty, shutdown tasks have the highest priority
@@ -408,10 +500,16 @@ auto Engine::thread_main(
       //
       // NB: This is not necessary if the current thread is the owning thread.
       if (worker_device != base_owner) {
-        // Synchronize outstanding_tasks_ with queue mutex
-        std::atomic_thread_fence(std::memory_order_release);
-        ready_queue_by_index(local_graph_task->cpu_ready_queue_, base_owner)
-            ->push(NodeTask(local_graph_task, nullptr, InputBuffer(0)));
+        if (local_graph_task->parallel_cpu_queue_) {
+          // The owning thread is parked in parallel_cpu_main() rather than in
+          // pop(). See Note [Parallel CPU backward]
+          local_graph_task->parallel_cpu_queue_->notify_all();
+        } else {
+          // Synchronize outstanding_tasks_ with queue mutex
+          std::atomic_thread_fence(std::memory_order_release);
+          ready_queue_by_index(local_graph_task->cpu_ready_queue_, base_owner)
+              ->push(NodeTask(local_graph_task, nullptr, InputBuffer(0)));
+        }
       }
     }
   }
@@ -447,6 +545,151 @@ void Engine::reentrant_thread_init() {
   }
 }
 
+// Detaches the queue of the GraphTask, keeps the node that came latest in the
+// forward pass and pushes the others back so that idle threads can take them.
+// Returns nullptr if the queue is empty.
+auto Engine::pop_parallel_cpu_task(const std::shared_ptr<GraphTask>& graph_task)
+    -> LockFreeReadyQueue::Item* {
+  using Item = LockFreeReadyQueue::Item;
+  Item* first = graph_task->parallel_cpu_queue_->pop_all();
+  if (!first || !first->next_) {
+    return first;
+  }
+
+  Item* best = first;
+  Item* best_prev = nullptr;
+  Item* last = first;
+  for (Item* prev = first; prev->next_; prev = prev->next_) {
+    Item* item = prev->next_;
+    if (item->fn_->sequence_nr() > best->fn_->sequence_nr()) {
+      best = item;
+      best_prev = prev;
+    }
+    last = item;
+  }
+
+  if (best_prev) {
+    best_prev->next_ = best->next_;
+    if (last == best) {
+      last = best_prev;
+    }
+  } else {
+    first = best->next_;
+  }
+  best->next_ = nullptr;
+  push_parallel_cpu_tasks(graph_task, first, last);
+  return best;
+}
+
+void Engine::push_parallel_cpu_tasks(
+    const std::shared_ptr<GraphTask>& graph_task,
+    LockFreeReadyQueue::Item* first,
+    LockFreeReadyQueue::Item* last) {
+  auto& queue = *graph_task->parallel_cpu_queue_;
+  queue.push(first, last);
+  if (queue.try_add_helper()) {
+    at::launch([this, graph_task]() { parallel_cpu_helper(graph_task); });
+  }
+}
+
+void Engine::push_ready_task(
+    const std::shared_ptr<GraphTask>& graph_task,
+    const std::shared_ptr<ReadyQueue>& cpu_ready_queue,
+    std::shared_ptr<Node> fn,
+    InputBuffer inputs) {
+  auto device = inputs.device();
+  if (graph_task->parallel_cpu_queue_ && device.type() == at::kCPU) {
+    ++graph_task->outstanding_tasks_;
+    auto item = new LockFreeReadyQueue::Item(std::move(fn), std::move(inputs));
+    push_parallel_cpu_tasks(graph_task, item, item);
+  } else {
+    ready_queue(cpu_ready_queue, device)->push(
+        NodeTask(graph_task, std::move(fn), std::move(inputs)));
+  }
+}
+
+// Runs one node of a GraphTask in the parallel CPU backward mode, the same way
+// thread_main does for a NodeTask. Returns true if the GraphTask is completed.
+bool Engine::run_parallel_cpu_task(
+    std::shared_ptr<GraphTask>& graph_task,
+    LockFreeReadyQueue::Item* item) {
+  {
+    // Scoped so that the inputs are released before the GraphTask can be
+    // marked as completed.
+    std::unique_ptr<LockFreeReadyQueue::Item> task(item);
+    if (!graph_task->has_error_.load()) {
+      AutoGradMode grad_mode(graph_task->grad_mode_);
+      try {
+        GraphTaskGuard guard(graph_task);
+        evaluate_function(
+            graph_task, task->fn_.get(), task->inputs_, graph_task->cpu_ready_queue_);
+      } catch (std::exception& e) {
+        thread_on_exception(graph_task, task->fn_, e);
+      }
+    }
+  }
+
+  --graph_task->outstanding_tasks_;
+  if (graph_task->completed()) {
+    graph_task->parallel_cpu_queue_->notify_all();
+    return true;
+  }
+  return false;
+}
+
+// Driven by the thread that called backward(). See Note [Parallel CPU backward]
+void Engine::parallel_cpu_main(std::shared_ptr<GraphTask> graph_task) {
+  auto& queue = *graph_task->parallel_cpu_queue_;
+  while (!graph_task->completed()) {
+    auto item = pop_parallel_cpu_task(graph_task);
+    if (!item) {
+      queue.wait([&graph_task] { return graph_task->completed(); });
+      continue;
+    }
+    if (run_parallel_cpu_task(graph_task, item)) {
+      break;
+    }
+  }
+  graph_task->mark_as_completed_and_run_post_processing();
+}
+
+// Runs on the inter-op thread pool until the queue of the GraphTask is empty.
+// See Note [Parallel CPU backward]
+void Engine::parallel_cpu_helper(std::shared_ptr<GraphTask> graph_task) {
+  const auto prev_worker_device = worker_device;
+  const auto prev_total_depth = total_depth;
+  const auto prev_local_ready_queue = local_ready_queue;
+  set_device(CPU_DEVICE);
+  total_depth = graph_task->reentrant_depth_;
+  // A fresh queue, owned by this helper, for reentrant backward calls
+  local_ready_queue = std::make_shared<ReadyQueue>();
+
+  auto& queue = *graph_task->parallel_cpu_queue_;
+  while (true) {
+    LockFreeReadyQueue::Item* item = nullptr;
+    if (!graph_task->completed()) {
+      item = pop_parallel_cpu_task(graph_task);
+    }
+    if (!item) {
+      queue.remove_helper();
+      // Work pushed while all helper slots were taken did not launch a new
+      // helper, so pick it up before leaving if we can get our slot back.
+      if (graph_task->completed() || queue.empty() || !queue.try_add_helper()) {
+        break;
+      }
+      continue;
+    }
+    if (run_parallel_cpu_task(graph_task, item)) {
+      queue.remove_helper();
+      break;
+    }
+  }
+
+  worker_device = prev_worker_device;
+  total_depth = prev_total_depth;
+  local_ready_queue = prev_local_ready_queue;
+}
+
 void Engine::thread_on_exception(
     std::shared_ptr<GraphTask> graph_task,
     const std::shared_ptr<Node>& fn,
@@ -803,9 +1046,8 @@ void Engine::evaluate_function(
                        opt_next_stream);
 
       if (is_ready) {
-        auto queue = ready_queue(cpu_ready_queue, input_buffer.device());
-        queue->push(
-            NodeTask(graph_task, next.function, std::move(input_buffer)));
+        push_ready_task(
+            graph_task, cpu_ready_queue, next.function, std::move(input_buffer));
       } else {
         not_ready.emplace(next.function.get(), std::move(input_buffer));
       }
@@ -820,9 +1062,8 @@ void Engine::evaluate_function(
                        opt_parent_stream,
                        opt_next_stream);
       if (is_ready) {
-        auto queue = ready_queue(cpu_ready_queue, input_buffer.device());
-        queue->push(
-            NodeTask(graph_task, next.function, std::move(input_buffer)));
+        push_ready_task(
+            graph_task, cpu_ready_queue, next.function, std::move(input_buffer));
         not_ready.erase(not_ready_it);
       }
     }
@@ -899,8 +1140,17 @@ std::shared_ptr<FutureVariableList> Engine::execute_with_graph_task(
   // Lock mutex for GraphTask.
   std::unique_lock<std::mutex> lock(graph_task->mutex_);
 
-  ready_queue(graph_task->cpu_ready_queue_, at::kCPU)->push(
-      NodeTask(graph_task, std::move(graph_root), InputBuffer(0)));
+  // Only top-level backward calls run in parallel, reentrant ones keep
+  // running on the thread that made them. See Note [Parallel CPU backward]
+  const bool parallel_cpu =
+      worker_device == NO_DEVICE && parallel_cpu_backward_.load();
+  if (parallel_cpu) {
+    graph_task->parallel_cpu_queue_ =
+        std::make_shared<LockFreeReadyQueue>(at::get_num_interop_threads());
+  }
+
+  push_ready_task(
+      graph_task, graph_task->cpu_ready_queue_, std::move(graph_root), InputBuffer(0));
 
   // worker_device == NO_DEVICE it's a CPU thread and it's trying to drive the
   // autograd engine with corresponding GraphTask, and its NOT a re-entrant call
@@ -916,7 +1166,11 @@ std::shared_ptr<FutureVariableList> Engine::execute_with_graph_task(
     // The owning thread start to drive the engine execution with the GraphTask
     // that has already been pushed to the current CPU thread's ready_queue
     lock.unlock();
-    thread_main(nullptr, false);
+    if (parallel_cpu) {
+      parallel_cpu_main(graph_task);
+    } else {
+      thread_main(nullptr, false);
+    }
     TORCH_INTERNAL_ASSERT(graph_task->future_result_->completed());
     // reset the worker_device after the completion of the graph_task, this is so
     // that the initial state of the engine remains the same across every backward()
@@ -989,6 +1243,14 @@ bool Engine::is_checkpoint_valid() {
   return checkpoint_valid;
 }
 
+void Engine::set_parallel_cpu_backward(bool enabled) {
+  parallel_cpu_backward_.store(enabled);
+}
+
+bool Engine::is_parallel_cpu_backward_enabled() const {
+  return parallel_cpu_backward_.load();
+}
+
 void Engine::init_local_ready_queue(std::shared_ptr<ReadyQueue> ready_queue) {
   if (ready_queue) {
     // if ready_queue provided in the caller, use the caller's ready_queue to initialize local_ready_queue
@@ -12,10 +12,13 @@
 #include <torch/csrc/autograd/input_buffer.h>
 #include <torch/csrc/utils/future.h>
 
+#include <atomic>
+#include <condition_variable>
 #include <deque>
 #include <exception>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <queue>
 #include <unordered_map>
 #include <utility>
@@ -24,6 +27,7 @@
 
 namespace torch { namespace autograd {
 struct ReadyQueue;
+struct LockFreeReadyQueue;
 }} // namespace torch::autograd
 
 namespace torch { namespace autograd {
@@ -151,6 +155,12 @@ struct GraphTask: std::enable_shared_from_this<GraphTask> {
   // and but next NodeTask should be run on CPU.
   std::shared_ptr<ReadyQueue> cpu_ready_queue_;
 
+  // Only set when this GraphTask runs in the parallel CPU backward mode, see
+  // Note [Parallel CPU backward]. Ready CPU nodes are then pushed here instead
+  // of cpu_ready_queue_, and are run by the owning thread together with
+  // helpers on the inter-op thread pool.
+  std::shared_ptr<LockFreeReadyQueue> parallel_cpu_queue_;
+
   // Future representing the completion of the graph task. Notified when all
   // tasks are done.
   std::shared_ptr<FutureVariableList> future_result_;
@@ -255,6 +265,55 @@ struct ReadyQueue {
   size_t size() const;
 };
 
+// Ready queue of a GraphTask running in the parallel CPU backward mode.
+// It is a Treiber stack: push() links items in with a CAS, and consumers
+// detach the whole stack at once with pop_all(), so there is no ABA problem.
+// The mutex is only taken to park the owning thread while it has nothing to
+// do, and to wake it up again.
+struct LockFreeReadyQueue {
+  struct Item {
+    Item(std::shared_ptr<Node> fn, InputBuffer inputs)
+        : fn_(std::move(fn)), inputs_(std::move(inputs)) {}
+    std::shared_ptr<Node> fn_;
+    InputBuffer inputs_;
+    Item* next_ = nullptr;
+  };
+
+  explicit LockFreeReadyQueue(int max_helpers) : max_helpers_(max_helpers) {}
+  LockFreeReadyQueue(const LockFreeReadyQueue&) = delete;
+  LockFreeReadyQueue& operator=(const LockFreeReadyQueue&) = delete;
+  ~LockFreeReadyQueue();
+
+  // Pushes the chain first -> ... -> last, taking ownership of its items.
+  void push(Item* first, Item* last);
+  // Detaches and returns every queued item, most recently pushed first.
+  Item* pop_all();
+  bool empty() const;
+
+  // Parks the calling thread until an item is pushed or done() holds.
+  template <typename Pred>
+  void wait(Pred done) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    ++sleepers_;
+    not_empty_.wait(lock, [&] { return !empty() || done(); });
+    --sleepers_;
+  }
+  // Wakes up parked threads so that they re-check their condition.
+  void notify_all();
+
+  // Reserves a helper slot, returns false if all max_helpers_ are running.
+  bool try_add_helper();
+  void remove_helper();
+
+ private:
+  std::atomic<Item*> head_{nullptr};
+  std::atomic<int> sleepers_{0};
+  std::atomic<int> num_helpers_{0};
+  const int max_helpers_;
+  std::mutex mutex_;
+  std::condition_variable not_empty_;
+};
+
 // A single instance of this struct should be created through the whole process lifetime.
 // The worker thread creation logic and Engine's destructor rely on this.
 struct TORCH_API Engine {
@@ -307,6 +366,13 @@ struct TORCH_API Engine {
 
   bool is_checkpoint_valid();
 
+  // Runs independent CPU nodes of top-level backward calls concurrently on
+  // the inter-op thread pool. Off by default, or on when the
+  // PYTORCH_AUTOGRAD_PARALLEL_CPU environment variable is set to 1.
+  // See Note [Parallel CPU backward]
+  void set_parallel_cpu_backward(bool enabled);
+  bool is_parallel_cpu_backward_enabled() const;
+
   size_t ready_queue_size(const std::shared_ptr<GraphTask>& graph_task, at::Device device);
 
   // Should be called after fork to notify that worker threads are gone
@@ -341,6 +407,24 @@ struct TORCH_API Engine {
   void reentrant_thread_init();
   void add_thread_pool_task(const std::weak_ptr<GraphTask>& graph_task);
 
+  // Parallel CPU backward, see Note [Parallel CPU backward]
+  void push_ready_task(
+      const std::shared_ptr<GraphTask>& graph_task,
+      const std::shared_ptr<ReadyQueue>& cpu_ready_queue,
+      std::shared_ptr<Node> fn,
+      InputBuffer inputs);
+  void push_parallel_cpu_tasks(
+      const std::shared_ptr<GraphTask>& graph_task,
+      LockFreeReadyQueue::Item* first,
+      LockFreeReadyQueue::Item* last);
+  LockFreeReadyQueue::Item* pop_parallel_cpu_task(
+      const std::shared_ptr<GraphTask>& graph_task);
+  bool run_parallel_cpu_task(
+      std::shared_ptr<GraphTask>& graph_task,
+      LockFreeReadyQueue::Item* item);
+  void parallel_cpu_main(std::shared_ptr<GraphTask> graph_task);
+  void parallel_cpu_helper(std::shared_ptr<GraphTask> graph_task);
+
   // Ensures device_ready_queues_ are initialized only once
   std::once_flag start_device_threads_flag_;
   // Safe to read device_ready_queues_ without synchronization after initialization
@@ -353,6 +437,8 @@ struct TORCH_API Engine {
   // How many nested reentrant calls are allowed until a new thread is used
   int max_recursion_depth_;
 
+  std::atomic<bool> parallel_cpu_backward_;
+
   struct ThreadPoolShared {
     // Data structures used by the threads for executing reentrant backwards
     // tasks. See Note [Reentrant backwards]
@@ -5,6 +5,7 @@
 #include <torch/csrc/autograd/grad_mode.h>
 #include <ATen/autocast_mode.h>
 #include <torch/csrc/autograd/profiler.h>
+#include <torch/csrc/autograd/profiler_streaming.h>
 #include <torch/csrc/autograd/python_function.h>
 #include <torch/csrc/autograd/function.h>
 
@@ -61,6 +62,22 @@ PyObject* THPAutograd_initExtension(PyObject* _unused, PyObject *unused) {
     at::enableRecordFunction(enable);
   });
 
+  py::class_<StreamingProfilerConfig>(m, "StreamingProfilerConfig")
+      .def(py::init<std::string>())
+      .def_readwrite("trace_path", &StreamingProfilerConfig::trace_path)
+      .def_readwrite("ring_buffer_size", &StreamingProfilerConfig::ring_buffer_size)
+      .def_readwrite("sample_period", &StreamingProfilerConfig::sample_period)
+      .def_readwrite("flush_interval_ms", &StreamingProfilerConfig::flush_interval_ms);
+
+  py::class_<StreamingProfilerStats>(m, "StreamingProfilerStats")
+      .def_readonly("recorded", &StreamingProfilerStats::recorded)
+      .def_readonly("dropped", &StreamingProfilerStats::dropped);
+
+  m.def("_enable_streaming_profiler", enableStreamingProfiler);
+  m.def("_disable_streaming_profiler", disableStreamingProfiler);
+  m.def("_streaming_profiler_enabled", streamingProfilerEnabled);
+  m.def("_flush_streaming_profiler", flushStreamingProfiler);
+
   Py_RETURN_TRUE;
 }
 
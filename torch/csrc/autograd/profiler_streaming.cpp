@@ -0,0 +1,438 @@
+#include <torch/csrc/autograd/profiler_streaming.h>
+#include <torch/csrc/autograd/profiler.h>
+
+#include <ATen/record_function.h>
+#include <c10/util/Exception.h>
+#include <c10/util/Logging.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace torch { namespace autograd { namespace profiler {
+
+namespace {
+
+// A RecordFunction that ran on a single thread, written as a Chrome trace
+// "complete" event.
+struct TraceRecord {
+  int64_t start_ns;
+  int64_t end_ns;
+  uint32_t name_id;
+};
+
+// Ring buffer with a single producer, the thread that owns it, and a single
+// consumer, the flush thread. Never grows: push() fails when it is full.
+class RingBuffer {
+ public:
+  RingBuffer(size_t capacity, uint64_t thread_id)
+      : records_(capacity), mask_(capacity - 1), thread_id_(thread_id) {
+    TORCH_INTERNAL_ASSERT(capacity > 0 && (capacity & mask_) == 0);
+  }
+
+  // Producer side
+  void push(const TraceRecord& record) {
+    const auto head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) == records_.size()) {
+      dropped_.store(
+          dropped_.load(std::memory_order_relaxed) + 1,
+          std::memory_order_relaxed);
+      return;
+    }
+    records_[head & mask_] = record;
+    head_.store(head + 1, std::memory_order_release);
+  }
+
+  void addDropped() {
+    dropped_.store(
+        dropped_.load(std::memory_order_relaxed) + 1,
+        std::memory_order_relaxed);
+  }
+
+  void markThreadExited() {
+    thread_exited_.store(true, std::memory_order_release);
+  }
+
+  // Consumer side
+  template <typename F>
+  uint64_t drain(F f) {
+    const auto tail = tail_.load(std::memory_order_relaxed);
+    const auto head = head_.load(std::memory_order_acquire);
+    for (auto i = tail; i != head; ++i) {
+      f(records_[i & mask_]);
+    }
+    tail_.store(head, std::memory_order_release);
+    return head - tail;
+  }
+
+  bool threadExited() const {
+    return thread_exited_.load(std::memory_order_acquire);
+  }
+
+  uint64_t dropped() const {
+    return dropped_.load(std::memory_order_relaxed);
+  }
+
+  uint64_t threadId() const {
+    return thread_id_;
+  }
+
+ private:
+  std::vector<TraceRecord> records_;
+  const size_t mask_;
+  const uint64_t thread_id_;
+  std::atomic<bool> thread_exited_{false};
+  std::atomic<uint64_t> dropped_{0};
+  // Keep the producer and consumer indices on separate cache lines
+  char pad0_[64];
+  std::atomic<uint64_t> head_{0};
+  char pad1_[64];
+  std::atomic<uint64_t> tail_{0};
+};
+
+size_t roundUpToPowerOfTwo(size_t n) {
+  size_t result = 1;
+  while (result < n) {
+    result <<= 1;
+  }
+  return result;
+}
+
+void writeJsonString(std::ostream& out, const std::string& str) {
+  out << '"';
+  for (char c : str) {
+    switch (c) {
+      case '"': out << "\\\""; break;
+      case '\\': out << "\\\\"; break;
+      case '\n': out << "\\n"; break;
+      case '\t': out << "\\t"; break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+              << static_cast<int>(c) << std::dec << std::setfill(' ');
+        } else {
+          out << c;
+        }
+    }
+  }
+  out << '"';
+}
+
+class Session {
+ public:
+  explicit Session(const StreamingProfilerConfig& config)
+      : config_(config),
+        ring_buffer_size_(roundUpToPowerOfTwo(config.ring_buffer_size)),
+        out_(config.trace_path, std::ios::out | std::ios::trunc),
+        start_ns_(getTime()) {
+    TORCH_CHECK(out_, "Could not open ", config.trace_path);
+    out_ << std::fixed << std::setprecision(3) << "[\n";
+  }
+
+  void start(at::CallbackHandle handle) {
+    handle_ = handle;
+    flush_thread_ = std::thread([this]() { run(); });
+  }
+
+  StreamingProfilerStats stop() {
+    {
+      std::lock_guard<std::mutex> guard(stop_mutex_);
+      stop_ = true;
+    }
+    stop_cv_.notify_all();
+    flush_thread_.join();
+    flush();
+
+    std::lock_guard<std::mutex> guard(flush_mutex_);
+    out_ << "\n]\n";
+    out_.close();
+    StreamingProfilerStats stats;
+    stats.recorded = recorded_;
+    stats.dropped = dropped_;
+    std::lock_guard<std::mutex> buffers_guard(buffers_mutex_);
+    for (const auto& buffer : buffers_) {
+      stats.dropped += buffer->dropped();
+    }
+    return stats;
+  }
+
+  at::CallbackHandle callbackHandle() const {
+    return handle_;
+  }
+
+  std::shared_ptr<RingBuffer> addRingBuffer(uint64_t thread_id) {
+    auto buffer = std::make_shared<RingBuffer>(ring_buffer_size_, thread_id);
+    std::lock_guard<std::mutex> guard(buffers_mutex_);
+    buffers_.push_back(buffer);
+    return buffer;
+  }
+
+  uint32_t intern(const std::string& name) {
+    std::lock_guard<std::mutex> guard(names_mutex_);
+    auto it = name_ids_.find(name);
+    if (it != name_ids_.end()) {
+      return it->second;
+    }
+    const auto id = static_cast<uint32_t>(names_.size());
+    names_.push_back(name);
+    name_ids_.emplace(name, id);
+    return id;
+  }
+
+  void flush() {
+    std::lock_guard<std::mutex> flush_guard(flush_mutex_);
+    if (!out_.is_open()) {
+      return;
+    }
+    std::vector<std::shared_ptr<RingBuffer>> buffers;
+    std::vector<bool> exited;
+    {
+      std::lock_guard<std::mutex> guard(buffers_mutex_);
+      buffers = buffers_;
+    }
+    // Read the flag before draining, a thread that has exited pushes nothing
+    // after it and its buffer can be released once drained.
+    exited.reserve(buffers.size());
+    for (const auto& buffer : buffers) {
+      exited.push_back(buffer->threadExited());
+    }
+
+    {
+      std::lock_guard<std::mutex> names_guard(names_mutex_);
+      for (const auto& buffer : buffers) {
+        const auto tid = buffer->threadId();
+        recorded_ += buffer->drain([&](const TraceRecord& record) {
+          writeEvent(record, tid);
+        });
+      }
+    }
+    out_.flush();
+
+    std::lock_guard<std::mutex> guard(buffers_mutex_);
+    for (size_t i = 0; i < buffers.size(); ++i) {
+      if (exited[i]) {
+        dropped_ += buffers[i]->dropped();
+        buffers_.erase(
+            std::find(buffers_.begin(), buffers_.end(), buffers[i]));
+      }
+    }
+  }
+
+ private:
+  void run() {
+    std::unique_lock<std::mutex> lock(stop_mutex_);
+    while (!stop_) {
+      stop_cv_.wait_for(
+          lock, std::chrono::milliseconds(config_.flush_interval_ms));
+      if (stop_) {
+        break;
+      }
+      lock.unlock();
+      try {
+        flush();
+      } catch (const std::exception& e) {
+        LOG(WARNING) << "Streaming profiler failed to flush: " << e.what();
+      }
+      lock.lock();
+    }
+  }
+
+  // Called with flush_mutex_ and names_mutex_ held
+  void writeEvent(const TraceRecord& record, uint64_t tid) {
+    if (!first_event_) {
+      out_ << ",\n";
+    }
+    first_event_ = false;
+    out_ << "{\"name\": ";
+    writeJsonString(out_, names_[record.name_id]);
+    out_ << ", \"ph\": \"X\", \"ts\": " << (record.start_ns - start_ns_) / 1000.0
+         << ", \"dur\": " << (record.end_ns - record.start_ns) / 1000.0
+         << ", \"tid\": " << tid << ", \"pid\": \"CPU Functions\", \"args\": {}}";
+  }
+
+  const StreamingProfilerConfig config_;
+  const size_t ring_buffer_size_;
+  at::CallbackHandle handle_ = 0;
+
+  // To protect out_, first_event_, recorded_ and dropped_
+  std::mutex flush_mutex_;
+  std::ofstream out_;
+  const int64_t start_ns_;
+  bool first_event_ = true;
+  uint64_t recorded_ = 0;
+  // Dropped events of ring buffers that were already released
+  uint64_t dropped_ = 0;
+
+  std::mutex buffers_mutex_;
+  std::vector<std::shared_ptr<RingBuffer>> buffers_;
+
+  std::mutex names_mutex_;
+  std::vector<std::string> names_;
+  std::unordered_map<std::string, uint32_t> name_ids_;
+
+  std::mutex stop_mutex_;
+  std::condition_variable stop_cv_;
+  bool stop_ = false;
+  std::thread flush_thread_;
+};
+
+// To protect current_session and updates of session_generation
+std::mutex session_mutex;
+std::shared_ptr<Session> current_session;
+// Bumped on every enable and disable, so that threads notice they need to
+// attach to the new session (or drop the old one).
+std::atomic<uint64_t> session_generation{0};
+// RecordFunction state of the thread that enabled the profiler
+bool prev_record_function_enabled = false;
+
+// Maximum number of nested RecordFunctions tracked per thread; deeper ones are
+// dropped.
+constexpr size_t kMaxDepth = 128;
+
+struct ThreadState {
+  struct OpenRange {
+    at::RecordFunctionHandle handle;
+    int64_t start_ns;
+    uint32_t name_id;
+  };
+
+  ~ThreadState() {
+    if (buffer) {
+      buffer->markThreadExited();
+    }
+  }
+
+  void attach(uint64_t thread_id) {
+    if (buffer) {
+      buffer->markThreadExited();
+    }
+    std::lock_guard<std::mutex> guard(session_mutex);
+    generation = session_generation.load();
+    session = current_session;
+    buffer = session ? session->addRingBuffer(thread_id) : nullptr;
+    open_ranges.clear();
+    name_ids.clear();
+  }
+
+  uint32_t intern(const char* name) {
+    auto inserted = name_ids.emplace(name, std::pair<uint32_t, std::string>());
+    auto& entry = inserted.first->second;
+    // The names of operators are static, but a RecordFunction may own its
+    // name, and another name may reuse its address once it is freed.
+    if (inserted.second || entry.second != name) {
+      entry.second = name;
+      entry.first = session->intern(entry.second);
+    }
+    return entry.first;
+  }
+
+  uint64_t generation = 0;
+  std::shared_ptr<Session> session;
+  std::shared_ptr<RingBuffer> buffer;
+  std::vector<OpenRange> open_ranges;
+  // Per-thread cache of interned names by address, so that only new names
+  // are copied and take the lock. Keeps the id and a copy of the name.
+  std::unordered_map<const char*, std::pair<uint32_t, std::string>> name_ids;
+};
+
+thread_local ThreadState thread_state;
+
+ThreadState* getThreadState() {
+  if (thread_state.generation != session_generation.load(std::memory_order_acquire)) {
+    thread_state.attach(at::RecordFunction::currentThreadId());
+  }
+  return thread_state.buffer ? &thread_state : nullptr;
+}
+
+void onFunctionEnter(const at::RecordFunction& fn) {
+  auto state = getThreadState();
+  if (!state) {
+    return;
+  }
+  if (state->open_ranges.size() >= kMaxDepth) {
+    // The matching end finds no open range and counts the drop
+    return;
+  }
+  state->open_ranges.push_back({fn.handle(), getTime(), state->intern(fn.name().str())});
+}
+
+void onFunctionExit(const at::RecordFunction& fn) {
+  const auto end_ns = getTime();
+  auto state = getThreadState();
+  if (!state) {
+    return;
+  }
+  auto& open_ranges = state->open_ranges;
+  // Usually the innermost range. Ranges above the match belong to async
+  // RecordFunctions that ended on another thread, so they are discarded.
+  for (auto i = open_ranges.size(); i > 0; --i) {
+    if (open_ranges[i - 1].handle == fn.handle()) {
+      const auto& range = open_ranges[i - 1];
+      state->buffer->push({range.start_ns, end_ns, range.name_id});
+      open_ranges.resize(i - 1);
+      return;
+    }
+  }
+  state->buffer->addDropped();
+}
+
+} // namespace
+
+void enableStreamingProfiler(const StreamingProfilerConfig& config) {
+  TORCH_CHECK(config.ring_buffer_size > 0, "ring_buffer_size must be positive");
+  TORCH_CHECK(config.sample_period > 0, "sample_period must be positive");
+  TORCH_CHECK(config.flush_interval_ms > 0, "flush_interval_ms must be positive");
+
+  std::lock_guard<std::mutex> guard(session_mutex);
+  TORCH_CHECK(!current_session, "Streaming profiler is already enabled");
+  auto session = std::make_shared<Session>(config);
+  session->start(at::addGlobalCallback(
+      at::RecordFunctionCallback(&onFunctionEnter, &onFunctionExit)
+          .needsIds(true)
+          .samplingProb(1.0 / config.sample_period)));
+  current_session = std::move(session);
+  ++session_generation;
+
+  prev_record_function_enabled = at::isRecordFunctionEnabled();
+  at::enableRecordFunction(true);
+}
+
+StreamingProfilerStats disableStreamingProfiler() {
+  std::shared_ptr<Session> session;
+  {
+    std::lock_guard<std::mutex> guard(session_mutex);
+    TORCH_CHECK(current_session, "Streaming profiler is not enabled");
+    session = std::move(current_session);
+    current_session = nullptr;
+    ++session_generation;
+  }
+  at::enableRecordFunction(prev_record_function_enabled);
+  at::removeCallback(session->callbackHandle());
+  return session->stop();
+}
+
+bool streamingProfilerEnabled() {
+  std::lock_guard<std::mutex> guard(session_mutex);
+  return current_session != nullptr;
+}
+
+void flushStreamingProfiler() {
+  std::shared_ptr<Session> session;
+  {
+    std::lock_guard<std::mutex> guard(session_mutex);
+    session = current_session;
+  }
+  TORCH_CHECK(session, "Streaming profiler is not enabled");
+  session->flush();
+}
+
+}}} // namespace torch::autograd::profiler
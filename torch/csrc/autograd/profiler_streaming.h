@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <torch/csrc/WindowsTorchApiMacro.h>
+
+namespace torch { namespace autograd { namespace profiler {
+
+// Continuous profiling, meant to be left on in production.
+//
+// enableProfiler() keeps every Event of every thread in memory until the
+// profile ends. The streaming profiler instead records into a fixed-size
+// lock-free ring buffer per thread, interns op names into integer ids and
+// only records one in sample_period RecordFunctions (on average). A background
+// thread drains the ring buffers every flush_interval_ms and appends the
+// events to trace_path in the Chrome trace format, which chrome://tracing and
+// Perfetto can open. When a thread fills its ring buffer between two flushes,
+// its new events are dropped and counted instead of growing the buffer.
+//
+// The profiler installs a global RecordFunction callback, so it sees the ops
+// of every thread that has RecordFunction enabled. enableStreamingProfiler()
+// enables it on the calling thread, from where it propagates to at::launch
+// tasks and autograd threads; other threads can use at::RecordFunctionGuard.
+// Like addGlobalCallback, enabling and disabling the streaming profiler is
+// not thread safe with respect to code that is running ops.
+struct TORCH_API StreamingProfilerConfig {
+  explicit StreamingProfilerConfig(std::string trace_path)
+      : trace_path(std::move(trace_path)) {}
+
+  std::string trace_path;
+  // Number of events a thread can buffer between two flushes, rounded up to
+  // a power of two.
+  int64_t ring_buffer_size = 1 << 16;
+  // Record one in sample_period RecordFunctions.
+  int64_t sample_period = 1;
+  int64_t flush_interval_ms = 1000;
+};
+
+struct TORCH_API StreamingProfilerStats {
+  // Events written to the trace
+  uint64_t recorded = 0;
+  // Events lost to full ring buffers, or whose RecordFunction ended on a
+  // different thread than it started on
+  uint64_t dropped = 0;
+};
+
+TORCH_API void enableStreamingProfiler(const StreamingProfilerConfig& config);
+// Writes the remaining events, closes the trace and returns the stats of the
+// whole run. Should be called from the thread that enabled the profiler.
+TORCH_API StreamingProfilerStats disableStreamingProfiler();
+TORCH_API bool streamingProfilerEnabled();
+// Writes the buffered events now instead of at the next flush interval.
+TORCH_API void flushStreamingProfiler();
+
+} // namespace profiler
+}} // namespace torch::autograd
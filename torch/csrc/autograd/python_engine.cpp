@@ -249,6 +249,27 @@ PyObject* THPEngine_is_checkpoint_valid(PyObject *self, PyObject *noargs) {
   END_HANDLE_TH_ERRORS
 }
 
+PyObject* THPEngine_set_parallel_cpu_backward(PyObject *self, PyObject *arg) {
+  HANDLE_TH_ERRORS
+  THPUtils_assert(PyBool_Check(arg), "enabled must be a bool (got %s)",
+      THPUtils_typename(arg));
+  auto& engine = python::PythonEngine::get_python_engine();
+  engine.set_parallel_cpu_backward(arg == Py_True);
+  Py_RETURN_NONE;
+  END_HANDLE_TH_ERRORS
+}
+
+PyObject* THPEngine_is_parallel_cpu_backward_enabled(PyObject *self, PyObject *noargs) {
+  HANDLE_TH_ERRORS
+  auto& engine = python::PythonEngine::get_python_engine();
+  if (engine.is_parallel_cpu_backward_enabled()) {
+    Py_RETURN_TRUE;
+  } else {
+    Py_RETURN_FALSE;
+  }
+  END_HANDLE_TH_ERRORS
+}
+
 PyObject *THPEngine_new(PyTypeObject *type, PyObject *args, PyObject *kwargs)
 {
   return type->tp_alloc(type, 0);
@@ -258,6 +279,8 @@ static struct PyMethodDef THPEngine_methods[] = {
   {(char*)"run_backward", (PyCFunction)(void(*)(void))THPEngine_run_backward, METH_VARARGS | METH_KEYWORDS, nullptr},
   {(char*)"queue_callback", (PyCFunction)THPEngine_queue_callback, METH_O, nullptr},
   {(char*)"is_checkpoint_valid", (PyCFunction)THPEngine_is_checkpoint_valid, METH_NOARGS, nullptr},
+  {(char*)"set_parallel_cpu_backward", (PyCFunction)THPEngine_set_parallel_cpu_backward, METH_O, nullptr},
+  {(char*)"is_parallel_cpu_backward_enabled", (PyCFunction)THPEngine_is_parallel_cpu_backward_enabled, METH_NOARGS, nullptr},
   {nullptr}
 };
 
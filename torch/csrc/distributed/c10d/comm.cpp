@@ -79,4 +79,13 @@ void broadcast_coalesced(
   }
 }
 
+std::vector<at::Tensor> CommHookInterface::parseHookResult(
+    const c10::IValue& result) {
+  TORCH_CHECK(
+      result.isTensorList(),
+      "Expected the communication hook to return a list of tensors, got ",
+      result.tagKind());
+  return result.toTensorVector();
+}
+
 } // namespace c10d
@@ -3,6 +3,7 @@
 #include <memory>
 
 #include <ATen/ATen.h>
+#include <ATen/core/ivalue.h>
 #include <c10d/ProcessGroup.hpp>
 
 namespace c10d {
@@ -13,4 +14,50 @@ void broadcast_coalesced(
     at::TensorList tensors,
     size_t buffer_size);
 
+// The flattened gradients of one Reducer bucket, one tensor per model
+// replica, as handed to a communication hook.
+class GradBucket {
+ public:
+  GradBucket(size_t index, std::vector<at::Tensor> tensors)
+      : index_(index), tensors_(std::move(tensors)) {}
+
+  // Position of the bucket in the Reducer's bucket order. Buckets are
+  // reduced in the same order on every process, so hooks can key
+  // per-bucket state by it.
+  size_t getIndex() const {
+    return index_;
+  }
+
+  const std::vector<at::Tensor>& getTensors() const {
+    return tensors_;
+  }
+
+ private:
+  size_t index_;
+  std::vector<at::Tensor> tensors_;
+};
+
+// A communication hook replaces the allreduce the Reducer issues for each
+// dense bucket once all of its gradients are ready. The gradients have
+// already been divided by the process group size, so summing them across
+// processes yields their average.
+//
+// runHook is called on the autograd thread and should only start the
+// communication; the Reducer waits for the returned Future at the end of the
+// backward pass, so compression and communication overlap with the
+// computation of the remaining gradients.
+class CommHookInterface {
+ public:
+  virtual ~CommHookInterface() {}
+
+  // Returns a Future whose value holds the reduced bucket, one tensor per
+  // replica, with the same number of elements as the bucket tensors.
+  virtual c10::intrusive_ptr<c10::ivalue::Future> runHook(
+      GradBucket& bucket) = 0;
+
+  // Turns the value of a Future returned by runHook into tensors. The
+  // default expects a list of tensors.
+  virtual std::vector<at::Tensor> parseHookResult(const c10::IValue& result);
+};
+
 } // namespace c10d
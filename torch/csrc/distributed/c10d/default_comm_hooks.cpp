@@ -0,0 +1,159 @@
+#include <torch/csrc/distributed/c10d/default_comm_hooks.h>
+
+#include <cmath>
+
+#include <ATen/CPUGeneratorImpl.h>
+#include <c10/util/Exception.h>
+
+namespace c10d {
+namespace {
+
+using FuturePtr = c10::intrusive_ptr<c10::ivalue::Future>;
+
+// Returns a Future that completes with `tensors` after `fn` has run, once
+// `future` has completed. Errors of `future`, and exceptions thrown by `fn`,
+// are forwarded to the returned Future.
+FuturePtr thenReturn(
+    const FuturePtr& future,
+    std::vector<at::Tensor> tensors,
+    std::function<void(std::vector<at::Tensor>&)> fn = nullptr) {
+  return future->then(
+      [future, tensors, fn]() mutable -> c10::IValue {
+        // Rethrows the error of the work, if any.
+        future->value();
+        if (fn) {
+          fn(tensors);
+        }
+        return c10::IValue(tensors);
+      },
+      c10::ListType::ofTensors());
+}
+
+// Orthonormalizes the columns of `matrix` in place (modified Gram-Schmidt).
+void orthogonalize(at::Tensor& matrix) {
+  constexpr double kEpsilon = 1e-8;
+  const auto num_cols = matrix.size(1);
+  for (int64_t i = 0; i < num_cols; ++i) {
+    auto col = matrix.narrow(1, i, 1);
+    col.div_(col.norm().add_(kEpsilon));
+    if (i + 1 < num_cols) {
+      auto rest = matrix.narrow(1, i + 1, num_cols - i - 1);
+      rest.sub_(col.mm(col.t().mm(rest)));
+    }
+  }
+}
+
+} // namespace
+
+FuturePtr AllReduceCommHook::runHook(GradBucket& bucket) {
+  std::vector<at::Tensor> tensors = bucket.getTensors();
+  auto work = process_group_->allreduce(tensors);
+  return thenReturn(work->getFuture(), std::move(tensors));
+}
+
+FuturePtr FP16CompressCommHook::runHook(GradBucket& bucket) {
+  const auto& tensors = bucket.getTensors();
+  std::vector<at::Tensor> compressed;
+  compressed.reserve(tensors.size());
+  for (const auto& tensor : tensors) {
+    compressed.push_back(tensor.to(at::kHalf));
+  }
+  auto work = process_group_->allreduce(compressed);
+  return thenReturn(
+      work->getFuture(),
+      tensors,
+      [compressed](std::vector<at::Tensor>& result) {
+        for (size_t i = 0; i < result.size(); ++i) {
+          result[i].copy_(compressed[i]);
+        }
+      });
+}
+
+PowerSGDCommHook::PowerSGDCommHook(
+    std::shared_ptr<ProcessGroup> process_group,
+    int64_t matrix_approximation_rank)
+    : AllReduceCommHook(std::move(process_group)),
+      matrix_approximation_rank_(matrix_approximation_rank) {
+  TORCH_CHECK(
+      matrix_approximation_rank_ > 0,
+      "PowerSGD requires a positive matrix approximation rank, got ",
+      matrix_approximation_rank_);
+}
+
+FuturePtr PowerSGDCommHook::runHook(GradBucket& bucket) {
+  const std::vector<at::Tensor>& tensors = bucket.getTensors();
+  const auto& first = tensors.front();
+  if (first.scalar_type() != at::kFloat && first.scalar_type() != at::kDouble) {
+    return AllReduceCommHook::runHook(bucket);
+  }
+
+  const int64_t numel = first.numel();
+  const int64_t cols = static_cast<int64_t>(std::ceil(std::sqrt(numel)));
+  const int64_t rows = (numel + cols - 1) / cols;
+  const int64_t rank =
+      std::min(matrix_approximation_rank_, std::min(rows, cols));
+  if ((rows + cols) * rank >= numel) {
+    return AllReduceCommHook::runHook(bucket);
+  }
+
+  std::shared_ptr<BucketState> state;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& entry = states_[bucket.getIndex()];
+    if (!entry || entry->numel != numel) {
+      entry = std::make_shared<BucketState>();
+      entry->numel = numel;
+      // Q is drawn on the CPU so that it is the same on every device.
+      auto generator = at::detail::createCPUGenerator(bucket.getIndex());
+      auto q = at::randn(
+          {cols, rank}, generator, at::TensorOptions().dtype(first.dtype()));
+      for (const auto& tensor : tensors) {
+        entry->errors.push_back(at::zeros({rows * cols}, tensor.options()));
+        entry->qs.push_back(q.to(tensor.options()));
+      }
+    }
+    state = entry;
+  }
+
+  // Add the error from the previous iteration. The error buffers then hold
+  // M, which is turned into the new error below.
+  std::vector<at::Tensor> matrices;
+  std::vector<at::Tensor> ps;
+  for (size_t i = 0; i < tensors.size(); ++i) {
+    auto& error = state->errors[i];
+    error.narrow(0, 0, numel).add_(tensors[i].view(-1));
+    matrices.push_back(error.view({rows, cols}));
+    ps.push_back(matrices[i].mm(state->qs[i]));
+  }
+
+  // P is allreduced synchronously: Gloo requires collectives to be issued in
+  // the same order on every process, which is only guaranteed for the ones
+  // issued from the autograd thread while buckets are marked ready. P only
+  // holds about sqrt(numel) * rank elements, and the much larger Q is still
+  // reduced asynchronously.
+  process_group_->allreduce(ps)->wait();
+
+  std::vector<at::Tensor> qs;
+  for (size_t i = 0; i < tensors.size(); ++i) {
+    orthogonalize(ps[i]);
+    qs.push_back(matrices[i].t().mm(ps[i]));
+    // The error is what the local approximation P Q^T misses of M.
+    matrices[i].sub_(ps[i].mm(qs[i].t()));
+    state->errors[i].narrow(0, numel, rows * cols - numel).zero_();
+  }
+
+  auto work = process_group_->allreduce(qs);
+  return thenReturn(
+      work->getFuture(),
+      tensors,
+      [state, ps, qs, numel](std::vector<at::Tensor>& result) {
+        for (size_t i = 0; i < result.size(); ++i) {
+          result[i].view(-1).copy_(
+              ps[i].mm(qs[i].t()).view(-1).narrow(0, 0, numel));
+        }
+        // Warm-start the next power iteration with the reduced Q.
+        state->qs = qs;
+      });
+}
+
+} // namespace c10d
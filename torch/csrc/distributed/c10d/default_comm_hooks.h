@@ -0,0 +1,80 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <ATen/ATen.h>
+#include <c10d/ProcessGroup.hpp>
+#include <torch/csrc/distributed/c10d/comm.h>
+
+namespace c10d {
+
+// Allreduces the bucket as is. Behaves like the Reducer without a hook, and
+// serves as a template for hooks that only pre- or post-process the bucket.
+class AllReduceCommHook : public CommHookInterface {
+ public:
+  explicit AllReduceCommHook(std::shared_ptr<ProcessGroup> process_group)
+      : process_group_(std::move(process_group)) {}
+
+  c10::intrusive_ptr<c10::ivalue::Future> runHook(GradBucket& bucket) override;
+
+ protected:
+  std::shared_ptr<ProcessGroup> process_group_;
+};
+
+// Casts the bucket to half precision before the allreduce and back to its
+// original dtype afterwards, halving the number of bytes sent.
+class FP16CompressCommHook : public AllReduceCommHook {
+ public:
+  using AllReduceCommHook::AllReduceCommHook;
+
+  c10::intrusive_ptr<c10::ivalue::Future> runHook(GradBucket& bucket) override;
+};
+
+// Low-rank gradient compression with error feedback (Vogels et al., 2019,
+// "PowerSGD: Practical Low-Rank Gradient Compression for Distributed
+// Optimization").
+//
+// The flattened bucket is padded and viewed as an n x m matrix M, after the
+// error left over from the previous iteration has been added to it. One step
+// of power iteration approximates M by P Q^T, with P of size n x r and Q of
+// size m x r, so only (n + m) * r elements are allreduced instead of n * m:
+//
+//   P = M Q,   allreduce(P),   orthogonalize(P)
+//   Q = M^T P, allreduce(Q)
+//
+// The part of the local M that is not captured by the approximation is kept
+// as error and added back in the next iteration. Q is reused across
+// iterations as the starting point of the power iteration, and is
+// initialized from a seed that only depends on the bucket index, so that all
+// processes start from the same Q.
+//
+// Buckets that would not get smaller, or that are neither float nor double,
+// are allreduced without compression.
+class PowerSGDCommHook : public AllReduceCommHook {
+ public:
+  explicit PowerSGDCommHook(
+      std::shared_ptr<ProcessGroup> process_group,
+      int64_t matrix_approximation_rank = 1);
+
+  c10::intrusive_ptr<c10::ivalue::Future> runHook(GradBucket& bucket) override;
+
+  // Per-bucket state, carried across iterations.
+  struct BucketState {
+    // Number of elements of the bucket the state was created for. The state
+    // is reset if the bucket changes size, e.g. after buckets are rebuilt.
+    int64_t numel = 0;
+    // One error matrix and one Q per replica.
+    std::vector<at::Tensor> errors;
+    std::vector<at::Tensor> qs;
+  };
+
+ private:
+  const int64_t matrix_approximation_rank_;
+  std::mutex mutex_;
+  std::unordered_map<size_t, std::shared_ptr<BucketState>> states_;
+};
+
+} // namespace c10d
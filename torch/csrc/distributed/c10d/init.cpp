@@ -23,7 +23,11 @@
 
 #include <torch/csrc/Exceptions.h>
 #include <torch/csrc/distributed/c10d/comm.h>
+#include <torch/csrc/distributed/c10d/default_comm_hooks.h>
+#include <torch/csrc/distributed/c10d/python_comm_hook.h>
 #include <torch/csrc/distributed/c10d/reducer.h>
+#include <torch/csrc/jit/python/pybind_utils.h>
+#include <torch/csrc/utils/memory.h>
 #include <torch/csrc/utils/object_ptr.h>
 #include <torch/csrc/utils/pybind.h>
 
@@ -35,6 +39,7 @@ namespace {
 
 #ifdef USE_C10D_GLOO
 constexpr char* GLOO_SOCKET_IFNAME_ENV = "GLOO_SOCKET_IFNAME";
+constexpr char* GLOO_HIERARCHICAL_ALLREDUCE_ENV = "GLOO_HIERARCHICAL_ALLREDUCE";
 #endif
 
 std::vector<std::string> split(char separator, const std::string& string) {
@@ -50,6 +55,32 @@ std::vector<std::string> split(char separator, const std::string& string) {
 template <typename T>
 using shared_ptr_class_ = py::class_<T, std::shared_ptr<T>>;
 
+// Communication hooks implemented in C++ that can be registered from Python
+// without running Python code in the backward pass.
+enum class BuiltinCommHookType {
+  ALLREDUCE,
+  FP16_COMPRESS,
+  POWER_SGD,
+};
+
+std::unique_ptr<::c10d::CommHookInterface> makeBuiltinCommHook(
+    BuiltinCommHookType type,
+    std::shared_ptr<::c10d::ProcessGroup> process_group,
+    int64_t matrix_approximation_rank) {
+  switch (type) {
+    case BuiltinCommHookType::ALLREDUCE:
+      return torch::make_unique<::c10d::AllReduceCommHook>(
+          std::move(process_group));
+    case BuiltinCommHookType::FP16_COMPRESS:
+      return torch::make_unique<::c10d::FP16CompressCommHook>(
+          std::move(process_group));
+    case BuiltinCommHookType::POWER_SGD:
+      return torch::make_unique<::c10d::PowerSGDCommHook>(
+          std::move(process_group), matrix_approximation_rank);
+  }
+  TORCH_CHECK(false, "Unknown communication hook type");
+}
+
 // PythonStore is a pybind11 trampoline class to allow a Python
 // class to inherit from c10d.Store and implement its interface.
 class PythonStore : public ::c10d::Store {
@@ -141,7 +172,48 @@ PyObject* c10d_init(PyObject* _unused) {
           [](::c10d::Reducer& reducer, const torch::autograd::Variable& output)
               -> void { reducer.prepare_for_backward({output}); },
           py::call_guard<py::gil_scoped_release>())
-      .def("get_backward_stats", &::c10d::Reducer::get_backward_stats);
+      .def("get_backward_stats", &::c10d::Reducer::get_backward_stats)
+      .def(
+          "_register_comm_hook",
+          [](::c10d::Reducer& reducer, py::object state, py::object hook) {
+            reducer.register_comm_hook(
+                torch::make_unique<::c10d::PythonCommHook>(
+                    std::move(state), std::move(hook)));
+          },
+          py::arg("state"),
+          py::arg("hook"))
+      .def(
+          "_register_builtin_comm_hook",
+          [](::c10d::Reducer& reducer,
+             BuiltinCommHookType type,
+             std::shared_ptr<::c10d::ProcessGroup> process_group,
+             int64_t matrix_approximation_rank) {
+            reducer.register_comm_hook(makeBuiltinCommHook(
+                type, std::move(process_group), matrix_approximation_rank));
+          },
+          py::arg("comm_hook_type"),
+          py::arg("process_group"),
+          py::arg("matrix_approximation_rank") = 1,
+          py::call_guard<py::gil_scoped_release>());
+
+  py::class_<::c10d::GradBucket>(module, "GradBucket", R"(
+The flattened gradients of one bucket of the DDP reducer, one tensor per
+model replica, as passed to a communication hook.
+)")
+      .def(
+          py::init<size_t, std::vector<at::Tensor>>(),
+          py::arg("index"),
+          py::arg("tensors"))
+      .def("get_index", &::c10d::GradBucket::getIndex)
+      .def("get_tensors", &::c10d::GradBucket::getTensors);
+
+  py::enum_<BuiltinCommHookType>(module, "BuiltinCommHookType", R"(
+An enum-like class for the communication hooks implemented in C++:
+``ALLREDUCE``, ``FP16_COMPRESS`` and ``POWER_SGD``.
+)")
+      .value("ALLREDUCE", BuiltinCommHookType::ALLREDUCE)
+      .value("FP16_COMPRESS", BuiltinCommHookType::FP16_COMPRESS)
+      .value("POWER_SGD", BuiltinCommHookType::POWER_SGD);
 
   py::enum_<::c10d::ReduceOp>(module, "ReduceOp", R"(
 An enum-like class for available reduction operations: ``SUM``, ``PRODUCT``,
@@ -569,7 +641,10 @@ They are used in specifying strategies for reduction collectives, e.g.,
       .def(py::init<>())
       .def_readwrite("devices", &::c10d::ProcessGroupGloo::Options::devices)
       .def_readwrite("timeout", &::c10d::ProcessGroupGloo::Options::timeout)
-      .def_readwrite("threads", &::c10d::ProcessGroupGloo::Options::threads);
+      .def_readwrite("threads", &::c10d::ProcessGroupGloo::Options::threads)
+      .def_readwrite(
+          "hierarchical_allreduce",
+          &::c10d::ProcessGroupGloo::Options::hierarchicalAllreduce);
 
   processGroupGloo.def_static(
       "create_device",
@@ -615,6 +690,12 @@ They are used in specifying strategies for reduction collectives, e.g.,
                   ::c10d::ProcessGroupGloo::createDefaultDevice());
             }
 
+            // Allreduce within every host first if
+            // "GLOO_HIERARCHICAL_ALLREDUCE" is set to 1.
+            char* hierarchicalEnv = getenv(GLOO_HIERARCHICAL_ALLREDUCE_ENV);
+            options.hierarchicalAllreduce =
+                hierarchicalEnv && std::string(hierarchicalEnv) == "1";
+
             options.timeout = timeout;
             options.threads = options.devices.size() * 2;
             return std::make_shared<::c10d::ProcessGroupGloo>(
@@ -668,7 +749,17 @@ They are used in specifying strategies for reduction collectives, e.g.,
       .def(
           "wait",
           &::c10d::ProcessGroup::Work::wait,
-          py::call_guard<py::gil_scoped_release>());
+          py::call_guard<py::gil_scoped_release>())
+      .def(
+          "get_future",
+          [](::c10d::ProcessGroup::Work& work)
+              -> std::shared_ptr<jit::PythonFutureWrapper> {
+            return std::make_shared<jit::PythonFutureWrapper>(work.getFuture());
+          },
+          R"(
+Returns a ``torch.futures.Future`` that is completed when the work completes.
+Only supported for the work of ``ProcessGroupGloo``.
+)");
 
   module.def(
       "_compute_bucket_assignment_by_size",
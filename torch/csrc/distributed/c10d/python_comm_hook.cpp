@@ -0,0 +1,50 @@
+#include <torch/csrc/distributed/c10d/python_comm_hook.h>
+
+#include <torch/csrc/jit/python/pybind_utils.h>
+
+namespace c10d {
+
+PythonCommHook::~PythonCommHook() {
+  py::gil_scoped_acquire ag;
+  state_.dec_ref();
+  hook_.dec_ref();
+  // Explicitly set state_ and hook_ to nullptr to prevent py::object's dtor
+  // from decref'ing the PyObject again.
+  state_.ptr() = nullptr;
+  hook_.ptr() = nullptr;
+}
+
+c10::intrusive_ptr<c10::ivalue::Future> PythonCommHook::runHook(
+    GradBucket& bucket) {
+  py::gil_scoped_acquire ag;
+  py::object result = hook_(state_, bucket);
+  try {
+    return result.cast<std::shared_ptr<torch::jit::PythonFutureWrapper>>()
+        ->fut;
+  } catch (const py::cast_error&) {
+    TORCH_CHECK(
+        false,
+        "The communication hook must return a torch.futures.Future, got ",
+        py::str(result.get_type()).cast<std::string>());
+  }
+}
+
+std::vector<at::Tensor> PythonCommHook::parseHookResult(
+    const c10::IValue& result) {
+  if (!result.isPyObject()) {
+    return CommHookInterface::parseHookResult(result);
+  }
+  py::gil_scoped_acquire ag;
+  py::object obj = torch::jit::toPyObject(result);
+  try {
+    return obj.cast<std::vector<at::Tensor>>();
+  } catch (const py::cast_error&) {
+    TORCH_CHECK(
+        false,
+        "The future returned by the communication hook must hold a list of ",
+        "tensors, got ",
+        py::str(obj.get_type()).cast<std::string>());
+  }
+}
+
+} // namespace c10d
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <torch/csrc/distributed/c10d/comm.h>
+#include <torch/csrc/utils/pybind.h>
+
+namespace c10d {
+
+// Runs a Python callable as the communication hook. The callable is invoked
+// as `hook(state, bucket)` and must return a torch.futures.Future whose value
+// is a list of tensors, e.g. the result of calling `then` on the future of a
+// ProcessGroup work.
+class PythonCommHook : public CommHookInterface {
+ public:
+  PythonCommHook(py::object state, py::object hook)
+      : state_(std::move(state)), hook_(std::move(hook)) {}
+
+  ~PythonCommHook() override;
+
+  c10::intrusive_ptr<c10::ivalue::Future> runHook(GradBucket& bucket) override;
+
+  std::vector<at::Tensor> parseHookResult(const c10::IValue& result) override;
+
+ private:
+  // Only accessed with the GIL held.
+  py::object state_;
+  py::object hook_;
+};
+
+} // namespace c10d
@@ -447,10 +447,26 @@ void Reducer::mark_bucket_ready(size_t bucket_index) {
       //
       tensors.push_back(replica.contents);
     }
-    bucket.work = process_group_->allreduce(tensors);
+    if (comm_hook_ != nullptr && !bucket.expect_sparse_gradient) {
+      GradBucket grad_bucket(next_bucket_, tensors);
+      bucket.future_work = comm_hook_->runHook(grad_bucket);
+    } else {
+      bucket.work = process_group_->allreduce(tensors);
+    }
   }
 }
 
+void Reducer::register_comm_hook(std::unique_ptr<CommHookInterface> iface) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  TORCH_CHECK(
+      comm_hook_ == nullptr,
+      "register_comm_hook can only be called once.");
+  TORCH_CHECK(
+      !require_finalize_ && !expect_autograd_hooks_,
+      "register_comm_hook must be called before the backward pass.");
+  comm_hook_ = std::move(iface);
+}
+
 void Reducer::initialize_buckets(
     std::vector<std::vector<size_t>> bucket_indices) {
   std::lock_guard<std::mutex> lock(mutex_);
@@ -733,6 +749,31 @@ void Reducer::finalize_backward() {
 
   // Wait for asynchronous reduction to complete and unflatten contents.
   for (auto& bucket : buckets_) {
+    if (bucket.future_work) {
+      bucket.future_work->wait();
+      auto result = comm_hook_->parseHookResult(bucket.future_work->value());
+      bucket.future_work.reset();
+      TORCH_CHECK(
+          result.size() == bucket.replicas.size(),
+          "Expected the communication hook to return ",
+          bucket.replicas.size(),
+          " tensors, got ",
+          result.size());
+      for (size_t i = 0; i < result.size(); ++i) {
+        auto& contents = bucket.replicas[i].contents;
+        if (!result[i].is_same(contents)) {
+          TORCH_CHECK(
+              result[i].numel() == contents.numel(),
+              "The communication hook returned a tensor of ",
+              result[i].numel(),
+              " elements for a bucket of ",
+              contents.numel());
+          contents.copy_(result[i].reshape(contents.sizes()));
+        }
+      }
+      finalize_bucket_dense(bucket);
+      continue;
+    }
     TORCH_INTERNAL_ASSERT(bucket.work);
     bucket.work->wait();
     if (!bucket.expect_sparse_gradient) {
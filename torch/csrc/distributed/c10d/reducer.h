@@ -9,6 +9,7 @@
 
 #include <c10d/ProcessGroup.hpp>
 #include <torch/csrc/autograd/function.h>
+#include <torch/csrc/distributed/c10d/comm.h>
 #include <torch/csrc/autograd/variable.h>
 #include <torch/csrc/distributed/autograd/context/context.h>
 
@@ -52,6 +53,12 @@ class Reducer {
     return backward_stats_;
   }
 
+  // Registers a hook that replaces the allreduce of every dense bucket, e.g.
+  // to compress gradients before they are communicated. Sparse buckets are
+  // still allreduced. A hook can only be registered once, before the first
+  // backward pass.
+  void register_comm_hook(std::unique_ptr<CommHookInterface> iface);
+
  protected:
   // Forward declaration.
   struct Bucket;
@@ -73,6 +80,9 @@ class Reducer {
   std::vector<std::pair<uintptr_t, std::shared_ptr<torch::autograd::Node>>>
       hooks_;
 
+  // Communication hook for dense buckets, if one was registered.
+  std::unique_ptr<CommHookInterface> comm_hook_;
+
   bool expect_autograd_hooks_;
   bool require_finalize_;
   size_t next_bucket_;
@@ -183,6 +193,10 @@ class Reducer {
     // Keep work handle around when this set of buckets is being reduced.
     std::shared_ptr<c10d::ProcessGroup::Work> work;
 
+    // Future returned by the communication hook, used instead of `work` for
+    // dense buckets when a hook is registered.
+    c10::intrusive_ptr<c10::ivalue::Future> future_work;
+
     // If this bucket should expect a single sparse gradient.
     // Implies: replicas[i].variables.size() == 1.
     bool expect_sparse_gradient = false;
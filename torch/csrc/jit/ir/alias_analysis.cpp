@@ -496,6 +496,8 @@ void AliasDb::analyzeImpl(Node* node) {
     case prim::Function:
     case prim::CreateObject:
     case prim::tolist:
+    case prim::AllocateArena:
+    case prim::MemoryPlanGuard:
       return analyzeCreator(node);
     case prim::TupleConstruct:
     case prim::DictConstruct:
@@ -512,6 +514,7 @@ void AliasDb::analyzeImpl(Node* node) {
         return analyzeCreator(node);
       return analyzeExtractor(node);
     case prim::unchecked_cast:
+    case prim::ArenaTensor:
       return makePointerTo(node->output(), node->input());
     case prim::ConstantChunk:
       return analyzeChunk(node);
@@ -30,21 +30,25 @@ bool Function::append_operator(
   auto opname = code_->op_names_.back();
 
   auto opname_c10 = opname;
-  std::function<void(Stack&)> fn;
+  Operation fn;
 
+  // Resolve the operation now rather than on every call.
   auto jit_op = findOperatorFor(opname);
   if (jit_op) {
-    fn = [jit_op](Stack& stack) { jit_op->getOperation()(stack); };
+    fn = jit_op->getOperation();
   } else {
     auto op = c10::Dispatcher::singleton().findSchema(opname_c10);
     if (op.has_value()) {
-      fn = [op](Stack& stack) { op->callBoxed(&stack); };
+      fn = [op](Stack& stack) {
+        op->callBoxed(&stack);
+        return 0;
+      };
     } else {
       return false;
     }
   }
 
-  code_->operators_.emplace_back(fn);
+  code_->operators_.emplace_back(std::move(fn));
   return true;
 }
 
@@ -60,7 +64,57 @@ void Function::set_register_size(size_t size) {
   code_->register_size_ = size;
 }
 
+static MobileOpCode toMobileOpCode(OpCode op) {
+  switch (op) {
+#define MOBILE_OPCODE_CASE(name) \
+  case name:                     \
+    return MobileOpCode::name;
+    FORALL_MOBILE_BYTECODE_OPCODES(MOBILE_OPCODE_CASE)
+#undef MOBILE_OPCODE_CASE
+    default:
+      TORCH_CHECK(false, toString(op), " is not supported in mobile module.");
+  }
+}
+
+// Returns the superinstruction that runs OP and the OP after it, if any.
+static c10::optional<MobileOpCode> fuseWithOP(OpCode op) {
+  switch (op) {
+    case LOAD:
+      return MobileOpCode::LOAD_OP;
+    case MOVE:
+      return MobileOpCode::MOVE_OP;
+    case GET_ATTR:
+      return MobileOpCode::GET_ATTR_OP;
+    default:
+      return c10::nullopt;
+  }
+}
+
+void Function::build_threaded_code() {
+  const auto& instructions = code_->instructions_;
+  auto& threaded = code_->threaded_instructions_;
+  threaded.clear();
+  threaded.reserve(instructions.size());
+  for (size_t i = 0; i < instructions.size(); ++i) {
+    const Instruction& inst = instructions[i];
+    MobileInstruction threaded_inst{
+        toMobileOpCode(inst.op), inst.N, inst.X, /*Y=*/0};
+    // The OP keeps its own instruction too, jumps may land on it.
+    if (i + 1 < instructions.size() && instructions[i + 1].op == OP) {
+      if (auto fused = fuseWithOP(inst.op)) {
+        threaded_inst.op = *fused;
+        threaded_inst.Y = instructions[i + 1].X;
+      }
+    }
+    threaded.push_back(threaded_inst);
+  }
+}
+
 bool Function::run(Stack& stack) const {
+  TORCH_CHECK(
+      code_->threaded_instructions_.size() == code_->instructions_.size(),
+      "build_threaded_code() wasn't called for ",
+      name_.qualifiedName());
   InterpreterState interp_state(code_);
   return interp_state.run(stack);
 }
@@ -26,6 +26,11 @@ class Function {
 
   void set_register_size(size_t size);
 
+  // Translates the instructions to the threaded code that run() executes,
+  // fusing the common pairs of instructions. Called once all the
+  // instructions and operators are appended.
+  void build_threaded_code();
+
  private:
   c10::QualifiedName name_;
   std::shared_ptr<Code> code_;
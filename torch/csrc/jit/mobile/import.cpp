@@ -147,6 +147,7 @@ void parseMethods(
     }
 
     function->set_register_size(register_size);
+    function->build_threaded_code();
 
     mcu.register_function(std::move(function));
   }
@@ -20,181 +20,256 @@ InterpreterState::InterpreterState(std::shared_ptr<Code> code)
 
 using namespace at;
 
+void InterpreterState::runOperator(size_t pc, int32_t op, Stack& stack) {
+  if (at::hasGlobalCallbacks()) {
+    if (auto debug_info = c10::ThreadLocalDebugInfo::get(
+            c10::DebugInfoKind::MOBILE_RUNTIME_INFO)) {
+      if (auto* mobile_debug_info =
+              dynamic_cast<MobileDebugInfo*>(debug_info.get())) {
+        mobile_debug_info->setOpIdx(pc);
+      }
+    }
+  }
+
+  // TODO(iliacher): remove the workaround after RecordFunction is in
+  // Dispatcher
+  bool prev_value = isRecordFunctionEnabled();
+  if (!prev_value) {
+    // enable only for the RecordFunction
+    enableRecordFunction(true);
+  }
+  RECORD_FUNCTION(code_->op_names_[op].name, stack);
+  if (!prev_value) {
+    enableRecordFunction(false);
+  }
+  code_->operators_[op](stack);
+}
+
+// With GCC and Clang each instruction jumps straight to the handler of the
+// next one through a table of label addresses (threaded code), instead of
+// going back to the top of a switch. This gives the branch predictor one
+// indirect branch per handler to learn from.
+#if defined(__GNUC__) || defined(__clang__)
+#define MOBILE_THREADED_DISPATCH
+#endif
+
+#ifdef MOBILE_THREADED_DISPATCH
+#define INSTRUCTION(name) L_##name:
+#define DISPATCH() \
+  goto* dispatch_table[static_cast<uint8_t>(instructions[pc].op)]
+#else
+#define INSTRUCTION(name) case MobileOpCode::name:
+#define DISPATCH() break
+#endif
+
 bool InterpreterState::run(Stack& stack) {
+  const MobileInstruction* instructions = code_->threaded_instructions_.data();
   size_t pc = 0;
+
+#ifdef MOBILE_THREADED_DISPATCH
+  static void* const dispatch_table[] = {
+#define DISPATCH_LABEL(name) &&L_##name,
+      FORALL_MOBILE_OPCODES(DISPATCH_LABEL)
+#undef DISPATCH_LABEL
+  };
+  DISPATCH();
+#else
   while (true) {
-    Instruction inst = code_->instructions_[pc];
+    switch (instructions[pc].op) {
+#endif
 
-    //    std::cout << "RUNNING " << pc << " " << code_->instructions_[pc];
-    //    if (inst.op == OP) {
-    //      std::cout << ", " << code_->op_names_[inst.X].name;
-    //      if (!code_->op_names_[inst.X].overload_name.empty()) {
-    //        std::cout << "." << code_->op_names_[inst.X].overload_name;
-    //      }
-    //    }
-    //    std::cout << std::endl;
-    switch (inst.op) {
-      case OP: {
-        if (at::hasGlobalCallbacks()) {
-          if (auto debug_info = c10::ThreadLocalDebugInfo::get(
-                  c10::DebugInfoKind::MOBILE_RUNTIME_INFO)) {
-            if (auto* mobile_debug_info =
-                    dynamic_cast<MobileDebugInfo*>(debug_info.get())) {
-              mobile_debug_info->setOpIdx(pc);
-            }
-          }
-        }
+  INSTRUCTION(OP) {
+    runOperator(pc, instructions[pc].X, stack);
+    ++pc;
+  }
+  DISPATCH();
+  INSTRUCTION(OPN) {
+    const MobileInstruction& inst = instructions[pc];
+    stack.push_back(inst.N);
+    code_->operators_[inst.X](stack);
+    ++pc;
+  }
+  DISPATCH();
+  INSTRUCTION(INTERFACE_CALL) {
+    const MobileInstruction& inst = instructions[pc];
+    torch::jit::Function& method =
+        peek(stack, 0, inst.N)
+            .toObject()
+            ->type()
+            ->getMethod(code_->constants_[inst.X].toStringRef());
+    method.run(stack);
+    ++pc;
+  }
+  DISPATCH();
+  INSTRUCTION(LOAD) {
+    stack.emplace_back(reg(instructions[pc].X));
+    ++pc;
+  }
+  DISPATCH();
+  INSTRUCTION(MOVE) {
+    stack.emplace_back(std::move(reg(instructions[pc].X)));
+    ++pc;
+  }
+  DISPATCH();
+  INSTRUCTION(STORE) {
+    reg(instructions[pc].X) = pop(stack);
+    ++pc;
+  }
+  DISPATCH();
+  INSTRUCTION(STOREN) {
+    const MobileInstruction& inst = instructions[pc];
+    for (size_t i = inst.N; i > 0; --i) {
+      reg(inst.X + i - 1) = pop(stack);
+    }
+    ++pc;
+  }
+  DISPATCH();
+  INSTRUCTION(DROP) {
+    pop(stack);
+    ++pc;
+  }
+  DISPATCH();
+  INSTRUCTION(DROPR) {
+    reg(instructions[pc].X) = IValue();
+    ++pc;
+  }
+  DISPATCH();
+  INSTRUCTION(LOADC) {
+    stack.emplace_back(code_->constants_[instructions[pc].X]);
+    ++pc;
+  }
+  DISPATCH();
+  INSTRUCTION(GET_ATTR) {
+    auto userObj = pop(stack).toObject();
+    auto value = userObj->getSlot(instructions[pc].X);
+    push(stack, std::move(value));
+    ++pc;
+  }
+  DISPATCH();
+  INSTRUCTION(SET_ATTR) {
+    const MobileInstruction& inst = instructions[pc];
+    auto v = pop(stack);
+    auto userObj = pop(stack).toObject();
+    // Mobile only: since the number of slots is not known, resize the
+    // numAttributes before setSlot.
+    while (userObj->type()->numAttributes() <= inst.X) {
+      std::stringstream ss;
+      ss << userObj->type()->numAttributes();
+      userObj->type()->addAttribute(ss.str(), c10::NoneType::create());
+    }
+    userObj->setSlot(inst.X, std::move(v));
+    ++pc;
+  }
+  DISPATCH();
+  INSTRUCTION(JF) {
+    pc += (pop(stack).toBool()) ? 1 : instructions[pc].X;
+  }
+  DISPATCH();
+  INSTRUCTION(JMP) {
+    pc += instructions[pc].X;
+  }
+  DISPATCH();
+  INSTRUCTION(LOOP) {
+    const MobileInstruction& inst = instructions[pc];
+    // stack: iteration_count, max_iter, cond, loop_carried_deps...
+    auto frame = stack.end() - (inst.N + 1);
+    int64_t trip_count = frame[0].toInt();
+    int64_t max_trip_count = frame[1].toInt();
+    bool cond = frame[2].toBool();
+    if (trip_count < max_trip_count && cond) {
+      frame[2] = trip_count;
+      frame[0] = trip_count + 1;
+      ++pc;
+    } else {
+      size_t n_loop_carried = inst.N - 2;
+      for (size_t i = 0; i < n_loop_carried; ++i) {
+        frame[i] = std::move(frame[i + 3]);
+      }
+      drop(stack, 3); // iteration_count, max_iter, cond
+      pc += inst.X;
+    }
+  }
+  DISPATCH();
+  INSTRUCTION(RET) {
+    return false;
+  }
+  INSTRUCTION(LIST_CONSTRUCT) {
+    const MobileInstruction& inst = instructions[pc];
+    auto type = code_->types_[inst.X]->expect<at::ListType>();
+    listConstruct(stack, type, inst.N);
+    ++pc;
+  }
+  DISPATCH();
+  INSTRUCTION(LIST_UNPACK) {
+    listUnpack(stack, instructions[pc].X);
+    ++pc;
+  }
+  DISPATCH();
+  INSTRUCTION(TUPLE_CONSTRUCT) {
+    tupleConstruct(stack, instructions[pc].X);
+    ++pc;
+  }
+  DISPATCH();
+  INSTRUCTION(TUPLE_SLICE) {
+    const MobileInstruction& inst = instructions[pc];
+    tupleSlice(stack, inst.X, inst.X + inst.N);
+    ++pc;
+  }
+  DISPATCH();
+  INSTRUCTION(DICT_CONSTRUCT) {
+    const MobileInstruction& inst = instructions[pc];
+    auto type = code_->types_[inst.X]->expect<at::DictType>();
+    dictConstruct(stack, type, inst.N);
+    ++pc;
+  }
+  DISPATCH();
+  INSTRUCTION(NAMED_TUPLE_CONSTRUCT) {
+    const MobileInstruction& inst = instructions[pc];
+    auto type = code_->types_[inst.X]->expect<at::TupleType>();
+    namedTupleConstruct(stack, type, inst.N);
+    ++pc;
+  }
+  DISPATCH();
+  INSTRUCTION(WARN) {
+    drop(stack, 1);
+    TORCH_WARN(pop(stack).toStringRef());
+    ++pc;
+  }
+  DISPATCH();
+  INSTRUCTION(LOAD_OP) {
+    const MobileInstruction& inst = instructions[pc];
+    stack.emplace_back(reg(inst.X));
+    runOperator(pc + 1, inst.Y, stack);
+    pc += 2;
+  }
+  DISPATCH();
+  INSTRUCTION(MOVE_OP) {
+    const MobileInstruction& inst = instructions[pc];
+    stack.emplace_back(std::move(reg(inst.X)));
+    runOperator(pc + 1, inst.Y, stack);
+    pc += 2;
+  }
+  DISPATCH();
+  INSTRUCTION(GET_ATTR_OP) {
+    const MobileInstruction& inst = instructions[pc];
+    auto userObj = pop(stack).toObject();
+    auto value = userObj->getSlot(inst.X);
+    push(stack, std::move(value));
+    runOperator(pc + 1, inst.Y, stack);
+    pc += 2;
+  }
+  DISPATCH();
 
-        // TODO(iliacher): remove the workaround after RecordFunction is in
-        // Dispatcher
-        bool prev_value = isRecordFunctionEnabled();
-        if (!prev_value) {
-          // enable only for the RecordFunction
-          enableRecordFunction(true);
-        }
-        RECORD_FUNCTION(code_->op_names_[inst.X].name, stack);
-        if (!prev_value) {
-          enableRecordFunction(false);
-        }
-        code_->operators_[inst.X](stack);
-        ++pc;
-      } break;
-      case OPN: {
-        stack.push_back(inst.N);
-        code_->operators_[inst.X](stack);
-        ++pc;
-      } break;
-      case INTERFACE_CALL: {
-        torch::jit::Function& method =
-            peek(stack, 0, inst.N)
-                .toObject()
-                ->type()
-                ->getMethod(code_->constants_[inst.X].toStringRef());
-        method.run(stack);
-        ++pc;
-      } break;
-      case LOAD:
-        stack.emplace_back(reg(inst.X));
-        ++pc;
-        break;
-      case MOVE:
-        stack.emplace_back(std::move(reg(inst.X)));
-        ++pc;
-        break;
-      case STORE:
-        reg(inst.X) = pop(stack);
-        ++pc;
-        break;
-      case STOREN:
-        for (size_t i = inst.N; i > 0; --i) {
-          reg(inst.X + i - 1) = pop(stack);
-        }
-        ++pc;
-        break;
-      case DROP:
-        pop(stack);
-        ++pc;
-        break;
-      case DROPR:
-        reg(inst.X) = IValue();
-        ++pc;
-        break;
-      case LOADC:
-        stack.emplace_back(code_->constants_[inst.X]);
-        ++pc;
-        break;
-      case GET_ATTR: {
-        auto userObj = pop(stack).toObject();
-        auto value = userObj->getSlot(inst.X);
-        push(stack, std::move(value));
-        ++pc;
-      } break;
-      case SET_ATTR: {
-        auto v = pop(stack);
-        auto userObj = pop(stack).toObject();
-        // Mobile only: since the number of slots is not known, resize the
-        // numAttributes before setSlot.
-        while (userObj->type()->numAttributes() <= inst.X) {
-          std::stringstream ss;
-          ss << userObj->type()->numAttributes();
-          userObj->type()->addAttribute(ss.str(), c10::NoneType::create());
-        }
-        userObj->setSlot(inst.X, std::move(v));
-        ++pc;
-      } break;
-      case JF:
-        pc += (pop(stack).toBool()) ? 1 : inst.X;
-        break;
-      case JMP:
-        pc += inst.X;
-        break;
-      case LOOP: {
-        // stack: iteration_count, max_iter, cond, loop_carried_deps...
-        auto frame = stack.end() - (inst.N + 1);
-        int64_t trip_count = frame[0].toInt();
-        int64_t max_trip_count = frame[1].toInt();
-        bool cond = frame[2].toBool();
-        if (trip_count < max_trip_count && cond) {
-          frame[2] = trip_count;
-          frame[0] = trip_count + 1;
-          ++pc;
-        } else {
-          size_t n_loop_carried = inst.N - 2;
-          for (size_t i = 0; i < n_loop_carried; ++i) {
-            frame[i] = std::move(frame[i + 3]);
-          }
-          drop(stack, 3); // iteration_count, max_iter, cond
-          pc += inst.X;
-        }
-      } break;
-      case RET:
-        return false;
-      case LIST_CONSTRUCT: {
-        auto type = code_->types_[inst.X]->expect<at::ListType>();
-        listConstruct(stack, type, inst.N);
-        ++pc;
-      } break;
-      case LIST_UNPACK: {
-        listUnpack(stack, inst.X);
-        ++pc;
-      } break;
-      case TUPLE_CONSTRUCT: {
-        tupleConstruct(stack, inst.X);
-        ++pc;
-      } break;
-      case TUPLE_SLICE: {
-        tupleSlice(stack, inst.X, inst.X + inst.N);
-        ++pc;
-      } break;
-      case DICT_CONSTRUCT: {
-        auto type = code_->types_[inst.X]->expect<at::DictType>();
-        dictConstruct(stack, type, inst.N);
-        ++pc;
-      } break;
-      case NAMED_TUPLE_CONSTRUCT: {
-        auto type = code_->types_[inst.X]->expect<at::TupleType>();
-        namedTupleConstruct(stack, type, inst.N);
-        ++pc;
-      } break;
-      case WARN: {
-        drop(stack, 1);
-        TORCH_WARN(pop(stack).toStringRef());
-        ++pc;
-      } break;
-      default:
-        AT_ERROR(toString(inst.op), " is invalid.");
+#ifndef MOBILE_THREADED_DISPATCH
     }
-    //  for (auto val : stack) {
-    //    if (val.isTensor()) {
-    //      std::cout << val.toTensor().sizes() << std::endl;
-    //    } else {
-    //      std::cout << val << std::endl;
-    //    }
-    //  }
   }
+#endif
   return false;
 }
 
+#undef INSTRUCTION
+#undef DISPATCH
+
 IValue& InterpreterState::reg(size_t reg) {
   return *(registers_.end() - reg);
 }
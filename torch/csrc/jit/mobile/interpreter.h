@@ -8,13 +8,71 @@ namespace torch {
 namespace jit {
 namespace mobile {
 using Stack = std::vector<c10::IValue>;
+
+// The bytecode instructions the mobile interpreter runs.
+#define FORALL_MOBILE_BYTECODE_OPCODES(_) \
+  _(OP)                                   \
+  _(OPN)                                  \
+  _(INTERFACE_CALL)                       \
+  _(LOAD)                                 \
+  _(MOVE)                                 \
+  _(STORE)                                \
+  _(STOREN)                               \
+  _(DROP)                                 \
+  _(DROPR)                                \
+  _(LOADC)                                \
+  _(GET_ATTR)                             \
+  _(SET_ATTR)                             \
+  _(JF)                                   \
+  _(JMP)                                  \
+  _(LOOP)                                 \
+  _(RET)                                  \
+  _(LIST_CONSTRUCT)                       \
+  _(LIST_UNPACK)                          \
+  _(TUPLE_CONSTRUCT)                      \
+  _(TUPLE_SLICE)                          \
+  _(DICT_CONSTRUCT)                       \
+  _(NAMED_TUPLE_CONSTRUCT)                \
+  _(WARN)
+
+// Superinstructions run an instruction and the OP that follows it with a
+// single dispatch.
+#define FORALL_MOBILE_SUPERINSTRUCTIONS(_) \
+  _(LOAD_OP) /* LOAD X; OP Y */            \
+  _(MOVE_OP) /* MOVE X; OP Y */            \
+  _(GET_ATTR_OP) /* GET_ATTR X; OP Y */
+
+#define FORALL_MOBILE_OPCODES(_)   \
+  FORALL_MOBILE_BYTECODE_OPCODES(_) \
+  FORALL_MOBILE_SUPERINSTRUCTIONS(_)
+
+enum class MobileOpCode : uint8_t {
+#define DEFINE_OP(op) op,
+  FORALL_MOBILE_OPCODES(DEFINE_OP)
+#undef DEFINE_OP
+};
+
+// An instruction of the threaded code that InterpreterState::run executes.
+// Superinstructions keep the operands of their first instruction in X and N,
+// and the operator of their OP in Y.
+struct MobileInstruction {
+  MobileOpCode op;
+  uint16_t N;
+  int32_t X;
+  int32_t Y;
+};
+
 struct Code {
   std::vector<Instruction> instructions_;
   std::vector<c10::OperatorName> op_names_;
-  std::vector<std::function<void(Stack&)>> operators_;
+  std::vector<Operation> operators_;
   std::vector<c10::IValue> constants_;
   std::vector<c10::TypePtr> types_;
   size_t register_size_; // Aggregated output size.
+  // instructions_ translated by Function::build_threaded_code. There is one
+  // instruction for each of instructions_, so that jump offsets and operator
+  // indices stay the same.
+  std::vector<MobileInstruction> threaded_instructions_;
 };
 
 struct InterpreterState {
@@ -24,6 +82,7 @@ struct InterpreterState {
  private:
   std::shared_ptr<Code> code_;
   c10::IValue& reg(size_t reg);
+  void runOperator(size_t pc, int32_t op, Stack& stack);
   std::vector<c10::IValue> registers_;
 };
 
@@ -0,0 +1,359 @@
+#include <torch/csrc/jit/passes/memory_planning.h>
+
+#include <torch/csrc/jit/ir/alias_analysis.h>
+#include <torch/csrc/jit/jit_log.h>
+#include <torch/csrc/jit/passes/shape_analysis.h>
+#include <torch/csrc/jit/runtime/operator.h>
+
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+// Offsets into the arena are kept aligned to the CPU allocator's alignment so
+// that planned tensors are as well aligned as freshly allocated ones.
+constexpr size_t kArenaAlignment = 64;
+
+size_t alignUp(size_t nbytes) {
+  return (nbytes + kArenaAlignment - 1) / kArenaAlignment * kArenaAlignment;
+}
+
+struct PlannedValue {
+  Value* value;
+  // [begin, end] in top-level node positions, inclusive
+  size_t begin;
+  size_t end;
+  size_t nbytes;
+  size_t offset;
+  std::vector<int64_t> sizes;
+  std::vector<int64_t> strides;
+  at::ScalarType dtype;
+};
+
+// Returns true if `op_schema` is the out= overload of `schema`: the same
+// arguments followed by a single mutated Tensor that is also returned.
+bool isOutVariantOf(
+    const FunctionSchema& op_schema,
+    const FunctionSchema& schema) {
+  const auto& overload = op_schema.overload_name();
+  const bool is_out_overload = overload == "out" ||
+      (overload.size() > 4 &&
+       overload.compare(overload.size() - 4, 4, "_out") == 0);
+  if (!is_out_overload || op_schema.is_vararg() ||
+      op_schema.returns().size() != 1 ||
+      op_schema.arguments().size() != schema.arguments().size() + 1) {
+    return false;
+  }
+  for (size_t i = 0; i < schema.arguments().size(); ++i) {
+    const auto& expected = schema.arguments()[i];
+    const auto& actual = op_schema.arguments()[i];
+    if (expected.name() != actual.name() ||
+        *expected.type() != *actual.type()) {
+      return false;
+    }
+  }
+  const auto& out = op_schema.arguments().back();
+  return out.type()->isSubtypeOf(TensorType::get()) && out.alias_info() &&
+      out.alias_info()->isWrite();
+}
+
+bool hasOutVariant(const Node* node) {
+  const FunctionSchema* schema = node->maybeSchema();
+  if (!schema || schema->is_mutable() || schema->is_vararg() ||
+      schema->returns().size() != 1 || schema->returns()[0].alias_info()) {
+    return false;
+  }
+  for (const auto& op : getAllOperatorsFor(node->kind())) {
+    if (isOutVariantOf(op->schema(), *schema)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool requiresGrad(const Value* v) {
+  auto tt = v->type()->cast<TensorType>();
+  return tt && tt->requiresGrad() && *tt->requiresGrad();
+}
+
+struct MemoryPlanner {
+  MemoryPlanner(std::shared_ptr<Graph> graph, bool guard_inputs)
+      : graph_(std::move(graph)), guard_inputs_(guard_inputs) {}
+
+  MemoryPlanStats run() {
+    // The plan is only valid for the input shapes it was made for, and they
+    // are checked before running it.
+    for (Value* input : graph_->inputs()) {
+      auto tt = input->type()->cast<TensorType>();
+      if (!tt || !tt->isComplete()) {
+        return MemoryPlanStats();
+      }
+    }
+
+    derived_ = outputsDerivedFromInputs();
+
+    size_t pos = 0;
+    for (Node* n : graph_->nodes()) {
+      positions_[n] = pos++;
+    }
+    positions_[graph_->return_node()] = pos;
+
+    AliasDb aliasDb(graph_);
+    collectValues(graph_->block());
+    std::vector<PlannedValue> planned;
+    for (Node* n : graph_->nodes()) {
+      if (auto pv = tryPlan(n, aliasDb)) {
+        planned.push_back(std::move(*pv));
+      }
+    }
+
+    MemoryPlanStats stats;
+    if (planned.empty()) {
+      return stats;
+    }
+    stats.planned_values = planned.size();
+    for (const auto& pv : planned) {
+      stats.planned_bytes += pv.nbytes;
+    }
+    stats.arena_bytes = assignOffsets(planned);
+    std::shared_ptr<Graph> unplanned = guard_inputs_ ? graph_->copy() : nullptr;
+    rewrite(planned, stats.arena_bytes);
+    if (unplanned) {
+      guardInputs(*unplanned);
+    }
+    GRAPH_DUMP("After PlanMemory: ", graph_);
+    return stats;
+  }
+
+ private:
+  void collectValues(Block* b) {
+    for (Value* v : b->inputs()) {
+      values_.push_back(v);
+    }
+    for (Node* n : b->nodes()) {
+      for (Value* v : n->outputs()) {
+        values_.push_back(v);
+      }
+      for (Block* sub : n->blocks()) {
+        collectValues(sub);
+      }
+    }
+  }
+
+  // Returns the outputs of the top-level nodes whose sizes and strides shape
+  // analysis derives from the types of the graph inputs alone. The sizes of
+  // the others may depend on the values of the inputs (aten::nonzero,
+  // aten::masked_select, aten::unique, ...), so the input guard doesn't
+  // make them fixed.
+  std::unordered_set<const Value*> outputsDerivedFromInputs() const {
+    auto derived_graph = graph_->copy();
+    EraseShapeInformation(derived_graph);
+    for (size_t i = 0; i < graph_->inputs().size(); ++i) {
+      derived_graph->inputs()[i]->setType(graph_->inputs()[i]->type());
+    }
+    PropagateInputShapes(derived_graph);
+
+    std::unordered_set<const Value*> derived;
+    auto derived_it = derived_graph->nodes().begin();
+    for (Node* n : graph_->nodes()) {
+      Node* derived_node = *derived_it++;
+      for (size_t i = 0; i < n->outputs().size(); ++i) {
+        auto tt = n->outputs()[i]->type()->cast<TensorType>();
+        auto derived_tt =
+            derived_node->outputs()[i]->type()->cast<TensorType>();
+        if (tt && derived_tt && derived_tt->isComplete() &&
+            tt->sizes().concrete_sizes() ==
+                derived_tt->sizes().concrete_sizes() &&
+            tt->strides().concrete_sizes() ==
+                derived_tt->strides().concrete_sizes()) {
+          derived.insert(n->outputs()[i]);
+        }
+      }
+    }
+    return derived;
+  }
+
+  // Position of the top-level node that (transitively) contains `n`.
+  size_t topLevelPosition(Node* n) const {
+    while (n->owningBlock() != graph_->block()) {
+      n = n->owningBlock()->owningNode();
+    }
+    return positions_.at(n);
+  }
+
+  size_t lastUse(const Value* v, size_t def) const {
+    size_t last = def;
+    for (const Use& use : v->uses()) {
+      last = std::max(last, topLevelPosition(use.user));
+    }
+    return last;
+  }
+
+  c10::optional<PlannedValue> tryPlan(Node* n, const AliasDb& aliasDb) const {
+    if (n->outputs().size() != 1 || !n->kind().is_aten()) {
+      return c10::nullopt;
+    }
+    Value* v = n->output();
+    auto tt = v->type()->cast<TensorType>();
+    if (!tt || !tt->scalarType() || !tt->device() || !tt->device()->is_cpu()) {
+      return c10::nullopt;
+    }
+    auto sizes = tt->sizes().concrete_sizes();
+    auto strides = tt->strides().concrete_sizes();
+    if (!sizes || !strides || !derived_.count(v)) {
+      return c10::nullopt;
+    }
+    // out= variants don't support autograd.
+    if (requiresGrad(v) ||
+        std::any_of(n->inputs().begin(), n->inputs().end(), requiresGrad)) {
+      return c10::nullopt;
+    }
+    size_t span = 1;
+    for (size_t i = 0; i < sizes->size(); ++i) {
+      if ((*sizes)[i] == 0 || (*strides)[i] < 0) {
+        return c10::nullopt;
+      }
+      span += ((*sizes)[i] - 1) * (*strides)[i];
+    }
+    if (!hasOutVariant(n) || aliasDb.escapesScope({v})) {
+      return c10::nullopt;
+    }
+
+    PlannedValue pv;
+    pv.value = v;
+    pv.begin = positions_.at(n);
+    // Memory must stay reserved until the last use of anything that may
+    // alias or contain it (views, loop-carried values, lists, ...).
+    pv.end = lastUse(v, pv.begin);
+    for (Value* other : values_) {
+      if (other != v && aliasDb.mayContainAlias(v, other)) {
+        pv.end = std::max(pv.end, lastUse(other, pv.begin));
+      }
+    }
+    pv.dtype = *tt->scalarType();
+    pv.nbytes = alignUp(span * c10::elementSize(pv.dtype));
+    pv.offset = 0;
+    pv.sizes = std::move(*sizes);
+    pv.strides = std::move(*strides);
+    return pv;
+  }
+
+  // Greedy by size: place the largest values first, each at the lowest
+  // offset that does not overlap a placed value with an overlapping lifetime.
+  // Returns the resulting arena size.
+  static size_t assignOffsets(std::vector<PlannedValue>& planned) {
+    std::vector<PlannedValue*> order;
+    for (auto& pv : planned) {
+      order.push_back(&pv);
+    }
+    std::stable_sort(
+        order.begin(), order.end(), [](PlannedValue* a, PlannedValue* b) {
+          return a->nbytes > b->nbytes;
+        });
+
+    size_t arena_bytes = 0;
+    std::vector<PlannedValue*> placed;
+    std::vector<std::pair<size_t, size_t>> busy;
+    for (PlannedValue* pv : order) {
+      busy.clear();
+      for (PlannedValue* other : placed) {
+        if (other->begin <= pv->end && pv->begin <= other->end) {
+          busy.emplace_back(other->offset, other->offset + other->nbytes);
+        }
+      }
+      std::sort(busy.begin(), busy.end());
+      size_t offset = 0;
+      for (const auto& range : busy) {
+        if (offset + pv->nbytes <= range.first) {
+          break;
+        }
+        offset = std::max(offset, range.second);
+      }
+      pv->offset = offset;
+      arena_bytes = std::max(arena_bytes, offset + pv->nbytes);
+      placed.push_back(pv);
+    }
+    return arena_bytes;
+  }
+
+  void rewrite(const std::vector<PlannedValue>& planned, size_t arena_bytes) {
+    Node* alloc = graph_->create(prim::AllocateArena, {}, 1);
+    alloc->i_(attr::size, static_cast<int64_t>(arena_bytes));
+    alloc->output()->setType(TensorType::get());
+    graph_->prependNode(alloc);
+    Value* arena = alloc->output();
+
+    for (const auto& pv : planned) {
+      Node* node = pv.value->node();
+      WithInsertPoint guard(node);
+      Node* view =
+          graph_->insertNode(graph_->create(prim::ArenaTensor, {arena}));
+      view->i_(attr::offset, static_cast<int64_t>(pv.offset))
+          ->is_(attr::sizes, pv.sizes)
+          ->is_(attr::stride, pv.strides)
+          ->i_(attr::dtype, static_cast<int64_t>(pv.dtype));
+      view->output()->setType(pv.value->type());
+
+      std::vector<Value*> inputs = node->inputs().vec();
+      inputs.push_back(view->output());
+      Node* out_node = graph_->insertNode(graph_->create(node->kind(), inputs));
+      out_node->copyMetadata(node);
+      out_node->output()->setType(pv.value->type());
+      TORCH_INTERNAL_ASSERT(
+          out_node->maybeOperator(),
+          "Could not find the out= variant of ",
+          node->kind().toQualString());
+      pv.value->replaceAllUsesWith(out_node->output());
+      node->destroy();
+    }
+  }
+
+  // Moves the planned graph into the true branch of a prim::If that checks
+  // the inputs have the shapes, strides and dtypes it was planned for, and
+  // runs UNPLANNED in the false branch.
+  void guardInputs(Graph& unplanned) {
+    std::vector<Node*> nodes(graph_->nodes().begin(), graph_->nodes().end());
+    Node* check = graph_->create(prim::MemoryPlanGuard, graph_->inputs());
+    check->output()->setType(BoolType::get());
+    graph_->prependNode(check);
+    Node* if_node = graph_->create(prim::If, {check->output()}, 0);
+    if_node->insertAfter(check);
+
+    Block* planned_block = if_node->addBlock();
+    for (Node* n : nodes) {
+      n->moveBefore(planned_block->return_node());
+    }
+    for (size_t i = 0; i < graph_->outputs().size(); ++i) {
+      Value* output = graph_->outputs()[i];
+      planned_block->registerOutput(output);
+      if_node->addOutput()->setType(output->type());
+      graph_->return_node()->replaceInput(i, if_node->outputs()[i]);
+    }
+
+    Block* unplanned_block = if_node->addBlock();
+    WithInsertPoint guard(unplanned_block);
+    for (Value* output : insertGraph(*graph_, unplanned, graph_->inputs())) {
+      unplanned_block->registerOutput(output);
+    }
+  }
+
+  std::shared_ptr<Graph> graph_;
+  bool guard_inputs_;
+  std::unordered_map<Node*, size_t> positions_;
+  std::vector<Value*> values_;
+  std::unordered_set<const Value*> derived_;
+};
+
+} // namespace
+
+MemoryPlanStats PlanMemory(std::shared_ptr<Graph>& graph, bool guard_inputs) {
+  return MemoryPlanner(graph, guard_inputs).run();
+}
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <torch/csrc/jit/ir/ir.h>
+
+namespace torch {
+namespace jit {
+
+struct MemoryPlanStats {
+  // number of intermediates that were assigned a slot in the arena
+  size_t planned_values = 0;
+  // sum of the (aligned) sizes of those intermediates
+  size_t planned_bytes = 0;
+  // size of the arena; smaller than planned_bytes when lifetimes allow reuse
+  size_t arena_bytes = 0;
+};
+
+// Statically plans the memory of tensor intermediates in `graph`.
+//
+// Every intermediate that has a complete CPU tensor type (e.g. recorded by
+// shape profiling) that shape analysis also derives from the types of the
+// graph inputs, is produced by an op with an `out=` overload, and does not
+// escape the graph is assigned an offset in a single arena. Outputs whose
+// sizes depend on the values of the inputs, like those of aten::nonzero, are
+// not planned. Offsets are
+// assigned greedily, largest tensor first, so that values whose lifetimes
+// (extended over everything that may alias them) overlap never share bytes.
+// The producing ops are then rewritten to their `out=` variants writing into
+// views of the arena. prim::AllocateArena allocates the arena on the first
+// run and reuses it in later runs.
+//
+// The plan is only valid for the shapes recorded in the graph, so graphs are
+// only planned when all their inputs are tensors with complete types. With
+// `guard_inputs`, the planned nodes run in a prim::If that
+// prim::MemoryPlanGuard takes when the inputs have the recorded sizes,
+// strides and dtypes and don't require grad; the other branch runs an
+// unplanned copy of the graph. Without it, the caller must check the inputs
+// against the types of the graph inputs itself.
+TORCH_API MemoryPlanStats PlanMemory(
+    std::shared_ptr<Graph>& graph,
+    bool guard_inputs = true);
+
+} // namespace jit
+} // namespace torch
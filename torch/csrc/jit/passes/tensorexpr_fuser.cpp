@@ -1,6 +1,7 @@
 #include <torch/csrc/jit/passes/tensorexpr_fuser.h>
 #include <ATen/record_function.h>
 #include <torch/csrc/jit/ir/alias_analysis.h>
+#include <torch/csrc/jit/ir/constants.h>
 #include <torch/csrc/jit/jit_log.h>
 #include <torch/csrc/jit/passes/common_subexpression_elimination.h>
 #include <torch/csrc/jit/passes/dead_code_elimination.h>
@@ -9,11 +10,51 @@
 #include <torch/csrc/jit/runtime/custom_operator.h>
 #include <torch/csrc/jit/runtime/operator_options.h>
 #include <torch/csrc/jit/tensorexpr/kernel.h>
+#include <torch/csrc/jit/tensorexpr/kernel_cache.h>
 
 namespace torch {
 namespace jit {
 
 namespace tensorexpr {
+
+static bool isConstantIntOrIntList(Value* v) {
+  if (v->node()->kind() == prim::ListConstruct) {
+    for (Value* i : v->node()->inputs()) {
+      auto const& ival = toIValue(i);
+      if (!ival || !ival->isInt()) {
+        return false;
+      }
+    }
+    return true;
+  }
+  auto const& ival = toIValue(v);
+  return ival && (ival->isInt() || ival->isIntList());
+}
+
+// Reductions are lowered on CPU only, for floating point inputs. The dim and
+// keepdim arguments have to be constants and the dtype of the result has to
+// be None. A negative position means the schema has no such argument.
+static bool isSupportedReduction(Node* node, int dim, int keepdim, int dtype) {
+  auto const& tt = node->inputs()[0]->type()->cast<TensorType>();
+  if (!tt || !tt->scalarType() || !c10::isFloatingType(*tt->scalarType()) ||
+      !tt->device() || !tt->device()->is_cpu()) {
+    return false;
+  }
+  if (dim >= 0 && !isConstantIntOrIntList(node->inputs()[dim])) {
+    return false;
+  }
+  if (keepdim >= 0) {
+    auto const& ival = toIValue(node->inputs()[keepdim]);
+    if (!ival || !ival->isBool()) {
+      return false;
+    }
+  }
+  if (dtype >= 0 && !node->inputs()[dtype]->type()->cast<NoneType>()) {
+    return false;
+  }
+  return true;
+}
+
 bool isSupported(Node* node) {
   // TODO:
   switch (node->kind()) {
@@ -85,6 +126,15 @@ bool isSupported(Node* node) {
     // Operators that can be both elementwise or reductions:
     case aten::min:
     case aten::max:
+      if (node->kind() == aten::max && node->inputs().size() == 1) {
+        return isSupportedReduction(node, -1, -1, -1);
+      }
+      // max.dim also returns the indices of the maximums, which the fuser
+      // doesn't compute.
+      if (node->kind() == aten::max && node->inputs().size() == 3) {
+        return node->outputs()[1]->uses().empty() &&
+            isSupportedReduction(node, 1, 2, -1);
+      }
       if (node->inputs().size() != 2) {
         return false;
       }
@@ -93,6 +143,15 @@ bool isSupported(Node* node) {
         return false;
       }
       return true;
+    case aten::sum:
+    case aten::mean:
+      if (node->inputs().size() == 2) {
+        return isSupportedReduction(node, -1, -1, 1);
+      }
+      return node->inputs().size() == 4 && isSupportedReduction(node, 1, 2, 3);
+    case aten::softmax:
+    case aten::log_softmax:
+      return node->inputs().size() == 3 && isSupportedReduction(node, 1, -1, 2);
     default:
       return false;
   }
@@ -370,20 +429,10 @@ void FuseTensorExprs(std::shared_ptr<Graph>& graph) {
 }
 
 Operation createTensorExprOp(const Node* node) {
-  auto kernel =
-      std::make_shared<tensorexpr::TensorExprKernel>(node->g(attr::Subgraph));
-  return [kernel](Stack& stack) {
+  auto cache = tensorexpr::KernelCache::get(node->g(attr::Subgraph));
+  return [cache](Stack& stack) {
     RECORD_FUNCTION("TensorExpr", std::vector<c10::IValue>());
-    if (!tensorexpr::fallbackAllowed()) {
-      kernel->run(stack);
-      return 0;
-    }
-
-    try {
-      kernel->run(stack);
-    } catch (const std::runtime_error& e) {
-      kernel->fallback(stack);
-    }
+    cache->run(stack);
     return 0;
   };
 }
@@ -27,6 +27,7 @@
 #include <torch/csrc/jit/passes/loop_unrolling.h>
 #include <torch/csrc/jit/passes/lower_graph.h>
 #include <torch/csrc/jit/passes/lower_tuples.h>
+#include <torch/csrc/jit/passes/memory_planning.h>
 #include <torch/csrc/jit/passes/normalize_ops.h>
 #include <torch/csrc/jit/passes/onnx.h>
 #include <torch/csrc/jit/passes/onnx/cast_all_constant_to_floating.h>
@@ -69,10 +70,13 @@
 #include <torch/csrc/jit/runtime/jit_exception.h>
 #include <torch/csrc/jit/runtime/operator.h>
 #include <torch/csrc/jit/runtime/print_handler.h>
+#include <torch/csrc/jit/runtime/static/init.h>
 #include <torch/csrc/jit/serialization/export.h>
 #include <torch/csrc/jit/serialization/import.h>
 #include <torch/csrc/jit/tensorexpr/execution_counter.h>
 #include <torch/csrc/jit/tensorexpr/kernel.h>
+#include <torch/csrc/jit/tensorexpr/kernel_cache.h>
+#include <torch/csrc/jit/tensorexpr/llvm_object_cache.h>
 
 #include <c10/macros/Export.h>
 #include <caffe2/serialize/inline_container.h>
@@ -280,6 +284,9 @@ void initJITBindings(PyObject* module) {
           "_jit_pass_remove_inplace_ops",
           [](std::shared_ptr<Graph> g) { return RemoveInplaceOps(g); })
       .def("_jit_pass_constant_pooling", ConstantPooling)
+      .def(
+          "_jit_pass_plan_memory",
+          [](std::shared_ptr<Graph>& g) { return PlanMemory(g).arena_bytes; })
       .def(
           "_jit_pass_create_functional_graphs",
           [](std::shared_ptr<Graph>& g) { return CreateFunctionalGraphs(g); })
@@ -505,6 +512,84 @@ void initJITBindings(PyObject* module) {
             using namespace torch::jit::tensorexpr;
             return getTECudaPointwiseBlockSize() = block_size;
           })
+      .def(
+          "_jit_get_te_cpu_parallel",
+          []() -> bool {
+            using namespace torch::jit::tensorexpr;
+            return getTECPUParallel();
+          })
+      .def(
+          "_jit_set_te_cpu_parallel",
+          [](bool enabled) {
+            using namespace torch::jit::tensorexpr;
+            return getTECPUParallel() = enabled;
+          })
+      .def(
+          "_jit_get_te_kernel_cache_size",
+          []() -> int {
+            using namespace torch::jit::tensorexpr;
+            return getTEKernelCacheSize();
+          })
+      .def(
+          "_jit_set_te_kernel_cache_size",
+          [](int size) {
+            using namespace torch::jit::tensorexpr;
+            return getTEKernelCacheSize() = size;
+          })
+      .def(
+          "_jit_get_te_kernel_cache_stats",
+          []() {
+            using namespace torch::jit::tensorexpr;
+            KernelCacheStats stats = getKernelCacheStats();
+            py::dict result;
+            result["hits"] = stats.hits;
+            result["compiles"] = stats.compiles;
+            result["fallbacks"] = stats.fallbacks;
+            return result;
+          })
+      .def(
+          "_jit_reset_te_kernel_cache_stats",
+          &tensorexpr::resetKernelCacheStats)
+      .def(
+          "_jit_get_te_object_cache_dir",
+          []() -> std::string {
+            using namespace torch::jit::tensorexpr;
+            return getTEObjectCacheDir();
+          })
+      .def(
+          "_jit_set_te_object_cache_dir",
+          [](const std::string& dir) {
+            using namespace torch::jit::tensorexpr;
+            return getTEObjectCacheDir() = dir;
+          })
+      .def(
+          "_jit_get_te_object_cache_size_limit",
+          []() -> int64_t {
+            using namespace torch::jit::tensorexpr;
+            return getTEObjectCacheSizeLimit();
+          })
+      .def(
+          "_jit_set_te_object_cache_size_limit",
+          [](int64_t limit) {
+            using namespace torch::jit::tensorexpr;
+            return getTEObjectCacheSizeLimit() = limit;
+          })
+      .def(
+          "_jit_get_te_object_cache_stats",
+          []() {
+            using namespace torch::jit::tensorexpr;
+            ObjectCacheStats stats = getObjectCacheStats();
+            py::dict result;
+            result["hits"] = stats.hits;
+            result["misses"] = stats.misses;
+            result["stores"] = stats.stores;
+            result["rejected"] = stats.rejected;
+            result["evictions"] = stats.evictions;
+            return result;
+          })
+      .def(
+          "_jit_reset_te_object_cache_stats",
+          &tensorexpr::resetObjectCacheStats)
       .def("_jit_set_texpr_fuser_enabled", &setTensorExprFuserEnabled)
       .def("_jit_texpr_fuser_enabled", &tensorExprFuserEnabled)
       .def("_jit_texpr_fallback_allowed", &tensorexpr::fallbackAllowed)
@@ -1043,6 +1128,7 @@ void initJITBindings(PyObject* module) {
   initTreeViewBindings(module);
   initJitScriptBindings(module);
   initJitBackendBindings(module);
+  initStaticRuntimeBindings(module);
 
   setPrintHandler([](const std::string& str) {
     py::gil_scoped_acquire acquire;
@@ -215,6 +215,9 @@ bool printerHasSpecialCaseFor(Symbol sym) {
       prim::MMBatchSide, // used as an optimization
       prim::Store, // used in interpreter only
       prim::profile, // used in interpreter only
+      prim::AllocateArena, // memory planning pass adds it
+      prim::ArenaTensor, // memory planning pass adds it
+      prim::MemoryPlanGuard, // memory planning pass adds it
 
   };
 
@@ -279,6 +282,9 @@ bool aliasAnalysisHasSpecialCaseFor(Symbol symbol) {
       prim::rpc_async,
       prim::Enter,
       prim::Exit,
+      prim::AllocateArena,
+      prim::ArenaTensor,
+      prim::MemoryPlanGuard,
   };
 
   // Operators that should not be used by alias analysis
@@ -47,6 +47,89 @@ RegisterOperators reg(
            };
          },
          aliasAnalysisSpecialCase()),
+     Operator(
+         prim::AllocateArena,
+         [](const Node* node) -> Operation {
+           const int64_t size = node->i(attr::size);
+           struct ArenaCache {
+             std::mutex mutex;
+             at::Tensor arena;
+           };
+           auto cache = std::make_shared<ArenaCache>();
+           return [size, cache](Stack& stack) {
+             std::lock_guard<std::mutex> guard(cache->mutex);
+             // A run holds the arena, or views of its storage, until it
+             // ends, so the arena is free when the cache is the only owner
+             // of both. Concurrent runs get an arena of their own.
+             if (!cache->arena.defined()) {
+               cache->arena = at::empty({size}, at::kByte);
+               push(stack, cache->arena);
+             } else if (
+                 cache->arena.use_count() == 1 &&
+                 cache->arena.storage().use_count() == 1) {
+               push(stack, cache->arena);
+             } else {
+               push(stack, at::empty({size}, at::kByte));
+             }
+             return 0;
+           };
+         },
+         aliasAnalysisSpecialCase()),
+     Operator(
+         prim::ArenaTensor,
+         [](const Node* node) -> Operation {
+           const auto dtype = static_cast<at::ScalarType>(node->i(attr::dtype));
+           const int64_t storage_offset =
+               node->i(attr::offset) / c10::elementSize(dtype);
+           const auto sizes = node->is(attr::sizes);
+           const auto strides = node->is(attr::stride);
+           return [=](Stack& stack) {
+             at::Tensor arena = pop(stack).toTensor();
+             at::Tensor result = at::empty({0}, arena.options().dtype(dtype));
+             result.set_(arena.storage(), storage_offset, sizes, strides);
+             // Resizing the view would write past its slot into the memory
+             // of other values.
+             result.unsafeGetTensorImpl()->set_allow_tensor_metadata_change(
+                 false);
+             push(stack, std::move(result));
+             return 0;
+           };
+         },
+         aliasAnalysisSpecialCase()),
+     Operator(
+         prim::MemoryPlanGuard,
+         [](const Node* node) -> Operation {
+           struct Expected {
+             at::ScalarType dtype;
+             at::Device device;
+             std::vector<int64_t> sizes;
+             std::vector<int64_t> strides;
+           };
+           std::vector<Expected> expected;
+           for (const Value* input : node->inputs()) {
+             auto type = input->type()->expect<TensorType>();
+             expected.push_back({*type->scalarType(),
+                                 *type->device(),
+                                 *type->sizes().concrete_sizes(),
+                                 *type->strides().concrete_sizes()});
+           }
+           return [expected](Stack& stack) {
+             bool matches = true;
+             auto inputs = last(stack, expected.size());
+             for (size_t i = 0; i < expected.size() && matches; ++i) {
+               const at::Tensor& t = inputs[i].toTensor();
+               matches = t.defined() && t.scalar_type() == expected[i].dtype &&
+                   t.device() == expected[i].device &&
+                   t.sizes().equals(expected[i].sizes) &&
+                   t.strides().equals(expected[i].strides) &&
+                   !(t.requires_grad() && at::GradMode::is_enabled());
+             }
+             drop(stack, expected.size());
+             push(stack, matches);
+             return 0;
+           };
+         },
+         aliasAnalysisSpecialCase()),
      Operator(
          "prim::Guard(Tensor(a) t) -> Tensor(a)",
          [](Stack& stack) {
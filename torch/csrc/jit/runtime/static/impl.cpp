@@ -0,0 +1,299 @@
+#include <torch/csrc/jit/runtime/static/impl.h>
+
+#include <ATen/core/grad_mode.h>
+#include <ATen/core/interned_strings.h>
+#include <torch/csrc/jit/ir/constants.h>
+#include <torch/csrc/jit/passes/constant_propagation.h>
+#include <torch/csrc/jit/passes/dead_code_elimination.h>
+#include <torch/csrc/jit/passes/freeze_module.h>
+#include <torch/csrc/jit/passes/inliner.h>
+#include <torch/csrc/jit/passes/lower_tuples.h>
+#include <torch/csrc/jit/passes/memory_planning.h>
+
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+using ProcessedNode = StaticRuntime::ProcessedNode;
+
+const at::Tensor& input(const ProcessedNode& pn, IValue* reg, size_t i) {
+  return reg[pn.inputs[i]].toTensor();
+}
+
+void setOutput(const ProcessedNode& pn, IValue* reg, at::Tensor t) {
+  reg[pn.outputs[0]] = std::move(t);
+}
+
+// Unboxed kernels for the ops that dominate typical inference graphs. They
+// skip pushing arguments onto a Stack and the std::function call of the
+// boxed Operation.
+const std::vector<std::pair<const char*, StaticRuntime::Kernel>>&
+unboxedKernels() {
+  static const std::vector<std::pair<const char*, StaticRuntime::Kernel>>
+      kernels = {
+          {"aten::add.Tensor(Tensor self, Tensor other, *, Scalar alpha=1) -> Tensor",
+           [](const ProcessedNode& pn, IValue* reg) {
+             setOutput(
+                 pn,
+                 reg,
+                 at::add(
+                     input(pn, reg, 0),
+                     input(pn, reg, 1),
+                     reg[pn.inputs[2]].toScalar()));
+           }},
+          {"aten::mul.Tensor(Tensor self, Tensor other) -> Tensor",
+           [](const ProcessedNode& pn, IValue* reg) {
+             setOutput(pn, reg, at::mul(input(pn, reg, 0), input(pn, reg, 1)));
+           }},
+          {"aten::mm(Tensor self, Tensor mat2) -> Tensor",
+           [](const ProcessedNode& pn, IValue* reg) {
+             setOutput(pn, reg, at::mm(input(pn, reg, 0), input(pn, reg, 1)));
+           }},
+          {"aten::addmm(Tensor self, Tensor mat1, Tensor mat2, *, Scalar beta=1, Scalar alpha=1) -> Tensor",
+           [](const ProcessedNode& pn, IValue* reg) {
+             setOutput(
+                 pn,
+                 reg,
+                 at::addmm(
+                     input(pn, reg, 0),
+                     input(pn, reg, 1),
+                     input(pn, reg, 2),
+                     reg[pn.inputs[3]].toScalar(),
+                     reg[pn.inputs[4]].toScalar()));
+           }},
+          {"aten::linear(Tensor input, Tensor weight, Tensor? bias=None) -> Tensor",
+           [](const ProcessedNode& pn, IValue* reg) {
+             const IValue& bias = reg[pn.inputs[2]];
+             setOutput(
+                 pn,
+                 reg,
+                 at::linear(
+                     input(pn, reg, 0),
+                     input(pn, reg, 1),
+                     bias.isNone() ? at::Tensor() : bias.toTensor()));
+           }},
+          {"aten::relu(Tensor self) -> Tensor",
+           [](const ProcessedNode& pn, IValue* reg) {
+             setOutput(pn, reg, at::relu(input(pn, reg, 0)));
+           }},
+          {"aten::sigmoid(Tensor self) -> Tensor",
+           [](const ProcessedNode& pn, IValue* reg) {
+             setOutput(pn, reg, at::sigmoid(input(pn, reg, 0)));
+           }},
+          {"aten::tanh(Tensor self) -> Tensor",
+           [](const ProcessedNode& pn, IValue* reg) {
+             setOutput(pn, reg, at::tanh(input(pn, reg, 0)));
+           }},
+      };
+  return kernels;
+}
+
+StaticRuntime::Kernel findKernel(const Node* node) {
+  for (const auto& entry : unboxedKernels()) {
+    if (node->matches(entry.first)) {
+      return entry.second;
+    }
+  }
+  return nullptr;
+}
+
+std::shared_ptr<Graph> prepareModule(const Module& module) {
+  TORCH_CHECK(
+      !module.hasattr("training") || !module.is_training(),
+      "StaticRuntime expects a module in eval mode");
+  Module frozen = freeze_module(module);
+  auto graph = frozen.get_method("forward").graph()->copy();
+  // Freezing turned every attribute access into a constant, so `self`
+  // should be dead once the method calls are inlined.
+  Inline(*graph);
+  EliminateDeadCode(graph);
+  TORCH_CHECK(
+      !graph->inputs().at(0)->hasUses(),
+      "StaticRuntime could not remove all uses of self from forward");
+  graph->eraseInput(0);
+  return graph;
+}
+
+} // namespace
+
+StaticRuntime::StaticRuntime(const Module& module, StaticRuntimeOptions opts)
+    : StaticRuntime(prepareModule(module), opts) {}
+
+StaticRuntime::StaticRuntime(
+    std::shared_ptr<Graph> graph,
+    StaticRuntimeOptions opts)
+    : graph_(std::move(graph)), opts_(opts) {
+  init();
+}
+
+void StaticRuntime::init() {
+  Inline(*graph_);
+  ConstantPropagation(graph_);
+  LowerAllTuples(graph_);
+  EliminateDeadCode(graph_);
+  if (opts_.plan_memory) {
+    auto unplanned = graph_->copy();
+    // prim::If is not supported here, so run() checks the inputs itself.
+    if (PlanMemory(graph_, /*guard_inputs=*/false).planned_values > 0) {
+      for (Value* v : graph_->inputs()) {
+        auto type = v->type()->expect<TensorType>();
+        planned_inputs_.push_back({*type->scalarType(),
+                                   *type->device(),
+                                   *type->sizes().concrete_sizes(),
+                                   *type->strides().concrete_sizes()});
+      }
+      StaticRuntimeOptions unplanned_opts = opts_;
+      unplanned_opts.plan_memory = false;
+      unplanned_ =
+          std::make_unique<StaticRuntime>(std::move(unplanned), unplanned_opts);
+    }
+  }
+
+  for (Value* v : graph_->inputs()) {
+    TORCH_CHECK(
+        v->type()->isSubtypeOf(TensorType::get()),
+        "StaticRuntime only supports Tensor inputs, got ",
+        v->type()->str());
+  }
+  for (Value* v : graph_->outputs()) {
+    TORCH_CHECK(
+        v->type()->isSubtypeOf(TensorType::get()),
+        "StaticRuntime only supports Tensor outputs, got ",
+        v->type()->str());
+  }
+
+  std::unordered_map<const Value*, size_t> reg_of;
+  auto assign = [&](const Value* v) {
+    reg_of[v] = registers_.size();
+    registers_.emplace_back();
+    return reg_of[v];
+  };
+
+  for (Value* v : graph_->inputs()) {
+    input_regs_.push_back(assign(v));
+  }
+  // Constants are materialized once and stay in their registers.
+  std::unordered_set<const Value*> constants;
+  for (Node* n : graph_->nodes()) {
+    TORCH_CHECK(
+        n->blocks().empty(),
+        "StaticRuntime does not support control flow, found ",
+        n->kind().toQualString());
+    if (n->kind() == prim::Constant) {
+      auto ivalue = toIValue(n->output());
+      TORCH_CHECK(ivalue, "StaticRuntime cannot materialize constant ", *n);
+      registers_[assign(n->output())] = std::move(*ivalue);
+      constants.insert(n->output());
+      continue;
+    }
+    ProcessedNode pn;
+    pn.node = n;
+    for (Value* v : n->inputs()) {
+      pn.inputs.push_back(reg_of.at(v));
+    }
+    for (Value* v : n->outputs()) {
+      pn.outputs.push_back(assign(v));
+    }
+    pn.kernel = findKernel(n);
+    if (!pn.kernel) {
+      pn.op = n->getOperation();
+    }
+    nodes_.push_back(std::move(pn));
+  }
+
+  std::unordered_map<const Value*, size_t> last_use;
+  for (size_t i = 0; i < nodes_.size(); ++i) {
+    Node* n = nodes_[i].node;
+    for (Value* v : n->inputs()) {
+      last_use[v] = i;
+    }
+    for (Value* v : n->outputs()) {
+      last_use.emplace(v, i);
+    }
+  }
+  std::unordered_set<const Value*> io(
+      graph_->inputs().begin(), graph_->inputs().end());
+  for (Value* v : graph_->outputs()) {
+    output_regs_.push_back(reg_of.at(v));
+    io.insert(v);
+  }
+  for (const auto& entry : last_use) {
+    if (!io.count(entry.first) && !constants.count(entry.first)) {
+      nodes_[entry.second].dead_after.push_back(reg_of.at(entry.first));
+    }
+  }
+  for (const Value* v : io) {
+    if (!constants.count(v)) {
+      clear_after_run_.push_back(reg_of.at(v));
+    }
+  }
+}
+
+bool StaticRuntime::matchesPlan(const std::vector<at::Tensor>& inputs) const {
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    const at::Tensor& t = inputs[i];
+    const PlannedInput& expected = planned_inputs_[i];
+    if (!t.defined() || t.scalar_type() != expected.dtype ||
+        t.device() != expected.device || !t.sizes().equals(expected.sizes) ||
+        !t.strides().equals(expected.strides)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::vector<at::Tensor> StaticRuntime::run(
+    const std::vector<at::Tensor>& inputs) {
+  TORCH_CHECK(
+      inputs.size() == input_regs_.size(),
+      "Expected ",
+      input_regs_.size(),
+      " inputs, got ",
+      inputs.size());
+  if (unplanned_ && !matchesPlan(inputs)) {
+    return unplanned_->run(inputs);
+  }
+  at::NoGradGuard no_grad;
+  IValue* reg = registers_.data();
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    reg[input_regs_[i]] = inputs[i];
+  }
+
+  for (const ProcessedNode& pn : nodes_) {
+    if (pn.kernel) {
+      pn.kernel(pn, reg);
+    } else {
+      stack_.clear();
+      for (size_t i : pn.inputs) {
+        stack_.push_back(reg[i]);
+      }
+      pn.op(stack_);
+      TORCH_INTERNAL_ASSERT(stack_.size() == pn.outputs.size());
+      for (size_t i = 0; i < pn.outputs.size(); ++i) {
+        reg[pn.outputs[i]] = std::move(stack_[i]);
+      }
+    }
+    for (size_t i : pn.dead_after) {
+      reg[i] = IValue();
+    }
+  }
+
+  std::vector<at::Tensor> outputs;
+  outputs.reserve(output_regs_.size());
+  for (size_t i : output_regs_) {
+    outputs.push_back(reg[i].toTensor());
+  }
+  for (size_t i : clear_after_run_) {
+    reg[i] = IValue();
+  }
+  stack_.clear();
+  return outputs;
+}
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <ATen/core/ivalue.h>
+#include <ATen/core/stack.h>
+#include <torch/csrc/WindowsTorchApiMacro.h>
+#include <torch/csrc/jit/api/module.h>
+#include <torch/csrc/jit/ir/ir.h>
+
+#include <memory>
+#include <vector>
+
+namespace torch {
+namespace jit {
+
+struct TORCH_API StaticRuntimeOptions {
+  // Run PlanMemory on the graph. This only has an effect when the inputs of
+  // the graph have complete types (e.g. from profiling). Inputs that do not
+  // match these types run an unplanned copy of the graph.
+  bool plan_memory = false;
+};
+
+// A minimal runtime for inference-only graphs without control flow.
+//
+// Unlike the interpreter it does not decode instructions or manage frames:
+// the graph is flattened once into a list of nodes whose inputs and outputs
+// are indices into a register file of IValues that is reused across runs.
+// Common ops are called through unboxed kernels picked at construction time,
+// everything else goes through its pre-resolved Operation with a reused
+// Stack. Registers are cleared after their last use, so intermediates do not
+// outlive a run.
+//
+// A StaticRuntime is not thread-safe; use one instance per thread.
+class TORCH_API StaticRuntime {
+ public:
+  // `module` must be in eval mode. It is frozen, and its forward method is
+  // inlined into a single graph.
+  explicit StaticRuntime(
+      const Module& module,
+      StaticRuntimeOptions opts = StaticRuntimeOptions());
+  // `graph` must take and return only Tensors.
+  explicit StaticRuntime(
+      std::shared_ptr<Graph> graph,
+      StaticRuntimeOptions opts = StaticRuntimeOptions());
+
+  std::vector<at::Tensor> run(const std::vector<at::Tensor>& inputs);
+
+  const std::shared_ptr<Graph>& graph() const {
+    return graph_;
+  }
+
+  struct ProcessedNode;
+  using Kernel = void (*)(const ProcessedNode&, IValue* registers);
+
+  struct ProcessedNode {
+    Node* node;
+    std::vector<size_t> inputs;
+    std::vector<size_t> outputs;
+    // Registers whose last use is this node.
+    std::vector<size_t> dead_after;
+    // Unboxed kernel, if one exists for this node's schema.
+    Kernel kernel;
+    // Boxed fallback.
+    Operation op;
+  };
+
+ private:
+  void init();
+  bool matchesPlan(const std::vector<at::Tensor>& inputs) const;
+
+  // The types of the inputs that the memory plan was made for.
+  struct PlannedInput {
+    at::ScalarType dtype;
+    at::Device device;
+    std::vector<int64_t> sizes;
+    std::vector<int64_t> strides;
+  };
+
+  std::shared_ptr<Graph> graph_;
+  StaticRuntimeOptions opts_;
+  std::vector<ProcessedNode> nodes_;
+  std::vector<size_t> input_regs_;
+  std::vector<size_t> output_regs_;
+  // Input and output registers, which are cleared at the end of a run rather
+  // than after their last use.
+  std::vector<size_t> clear_after_run_;
+  std::vector<IValue> registers_;
+  Stack stack_;
+  // Set when memory was planned.
+  std::vector<PlannedInput> planned_inputs_;
+  std::unique_ptr<StaticRuntime> unplanned_;
+};
+
+} // namespace jit
+} // namespace torch
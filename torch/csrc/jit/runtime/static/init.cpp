@@ -0,0 +1,26 @@
+#include <torch/csrc/jit/runtime/static/init.h>
+#include <torch/csrc/jit/runtime/static/impl.h>
+
+namespace torch {
+namespace jit {
+
+void initStaticRuntimeBindings(PyObject* module) {
+  auto m = py::handle(module).cast<py::module>();
+  py::class_<StaticRuntime>(m, "StaticRuntime")
+      .def(
+          "run",
+          &StaticRuntime::run,
+          py::call_guard<py::gil_scoped_release>())
+      .def_property_readonly("graph", &StaticRuntime::graph);
+  m.def(
+       "_jit_to_static_runtime",
+       [](const std::shared_ptr<Graph>& g) {
+         return StaticRuntime(g->copy());
+       })
+      .def("_jit_to_static_runtime", [](const Module& module) {
+        return StaticRuntime(module);
+      });
+}
+
+} // namespace jit
+} // namespace torch
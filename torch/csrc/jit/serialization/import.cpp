@@ -18,11 +18,19 @@
 #include <caffe2/serialize/istream_adapter.h>
 
 #include <ATen/ATen.h>
+#include <ATen/Parallel.h>
+#include <ATen/core/grad_mode.h>
+#include <c10/util/numa.h>
 #include <fmt/format.h>
 
+#include <condition_variable>
+#include <cstring>
+#include <exception>
 #include <fstream>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace torch {
@@ -55,6 +63,105 @@ void postSetStateValidate(const IValue& v) {
   }
 }
 
+namespace {
+
+// Reads every record under an archive's directory (the tensor data) with
+// PyTorchStreamReader::getRecords, in an inter-op task, while the archive's
+// pickle is being parsed. The unpickler then takes the records it needs from
+// here. Whichever of the task and the first take() gets to the records first
+// reads them, so loading never waits on a busy inter-op pool.
+class RecordPrefetch {
+ public:
+  RecordPrefetch(PyTorchStreamReader& reader, std::string prefix)
+      : reader_(reader), prefix_(std::move(prefix)) {}
+
+  void run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (started_) {
+      return;
+    }
+    started_ = true;
+    lock.unlock();
+
+    std::vector<std::string> names;
+    std::unordered_map<std::string, at::DataPtr> records;
+    std::exception_ptr error;
+    try {
+      for (const auto& record : reader_.getAllRecords()) {
+        // drop the archive's top-level directory
+        auto slash = record.find('/');
+        if (slash == std::string::npos) {
+          continue;
+        }
+        auto name = record.substr(slash + 1);
+        if (name.compare(0, prefix_.size(), prefix_) == 0) {
+          names.push_back(std::move(name));
+        }
+      }
+      auto results = reader_.getRecords(
+          names, [](std::function<void()> fn) { at::launch(std::move(fn)); });
+      for (size_t i = 0; i < names.size(); ++i) {
+        records.emplace(
+            names[i].substr(prefix_.size()),
+            std::move(std::get<0>(results[i])));
+      }
+    } catch (...) {
+      // Reported by the next take(), so that loading fails where the
+      // records are needed.
+      error = std::current_exception();
+      records.clear();
+    }
+
+    lock.lock();
+    records_ = std::move(records);
+    error_ = error;
+    done_ = true;
+    cv_.notify_all();
+  }
+
+  void wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!started_) {
+      // Nothing was read yet; make the pending task a no-op.
+      started_ = true;
+      done_ = true;
+      return;
+    }
+    cv_.wait(lock, [this] { return done_; });
+  }
+
+  // Returns the record `name` (relative to the prefix) if it was prefetched
+  // and has not been taken yet, and an empty DataPtr otherwise. Rethrows the
+  // error of the prefetch, e.g. a failed read or CRC-32 check.
+  at::DataPtr take(const std::string& name) {
+    run();
+    wait();
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (error_) {
+      std::rethrow_exception(error_);
+    }
+    auto it = records_.find(name);
+    if (it == records_.end()) {
+      return at::DataPtr();
+    }
+    at::DataPtr data_ptr = std::move(it->second);
+    records_.erase(it);
+    return data_ptr;
+  }
+
+ private:
+  PyTorchStreamReader& reader_;
+  std::string prefix_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool started_ = false;
+  bool done_ = false;
+  std::unordered_map<std::string, at::DataPtr> records_;
+  std::exception_ptr error_;
+};
+
+} // namespace
+
 IValue readArchiveAndTensors(
     const std::string& archive_name,
     c10::optional<TypeResolver> type_resolver,
@@ -81,7 +188,14 @@ IValue readArchiveAndTensors(
   };
 
   std::string archive_name_plus_slash = archive_name + "/";
+  auto prefetch = std::make_shared<RecordPrefetch>(
+      stream_reader, archive_name_plus_slash);
+  at::launch([prefetch] { prefetch->run(); });
+
   auto read_record = [&](const std::string& name) {
+    if (auto data_ptr = prefetch->take(name)) {
+      return data_ptr;
+    }
     std::string ss = archive_name_plus_slash + name;
     return std::get<0>(stream_reader.getRecord(ss));
   };
@@ -93,7 +207,15 @@ IValue readArchiveAndTensors(
       std::move(read_record),
       device);
   unpickler.set_version(stream_reader.version());
-  return unpickler.parse_ivalue();
+  // The prefetch has to be finished before the reader can go away.
+  try {
+    auto result = unpickler.parse_ivalue();
+    prefetch->wait();
+    return result;
+  } catch (...) {
+    prefetch->wait();
+    throw;
+  }
 }
 
 namespace {
@@ -353,5 +475,69 @@ Module load(
   return deserializer.deserialize(device, extra_files);
 }
 
+void placeOnNUMANodes(
+    Module& module,
+    const std::function<int(const std::string&)>& numa_node_for) {
+  if (!c10::IsNUMAEnabled()) {
+    return;
+  }
+  // Each storage is copied once, to the node of the first name that reaches
+  // it, so that tied weights and views keep sharing memory. Tensors reachable
+  // under several names are rebound once.
+  std::unordered_map<c10::StorageImpl*, c10::Storage> placed_storages;
+  std::unordered_set<c10::TensorImpl*> placed;
+  // Keeps the keys of placed_storages from being reused by new storages.
+  std::vector<c10::Storage> originals;
+  auto place = [&](const std::string& name, const at::Tensor& tensor) {
+    if (!tensor.defined() || !tensor.device().is_cpu() ||
+        tensor.layout() != at::kStrided || !tensor.has_storage() ||
+        !placed.insert(tensor.unsafeGetTensorImpl()).second) {
+      return;
+    }
+    const c10::Storage& storage = tensor.storage();
+    auto it = placed_storages.find(storage.unsafeGetStorageImpl());
+    if (it == placed_storages.end()) {
+      originals.push_back(storage);
+      int numa_node_id = numa_node_for(name);
+      if (numa_node_id < 0) {
+        // An empty storage marks the ones left in place.
+        placed_storages.emplace(storage.unsafeGetStorageImpl(), c10::Storage());
+        return;
+      }
+      // Copy rather than move the pages in place: the storage may alias a
+      // memory-mapped archive.
+      c10::Storage copy;
+      {
+        c10::NUMAPlacementGuard guard(numa_node_id);
+        copy = c10::Storage(
+            c10::Storage::use_byte_size_t(),
+            storage.nbytes(),
+            at::getCPUAllocator(),
+            /*resizable=*/true);
+      }
+      if (storage.nbytes() > 0) {
+        std::memcpy(copy.data(), storage.data(), storage.nbytes());
+        // The allocator may have handed out recycled memory placed elsewhere.
+        c10::NUMAMove(copy.data(), copy.nbytes(), numa_node_id);
+      }
+      it = placed_storages.emplace(storage.unsafeGetStorageImpl(), copy).first;
+    }
+    if (!it->second) {
+      return;
+    }
+    at::NoGradGuard no_grad;
+    at::Tensor view = at::empty({0}, tensor.options());
+    view.set_(
+        it->second, tensor.storage_offset(), tensor.sizes(), tensor.strides());
+    tensor.set_data(view);
+  };
+  for (const auto& p : module.named_parameters(/*recurse=*/true)) {
+    place(p.name, p.value);
+  }
+  for (const auto& b : module.named_buffers(/*recurse=*/true)) {
+    place(b.name, b.value);
+  }
+}
+
 } // namespace jit
 } // namespace torch
@@ -60,11 +60,25 @@ TORCH_API Module load(
 /// The reader adapter, which is for customized input stream, must contain a
 /// serialized `Module`, exported either via `ScriptModule.save()` in
 /// Python or `torch::jit::ExportModule` in C++.
+///
+/// Passing a `caffe2::serialize::MMapAdapter` maps the file instead of
+/// reading it: CPU tensors are then built on top of the mapping, and their
+/// pages are shared through the page cache by every process that loads the
+/// same file. The file must not be modified while the module is in use.
 TORCH_API Module load(
     std::unique_ptr<caffe2::serialize::ReadAdapterInterface> rai,
     c10::optional<c10::Device> device = c10::nullopt,
     ExtraFilesMap& extra_files = default_extra_files);
 
+/// Copies the CPU parameters and buffers of `module` into memory on the NUMA
+/// node returned by `numa_node_for` for their fully qualified name (e.g.
+/// "encoder.fc.weight"), typically the node of the threads that will run the
+/// code using them. Names mapped to -1 are left in place. Does nothing unless
+/// NUMA support is enabled.
+TORCH_API void placeOnNUMANodes(
+    Module& module,
+    const std::function<int(const std::string&)>& numa_node_for);
+
 TORCH_API IValue readArchiveAndTensors(
     const std::string& archive_name,
     c10::optional<TypeResolver> type_resolver,
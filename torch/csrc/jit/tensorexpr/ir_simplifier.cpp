@@ -1086,7 +1086,8 @@ Stmt* IRSimplifierBase::mutate(const For* v) {
 
   const Expr* loops = new Sub(stop_new, start_new);
   loops = loops->accept_mutator(this);
-  if (loop_options.isDefault() && loops->isConstant()) {
+  if (!loop_options.is_gpu_block_index() &&
+      !loop_options.is_gpu_thread_index() && loops->isConstant()) {
     if (immediateEquals(loops, 0)) {
       return new Block({});
     } else if (immediateEquals(loops, 1)) {
@@ -17,6 +17,7 @@ namespace tensorexpr {
 static int te_cuda_pointwise_loop_levels = -1;
 static int te_cuda_pointwise_block_count = -1;
 static int te_cuda_pointwise_block_size = -1;
+static bool te_cpu_parallel = true;
 static bool fallback_allowed = true;
 
 bool setFallbackAllowed(bool value) {
@@ -48,6 +49,53 @@ int& getTECudaPointwiseBlockSize() {
   return te_cuda_pointwise_block_size;
 }
 
+bool& getTECPUParallel() {
+  return te_cpu_parallel;
+}
+
+// Find the outer-most For loops of STMT.
+static std::vector<For*> findOuterLoops(Stmt* stmt) {
+  std::vector<For*> loops;
+  if (For* rootF = dynamic_cast<For*>(stmt)) {
+    loops.push_back(rootF);
+  } else if (Block* body = dynamic_cast<Block*>(stmt)) {
+    std::vector<Block*> blocks = {body};
+    while (blocks.size()) {
+      Block* b = blocks.back();
+      blocks.pop_back();
+
+      for (Stmt* s : *b) {
+        if (For* f = dynamic_cast<For*>(s)) {
+          loops.push_back(f);
+        } else if (Block* b2 = dynamic_cast<Block*>(s)) {
+          blocks.push_back(b2);
+        }
+      }
+    }
+  }
+  return loops;
+}
+
+// Iterations of F are independent if every store in it writes an element
+// indexed by F's variable. A loop accumulating into the same element, like
+// the one of a reduction to a scalar, has to stay serial.
+static bool isParallelizable(For* f) {
+  for (Store* store : NodeFinder<Store>::find(f)) {
+    bool indexed_by_loop_var = false;
+    for (const Expr* index : store->indices()) {
+      NodeFinder<Var> finder;
+      index->accept(&finder);
+      for (Var* var : finder.nodes) {
+        indexed_by_loop_var |= var == f->var();
+      }
+    }
+    if (!indexed_by_loop_var) {
+      return false;
+    }
+  }
+  return true;
+}
+
 } // namespace tensorexpr
 } // namespace jit
 } // namespace torch
@@ -79,6 +127,62 @@ static std::vector<DimArg> texprDims(const torch::jit::Value* v) {
   return dimArgs;
 }
 
+// Returns the dimensions reduced by the `int dim` or `int[] dim` argument
+// DIMS of a reduction of a tensor of rank RANK, wrapped into [0, rank). A null
+// DIMS or an empty list reduces all the dimensions.
+static std::vector<size_t> reductionDims(
+    const torch::jit::Value* dims,
+    size_t rank) {
+  std::vector<int64_t> dimsList;
+  if (dims && dims->node()->kind() == prim::ListConstruct) {
+    for (auto const& d : dims->node()->inputs()) {
+      auto const& val = toIValue(d);
+      if (!val || !val->isInt()) {
+        throw malformed_input("reduction dimension is not a constant int");
+      }
+      dimsList.push_back(val->toInt());
+    }
+  } else if (dims) {
+    auto const& val = toIValue(dims);
+    if (val && val->isInt()) {
+      dimsList.push_back(val->toInt());
+    } else if (val && val->isIntList()) {
+      dimsList = val->toIntVector();
+    } else {
+      throw malformed_input("reduction dimensions are not constant ints");
+    }
+  }
+
+  std::vector<size_t> result;
+  if (dimsList.empty()) {
+    for (size_t i = 0; i < rank; i++) {
+      result.push_back(i);
+    }
+    return result;
+  }
+  for (int64_t d : dimsList) {
+    if (d < 0) {
+      d += rank;
+    }
+    if (d < 0 || d >= static_cast<int64_t>(rank)) {
+      throw malformed_input("reduction dimension out of range");
+    }
+    result.push_back(d);
+  }
+  return result;
+}
+
+// The initial value of a max reduction. Maximum(Dtype) starts from
+// numeric_limits::min(), which is the smallest positive floating point value,
+// not the lowest one.
+static ExprHandle lowestValue(at::ScalarType type) {
+  if (!c10::isFloatingType(type)) {
+    throw unsupported_dtype();
+  }
+  // The initializer is cast to the type of the reduction.
+  return ExprHandle(-std::numeric_limits<float>::infinity());
+}
+
 template <typename T>
 int64_t bufferSize(T t) {
   int64_t size = 1;
@@ -413,6 +517,109 @@ Tensor* TensorExprKernel::computeFourOperand(
       });
 }
 
+Tensor* TensorExprKernel::computeReduction(
+    const std::string& name,
+    const std::vector<ExprHandle>& inputShape,
+    const std::vector<size_t>& reduceDims,
+    bool keepdim,
+    const Reducer& reducer,
+    const std::function<ExprHandle(const std::vector<ExprHandle>&)>& body) {
+  hasReduction_ = true;
+
+  std::vector<bool> reduced(inputShape.size(), false);
+  for (size_t d : reduceDims) {
+    reduced[d] = true;
+  }
+
+  std::vector<DimArg> outputDims;
+  std::vector<DimArg> reduceArgs;
+  for (size_t i = 0; i < inputShape.size(); i++) {
+    if (!reduced[i]) {
+      outputDims.emplace_back(inputShape[i], "i" + c10::to_string(i));
+      continue;
+    }
+    reduceArgs.emplace_back(inputShape[i], "r" + c10::to_string(i));
+    if (keepdim) {
+      outputDims.emplace_back(IntImm::make(1), "i" + c10::to_string(i));
+    }
+  }
+
+  // The reduction passes the output axes followed by the reduction axes; put
+  // them back in the order of the input dimensions.
+  size_t outputRank = outputDims.size();
+  std::function<ExprHandle(ParameterList&)> reduceBody =
+      [reduced, keepdim, outputRank, body](ParameterList& vars) {
+        std::vector<ExprHandle> inputAxes;
+        size_t outputIdx = 0;
+        size_t reduceIdx = outputRank;
+        for (bool r : reduced) {
+          if (!r) {
+            inputAxes.push_back(vars[outputIdx++]);
+            continue;
+          }
+          inputAxes.push_back(vars[reduceIdx++]);
+          if (keepdim) {
+            // Skip the size 1 output axis.
+            outputIdx++;
+          }
+        }
+        return body(inputAxes);
+      };
+  return Reduce(name, outputDims, reducer, reduceBody, reduceArgs);
+}
+
+Tensor* TensorExprKernel::computeSoftmax(
+    const torch::jit::Value* v,
+    bool logSoftmax) {
+  // softmax(x) = exp(x - max(x)) / sum(exp(x - max(x))), and
+  // log_softmax(x) = (x - max(x)) - log(sum(exp(x - max(x)))),
+  // where max and sum reduce the softmax dimension. Subtracting the max keeps
+  // exp from overflowing.
+  auto const& n = v->node();
+  auto const& inputShape = valueShape(n->inputs()[0]);
+  auto const& dims = reductionDims(n->inputs()[1], inputShape.size());
+  size_t dim = dims[0];
+  auto inputType = *n->inputs()[0]->type()->cast<TensorType>()->scalarType();
+
+  auto input = [this, n](const std::vector<ExprHandle>& axes) {
+    return tensorOrConstant(n->inputs()[0], axes);
+  };
+  // Indices of the keepdim reductions, which have size 1 along DIM.
+  auto reducedAxes = [dim](std::vector<ExprHandle> axes) {
+    axes[dim] = IntImm::make(0);
+    return axes;
+  };
+
+  Tensor* max = computeReduction(
+      "aten_softmax_max",
+      inputShape,
+      {dim},
+      true,
+      Maximum(lowestValue(inputType)),
+      input);
+  Tensor* sum = computeReduction(
+      "aten_softmax_sum",
+      inputShape,
+      {dim},
+      true,
+      Sum(),
+      [input, reducedAxes, max](const std::vector<ExprHandle>& axes) {
+        return exp(input(axes) - max->call(reducedAxes(axes)));
+      });
+  return Compute(
+      logSoftmax ? "aten_log_softmax" : "aten_softmax",
+      c10::fmap<DimArg>(inputShape),
+      [this, v, logSoftmax, input, reducedAxes, max, sum](
+          const std::vector<VarHandle>& axes) {
+        std::vector<ExprHandle> indices(axes.begin(), axes.end());
+        ExprHandle shifted = input(indices) - max->call(reducedAxes(indices));
+        ExprHandle total = sum->call(reducedAxes(indices));
+        ExprHandle result =
+            logSoftmax ? shifted - log(total) : exp(shifted) / total;
+        return demoteOutput(result, v);
+      });
+}
+
 Tensor* TensorExprKernel::computeValue(const torch::jit::Value* v) {
   switch (v->node()->kind()) {
     case aten::add: {
@@ -551,12 +758,80 @@ Tensor* TensorExprKernel::computeValue(const torch::jit::Value* v) {
     } break;
 
     case aten::max: {
-      return computeTwoOperand(
-          "aten_max", v, [](const ExprHandle& lhs, const ExprHandle& rhs) {
-            return Max::make(lhs, rhs, false);
+      auto const& n = v->node();
+      if (n->inputs().size() == 2) {
+        return computeTwoOperand(
+            "aten_max", v, [](const ExprHandle& lhs, const ExprHandle& rhs) {
+              return Max::make(lhs, rhs, false);
+            });
+      }
+
+      // max(self) or the values of max.dim(self, dim, keepdim).
+      if (v->offset() != 0) {
+        throw std::runtime_error("max.dim indices are not supported");
+      }
+      auto const& inputShape = valueShape(n->inputs()[0]);
+      bool fullReduction = n->inputs().size() == 1;
+      auto const& reduceDims = reductionDims(
+          fullReduction ? nullptr : n->inputs()[1], inputShape.size());
+      bool keepdim = !fullReduction && toIValue(n->inputs()[2])->toBool();
+      auto inputType = *n->inputs()[0]->type()->cast<TensorType>()->scalarType();
+      return computeReduction(
+          "aten_max",
+          inputShape,
+          reduceDims,
+          keepdim,
+          Maximum(lowestValue(inputType)),
+          [this, n](const std::vector<ExprHandle>& axes) {
+            return tensorOrConstant(n->inputs()[0], axes);
+          });
+    } break;
+
+    case aten::sum:
+    case aten::mean: {
+      // sum(self, dtype) or sum.dim_IntList(self, dim, keepdim, dtype), and
+      // the same for mean. The fuser only lets through a None dtype.
+      auto const& n = v->node();
+      auto const& inputShape = valueShape(n->inputs()[0]);
+      bool fullReduction = n->inputs().size() == 2;
+      auto const& reduceDims = reductionDims(
+          fullReduction ? nullptr : n->inputs()[1], inputShape.size());
+      bool keepdim = !fullReduction && toIValue(n->inputs()[2])->toBool();
+      Tensor* sum = computeReduction(
+          "aten_sum",
+          inputShape,
+          reduceDims,
+          keepdim,
+          Sum(),
+          [this, n](const std::vector<ExprHandle>& axes) {
+            return tensorOrConstant(n->inputs()[0], axes);
+          });
+      if (n->kind() == aten::sum) {
+        return sum;
+      }
+
+      ExprHandle count = IntImm::make(1);
+      for (size_t d : reduceDims) {
+        count = count * inputShape[d];
+      }
+      return Compute(
+          "aten_mean",
+          c10::fmap<DimArg>(ExprVectorToExprHandleVector(sum->dims())),
+          [this, v, sum, count](const std::vector<VarHandle>& axes) {
+            std::vector<ExprHandle> inputs = {sum->call(axes), count};
+            promoteInputs(inputs);
+            return demoteOutput(inputs[0] / inputs[1], v);
           });
     } break;
 
+    case aten::softmax: {
+      return computeSoftmax(v, false);
+    } break;
+
+    case aten::log_softmax: {
+      return computeSoftmax(v, true);
+    } break;
+
     case aten::clamp: {
       bool noMin = false;
       bool noMax = false;
@@ -1028,6 +1303,11 @@ Stmt* TensorExprKernel::generateStmt(BackendType backendType) {
     if (!l.hasLoopBodyFor(p.second)) {
       continue;
     }
+    // Reductions are computed into their own buffer; inlining them would
+    // recompute the reduction for every use.
+    if (dynamic_cast<const ReduceOp*>(p.second->body())) {
+      continue;
+    }
     Stmt* loop = l.getLoopBodyFor(p.second);
     if (torch::jit::tensorexpr::HasRand(loop).has_rand()) {
       l.computeInlineWithRandom(loop);
@@ -1086,26 +1366,7 @@ Stmt* TensorExprKernel::generateStmt(BackendType backendType) {
 
   if (backendType == kLLVMCodeGen) {
     std::vector<For*> innerLoops;
-    std::vector<For*> worklist;
-
-    // Find outer-most For loops
-    if (For* rootF = dynamic_cast<For*>(l.root_stmt())) {
-      worklist.push_back(rootF);
-    } else if (Block* body = dynamic_cast<Block*>(l.root_stmt())) {
-      std::vector<Block*> blocks = {body};
-      while (blocks.size()) {
-        Block* b = blocks.back();
-        blocks.pop_back();
-
-        for (Stmt* s : *b) {
-          if (For* f = dynamic_cast<For*>(s)) {
-            worklist.push_back(f);
-          } else if (Block* b2 = dynamic_cast<Block*>(s)) {
-            blocks.push_back(b2);
-          }
-        }
-      }
-    }
+    std::vector<For*> worklist = findOuterLoops(l.root_stmt());
 
     // Traverse the For loop nest find inner-most loops, which are
     // vectorization candidates.
@@ -1128,8 +1389,12 @@ Stmt* TensorExprKernel::generateStmt(BackendType backendType) {
       }
     }
 
-    // vectorize inner loops.
+    // vectorize inner loops. Reduction loops store to the same element in
+    // every iteration, LLVM vectorizes them instead.
     for (For* loop : innerLoops) {
+      if (loop->loop_options().is_reduction()) {
+        continue;
+      }
       For* outer1;
       For* split1;
       For* tail1;
@@ -1147,6 +1412,16 @@ Stmt* TensorExprKernel::generateStmt(BackendType backendType) {
         l.vectorize(split2);
       }
     }
+
+    // Run the outer-most loops on the intra-op thread pool. The random number
+    // generator is not thread safe, so kernels using it stay serial.
+    if (getTECPUParallel() && !hasRandom_) {
+      for (For* loop : findOuterLoops(l.root_stmt())) {
+        if (isParallelizable(loop)) {
+          l.parallelize(loop);
+        }
+      }
+    }
   }
 
   Stmt* stmt = l.root_stmt();
@@ -1296,6 +1571,41 @@ TensorExprKernel::BackendType TensorExprKernel::inferBackendTypeFromDevice(
   return backendType;
 }
 
+// Returns the first dimension of the first tensor input of GRAPH, or 0 if it
+// has none.
+static int64_t graphBatchSize(const std::shared_ptr<Graph>& graph) {
+  for (const torch::jit::Value* input : graph->inputs()) {
+    auto tt = input->type()->cast<TensorType>();
+    if (tt && tt->sizes().size() && *tt->sizes().size() > 0) {
+      return tt->sizes()[0].value_or(0);
+    }
+  }
+  return 0;
+}
+
+bool TensorExprKernel::supportsSymbolicBatch(
+    const std::shared_ptr<Graph>& subgraph) {
+  if (graphBatchSize(subgraph) <= 1) {
+    return false;
+  }
+  for (const Node* n : subgraph->nodes()) {
+    switch (n->kind()) {
+      case aten::sum:
+      case aten::mean:
+      case aten::softmax:
+      case aten::log_softmax:
+      case prim::ConstantChunk:
+      case aten::cat:
+      case aten::slice:
+      case aten::unsqueeze:
+        return false;
+      default:
+        break;
+    }
+  }
+  return true;
+}
+
 void TensorExprKernel::bindInput(const torch::jit::Value* input) {
   auto const& t = input->type();
   switch (t->kind()) {
@@ -1306,8 +1616,18 @@ void TensorExprKernel::bindInput(const torch::jit::Value* input) {
           ToDtype(static_cast<ScalarType>(*tt->scalarType())),
           {0});
       std::vector<DimArg> inputTensorDims;
+      std::vector<ShapeArg> sizeArgs;
       for (size_t i = 0; i < *tt->sizes().size(); i++) {
         auto const size = *tt->sizes()[i];
+        if (i == 0 && symbolicBatch_ && size == batch_) {
+          // The first batched input passes the batch size to the kernel.
+          if (!batchVar_.node()) {
+            batchVar_ = VarHandle("batch", kInt);
+            sizeArgs.emplace_back(0, batchVar_);
+          }
+          inputTensorDims.emplace_back(DimArg(batchVar_, "i0"));
+          continue;
+        }
         inputTensorDims.emplace_back(
             DimArg(IntImm::make(size), "i" + c10::to_string(i)));
       }
@@ -1325,7 +1645,7 @@ void TensorExprKernel::bindInput(const torch::jit::Value* input) {
                 return inBuffer(idx);
               }));
       kernelArgs_.emplace_back(
-          inBuffer, std::vector<ShapeArg>(), std::vector<ShapeArg>());
+          inBuffer, std::move(sizeArgs), std::vector<ShapeArg>());
       break;
     }
     case TypeKind::FloatType: {
@@ -1358,6 +1678,10 @@ void TensorExprKernel::compile() {
 
   // Bind inputs to buffers.
   nInputs_ = graph_->inputs().size();
+  if (symbolicBatch_) {
+    TORCH_INTERNAL_ASSERT(supportsSymbolicBatch(graph_));
+    batch_ = graphBatchSize(graph_);
+  }
   for (auto const& input : graph_->inputs()) {
     bindInput(input);
     inputTypes_.push_back(input->type());
@@ -1391,6 +1715,9 @@ void TensorExprKernel::compile() {
 
   device_ = pickDeviceType(graph_->inputs());
   BackendType backendType = inferBackendTypeFromDevice(device_);
+  if (hasReduction_ && backendType == kCudaCodeGen) {
+    throw std::runtime_error("Reductions are only supported on CPU");
+  }
   Stmt* stmt = generateStmt(backendType);
 
   // Set up formal params (inputs, then outputs) for kernel.
@@ -1400,8 +1727,10 @@ void TensorExprKernel::compile() {
   codegen_ = CreateCodeGen(getCodeGenName(backendType), stmt, params, device_);
 }
 
-TensorExprKernel::TensorExprKernel(const std::shared_ptr<Graph>& subgraph)
-    : graph_(subgraph), code_(subgraph, "") {
+TensorExprKernel::TensorExprKernel(
+    const std::shared_ptr<Graph>& subgraph,
+    bool symbolicBatch)
+    : graph_(subgraph), code_(subgraph, ""), symbolicBatch_(symbolicBatch) {
   if (!fallbackAllowed()) {
     compile();
     return;
@@ -44,7 +44,19 @@ inline std::vector<ExprHandle> computeIndicesToBroadcast(
 
 class TORCH_API TensorExprKernel {
  public:
-  explicit TensorExprKernel(const std::shared_ptr<Graph>& subgraph);
+  // With SYMBOLIC_BATCH, the first dimension of the tensor inputs whose size
+  // is the batch size of the subgraph (see supportsSymbolicBatch) is a
+  // runtime argument of the kernel, so that it runs inputs of any batch size.
+  explicit TensorExprKernel(
+      const std::shared_ptr<Graph>& subgraph,
+      bool symbolicBatch = false);
+
+  // Whether the kernel of SUBGRAPH can be compiled with a symbolic batch
+  // size. The batch size is the first dimension of the first tensor input,
+  // and the tensor inputs with the same first dimension are batched. It must
+  // be greater than 1, and all the nodes must be elementwise: the other ops
+  // are lowered with the shapes of their types.
+  static bool supportsSymbolicBatch(const std::shared_ptr<Graph>& subgraph);
 
   void run(Stack& stack);
 
@@ -52,6 +64,16 @@ class TORCH_API TensorExprKernel {
     InterpreterState(code_).run(stack);
   }
 
+  // Whether run() executes the graph in the interpreter, because the kernel
+  // failed to compile or run.
+  bool usesFallback() const {
+    return fallback_;
+  }
+
+  bool usesSymbolicBatch() const {
+    return symbolicBatch_;
+  }
+
   Stmt* getCodeGenStmt();
 
  private:
@@ -153,6 +175,18 @@ class TORCH_API TensorExprKernel {
           const ExprHandle&,
           const ExprHandle&)>& innerExpr);
 
+  // Reduces the dimensions reduceDims of a tensor of shape inputShape. body
+  // returns the value to reduce at the given input indices.
+  Tensor* computeReduction(
+      const std::string& name,
+      const std::vector<ExprHandle>& inputShape,
+      const std::vector<size_t>& reduceDims,
+      bool keepdim,
+      const Reducer& reducer,
+      const std::function<ExprHandle(const std::vector<ExprHandle>&)>& body);
+
+  Tensor* computeSoftmax(const torch::jit::Value* v, bool logSoftmax);
+
   Tensor* computeValue(const torch::jit::Value* v);
 
   void flattenTensors(BackendType backendType);
@@ -217,13 +251,19 @@ class TORCH_API TensorExprKernel {
   std::shared_ptr<Graph> graph_;
   Code code_;
   bool fallback_{false};
+  bool symbolicBatch_{false};
+  // The first dimension of the batched inputs, when symbolicBatch_
+  int64_t batch_ = 0;
+  VarHandle batchVar_;
   bool hasRandom_{false};
   bool hasBroadcast_{false};
+  bool hasReduction_{false};
 };
 
 TORCH_API int& getTECudaPointwiseLoopLevels();
 TORCH_API int& getTECudaPointwiseBlockCount();
 TORCH_API int& getTECudaPointwiseBlockSize();
+TORCH_API bool& getTECPUParallel();
 TORCH_API bool fallbackAllowed();
 TORCH_API bool setFallbackAllowed(bool value);
 
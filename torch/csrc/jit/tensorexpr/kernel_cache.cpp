@@ -0,0 +1,308 @@
+#include <torch/csrc/jit/tensorexpr/kernel_cache.h>
+
+#include <torch/csrc/jit/jit_log.h>
+#include <torch/csrc/jit/passes/shape_analysis.h>
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <unordered_map>
+
+namespace torch {
+namespace jit {
+namespace tensorexpr {
+
+static int te_kernel_cache_size = 8;
+static std::atomic<uint64_t> kernel_cache_hits{0};
+static std::atomic<uint64_t> kernel_cache_compiles{0};
+static std::atomic<uint64_t> kernel_cache_fallbacks{0};
+
+int& getTEKernelCacheSize() {
+  return te_kernel_cache_size;
+}
+
+KernelCacheStats getKernelCacheStats() {
+  KernelCacheStats stats;
+  stats.hits = kernel_cache_hits;
+  stats.compiles = kernel_cache_compiles;
+  stats.fallbacks = kernel_cache_fallbacks;
+  return stats;
+}
+
+void resetKernelCacheStats() {
+  kernel_cache_hits = 0;
+  kernel_cache_compiles = 0;
+  kernel_cache_fallbacks = 0;
+}
+
+// Kernels are specialized on these properties of each tensor input.
+static void appendKey(
+    std::vector<int64_t>& key,
+    at::ScalarType dtype,
+    at::Device device,
+    at::IntArrayRef sizes,
+    at::IntArrayRef strides) {
+  key.push_back(static_cast<int64_t>(dtype));
+  key.push_back(static_cast<int64_t>(device.type()));
+  key.push_back(device.index());
+  key.push_back(sizes.size());
+  key.insert(key.end(), sizes.begin(), sizes.end());
+  key.insert(key.end(), strides.begin(), strides.end());
+}
+
+// Returns the key of the input types of GRAPH, if they are all complete.
+static c10::optional<std::vector<int64_t>> graphKey(
+    const std::shared_ptr<Graph>& graph) {
+  std::vector<int64_t> key;
+  for (const Value* input : graph->inputs()) {
+    auto const& tt = input->type()->cast<TensorType>();
+    if (!tt) {
+      key.push_back(-1);
+      continue;
+    }
+    if (!tt->isComplete()) {
+      return c10::nullopt;
+    }
+    appendKey(
+        key,
+        *tt->scalarType(),
+        *tt->device(),
+        *tt->sizes().concrete_sizes(),
+        *tt->strides().concrete_sizes());
+  }
+  return key;
+}
+
+static std::vector<int64_t> inputsKey(const at::ArrayRef<IValue>& inputs) {
+  std::vector<int64_t> key;
+  for (const IValue& input : inputs) {
+    if (!input.isTensor()) {
+      key.push_back(-1);
+      continue;
+    }
+    auto const& t = input.toTensor();
+    appendKey(key, t.scalar_type(), t.device(), t.sizes(), t.strides());
+  }
+  return key;
+}
+
+// Returns the first dimension of the first tensor input, which is the batch
+// size of TensorExprKernel::supportsSymbolicBatch, or 0 if there is none.
+static int64_t batchSize(const at::ArrayRef<IValue>& inputs) {
+  for (const IValue& input : inputs) {
+    if (input.isTensor() && input.toTensor().dim() > 0) {
+      return input.toTensor().size(0);
+    }
+  }
+  return 0;
+}
+
+// Returns the key of the kernels with a symbolic batch size that can run
+// INPUTS: the key of their types without the first dimension of the batched
+// inputs.
+static c10::optional<std::vector<int64_t>> batchKey(
+    const at::ArrayRef<IValue>& inputs) {
+  int64_t batch = batchSize(inputs);
+  if (batch <= 1) {
+    return c10::nullopt;
+  }
+  // Tells these keys apart from the ones of inputsKey.
+  std::vector<int64_t> key = {-2};
+  for (const IValue& input : inputs) {
+    if (!input.isTensor()) {
+      key.push_back(-1);
+      continue;
+    }
+    auto const& t = input.toTensor();
+    std::vector<int64_t> sizes = t.sizes().vec();
+    if (!sizes.empty() && sizes[0] == batch) {
+      sizes[0] = -1;
+    }
+    appendKey(key, t.scalar_type(), t.device(), sizes, t.strides());
+  }
+  return key;
+}
+
+static bool allShapesAreKnown(const std::shared_ptr<Graph>& graph) {
+  for (const Value* input : graph->inputs()) {
+    if (input->type()->cast<TensorType>() && !input->isCompleteTensor()) {
+      return false;
+    }
+  }
+  for (const Node* n : graph->nodes()) {
+    for (const Value* output : n->outputs()) {
+      if (output->type()->cast<TensorType>() && !output->isCompleteTensor()) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+std::shared_ptr<KernelCache> KernelCache::get(
+    const std::shared_ptr<Graph>& subgraph) {
+  static std::mutex mutex;
+  static std::unordered_map<std::string, std::weak_ptr<KernelCache>> caches;
+
+  std::string text = subgraph->toString(false);
+  std::lock_guard<std::mutex> guard(mutex);
+  auto it = caches.find(text);
+  if (it != caches.end()) {
+    if (auto cache = it->second.lock()) {
+      return cache;
+    }
+  }
+
+  // Forget the caches of the graphs that were destroyed.
+  for (auto i = caches.begin(); i != caches.end();) {
+    i = i->second.expired() ? caches.erase(i) : std::next(i);
+  }
+
+  auto cache = std::make_shared<KernelCache>(subgraph);
+  caches[text] = cache;
+  return cache;
+}
+
+KernelCache::KernelCache(const std::shared_ptr<Graph>& subgraph)
+    : graph_(subgraph),
+      nInputs_(subgraph->inputs().size()),
+      kernel_(std::make_shared<TensorExprKernel>(subgraph)),
+      key_(graphKey(subgraph)) {
+  kernel_cache_compiles++;
+}
+
+void KernelCache::run(Stack& stack) {
+  auto kernel = lookup(last(stack, nInputs_));
+  if (!kernel) {
+    kernel_cache_fallbacks++;
+    kernel_->fallback(stack);
+    return;
+  }
+  kernel->run(stack);
+  if (kernel->usesFallback()) {
+    kernel_cache_fallbacks++;
+  }
+}
+
+std::shared_ptr<KernelCache::Specialization> KernelCache::find(
+    const Key& key) {
+  for (auto it = specializations_.begin(); it != specializations_.end();
+       ++it) {
+    if ((*it)->key == key) {
+      specializations_.splice(
+          specializations_.begin(), specializations_, it);
+      return *it;
+    }
+  }
+  return nullptr;
+}
+
+std::shared_ptr<TensorExprKernel> KernelCache::lookup(
+    const at::ArrayRef<IValue>& inputs) {
+  // Without the shapes of the subgraph we can't tell whether its kernel
+  // matches the inputs, assume it does.
+  if (!key_) {
+    kernel_cache_hits++;
+    return kernel_;
+  }
+  Key key = inputsKey(inputs);
+  if (key == *key_) {
+    kernel_cache_hits++;
+    return kernel_;
+  }
+  auto batch_key = batchKey(inputs);
+
+  std::shared_ptr<Specialization> entry;
+  std::shared_future<std::shared_ptr<TensorExprKernel>> cached;
+  std::promise<std::shared_ptr<TensorExprKernel>> promise;
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto found = find(key);
+    if (!found && batch_key) {
+      found = find(*batch_key);
+    }
+    if (found) {
+      kernel_cache_hits++;
+      cached = found->kernel;
+    } else {
+      // Concurrent runs with the same inputs find this entry and wait for
+      // the kernel compiled below.
+      entry = std::make_shared<Specialization>();
+      entry->key = key;
+      entry->kernel = promise.get_future().share();
+      specializations_.push_front(entry);
+      while (specializations_.size() >
+             static_cast<size_t>(std::max(getTEKernelCacheSize(), 0))) {
+        specializations_.pop_back();
+      }
+    }
+  }
+  // Waits for the run that compiles it, if it isn't done yet.
+  if (cached.valid()) {
+    return cached.get();
+  }
+
+  std::shared_ptr<TensorExprKernel> kernel;
+  try {
+    kernel = specialize(inputs);
+  } catch (...) {
+    promise.set_exception(std::current_exception());
+    std::lock_guard<std::mutex> guard(mutex_);
+    specializations_.remove(entry);
+    throw;
+  }
+  promise.set_value(kernel);
+
+  // The other batch sizes find a kernel with a symbolic batch size under the
+  // key without it.
+  if (kernel && kernel->usesSymbolicBatch() && batch_key) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto it = std::find(
+        specializations_.begin(), specializations_.end(), entry);
+    if (it != specializations_.end()) {
+      bool found = std::any_of(
+          specializations_.begin(),
+          specializations_.end(),
+          [&](const std::shared_ptr<Specialization>& s) {
+            return s->key == *batch_key;
+          });
+      if (found) {
+        specializations_.erase(it);
+      } else {
+        entry->key = std::move(*batch_key);
+      }
+    }
+  }
+  return kernel;
+}
+
+std::shared_ptr<TensorExprKernel> KernelCache::specialize(
+    const at::ArrayRef<IValue>& inputs) {
+  auto graph = graph_->copy();
+  EraseShapeInformation(graph);
+  for (size_t i = 0; i < inputs.size(); i++) {
+    if (inputs[i].isTensor()) {
+      graph->inputs()[i]->setType(TensorType::create(inputs[i].toTensor()));
+    }
+  }
+  PropagateInputShapes(graph);
+  GRAPH_DUMP("Specialized TensorExpr subgraph: ", graph);
+
+  // The kernel needs the shapes of all the tensors; run the ones it can't
+  // infer in the interpreter.
+  if (!allShapesAreKnown(graph)) {
+    if (!fallbackAllowed()) {
+      throw std::runtime_error(
+          "Cannot infer the shapes of a specialized TensorExpr subgraph");
+    }
+    return nullptr;
+  }
+
+  kernel_cache_compiles++;
+  return std::make_shared<TensorExprKernel>(
+      graph, TensorExprKernel::supportsSymbolicBatch(graph));
+}
+
+} // namespace tensorexpr
+} // namespace jit
+} // namespace torch
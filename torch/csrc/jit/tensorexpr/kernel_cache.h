@@ -0,0 +1,87 @@
+#pragma once
+
+#include <torch/csrc/jit/tensorexpr/kernel.h>
+
+#include <cstdint>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+
+namespace torch {
+namespace jit {
+namespace tensorexpr {
+
+// Counters of all the kernel caches of the process.
+struct TORCH_API KernelCacheStats {
+  // Runs that found their kernel already compiled
+  uint64_t hits = 0;
+  // Kernels compiled, including the ones that failed to
+  uint64_t compiles = 0;
+  // Runs in the interpreter
+  uint64_t fallbacks = 0;
+};
+
+// Runs a fusion group with kernels specialized on the sizes, strides, dtypes
+// and devices of its tensor inputs.
+//
+// A TensorExprKernel is compiled for the shapes recorded in its subgraph and
+// can't run inputs of other shapes. When the inputs don't match them, the
+// cache specializes a copy of the subgraph on the input types, propagates the
+// shapes through it and compiles a kernel for it. The most recently used
+// getTEKernelCacheSize() specializations are kept, besides the kernel of the
+// original shapes. Elementwise specializations are compiled with a symbolic
+// batch size and run the inputs that only differ from them in it.
+//
+// Kernels are compiled without holding the lock of the cache. Concurrent runs
+// with the same new shapes wait for the run that compiles their kernel.
+//
+// Fusion groups with the same subgraph share a cache, so the GraphExecutors
+// of a graph don't compile the same kernels again.
+class TORCH_API KernelCache {
+ public:
+  // Returns the cache of the fusion groups with the subgraph SUBGRAPH.
+  static std::shared_ptr<KernelCache> get(
+      const std::shared_ptr<Graph>& subgraph);
+
+  explicit KernelCache(const std::shared_ptr<Graph>& subgraph);
+
+  void run(Stack& stack);
+
+ private:
+  using Key = std::vector<int64_t>;
+
+  struct Specialization {
+    Key key;
+    // Ready when the kernel is compiled. A null kernel runs the inputs in
+    // the interpreter.
+    std::shared_future<std::shared_ptr<TensorExprKernel>> kernel;
+  };
+
+  std::shared_ptr<TensorExprKernel> lookup(const at::ArrayRef<IValue>& inputs);
+
+  std::shared_ptr<TensorExprKernel> specialize(
+      const at::ArrayRef<IValue>& inputs);
+
+  // Moves the specialization of KEY to the front and returns it, or nullptr
+  // if there is none. Callers hold mutex_.
+  std::shared_ptr<Specialization> find(const Key& key);
+
+  std::shared_ptr<Graph> graph_;
+  size_t nInputs_;
+  // The kernel of the shapes of graph_, and the key of these shapes if they
+  // are all known.
+  std::shared_ptr<TensorExprKernel> kernel_;
+  c10::optional<Key> key_;
+  // Most recently used first
+  std::list<std::shared_ptr<Specialization>> specializations_;
+  std::mutex mutex_;
+};
+
+TORCH_API int& getTEKernelCacheSize();
+TORCH_API KernelCacheStats getKernelCacheStats();
+TORCH_API void resetKernelCacheStats();
+
+} // namespace tensorexpr
+} // namespace jit
+} // namespace torch
@@ -3,22 +3,31 @@
 #include <torch/csrc/jit/tensorexpr/llvm_codegen.h>
 #include <torch/csrc/jit/tensorexpr/llvm_jit.h>
 
+#include <ATen/Parallel.h>
+
 #include <memory>
+#include <sstream>
 
 #include <llvm/Analysis/TargetTransformInfo.h>
+#include <llvm/Config/llvm-config.h>
 #include <llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h>
 #include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
 #include <llvm/IR/IRBuilder.h>
 #include <llvm/IR/LegacyPassManager.h>
+#include <llvm/IR/Metadata.h>
 #include <llvm/IR/Verifier.h>
+#include <llvm/Support/SmallVectorMemoryBuffer.h>
 #include <llvm/Support/TargetSelect.h>
 #include <llvm/Target/TargetMachine.h>
 #include <llvm/Transforms/IPO/PassManagerBuilder.h>
 
+#include <torch/csrc/jit/tensorexpr/analysis.h>
 #include <torch/csrc/jit/tensorexpr/buffer.h>
 #include <torch/csrc/jit/tensorexpr/execution_counter.h>
+#include <torch/csrc/jit/tensorexpr/hash_provider.h>
 #include <torch/csrc/jit/tensorexpr/ir.h>
 #include <torch/csrc/jit/tensorexpr/ir_printer.h>
+#include <torch/csrc/jit/tensorexpr/llvm_object_cache.h>
 #include <torch/csrc/jit/tensorexpr/types.h>
 
 #define DEBUG_PRINT 0
@@ -57,6 +66,16 @@ class LLVMCodeGenImpl : public IRVisitor {
   llvm::Type* dtypeToLLVMPtr(Dtype dtype);
   void emitWrapper(const std::vector<llvm::Type*>& params);
   void emitKernel(Stmt* stmt, const std::vector<llvm::Type*>& params);
+  std::unique_ptr<llvm::MemoryBuffer> emitObject();
+  void emitSerialFor(const For* v, llvm::Value* start, llvm::Value* stop);
+  void emitParallelFor(
+      const For* v,
+      llvm::Value* start,
+      llvm::Value* stop,
+      llvm::Value* grainSize);
+  bool isAvailable(const Expr* e);
+  llvm::Value* emitLoopWork(Stmt* s);
+  llvm::Value* emitGrainSize(const For* v);
 
  public:
   LLVMCodeGenImpl(
@@ -148,6 +167,34 @@ static llvm::orc::JITTargetMachineBuilder makeTargetMachineBuilder() {
 #endif
 }
 
+// Describes everything the machine code of a kernel depends on.
+static ObjectCacheKey objectCacheKey(
+    Stmt* stmt,
+    const std::vector<CodeGen::BufferArg>& args,
+    Dtype dtype,
+    const llvm::TargetMachine& TM) {
+  std::ostringstream oss;
+  oss << "llvm " << LLVM_VERSION_STRING << "\n";
+  oss << "triple " << TM.getTargetTriple().str() << "\n";
+  oss << "cpu " << TM.getTargetCPU().str() << "\n";
+  oss << "features " << TM.getTargetFeatureString().str() << "\n";
+  oss << "ret " << dtype << "\n";
+  IRPrinter printer(oss);
+  for (auto const& arg : args) {
+    oss << (arg.isVar() ? "var " : "buf ") << arg.dtype() << " ";
+    printer.print(ExprHandle(arg.var()));
+    oss << "\n";
+  }
+  printer.print(*stmt);
+
+  // The printed IR doesn't show all the loop options, the hash does.
+  HashProvider hasher;
+  ObjectCacheKey key;
+  key.text = oss.str();
+  key.hash = hasher.hash_combine(hasher.hash(stmt), key.text)._h;
+  return key;
+}
+
 LLVMCodeGen::~LLVMCodeGen() = default;
 
 LLVMCodeGen::LLVMCodeGen(Stmt* stmt)
@@ -260,11 +307,29 @@ LLVMCodeGenImpl::LLVMCodeGenImpl(
     }
   }
 
-  emitWrapper(params);
-  emitKernel(stmt, params);
+  // Load the kernel from the on-disk cache if an earlier process compiled
+  // it, otherwise compile it and cache its object file.
+  c10::optional<ObjectCacheKey> cacheKey;
+  std::unique_ptr<llvm::MemoryBuffer> object;
+  if (!getTEObjectCacheDir().empty()) {
+    cacheKey = objectCacheKey(stmt, args, dtype, *TM_);
+    object = loadCachedObject(*cacheKey);
+  }
+  if (!object) {
+    emitWrapper(params);
+    emitKernel(stmt, params);
+    if (cacheKey) {
+      object = emitObject();
+      storeCachedObject(*cacheKey, object->getBuffer());
+    }
+  }
 
-  cantFail(jit_->addModule(
-      llvm::orc::ThreadSafeModule(std::move(module_), context_)));
+  if (object) {
+    cantFail(jit_->addObject(std::move(object)));
+  } else {
+    cantFail(jit_->addModule(
+        llvm::orc::ThreadSafeModule(std::move(module_), context_)));
+  }
   auto sym = jit_->findSymbol("wrapper");
   kernelAddress_ = cantFail(sym.getAddress());
   argv_ = std::make_unique<void*[]>(params.size());
@@ -960,6 +1025,63 @@ void LLVMCodeGenImpl::visit(const Load* v) {
   value_ = load;
 }
 
+bool LLVMCodeGenImpl::isAvailable(const Expr* e) {
+  NodeFinder<Var> finder;
+  e->accept(&finder);
+  for (Var* var : finder.nodes) {
+    if (!varToArg_.count(var) && !varToVal_.count(var)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+llvm::Value* LLVMCodeGenImpl::emitLoopWork(Stmt* s) {
+  // Anything above GRAIN_SIZE results in a grain size of one iteration, so
+  // saturate there instead of risking an overflow on deep nests.
+  auto cap = llvm::ConstantInt::getSigned(LongTy_, at::internal::GRAIN_SIZE);
+  auto saturate = [&](llvm::Value* work) {
+    return irb_.CreateSelect(irb_.CreateICmpSLT(work, cap), work, cap);
+  };
+
+  auto zero = llvm::ConstantInt::getSigned(LongTy_, 0);
+  llvm::Value* work = zero;
+  if (Block* block = dynamic_cast<Block*>(s)) {
+    for (Stmt* stmt : *block) {
+      work = saturate(irb_.CreateAdd(work, emitLoopWork(stmt)));
+    }
+  } else if (For* loop = dynamic_cast<For*>(s)) {
+    llvm::Value* tripCount = llvm::ConstantInt::getSigned(LongTy_, 1);
+    if (isAvailable(loop->start()) && isAvailable(loop->stop())) {
+      loop->start()->accept(this);
+      auto start = irb_.CreateSExt(value_, LongTy_);
+      loop->stop()->accept(this);
+      auto stop = irb_.CreateSExt(value_, LongTy_);
+      tripCount = irb_.CreateSub(stop, start);
+      tripCount = irb_.CreateSelect(
+          irb_.CreateICmpSGT(tripCount, zero), tripCount, zero);
+    }
+    work = saturate(
+        irb_.CreateMul(saturate(tripCount), emitLoopWork(loop->body())));
+  } else if (Store* store = dynamic_cast<Store*>(s)) {
+    work = llvm::ConstantInt::getSigned(
+        LongTy_, store->value()->dtype().lanes());
+  }
+  return work;
+}
+
+llvm::Value* LLVMCodeGenImpl::emitGrainSize(const For* v) {
+  // Each task should cover about GRAIN_SIZE elements, the same granularity
+  // ATen uses for its own elementwise kernels.
+  auto one = llvm::ConstantInt::getSigned(LongTy_, 1);
+  auto work = emitLoopWork(v->body());
+  work = irb_.CreateSelect(irb_.CreateICmpSGT(work, one), work, one);
+  auto grainSize = irb_.CreateSDiv(
+      llvm::ConstantInt::getSigned(LongTy_, at::internal::GRAIN_SIZE), work);
+  return irb_.CreateSelect(
+      irb_.CreateICmpSGT(grainSize, one), grainSize, one);
+}
+
 void LLVMCodeGenImpl::visit(const For* v) {
   // Create "start" and "stop" values.
   v->start()->accept(this);
@@ -967,6 +1089,33 @@ void LLVMCodeGenImpl::visit(const For* v) {
   v->stop()->accept(this);
   auto stop = this->value_;
 
+  if (!v->loop_options().is_parallel()) {
+    emitSerialFor(v, start, stop);
+    value_ = llvm::ConstantInt::get(IntTy_, 0);
+    return;
+  }
+
+  // The grain size folds to a constant when the bounds of the inner loops
+  // are constants. Don't outline loops that would run as a single task.
+  auto grainSize = emitGrainSize(v);
+  auto startImm = llvm::dyn_cast<llvm::ConstantInt>(start);
+  auto stopImm = llvm::dyn_cast<llvm::ConstantInt>(stop);
+  auto grainImm = llvm::dyn_cast<llvm::ConstantInt>(grainSize);
+  if (startImm && stopImm && grainImm &&
+      stopImm->getSExtValue() - startImm->getSExtValue() <=
+          grainImm->getSExtValue()) {
+    emitSerialFor(v, start, stop);
+  } else {
+    emitParallelFor(v, start, stop, grainSize);
+  }
+
+  value_ = llvm::ConstantInt::get(IntTy_, 0);
+}
+
+void LLVMCodeGenImpl::emitSerialFor(
+    const For* v,
+    llvm::Value* start,
+    llvm::Value* stop) {
   // Create block for loop condition test.
   auto preheader = irb_.GetInsertBlock();
   auto condBlock = llvm::BasicBlock::Create(getContext(), "cond", fn_);
@@ -1000,14 +1149,124 @@ void LLVMCodeGenImpl::visit(const For* v) {
 
   // Increment the index variable and branch back to loop test.
   auto inc = irb_.CreateAdd(idx, llvm::ConstantInt::getSigned(IntTy_, 1));
-  irb_.CreateBr(condBlock);
+  auto backedge = irb_.CreateBr(condBlock);
   idx->addIncoming(inc, body);
 
+  // The loop vectorizer doesn't reassociate floating-point reductions unless
+  // the loop asks for vectorization.
+  if (v->loop_options().is_reduction()) {
+    llvm::Metadata* vectorizeEnable[] = {
+        llvm::MDString::get(getContext(), "llvm.loop.vectorize.enable"),
+        llvm::ConstantAsMetadata::get(
+            llvm::ConstantInt::getTrue(getContext()))};
+    auto self = llvm::MDNode::getTemporary(getContext(), llvm::None);
+    llvm::Metadata* loopID[] = {
+        self.get(), llvm::MDNode::get(getContext(), vectorizeEnable)};
+    auto loopMD = llvm::MDNode::getDistinct(getContext(), loopID);
+    loopMD->replaceOperandWith(0, loopMD);
+    backedge->setMetadata(llvm::LLVMContext::MD_loop, loopMD);
+  }
+
   // Exit the loop.
   irb_.SetInsertPoint(exit);
 
   varToVal_.erase(v->var());
-  value_ = llvm::ConstantInt::get(IntTy_, 0);
+}
+
+// A parallel loop is outlined into a function that runs the iterations in
+// [begin, end) serially:
+//
+//   void parallel_body(int64_t begin, int64_t end, void* env);
+//
+// Every value the body may refer to -- the kernel arguments and the values
+// bound by enclosing loops, lets and allocations -- is stored into an env
+// struct on the caller's stack, and the loop itself becomes a call to the
+// nnc_parallel_for runtime function, which hands chunks of the iteration
+// space to at::parallel_for.
+void LLVMCodeGenImpl::emitParallelFor(
+    const For* v,
+    llvm::Value* start,
+    llvm::Value* stop,
+    llvm::Value* grainSize) {
+  std::vector<const Var*> captured;
+  std::vector<llvm::Value*> capturedVals;
+  std::vector<llvm::Type*> capturedTys;
+  for (auto const& p : varToArg_) {
+    captured.push_back(p.first);
+    capturedVals.push_back(fn_->arg_begin() + p.second);
+  }
+  for (auto const& p : varToVal_) {
+    captured.push_back(p.first);
+    capturedVals.push_back(p.second);
+  }
+  for (auto val : capturedVals) {
+    capturedTys.push_back(val->getType());
+  }
+  auto envTy = llvm::StructType::get(getContext(), capturedTys);
+  auto voidPtrTy = llvm::Type::getInt8PtrTy(getContext());
+
+  // Allocate the env in the entry block, so that a parallel loop nested in a
+  // serial one does not grow the stack on every iteration.
+  llvm::IRBuilder<> entryIrb(
+      &fn_->getEntryBlock(), fn_->getEntryBlock().getFirstInsertionPt());
+  auto env = entryIrb.CreateAlloca(envTy);
+  for (size_t i = 0; i < capturedVals.size(); i++) {
+    irb_.CreateStore(capturedVals[i], irb_.CreateStructGEP(envTy, env, i));
+  }
+
+  auto bodyFnTy = llvm::FunctionType::get(
+      llvm::Type::getVoidTy(getContext()),
+      {LongTy_, LongTy_, voidPtrTy},
+      false);
+  auto bodyFn = llvm::Function::Create(
+      bodyFnTy,
+      llvm::Function::PrivateLinkage,
+      "parallel_body",
+      module_.get());
+
+  // Emit the body function with its own view of the variables.
+  auto callerFn = fn_;
+  auto callerBlock = irb_.GetInsertBlock();
+  auto callerArgs = std::move(varToArg_);
+  auto callerVals = std::move(varToVal_);
+  varToArg_.clear();
+  varToVal_.clear();
+
+  fn_ = bodyFn;
+  irb_.SetInsertPoint(llvm::BasicBlock::Create(getContext(), "entry", fn_));
+  auto arg = fn_->arg_begin();
+  llvm::Value* begin = irb_.CreateTrunc(arg++, IntTy_);
+  llvm::Value* end = irb_.CreateTrunc(arg++, IntTy_);
+  auto bodyEnv = irb_.CreatePointerCast(arg, envTy->getPointerTo());
+  for (size_t i = 0; i < captured.size(); i++) {
+    varToVal_.emplace(
+        captured[i], irb_.CreateLoad(irb_.CreateStructGEP(envTy, bodyEnv, i)));
+  }
+  emitSerialFor(v, begin, end);
+  irb_.CreateRetVoid();
+  if (llvm::verifyFunction(*fn_, &llvm::outs())) {
+    throw std::runtime_error("Function verification failed");
+  }
+
+  fn_ = callerFn;
+  varToArg_ = std::move(callerArgs);
+  varToVal_ = std::move(callerVals);
+  irb_.SetInsertPoint(callerBlock);
+
+  // Call into the runtime.
+  auto parallelForTy = llvm::FunctionType::get(
+      llvm::Type::getVoidTy(getContext()),
+      {LongTy_, LongTy_, LongTy_, bodyFn->getType(), voidPtrTy},
+      false);
+  llvm::FunctionCallee callee =
+      module_->getOrInsertFunction("nnc_parallel_for", parallelForTy);
+  irb_.CreateCall(
+      callee,
+      {irb_.CreateSExt(start, LongTy_),
+       irb_.CreateSExt(stop, LongTy_),
+       grainSize,
+       bodyFn,
+       irb_.CreatePointerCast(env, voidPtrTy)});
 }
 
 void LLVMCodeGenImpl::visit(const Block* v) {
@@ -1577,6 +1836,21 @@ void LLVMCodeGenImpl::visit(const Cond* v) {
   throw unimplemented_lowering(v);
 }
 
+std::unique_ptr<llvm::MemoryBuffer> LLVMCodeGenImpl::emitObject() {
+  llvm::SmallVector<char, 0> objBuffer;
+  llvm::raw_svector_ostream objStream(objBuffer);
+  llvm::legacy::PassManager PM;
+  if (TM_->addPassesToEmitFile(
+          PM,
+          objStream,
+          nullptr,
+          llvm::TargetMachine::CodeGenFileType::CGFT_ObjectFile)) {
+    throw std::runtime_error("Target can't emit object files");
+  }
+  PM.run(*module_);
+  return std::make_unique<llvm::SmallVectorMemoryBuffer>(std::move(objBuffer));
+}
+
 void LLVMCodeGenImpl::optimize(llvm::Module& M) {
   llvm::legacy::FunctionPassManager FPM(&M);
   llvm::legacy::PassManager PM;
@@ -2,6 +2,7 @@
 
 #include <torch/csrc/jit/tensorexpr/llvm_jit.h>
 
+#include <ATen/Parallel.h>
 #include <llvm/ExecutionEngine/Orc/LLJIT.h>
 #include <sleef.h>
 #include <algorithm>
@@ -9,6 +10,26 @@
 #include <string>
 #include <vector>
 
+namespace {
+
+// Runtime entry point for loops marked with LoopNest::parallelize. The LLVM
+// backend outlines the loop body into FN, which runs the iterations in
+// [begin, end) with the captured values it finds in ENV.
+using ParallelBody = void (*)(int64_t begin, int64_t end, void* env);
+
+void nncParallelFor(
+    int64_t start,
+    int64_t stop,
+    int64_t grain_size,
+    ParallelBody fn,
+    void* env) {
+  at::parallel_for(start, stop, grain_size, [&](int64_t begin, int64_t end) {
+    fn(begin, end, env);
+  });
+}
+
+} // namespace
+
 namespace llvm {
 namespace orc {
 
@@ -77,6 +98,11 @@ class TORCH_API PytorchLLVMJITImpl {
         *Mangle("remainderf"),
         {llvm::pointerToJITTargetAddress(&remainderf), {}}));
 
+    // Runtime support for parallel loops
+    cantFail(LLJ->defineAbsolute(
+        *Mangle("nnc_parallel_for"),
+        {llvm::pointerToJITTargetAddress(&nncParallelFor), {}}));
+
     // FP32 Sleef functions -- SSE
     cantFail(LLJ->defineAbsolute(
         *Mangle("Sleef_acosf4"),
@@ -425,6 +451,10 @@ class TORCH_API PytorchLLVMJITImpl {
     return Error::success();
   }
 
+  Error addObject(std::unique_ptr<MemoryBuffer> Obj) {
+    return LLJ->addObjectFile(std::move(Obj));
+  }
+
   JITSymbol findSymbol(const std::string Name) {
     return cantFail(LLJ->lookup(Name));
   }
@@ -443,6 +473,10 @@ Error PytorchLLVMJIT::addModule(ThreadSafeModule M) {
   return impl_->addModule(std::move(M));
 }
 
+Error PytorchLLVMJIT::addObject(std::unique_ptr<MemoryBuffer> Obj) {
+  return impl_->addObject(std::move(Obj));
+}
+
 JITSymbol PytorchLLVMJIT::findSymbol(const std::string Name) {
   return impl_->findSymbol(std::move(Name));
 }
@@ -6,6 +6,7 @@
 #include <llvm/ExecutionEngine/JITSymbol.h>
 #include <llvm/ExecutionEngine/Orc/Core.h>
 #include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
+#include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Target/TargetMachine.h>
 
 #include <memory>
@@ -23,6 +24,10 @@ class TORCH_API PytorchLLVMJIT {
 
   Error addModule(ThreadSafeModule M);
 
+  // Adds a relocatable object file compiled for the host, e.g. loaded from
+  // the on-disk kernel cache.
+  Error addObject(std::unique_ptr<MemoryBuffer> Obj);
+
   JITSymbol findSymbol(const std::string Name);
 
   TargetMachine& getTargetMachine();
@@ -0,0 +1,242 @@
+#include <torch/csrc/jit/tensorexpr/llvm_object_cache.h>
+
+#include <atomic>
+#include <cstdlib>
+
+#ifdef TORCH_ENABLE_LLVM
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/Chrono.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/Process.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+#endif
+
+namespace torch {
+namespace jit {
+namespace tensorexpr {
+
+static int64_t te_object_cache_size_limit = 1LL << 30;
+static std::atomic<uint64_t> object_cache_hits{0};
+static std::atomic<uint64_t> object_cache_misses{0};
+static std::atomic<uint64_t> object_cache_stores{0};
+static std::atomic<uint64_t> object_cache_rejected{0};
+static std::atomic<uint64_t> object_cache_evictions{0};
+
+std::string& getTEObjectCacheDir() {
+  static std::string dir = []() -> std::string {
+    const char* dir_c_str = std::getenv("PYTORCH_TENSOREXPR_CACHE_DIR");
+    return dir_c_str ? dir_c_str : "";
+  }();
+  return dir;
+}
+
+int64_t& getTEObjectCacheSizeLimit() {
+  return te_object_cache_size_limit;
+}
+
+ObjectCacheStats getObjectCacheStats() {
+  ObjectCacheStats stats;
+  stats.hits = object_cache_hits;
+  stats.misses = object_cache_misses;
+  stats.stores = object_cache_stores;
+  stats.rejected = object_cache_rejected;
+  stats.evictions = object_cache_evictions;
+  return stats;
+}
+
+void resetObjectCacheStats() {
+  object_cache_hits = 0;
+  object_cache_misses = 0;
+  object_cache_stores = 0;
+  object_cache_rejected = 0;
+  object_cache_evictions = 0;
+}
+
+#ifdef TORCH_ENABLE_LLVM
+
+// An entry is a header, the text of its key and the object file. The last
+// byte of the magic is the version of this layout.
+static constexpr char kMagic[8] = {'N', 'N', 'C', 'O', 'B', 'J', '\0', 1};
+static constexpr const char* kExtension = ".nncobj";
+
+struct EntryHeader {
+  char magic[8];
+  uint64_t keySize;
+  uint64_t objectSize;
+  // FNV-1a of the key text and the object file
+  uint64_t checksum;
+};
+
+static uint64_t fnv1a(uint64_t hash, llvm::StringRef data) {
+  for (unsigned char c : data) {
+    hash ^= c;
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+static uint64_t checksum(llvm::StringRef key, llvm::StringRef object) {
+  return fnv1a(fnv1a(0xcbf29ce484222325ULL, key), object);
+}
+
+static std::string entryPath(const std::string& dir, const ObjectCacheKey& key) {
+  std::ostringstream name;
+  name << std::hex << std::setw(16) << std::setfill('0') << key.hash
+       << kExtension;
+  llvm::SmallString<128> path(dir);
+  llvm::sys::path::append(path, name.str());
+  return path.str().str();
+}
+
+// Returns the object file of ENTRY if it is a well-formed entry of KEY.
+static bool parseEntry(
+    llvm::StringRef entry,
+    const ObjectCacheKey& key,
+    llvm::StringRef& object) {
+  EntryHeader header;
+  if (entry.size() < sizeof(header)) {
+    return false;
+  }
+  std::memcpy(&header, entry.data(), sizeof(header));
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+    return false;
+  }
+  llvm::StringRef body = entry.drop_front(sizeof(header));
+  if (header.keySize != key.text.size() ||
+      body.size() != header.keySize + header.objectSize) {
+    return false;
+  }
+  llvm::StringRef text = body.take_front(header.keySize);
+  object = body.drop_front(header.keySize);
+  return text == key.text && header.checksum == checksum(text, object);
+}
+
+// Marks PATH as recently used for the eviction.
+static void touch(const std::string& path) {
+  int fd;
+  if (llvm::sys::fs::openFileForRead(path, fd)) {
+    return;
+  }
+  auto now = std::chrono::system_clock::now();
+  llvm::sys::fs::setLastAccessAndModificationTime(fd, now, now);
+  llvm::sys::Process::SafelyCloseFileDescriptor(fd);
+}
+
+// Deletes the least recently used entries of DIR until their total size is
+// within the limit.
+static void evict(const std::string& dir) {
+  struct Entry {
+    std::string path;
+    llvm::sys::TimePoint<> time;
+    uint64_t size;
+  };
+  std::vector<Entry> entries;
+  uint64_t total = 0;
+  std::error_code ec;
+  for (llvm::sys::fs::directory_iterator it(dir, ec), end; it != end && !ec;
+       it.increment(ec)) {
+    if (llvm::sys::path::extension(it->path()) != kExtension) {
+      continue;
+    }
+    auto status = it->status();
+    if (!status) {
+      continue;
+    }
+    entries.push_back(
+        {it->path(), status->getLastModificationTime(), status->getSize()});
+    total += status->getSize();
+  }
+
+  uint64_t limit = std::max<int64_t>(getTEObjectCacheSizeLimit(), 0);
+  if (total <= limit) {
+    return;
+  }
+  std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+    return a.time < b.time;
+  });
+  for (const Entry& entry : entries) {
+    if (total <= limit) {
+      break;
+    }
+    // Another process may have deleted it already.
+    if (!llvm::sys::fs::remove(entry.path)) {
+      total -= entry.size;
+      object_cache_evictions++;
+    }
+  }
+}
+
+std::unique_ptr<llvm::MemoryBuffer> loadCachedObject(
+    const ObjectCacheKey& key) {
+  const std::string& dir = getTEObjectCacheDir();
+  if (dir.empty()) {
+    return nullptr;
+  }
+  std::string path = entryPath(dir, key);
+  auto entry = llvm::MemoryBuffer::getFile(path);
+  if (!entry) {
+    object_cache_misses++;
+    return nullptr;
+  }
+  llvm::StringRef object;
+  if (!parseEntry((*entry)->getBuffer(), key, object)) {
+    llvm::sys::fs::remove(path);
+    object_cache_rejected++;
+    object_cache_misses++;
+    return nullptr;
+  }
+  touch(path);
+  object_cache_hits++;
+  return llvm::MemoryBuffer::getMemBufferCopy(object, path);
+}
+
+void storeCachedObject(const ObjectCacheKey& key, llvm::StringRef object) {
+  const std::string& dir = getTEObjectCacheDir();
+  if (dir.empty() || llvm::sys::fs::create_directories(dir)) {
+    return;
+  }
+
+  // Write to a temporary file first, so that concurrent processes never
+  // read a partial entry.
+  std::string path = entryPath(dir, key);
+  int fd;
+  llvm::SmallString<128> tmpPath;
+  if (llvm::sys::fs::createUniqueFile(path + "-%%%%%%%%.tmp", fd, tmpPath)) {
+    return;
+  }
+  EntryHeader header;
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.keySize = key.text.size();
+  header.objectSize = object.size();
+  header.checksum = checksum(key.text, object);
+  {
+    llvm::raw_fd_ostream os(fd, /*shouldClose=*/true);
+    os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    os << key.text << object;
+    os.close();
+    if (os.has_error()) {
+      os.clear_error();
+      llvm::sys::fs::remove(tmpPath);
+      return;
+    }
+  }
+  if (llvm::sys::fs::rename(tmpPath, path)) {
+    llvm::sys::fs::remove(tmpPath);
+    return;
+  }
+  object_cache_stores++;
+  evict(dir);
+}
+
+#endif // TORCH_ENABLE_LLVM
+
+} // namespace tensorexpr
+} // namespace jit
+} // namespace torch
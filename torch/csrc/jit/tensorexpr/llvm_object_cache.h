@@ -0,0 +1,70 @@
+#pragma once
+
+#include <torch/csrc/WindowsTorchApiMacro.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#ifdef TORCH_ENABLE_LLVM
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/MemoryBuffer.h>
+#endif
+
+namespace torch {
+namespace jit {
+namespace tensorexpr {
+
+// Counters of the on-disk cache of compiled LLVM kernels.
+struct TORCH_API ObjectCacheStats {
+  // Kernels loaded from the cache
+  uint64_t hits = 0;
+  // Kernels not found in the cache
+  uint64_t misses = 0;
+  // Kernels written to the cache
+  uint64_t stores = 0;
+  // Entries deleted because they were truncated, corrupted or collided with
+  // another kernel
+  uint64_t rejected = 0;
+  // Entries deleted to keep the cache under its size limit
+  uint64_t evictions = 0;
+};
+
+// Directory of the on-disk cache of compiled LLVM kernels. The cache is
+// disabled when it is empty, which is the default unless the environment
+// variable PYTORCH_TENSOREXPR_CACHE_DIR is set.
+TORCH_API std::string& getTEObjectCacheDir();
+// Total size in bytes of the entries of the cache. The least recently used
+// entries are deleted when a new entry exceeds it.
+TORCH_API int64_t& getTEObjectCacheSizeLimit();
+TORCH_API ObjectCacheStats getObjectCacheStats();
+TORCH_API void resetObjectCacheStats();
+
+#ifdef TORCH_ENABLE_LLVM
+
+// Identifies the machine code of a kernel. The text describes everything the
+// code was compiled from: the IR, the arguments, the target and the LLVM
+// version. The hash names the file of the entry, and the text is stored in it
+// to tell apart the kernels whose hashes collide.
+struct ObjectCacheKey {
+  uint64_t hash;
+  std::string text;
+};
+
+// Returns the object file cached for KEY, or nullptr if there is none or the
+// cache is disabled. Entries that fail validation are deleted.
+TORCH_API std::unique_ptr<llvm::MemoryBuffer> loadCachedObject(
+    const ObjectCacheKey& key);
+
+// Writes the object file OBJECT to the cache under KEY, then evicts the least
+// recently used entries above the size limit. Failures to write are ignored:
+// the cache only saves compile time.
+TORCH_API void storeCachedObject(
+    const ObjectCacheKey& key,
+    llvm::StringRef object);
+
+#endif // TORCH_ENABLE_LLVM
+
+} // namespace tensorexpr
+} // namespace jit
+} // namespace torch
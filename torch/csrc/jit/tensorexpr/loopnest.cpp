@@ -226,13 +226,20 @@ class Vectorizer : public IRMutator {
   Stmt* mutate(const Store* v) override {
     const Buf* buf = v->buf();
     std::vector<const Expr*> inputs = {v->flat_index(), v->value(), v->mask()};
-    return try_vectorize(v, inputs, [&]() {
+    Stmt* new_store = try_vectorize(v, inputs, [&]() {
       return Store::make(
           BufHandle(buf),
           {ExprHandle(inputs[0])},
           ExprHandle(inputs[1]),
           ExprHandle(inputs[2]));
     });
+    // All the lanes of a vector stored to an index broadcast from the loop
+    // invariant one would write the same element, e.g. in a reduction loop.
+    if (new_store != v && dynamic_cast<const Broadcast*>(inputs[0])) {
+      throw std::runtime_error(
+          "Can't vectorize a store to a loop-invariant index!");
+    }
+    return new_store;
   }
 
   Stmt* mutate(const For* v) override {
@@ -727,7 +734,17 @@ Stmt* LoopNest::lowerToStmt(Tensor* t) {
   for (size_t i = 0; i < f->ndim(); i++) {
     // Going in reverse order: from innermost loop to the outermost
     size_t dim_index = f->ndim() - i - 1;
-    body = new For(f->arg(dim_index), new IntImm(0), f->dim(dim_index), body);
+    // The dimensions past the ones of the tensor are reduced.
+    LoopOptions loop_options;
+    if (dim_index >= t->ndim()) {
+      loop_options.set_reduction();
+    }
+    body = new For(
+        f->arg(dim_index),
+        new IntImm(0),
+        f->dim(dim_index),
+        body,
+        loop_options);
     indices.pop_back();
     if (initializer && indices.size() == t->ndim()) {
       Store* init = new Store(t->buf(), indices, initializer, new IntImm(1));
@@ -1186,6 +1203,10 @@ void LoopNest::setGPUThreadIndex(For* f, int thread_index) {
   f->set_gpu_thread_index(thread_index);
 }
 
+void LoopNest::parallelize(For* f) {
+  f->set_parallel();
+}
+
 Stmt* LoopNest::getLoopBodyFor(Tensor* t) const {
   return tensor_to_stmt_.at(t);
 }
@@ -42,6 +42,9 @@ class TORCH_API LoopNest {
 
   void setGPUBlockIndex(For* f, int idx);
   void setGPUThreadIndex(For* f, int idx);
+  // Mark the iterations of F as independent, so that the LLVM backend runs
+  // them with at::parallel_for.
+  void parallelize(For* f);
 
   // Insert a temporary computation of statement S in the scope of loop AT.
   // S is assumed to be a Store or a Block containing a Store. Along with the
@@ -541,23 +541,52 @@ class TORCH_API LoopOptions {
     gpu_thread_index_ = index;
   }
 
+  // CPU parallel loop: iterations are independent and may be distributed
+  // across the intra-op thread pool.
+  bool is_parallel() const {
+    return is_parallel_;
+  }
+
+  void set_parallel() {
+    if (is_gpu_block_index() || is_gpu_thread_index()) {
+      throw std::runtime_error("Cannot parallelize a GPU-mapped loop");
+    }
+    is_parallel_ = true;
+  }
+
+  // Reduction loop: every iteration accumulates into the same elements. This
+  // is a hint for the code generators and doesn't change what the loop
+  // computes, so it is not part of isDefault().
+  bool is_reduction() const {
+    return is_reduction_;
+  }
+
+  void set_reduction() {
+    is_reduction_ = true;
+  }
+
   std::string ToString() const {
     std::ostringstream oss;
     if (is_gpu_block_index()) {
       oss << gpu_block_index_str();
     } else if (is_gpu_thread_index()) {
       oss << gpu_thread_index_str();
+    } else if (is_parallel()) {
+      oss << "parallel";
     }
     return oss.str();
   }
 
   bool isDefault() const {
-    return gpu_block_index_ == IDX_UNSET && gpu_thread_index_ == IDX_UNSET;
+    return gpu_block_index_ == IDX_UNSET && gpu_thread_index_ == IDX_UNSET &&
+        !is_parallel_;
   }
 
  private:
   int gpu_block_index_{IDX_UNSET};
   int gpu_thread_index_{IDX_UNSET};
+  bool is_parallel_{false};
+  bool is_reduction_{false};
 };
 
 class TORCH_API For : public StmtNode<For> {
@@ -651,6 +680,10 @@ class TORCH_API For : public StmtNode<For> {
     loop_options_.set_gpu_thread_index(thread_index);
   }
 
+  void set_parallel() {
+    loop_options_.set_parallel();
+  }
+
   For* cloneWithNewBody(Stmt* body) const {
     return new For(var_, start_, stop_, body, loop_options_);
   }
@@ -48,12 +48,56 @@ void ProcessGroup::Work::abort() {
   TORCH_CHECK(false, "ProcessGroup::Work::abort not implemented.")
 }
 
+c10::intrusive_ptr<c10::ivalue::Future> ProcessGroup::Work::getFuture() {
+  TORCH_CHECK(false, "ProcessGroup::Work::getFuture not implemented.");
+}
+
+namespace {
+
+void completeFuture(
+    const c10::intrusive_ptr<c10::ivalue::Future>& future,
+    const std::exception_ptr& exception) {
+  if (!exception) {
+    future->markCompleted();
+    return;
+  }
+  try {
+    std::rethrow_exception(exception);
+  } catch (const std::exception& e) {
+    future->setError(e.what());
+  } catch (...) {
+    future->setError("unknown error in ProcessGroup::Work");
+  }
+}
+
+} // namespace
+
+c10::intrusive_ptr<c10::ivalue::Future> ProcessGroup::Work::getFinishFuture() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (future_) {
+    return future_;
+  }
+  future_ = c10::make_intrusive<c10::ivalue::Future>(c10::NoneType::get());
+  if (completed_) {
+    auto future = future_;
+    auto exception = exception_;
+    lock.unlock();
+    completeFuture(future, exception);
+    return future;
+  }
+  return future_;
+}
+
 void ProcessGroup::Work::finish(std::exception_ptr exception) {
   std::unique_lock<std::mutex> lock(mutex_);
   completed_ = true;
   exception_ = exception;
+  auto future = future_;
   lock.unlock();
   cv_.notify_all();
+  if (future) {
+    completeFuture(future, exception);
+  }
 }
 
 ProcessGroup::ProcessGroup(int rank, int size) : rank_(rank), size_(size) {
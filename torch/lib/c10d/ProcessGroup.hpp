@@ -8,6 +8,7 @@
 #include <vector>
 
 #include <ATen/ATen.h>
+#include <ATen/core/ivalue.h>
 
 #include <c10d/Types.hpp>
 
@@ -87,13 +88,24 @@ class ProcessGroup {
 
     virtual void abort();
 
+    // Returns a Future that is marked completed (with no value) when the
+    // work completes, or with an error if the work failed. Callbacks added
+    // to it run on the thread that completes the work, so they should be
+    // short or hand off to another thread. Not every kind of work supports
+    // this; the default implementation throws.
+    virtual c10::intrusive_ptr<c10::ivalue::Future> getFuture();
+
    protected:
     void finish(std::exception_ptr exception = nullptr);
 
+    // getFuture() implementation for work that completes through finish().
+    c10::intrusive_ptr<c10::ivalue::Future> getFinishFuture();
+
     mutable std::mutex mutex_;
     std::condition_variable cv_;
     bool completed_ = false;
     std::exception_ptr exception_;
+    c10::intrusive_ptr<c10::ivalue::Future> future_;
   };
 
   explicit ProcessGroup(int rank, int size);
@@ -7,6 +7,8 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <cstring>
 #include <type_traits>
 
 #include <gloo/allgather.h>
@@ -326,6 +328,10 @@ void initializeStreamsEvents(
 
 const auto kLoopbackAddress = "127.0.0.1";
 
+// Overrides the hostname that ranks are grouped by for hierarchical
+// allreduce.
+const auto kHierarchyHostEnv = "GLOO_HIERARCHICAL_ALLREDUCE_HOST";
+
 } // namespace
 
 ProcessGroupGloo::SendWork::SendWork(
@@ -390,7 +396,9 @@ void ProcessGroupGloo::RecvWork::abort() {
 }
 
 ProcessGroupGloo::Options::Options()
-    : timeout(std::chrono::milliseconds(10 * 1000)), threads(2) {}
+    : timeout(std::chrono::milliseconds(10 * 1000)),
+      threads(2),
+      hierarchicalAllreduce(false) {}
 
 namespace {
 
@@ -535,6 +543,10 @@ ProcessGroupGloo::ProcessGroupGloo(
     contexts_.push_back(std::move(context));
   }
 
+  if (options.hierarchicalAllreduce) {
+    initializeHierarchy(options);
+  }
+
   // Every worker thread stores the AsyncWork object it's currently
   // working on in the workInProgress_ vector. It must have size equal
   // to the number of workers such that they can simply index into it
@@ -573,6 +585,69 @@ std::shared_ptr<::gloo::Context> ProcessGroupGloo::getContext(uint32_t tag) {
   return contexts_[tag % contexts_.size()];
 }
 
+void ProcessGroupGloo::initializeHierarchy(const Options& options) {
+  // The host can be overridden, e.g. if containers on different machines
+  // share a hostname.
+  std::vector<char> hostname;
+  if (const char* hostEnv = getenv(kHierarchyHostEnv)) {
+    hostname.assign(hostEnv, hostEnv + strlen(hostEnv));
+  } else {
+    const auto hostNameMax = sysconf(_SC_HOST_NAME_MAX);
+    hostname.resize(hostNameMax + 1, '\0');
+    if (gethostname(hostname.data(), hostNameMax) != 0) {
+      throw std::system_error(errno, std::system_category());
+    }
+    hostname.resize(strlen(hostname.data()));
+  }
+
+  const std::string prefix = "hierarchy/";
+  store_->set(prefix + std::to_string(rank_), hostname);
+
+  // Hosts are numbered in order of their lowest rank.
+  std::vector<std::vector<char>> hosts;
+  std::vector<int> localRanks;
+  size_t hostIndex = 0;
+  for (int rank = 0; rank < size_; rank++) {
+    auto host = store_->get(prefix + std::to_string(rank));
+    auto it = std::find(hosts.begin(), hosts.end(), host);
+    if (it == hosts.end()) {
+      it = hosts.insert(hosts.end(), std::move(host));
+    }
+    if (*it == hostname) {
+      hostIndex = it - hosts.begin();
+      localRanks.push_back(rank);
+    }
+  }
+
+  const auto numHosts = hosts.size();
+  if (numHosts == 1 || numHosts == static_cast<size_t>(size_)) {
+    return;
+  }
+
+  const int localRank =
+      std::find(localRanks.begin(), localRanks.end(), rank_) -
+      localRanks.begin();
+  for (size_t i = 0; i < options.devices.size(); i++) {
+    auto context = std::make_shared<::gloo::rendezvous::Context>(
+        localRank, localRanks.size());
+    auto store = ::gloo::rendezvous::PrefixStore(
+        c10::str(prefix, "local/", hostIndex, "/", i), *store_);
+    context->setTimeout(options.timeout);
+    context->connectFullMesh(store, options.devices[i]);
+    localContexts_.push_back(std::move(context));
+
+    if (localRank == 0) {
+      auto context = std::make_shared<::gloo::rendezvous::Context>(
+          hostIndex, numHosts);
+      auto store = ::gloo::rendezvous::PrefixStore(
+          c10::str(prefix, "leaders/", i), *store_);
+      context->setTimeout(options.timeout);
+      context->connectFullMesh(store, options.devices[i]);
+      leaderContexts_.push_back(std::move(context));
+    }
+  }
+}
+
 void ProcessGroupGloo::runLoop(int workerIndex) {
   std::unique_lock<std::mutex> lock(workMutex_);
 
@@ -805,6 +880,61 @@ class AsyncAllreduceWork : public ProcessGroupGloo::AsyncWork {
   }
 };
 
+// Allreduce of a single tensor as a reduce among the ranks on every host,
+// an allreduce among the first ranks of all hosts, and a broadcast among the
+// ranks on every host. Every reduce op supported by allreduce is
+// associative, so the result is the same as that of the flat allreduce.
+class AsyncHierarchicalAllreduceWork : public AsyncAllreduceWork {
+ public:
+  AsyncHierarchicalAllreduceWork(
+      const std::shared_ptr<gloo::Context>& localContext,
+      const std::shared_ptr<gloo::Context>& leaderContext,
+      std::vector<at::Tensor>& inputs,
+      ReduceOp reduceOp,
+      uint32_t tag)
+      : AsyncAllreduceWork(leaderContext, inputs, reduceOp, tag),
+        localContext(localContext) {}
+
+  std::shared_ptr<gloo::Context> localContext;
+
+  void run() override {
+    auto& tensor = inputs[0];
+    const auto& scalarType = tensor.scalar_type();
+
+    gloo::ReduceOptions reduceOpts(localContext);
+    reduceOpts.setRoot(0);
+    reduceOpts.setTag(tag);
+    reduceOpts.setReduceFunction(getReduceFunction(scalarType, reduceOp));
+    GENERATE_ALL_TYPES(scalarType, setOutput, reduceOpts, tensor);
+    gloo::reduce(reduceOpts);
+
+    // Only the first rank on every host has a leader context.
+    if (context) {
+      allreduce(inputs);
+    }
+
+    gloo::BroadcastOptions broadcastOpts(localContext);
+    broadcastOpts.setRoot(0);
+    broadcastOpts.setTag(tag);
+    GENERATE_ALL_TYPES(scalarType, setOutput, broadcastOpts, tensor);
+    gloo::broadcast(broadcastOpts);
+  }
+
+ private:
+  template <typename T>
+  void getReduceFunction(gloo::ReduceOptions::Func& fn, const ReduceOp op) {
+    fn = toFunction<T>(op);
+  }
+
+  gloo::ReduceOptions::Func getReduceFunction(
+      const at::ScalarType& dtype,
+      const ReduceOp op) {
+    gloo::ReduceOptions::Func fn;
+    GENERATE_ALL_TYPES(dtype, getReduceFunction, fn, op);
+    return fn;
+  }
+};
+
 class AsyncAllreduceCoalescedWork : public AsyncAllreduceWork {
  public:
   AsyncAllreduceCoalescedWork(
@@ -1269,7 +1399,16 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupGloo::allreduce(
   auto tag = nextTag();
   auto context = getContext(tag);
   if (device.type() == at::kCPU) {
-    if (layout == c10::kStrided) {
+    if (layout == c10::kStrided && inputs.size() == 1 &&
+        !localContexts_.empty()) {
+      const auto index = tag % localContexts_.size();
+      work = std::make_shared<AsyncHierarchicalAllreduceWork>(
+          localContexts_[index],
+          leaderContexts_.empty() ? nullptr : leaderContexts_[index],
+          inputs,
+          opts.reduceOp,
+          tag);
+    } else if (layout == c10::kStrided) {
       work = std::make_shared<AsyncAllreduceWork>(
           std::move(context), inputs, opts.reduceOp, tag);
     } else if (layout == c10::kSparse) {
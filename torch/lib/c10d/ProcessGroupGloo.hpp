@@ -80,6 +80,10 @@ class ProcessGroupGloo : public ProcessGroup {
 
     virtual void run() = 0;
 
+    c10::intrusive_ptr<c10::ivalue::Future> getFuture() override {
+      return getFinishFuture();
+    }
+
    protected:
     friend class ProcessGroupGloo;
   };
@@ -129,6 +133,15 @@ class ProcessGroupGloo : public ProcessGroup {
     std::vector<std::shared_ptr<::gloo::transport::Device>> devices;
     std::chrono::milliseconds timeout;
     int threads;
+
+    // Run allreduce of a single dense CPU tensor in three steps: reduce to
+    // the first rank on every host, allreduce among these leaders, and
+    // broadcast back on every host. Ranks are grouped by hostname, which
+    // they exchange through the store on construction. Then each host only
+    // sends and receives one copy of the tensor across the network, instead
+    // of one per local rank. It has no effect if every rank runs on a
+    // different host, or all of them on the same host.
+    bool hierarchicalAllreduce;
   };
 
   // Helper functions to create a new device object.
@@ -245,6 +258,16 @@ class ProcessGroupGloo : public ProcessGroup {
   // to contexts being used in a round-robin fashion.
   std::shared_ptr<::gloo::Context> getContext(uint32_t tag);
 
+  // Groups ranks by host and connects the contexts for hierarchical
+  // allreduce (see Options::hierarchicalAllreduce).
+  void initializeHierarchy(const Options& options);
+
+  // Contexts connecting the ranks on this host, and the first ranks of all
+  // hosts (only set on those), one per device. Both are empty if
+  // hierarchical allreduce is disabled.
+  std::vector<std::shared_ptr<::gloo::Context>> localContexts_;
+  std::vector<std::shared_ptr<::gloo::Context>> leaderContexts_;
+
   // Entrypoint for worker threads.
   void runLoop(int workerIndex);
 
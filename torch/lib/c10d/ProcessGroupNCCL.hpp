@@ -81,6 +81,11 @@ class ProcessGroupNCCL : public ProcessGroup {
     // execution on the GPUs
     bool finishedGPUExecution();
 
+    // Makes the current streams wait for the work, and returns a completed
+    // Future. Kernels that callbacks enqueue on the current streams run
+    // after the work, as after wait().
+    c10::intrusive_ptr<c10::ivalue::Future> getFuture() override;
+
    protected:
     // The cached list of CUDA devices to operate on
     std::vector<at::Device> devices_;
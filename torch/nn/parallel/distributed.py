@@ -485,6 +485,47 @@ class DistributedDataParallel(Module):
         finally:
             self.require_backward_grad_sync = old_require_backward_grad_sync
 
+    def register_comm_hook(self, state, hook):
+        r"""
+        Registers a communication hook that replaces the allreduce of every
+        dense gradient bucket, e.g. to compress gradients before they are
+        communicated. It can only be registered once, before the first
+        backward pass.
+
+        The hook is called as ``hook(state, bucket)`` as soon as all gradients
+        of the ``dist.GradBucket`` ``bucket`` are ready. The flattened
+        gradients returned by ``bucket.get_tensors()`` have already been
+        divided by the size of the process group. The hook must return a
+        ``torch.futures.Future`` holding a list of tensors with the reduced
+        gradients, one per tensor of the bucket. DDP waits for these futures
+        at the end of the backward pass, so the hook should only start the
+        communication.
+
+        .. warning ::
+            ``Work.get_future`` is only supported by the Gloo backend.
+
+        Example::
+
+            >>> def allreduce_hook(process_group, bucket):
+            ...     tensors = bucket.get_tensors()
+            ...     fut = process_group.allreduce(tensors).get_future()
+            ...     return fut.then(lambda _: tensors)
+            >>> ddp.register_comm_hook(ddp.process_group, allreduce_hook)
+        """
+        self.reducer._register_comm_hook(state, hook)
+
+    def _register_builtin_comm_hook(self, comm_hook_type,
+                                    matrix_approximation_rank=1):
+        r"""
+        Registers one of the communication hooks implemented in C++, see
+        ``dist.BuiltinCommHookType``. They run without acquiring the GIL.
+        ``matrix_approximation_rank`` is the rank of the low-rank
+        approximation computed by ``POWER_SGD``, which keeps the error of the
+        approximation and adds it to the gradients of the next iteration.
+        """
+        self.reducer._register_builtin_comm_hook(
+            comm_hook_type, self.process_group, matrix_approximation_rank)
+
     def forward(self, *inputs, **kwargs):
         if self.require_forward_param_sync:
             self._sync_params()